@@ -128,6 +128,10 @@ else()
   message(STATUS "statx() not found")
 endif()
 set(CMAKE_REQUIRED_DEFINITIONS "")
+check_symbol_exists(__NR_io_uring_setup "sys/syscall.h;linux/io_uring.h" HAVE_LINUX_IO_URING)
+if(HAVE_LINUX_IO_URING)
+  list(APPEND SYSTEM_DEFINES -DHAVE_LINUX_IO_URING=1)
+endif()
 
 find_package(SSE)
 foreach(_sse SSE SSE2 SSE3 SSSE3 SSE4_1 SSE4_2 AVX AVX2)
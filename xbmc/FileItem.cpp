@@ -738,7 +738,7 @@ void CFileItem::Serialize(CVariant& value) const
   {
     auto& customProperties = value["customproperties"];
     for (const auto& prop : m_mapProperties)
-      customProperties[prop.first] = prop.second;
+      customProperties[GetPropertyName(prop.first)] = prop.second;
   }
 }
 
@@ -840,6 +840,26 @@ void CFileItem::ToSortable(SortItem &sortable, const Fields &fields) const
   sortable[FieldFolder] = m_bIsFolder;
 }
 
+size_t CFileItem::GetMemoryUsage() const
+{
+  size_t bytes = CGUIListItem::GetMemoryUsage() + sizeof(CFileItem) - sizeof(CGUIListItem);
+  bytes += GetStringHeapUsage(m_strPath) + GetStringHeapUsage(m_strDynPath);
+  bytes += GetStringHeapUsage(m_mimetype) + GetStringHeapUsage(m_extrainfo);
+  bytes += GetStringHeapUsage(m_strDVDLabel) + GetStringHeapUsage(m_strTitle);
+  bytes += GetStringHeapUsage(m_strLockCode);
+
+  if (m_musicInfoTag)
+    bytes += sizeof(*m_musicInfoTag);
+  if (m_videoInfoTag)
+    bytes += sizeof(*m_videoInfoTag);
+  if (m_pictureInfoTag)
+    bytes += sizeof(*m_pictureInfoTag);
+  if (m_gameInfoTag)
+    bytes += sizeof(*m_gameInfoTag);
+
+  return bytes;
+}
+
 bool CFileItem::Exists(bool bUseCache /* = true */) const
 {
   if (m_strPath.empty()
@@ -1799,7 +1819,7 @@ void CFileItem::UpdateInfo(const CFileItem &item, bool replaceLabels /*=true*/)
     SetLabel(item.GetLabel());
   if (replaceLabels && !item.GetLabel2().empty())
     SetLabel2(item.GetLabel2());
-  if (!item.GetArt().empty())
+  if (item.HasArt())
     SetArt(item.GetArt());
   AppendProperties(item);
 
@@ -1867,7 +1887,7 @@ void CFileItem::MergeInfo(const CFileItem& item)
     SetLabel(item.GetLabel());
   if (!item.GetLabel2().empty())
     SetLabel2(item.GetLabel2());
-  if (!item.GetArt().empty())
+  if (item.HasArt())
   {
     if (item.IsVideo())
       AppendArt(item.GetArt());
@@ -2490,6 +2510,24 @@ bool CFileItemList::IsEmpty() const
   return m_items.empty();
 }
 
+size_t CFileItemList::GetMemoryUsage() const
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  size_t bytes = CFileItem::GetMemoryUsage() + sizeof(CFileItemList) - sizeof(CFileItem);
+  bytes += GetStringHeapUsage(m_content);
+
+  // control block of make_shared and the vector slot
+  bytes += m_items.capacity() * sizeof(CFileItemPtr);
+  for (const auto& item : m_items)
+    bytes += item->GetMemoryUsage() + 2 * sizeof(void*) + sizeof(long) * 2;
+
+  // fast lookup map, one tree node per item
+  for (const auto& it : m_map)
+    bytes += sizeof(it) + 4 * sizeof(void*) + GetStringHeapUsage(it.first);
+
+  return bytes;
+}
+
 void CFileItemList::Reserve(size_t iCount)
 {
   std::unique_lock<CCriticalSection> lock(m_lock);
@@ -154,6 +154,11 @@ public:
   void ToSortable(SortItem &sortable, const Fields &fields) const;
   bool IsFileItem() const override { return true; }
 
+  /*! \brief Approximate number of bytes used by this item
+   Info tags owned by the item are counted by their object size only.
+   */
+  size_t GetMemoryUsage() const override;
+
   bool Exists(bool bUseCache = true) const;
 
   /*!
@@ -747,6 +752,12 @@ public:
   CFileItemPtr Get(const std::string& strPath) const;
   int Size() const;
   bool IsEmpty() const;
+
+  /*! \brief Approximate number of bytes used by the list and all items in it
+   Items shared with other lists are counted in each of them.
+   */
+  size_t GetMemoryUsage() const override;
+
   void Append(const CFileItemList& itemlist);
   void Assign(const CFileItemList& itemlist, bool append = false);
   bool Copy  (const CFileItemList& item, bool copyItems = true);
@@ -143,6 +143,11 @@ CDataCacheCore& CServiceBroker::GetDataCacheCore()
   return g_application.m_ServiceManager->GetDataCacheCore();
 }
 
+CDVDThumbExtractor& CServiceBroker::GetThumbExtractor()
+{
+  return g_application.m_ServiceManager->GetThumbExtractor();
+}
+
 CPlatform& CServiceBroker::GetPlatform()
 {
   return g_application.m_ServiceManager->GetPlatform();
@@ -56,6 +56,7 @@ class CComponentContainer;
 class CContextMenuManager;
 class XBPython;
 class CDataCacheCore;
+class CDVDThumbExtractor;
 class IAE;
 class IApplicationComponent;
 class CFavouritesService;
@@ -151,6 +152,7 @@ public:
   static PVR::CPVRManager& GetPVRManager();
   static CContextMenuManager& GetContextMenuManager();
   static CDataCacheCore& GetDataCacheCore();
+  static CDVDThumbExtractor& GetThumbExtractor();
   static CPlatform& GetPlatform();
   static PLAYLIST::CPlayListPlayer& GetPlaylistPlayer();
   static CSlideShowDelegator& GetSlideShowDelegator();
@@ -19,6 +19,7 @@
 #include "addons/VFSEntry.h"
 #include "addons/binary-addons/BinaryAddonManager.h"
 #include "cores/DataCacheCore.h"
+#include "cores/VideoPlayer/DVDThumbExtractor.h"
 #include "cores/RetroPlayer/guibridge/GUIGameRenderManager.h"
 #include "cores/playercorefactory/PlayerCoreFactory.h"
 #include "favourites/FavouritesService.h"
@@ -143,6 +144,7 @@ bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
   m_PVRManager = std::make_unique<PVR::CPVRManager>();
 
   m_dataCacheCore = std::make_unique<CDataCacheCore>();
+  m_thumbExtractor = std::make_unique<CDVDThumbExtractor>();
 
   m_binaryAddonCache = std::make_unique<ADDON::CBinaryAddonCache>();
   m_binaryAddonCache->Init();
@@ -231,6 +233,8 @@ void CServiceManager::DeinitStageThree()
   m_contextMenuManager->Deinit();
   m_gameServices.reset();
   m_peripherals->Clear();
+  // fail pending thumbnail extractions before the jobs waiting for them are torn down
+  m_thumbExtractor->Deinitialize();
 
   m_Platform->DeinitStageThree();
 }
@@ -254,6 +258,7 @@ void CServiceManager::DeinitStageTwo()
   m_serviceAddons.reset();
   m_favouritesService.reset();
   m_binaryAddonCache.reset();
+  m_thumbExtractor.reset();
   m_dataCacheCore.reset();
   m_PVRManager.reset();
   m_extsMimeSupportList.reset();
@@ -356,6 +361,11 @@ CDataCacheCore& CServiceManager::GetDataCacheCore()
   return *m_dataCacheCore;
 }
 
+CDVDThumbExtractor& CServiceManager::GetThumbExtractor()
+{
+  return *m_thumbExtractor;
+}
+
 CPlatform& CServiceManager::GetPlatform()
 {
   return *m_Platform;
@@ -43,6 +43,7 @@ class IWSDiscovery;
 }
 #endif
 class CDataCacheCore;
+class CDVDThumbExtractor;
 class CFavouritesService;
 class CNetworkBase;
 class CWinSystemBase;
@@ -119,6 +120,7 @@ public:
   PVR::CPVRManager& GetPVRManager();
   CContextMenuManager& GetContextMenuManager();
   CDataCacheCore& GetDataCacheCore();
+  CDVDThumbExtractor& GetThumbExtractor();
   /**\brief Get the platform object. This is save to be called after Init1() was called
    */
   CPlatform& GetPlatform();
@@ -166,6 +168,7 @@ protected:
   std::unique_ptr<PVR::CPVRManager> m_PVRManager;
   std::unique_ptr<CContextMenuManager> m_contextMenuManager;
   std::unique_ptr<CDataCacheCore> m_dataCacheCore;
+  std::unique_ptr<CDVDThumbExtractor> m_thumbExtractor;
   std::unique_ptr<CPlatform> m_Platform;
   std::unique_ptr<PLAYLIST::CPlayListPlayer> m_playlistPlayer;
   std::unique_ptr<KODI::GAME::CControllerManager> m_gameControllerManager;
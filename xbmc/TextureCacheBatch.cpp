@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureCacheBatch.h"
+
+#include "ServiceBroker.h"
+#include "TextureCache.h"
+#include "TextureDatabase.h"
+#include "filesystem/File.h"
+
+#include <mutex>
+
+using namespace XFILE;
+
+namespace
+{
+// the job manager runs at most three low priority jobs, higher priorities keep
+// the remaining workers so the GUI stays responsive during a scan
+constexpr unsigned int CACHE_JOBS = 3;
+
+// images waiting for a job before Add() blocks the scanner
+constexpr unsigned int MAX_PENDING = 32;
+} // unnamed namespace
+
+CTextureCacheBatch::CTextureCacheBatch() : m_jobs(CACHE_JOBS, CJob::PRIORITY_LOW)
+{
+}
+
+CTextureCacheBatch::~CTextureCacheBatch()
+{
+  Wait();
+}
+
+void CTextureCacheBatch::Add(const std::string& image)
+{
+  const std::string url = CTextureUtils::UnwrapImageURL(image);
+  if (url.empty())
+    return;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    if (m_images.empty())
+      m_start = std::chrono::steady_clock::now();
+    if (!m_images.insert(url).second)
+    {
+      m_stats.duplicates++;
+      return;
+    }
+  }
+
+  const auto textureCache = CServiceBroker::GetTextureCache();
+  if (textureCache->HasCachedImage(image))
+  {
+    textureCache->BackgroundCacheImage(image);
+    return;
+  }
+
+  m_jobs.WaitForFewer(MAX_PENDING);
+  m_jobs.Submit("", [this, image] { Cache(image); });
+}
+
+void CTextureCacheBatch::Cache(const std::string& image)
+{
+  CTextureDetails details;
+  const bool cached = CServiceBroker::GetTextureCache()->CacheImage(image, details);
+
+  struct __stat64 buffer = {};
+  if (cached && CFile::Stat(CTextureCache::GetCachedPath(details.file), &buffer) != 0)
+    buffer.st_size = 0;
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (cached)
+  {
+    m_stats.images++;
+    m_stats.bytes += buffer.st_size;
+  }
+  else
+    m_stats.failed++;
+}
+
+CTextureCacheBatch::Stats CTextureCacheBatch::Wait()
+{
+  m_jobs.Wait();
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  Stats stats = m_stats;
+  if (!m_images.empty())
+  {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+    stats.seconds = elapsed.count();
+  }
+
+  m_images.clear();
+  m_stats = Stats();
+  return stats;
+}
+
+void CTextureCacheBatch::Cancel()
+{
+  m_jobs.Cancel();
+}
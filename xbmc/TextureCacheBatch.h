@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "utils/JobGroup.h"
+
+#include <chrono>
+#include <set>
+#include <stdint.h>
+#include <string>
+
+/*!
+ \ingroup textures
+ \brief Caches the artwork found by a library scan a few images at once
+
+ The scanner hands the art of an item over and continues with the next item
+ while the images are downloaded and cached in the background. An image is
+ only cached once however many items use it, and Add() blocks while too many
+ images wait for caching so the scan can't run away from its artwork. Wait()
+ drains the batch at the end of the scan and returns how fast it went.
+
+ Images that are in the texture cache already go to
+ CTextureCache::BackgroundCacheImage() as before, so their usage and the checks
+ for updated images are handled the same way.
+
+ \sa CTextureCache
+ */
+class CTextureCacheBatch
+{
+public:
+  struct Stats
+  {
+    double ImagesPerSecond() const { return seconds > 0.0 ? images / seconds : 0.0; }
+
+    unsigned int images = 0; //!< images cached
+    unsigned int failed = 0; //!< images that could not be cached
+    unsigned int duplicates = 0; //!< images added again while in the batch
+    uint64_t bytes = 0; //!< size of the cached images
+    double seconds = 0.0; //!< time from the first image until the batch was drained
+  };
+
+  CTextureCacheBatch();
+
+  /*! \brief Waits for the images of the batch, cancel them first if they are not needed anymore
+   */
+  ~CTextureCacheBatch();
+
+  /*! \brief Cache an image in the background
+   Blocks while the batch is full.
+   \param image url of the image to cache
+   */
+  void Add(const std::string& image);
+
+  /*! \brief Wait until all images of the batch are cached and start a new batch
+   \return the counters of the finished batch
+   */
+  Stats Wait();
+
+  /*! \brief Drop the images that are not being cached yet, e.g. when the scan was stopped
+   */
+  void Cancel();
+
+private:
+  CTextureCacheBatch(const CTextureCacheBatch&) = delete;
+  CTextureCacheBatch& operator=(const CTextureCacheBatch&) = delete;
+
+  void Cache(const std::string& image);
+
+  CJobGroup m_jobs;
+
+  CCriticalSection m_section;
+  std::set<std::string> m_images;
+  Stats m_stats;
+  std::chrono::steady_clock::time_point m_start;
+};
@@ -40,6 +40,8 @@ Arguments:
   --debug               Enable debug logging
   --version             Print version information
   --test                Enable test mode. [FILE] required.
+  --playback-benchmark  Play [FILE] without drawing the video, log the decode and render
+                        statistics and quit. Use with --windowing=null where available.
   --settings=<filename> Loads specified file after advancedsettings.xml replacing any settings specified
                         specified file must exist in special://xbmc/system/
 )""";
@@ -66,7 +68,10 @@ void CAppParamParser::Parse(const char* const* argv, int nArgs)
   {
     // testmode is only valid if at least one item to play was given
     if (m_params->GetPlaylist().IsEmpty())
+    {
       m_params->SetTestMode(false);
+      m_params->SetPlaybackBenchmark(false);
+    }
   }
 
   // Record raw paramerters
@@ -107,6 +112,12 @@ void CAppParamParser::ParseArg(const std::string &arg)
     m_params->SetLogLevel(LOG_LEVEL_DEBUG);
   else if (arg == "--test")
     m_params->SetTestMode(true);
+  else if (arg == "--playback-benchmark")
+  {
+    // test mode quits once the playback ends
+    m_params->SetTestMode(true);
+    m_params->SetPlaybackBenchmark(true);
+  }
   else if (arg.substr(0, 11) == "--settings=")
     m_params->SetSettingsFile(arg.substr(11));
   else if (arg.length() != 0 && arg[0] != '-')
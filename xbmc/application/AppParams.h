@@ -41,6 +41,9 @@ public:
   bool IsTestMode() const { return m_testmode; }
   void SetTestMode(bool testMode) { m_testmode = testMode; }
 
+  bool IsPlaybackBenchmark() const { return m_playbackBenchmark; }
+  void SetPlaybackBenchmark(bool playbackBenchmark) { m_playbackBenchmark = playbackBenchmark; }
+
   const std::string& GetSettingsFile() const { return m_settingsFile; }
   void SetSettingsFile(const std::string& settingsFile) { m_settingsFile = settingsFile; }
 
@@ -84,6 +87,7 @@ private:
   bool m_standAlone{false};
   bool m_platformDirectories{true};
   bool m_testmode{false};
+  bool m_playbackBenchmark{false};
 
   std::string m_settingsFile;
   std::string m_windowing;
@@ -137,6 +137,7 @@
 #include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
 #include "utils/TimeUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/XTimeUtils.h"
@@ -858,6 +859,8 @@ bool CApplication::OnSettingsSaving() const
 
 void CApplication::Render()
 {
+  KODI_TRACE_SCOPE("app", "CApplication::Render");
+
   // do not render if we are stopped or in background
   if (m_bStop)
     return;
@@ -1808,6 +1811,8 @@ void CApplication::UnlockFrameMoveGuard()
 
 void CApplication::FrameMove(bool processEvents, bool processGUI)
 {
+  KODI_TRACE_SCOPE("app", "CApplication::FrameMove");
+
   const auto appPlayer = GetComponent<CApplicationPlayer>();
   bool renderGUI = GetComponent<CApplicationPowerHandling>()->GetRenderGUI();
   if (processEvents)
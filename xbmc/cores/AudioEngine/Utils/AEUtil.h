@@ -92,10 +92,6 @@ private:
 
 class CAEUtil
 {
-private:
-
-  static float SoftClamp(const float x);
-
 public:
   static CAEChannelInfo          GuessChLayout     (const unsigned int channels);
   static const char*             GetStdChLayoutName(const enum AEStdChLayout layout);
@@ -163,11 +159,13 @@ public:
     return 20*log10(scale);
   }
 
-  #if defined(HAVE_SSE) && defined(__SSE__)
-  static void SSEMulArray     (float *data, const float mul, uint32_t count);
-  static void SSEMulAddArray  (float *data, float *add, const float mul, uint32_t count);
-  #endif
+  /*! \brief sample kernels, dispatched to the fastest CAEVectorOps variant of the CPU */
+  static void MulArray(float* data, const float mul, uint32_t count);
+  static void MulAddArray(float* data, const float* add, const float mul, uint32_t count);
   static void ClampArray(float *data, uint32_t count);
+  static bool NeedsClamp(const float* data, uint32_t count);
+  static void InterleaveArray(float* dst, const float* const* src, uint32_t channels, uint32_t frames);
+  static void DeinterleaveArray(float* const* dst, const float* src, uint32_t channels, uint32_t frames);
 
   static bool S16NeedsByteSwap(AEDataFormat in, AEDataFormat out);
 
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+// This file is built with -mavx2 and must only be entered after a runtime check
+// for CPU_FEATURE_AVX2, see CAEVectorOps::IsSupported().
+
+#include "AEVectorOps.h"
+
+#include <immintrin.h>
+
+namespace
+{
+// scalar tails are kept local so no AVX encoded code leaks into shared inline functions
+void MulArrayTail(float* data, float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] *= mul;
+}
+
+void MulAddArrayTail(float* data, const float* add, float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] += add[i] * mul;
+}
+
+float SoftClampTail(const float x)
+{
+  if (x < -3.0f)
+    return -1.0f;
+  else if (x > 3.0f)
+    return 1.0f;
+  float y = x * x;
+  return x * (27.0f + y) / (27.0f + 9.0f * y);
+}
+
+void MulArrayAVX2(float* data, float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+
+  MulArrayTail(data + i, mul, count - i);
+}
+
+void MulAddArrayAVX2(float* data, const float* add, float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    // separate mul and add, a fused multiply-add would round differently than the reference
+    const __m256 ad = _mm256_loadu_ps(add + i);
+    const __m256 to = _mm256_loadu_ps(data + i);
+    _mm256_storeu_ps(data + i, _mm256_add_ps(to, _mm256_mul_ps(ad, m)));
+  }
+
+  MulAddArrayTail(data + i, add + i, mul, count - i);
+}
+
+void ClampArrayAVX2(float* data, uint32_t count)
+{
+  const __m256 c27 = _mm256_set1_ps(27.0f);
+  const __m256 c9 = _mm256_set1_ps(9.0f);
+  const __m256 c3 = _mm256_set1_ps(3.0f);
+  const __m256 cm3 = _mm256_set1_ps(-3.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 mone = _mm256_set1_ps(-1.0f);
+
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 x = _mm256_loadu_ps(data + i);
+    const __m256 y = _mm256_mul_ps(x, x);
+    __m256 r = _mm256_div_ps(_mm256_mul_ps(x, _mm256_add_ps(c27, y)),
+                             _mm256_add_ps(c27, _mm256_mul_ps(c9, y)));
+
+    r = _mm256_blendv_ps(r, one, _mm256_cmp_ps(x, c3, _CMP_GT_OQ));
+    r = _mm256_blendv_ps(r, mone, _mm256_cmp_ps(x, cm3, _CMP_LT_OQ));
+    _mm256_storeu_ps(data + i, r);
+  }
+
+  for (; i < count; ++i)
+    data[i] = SoftClampTail(data[i]);
+}
+
+bool NeedsClampAVX2(const float* data, uint32_t count)
+{
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 mone = _mm256_set1_ps(-1.0f);
+
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 x = _mm256_loadu_ps(data + i);
+    const __m256 out =
+        _mm256_or_ps(_mm256_cmp_ps(x, one, _CMP_GT_OQ), _mm256_cmp_ps(x, mone, _CMP_LT_OQ));
+    if (_mm256_movemask_ps(out))
+      return true;
+  }
+
+  for (; i < count; ++i)
+  {
+    if (data[i] > 1.0f || data[i] < -1.0f)
+      return true;
+  }
+  return false;
+}
+
+void InterleaveAVX2(float* dst, const float* const* src, uint32_t channels, uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    const float* l = src[0];
+    const float* r = src[1];
+    for (; f + 8 <= frames; f += 8)
+    {
+      const __m256 vl = _mm256_loadu_ps(l + f);
+      const __m256 vr = _mm256_loadu_ps(r + f);
+      // per 128 bit lane: L0 R0 L1 R1 | L4 R4 L5 R5 and L2 R2 L3 R3 | L6 R6 L7 R7
+      const __m256 lo = _mm256_unpacklo_ps(vl, vr);
+      const __m256 hi = _mm256_unpackhi_ps(vl, vr);
+      _mm256_storeu_ps(dst + 2 * f, _mm256_permute2f128_ps(lo, hi, 0x20));
+      _mm256_storeu_ps(dst + 2 * f + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+  }
+
+  for (; f < frames; ++f)
+  {
+    for (uint32_t c = 0; c < channels; ++c)
+      dst[f * channels + c] = src[c][f];
+  }
+}
+
+void DeinterleaveAVX2(float* const* dst, const float* src, uint32_t channels, uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    float* l = dst[0];
+    float* r = dst[1];
+    for (; f + 8 <= frames; f += 8)
+    {
+      const __m256 v0 = _mm256_loadu_ps(src + 2 * f);
+      const __m256 v1 = _mm256_loadu_ps(src + 2 * f + 8);
+      // L0 R0 L1 R1 | L4 R4 L5 R5 and L2 R2 L3 R3 | L6 R6 L7 R7
+      const __m256 t0 = _mm256_permute2f128_ps(v0, v1, 0x20);
+      const __m256 t1 = _mm256_permute2f128_ps(v0, v1, 0x31);
+      _mm256_storeu_ps(l + f, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm256_storeu_ps(r + f, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+  }
+
+  for (; f < frames; ++f)
+  {
+    for (uint32_t c = 0; c < channels; ++c)
+      dst[c][f] = src[f * channels + c];
+  }
+}
+} // namespace
+
+const CAEVectorOps::Kernels& CAEVectorOps::GetAVX2()
+{
+  static const Kernels kernels = {ISA::AVX2,       "avx2",         MulArrayAVX2,
+                                  MulAddArrayAVX2, ClampArrayAVX2, NeedsClampAVX2,
+                                  InterleaveAVX2,  DeinterleaveAVX2};
+  return kernels;
+}
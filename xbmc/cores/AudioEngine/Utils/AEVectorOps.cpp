@@ -0,0 +1,301 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEVectorOps.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <atomic>
+#include <cmath>
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+void MulArrayScalar(float* data, float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] *= mul;
+}
+
+void MulAddArrayScalar(float* data, const float* add, float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] += add[i] * mul;
+}
+
+void ClampArrayScalar(float* data, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] = CAEVectorOps::SoftClamp(data[i]);
+}
+
+bool NeedsClampScalar(const float* data, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    if (std::fabs(data[i]) > 1.0f)
+      return true;
+  }
+  return false;
+}
+
+void InterleaveScalar(float* dst, const float* const* src, uint32_t channels, uint32_t frames)
+{
+  for (uint32_t f = 0; f < frames; ++f)
+  {
+    for (uint32_t c = 0; c < channels; ++c)
+      *dst++ = src[c][f];
+  }
+}
+
+void DeinterleaveScalar(float* const* dst, const float* src, uint32_t channels, uint32_t frames)
+{
+  for (uint32_t f = 0; f < frames; ++f)
+  {
+    for (uint32_t c = 0; c < channels; ++c)
+      dst[c][f] = *src++;
+  }
+}
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+void MulArraySSE(float* data, float mul, uint32_t count)
+{
+  const __m128 m = _mm_set_ps1(mul);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), m));
+
+  MulArrayScalar(data + i, mul, count - i);
+}
+
+void MulAddArraySSE(float* data, const float* add, float mul, uint32_t count)
+{
+  const __m128 m = _mm_set_ps1(mul);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 ad = _mm_loadu_ps(add + i);
+    const __m128 to = _mm_loadu_ps(data + i);
+    _mm_storeu_ps(data + i, _mm_add_ps(to, _mm_mul_ps(ad, m)));
+  }
+
+  MulAddArrayScalar(data + i, add + i, mul, count - i);
+}
+
+void ClampArraySSE(float* data, uint32_t count)
+{
+  const __m128 c27 = _mm_set_ps1(27.0f);
+  const __m128 c9 = _mm_set_ps1(9.0f);
+  const __m128 c3 = _mm_set_ps1(3.0f);
+  const __m128 cm3 = _mm_set_ps1(-3.0f);
+  const __m128 one = _mm_set_ps1(1.0f);
+  const __m128 mone = _mm_set_ps1(-1.0f);
+
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    /* tanh approx clamp, same operation order as SoftClamp */
+    const __m128 x = _mm_loadu_ps(data + i);
+    const __m128 y = _mm_mul_ps(x, x);
+    __m128 r = _mm_div_ps(_mm_mul_ps(x, _mm_add_ps(c27, y)), _mm_add_ps(c27, _mm_mul_ps(c9, y)));
+
+    /* saturate outside of [-3, 3] */
+    const __m128 hi = _mm_cmpgt_ps(x, c3);
+    const __m128 lo = _mm_cmplt_ps(x, cm3);
+    r = _mm_or_ps(_mm_andnot_ps(hi, r), _mm_and_ps(hi, one));
+    r = _mm_or_ps(_mm_andnot_ps(lo, r), _mm_and_ps(lo, mone));
+    _mm_storeu_ps(data + i, r);
+  }
+
+  ClampArrayScalar(data + i, count - i);
+}
+
+bool NeedsClampSSE(const float* data, uint32_t count)
+{
+  const __m128 one = _mm_set_ps1(1.0f);
+  const __m128 mone = _mm_set_ps1(-1.0f);
+
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 x = _mm_loadu_ps(data + i);
+    if (_mm_movemask_ps(_mm_or_ps(_mm_cmpgt_ps(x, one), _mm_cmplt_ps(x, mone))))
+      return true;
+  }
+
+  return NeedsClampScalar(data + i, count - i);
+}
+
+void InterleaveSSE(float* dst, const float* const* src, uint32_t channels, uint32_t frames)
+{
+  if (channels != 2)
+  {
+    InterleaveScalar(dst, src, channels, frames);
+    return;
+  }
+
+  const float* l = src[0];
+  const float* r = src[1];
+  uint32_t f = 0;
+  for (; f + 4 <= frames; f += 4)
+  {
+    const __m128 vl = _mm_loadu_ps(l + f);
+    const __m128 vr = _mm_loadu_ps(r + f);
+    _mm_storeu_ps(dst + 2 * f, _mm_unpacklo_ps(vl, vr));
+    _mm_storeu_ps(dst + 2 * f + 4, _mm_unpackhi_ps(vl, vr));
+  }
+
+  const float* tail[2] = {l + f, r + f};
+  InterleaveScalar(dst + 2 * f, tail, 2, frames - f);
+}
+
+void DeinterleaveSSE(float* const* dst, const float* src, uint32_t channels, uint32_t frames)
+{
+  if (channels != 2)
+  {
+    DeinterleaveScalar(dst, src, channels, frames);
+    return;
+  }
+
+  float* l = dst[0];
+  float* r = dst[1];
+  uint32_t f = 0;
+  for (; f + 4 <= frames; f += 4)
+  {
+    const __m128 v0 = _mm_loadu_ps(src + 2 * f);
+    const __m128 v1 = _mm_loadu_ps(src + 2 * f + 4);
+    _mm_storeu_ps(l + f, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(r + f, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+
+  float* const tail[2] = {l + f, r + f};
+  DeinterleaveScalar(tail, src + 2 * f, 2, frames - f);
+}
+#endif
+
+const CAEVectorOps::Kernels* Resolve()
+{
+  static const CAEVectorOps::ISA order[] = {CAEVectorOps::ISA::AVX2, CAEVectorOps::ISA::NEON,
+                                            CAEVectorOps::ISA::SSE, CAEVectorOps::ISA::SCALAR};
+  for (const auto isa : order)
+  {
+    const CAEVectorOps::Kernels* kernels = CAEVectorOps::Get(isa);
+    if (kernels)
+      return kernels;
+  }
+  return nullptr;
+}
+} // namespace
+
+const CAEVectorOps::Kernels& CAEVectorOps::GetScalar()
+{
+  static const Kernels kernels = {ISA::SCALAR,       "scalar",        MulArrayScalar,
+                                  MulAddArrayScalar, ClampArrayScalar, NeedsClampScalar,
+                                  InterleaveScalar,  DeinterleaveScalar};
+  return kernels;
+}
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+const CAEVectorOps::Kernels& CAEVectorOps::GetSSE()
+{
+  static const Kernels kernels = {ISA::SSE,       "sse",         MulArraySSE,
+                                  MulAddArraySSE, ClampArraySSE, NeedsClampSSE,
+                                  InterleaveSSE,  DeinterleaveSSE};
+  return kernels;
+}
+#endif
+
+bool CAEVectorOps::IsSupported(ISA isa)
+{
+  switch (isa)
+  {
+    case ISA::SCALAR:
+      return true;
+    case ISA::SSE:
+#if defined(HAVE_SSE) && defined(__SSE__)
+      return true;
+#else
+      return false;
+#endif
+    case ISA::AVX2:
+#if defined(HAVE_AE_VECTOROPS_AVX2)
+    {
+      const auto cpuInfo = CServiceBroker::GetCPUInfo();
+      return cpuInfo && (cpuInfo->GetCPUFeatures() & CPU_FEATURE_AVX2) == CPU_FEATURE_AVX2;
+    }
+#else
+      return false;
+#endif
+    case ISA::NEON:
+#if defined(HAVE_AE_VECTOROPS_NEON) && defined(__aarch64__)
+      return true;
+#elif defined(HAVE_AE_VECTOROPS_NEON)
+    {
+      const auto cpuInfo = CServiceBroker::GetCPUInfo();
+      return cpuInfo && (cpuInfo->GetCPUFeatures() & CPU_FEATURE_NEON) == CPU_FEATURE_NEON;
+    }
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+const CAEVectorOps::Kernels* CAEVectorOps::Get(ISA isa)
+{
+  if (!IsSupported(isa))
+    return nullptr;
+
+  switch (isa)
+  {
+    case ISA::SCALAR:
+      return &GetScalar();
+#if defined(HAVE_SSE) && defined(__SSE__)
+    case ISA::SSE:
+      return &GetSSE();
+#endif
+#if defined(HAVE_AE_VECTOROPS_AVX2)
+    case ISA::AVX2:
+      return &GetAVX2();
+#endif
+#if defined(HAVE_AE_VECTOROPS_NEON)
+    case ISA::NEON:
+      return &GetNEON();
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const CAEVectorOps::Kernels& CAEVectorOps::Get()
+{
+  static std::atomic<const Kernels*> resolved{nullptr};
+
+  const Kernels* kernels = resolved.load(std::memory_order_acquire);
+  if (kernels)
+    return *kernels;
+
+  kernels = Resolve();
+
+  // runtime detected variants need CPUInfo, don't pin a lesser choice before it exists
+  if (CServiceBroker::GetCPUInfo())
+  {
+    const Kernels* expected = nullptr;
+    if (resolved.compare_exchange_strong(expected, kernels, std::memory_order_acq_rel))
+      CLog::Log(LOGINFO, "CAEVectorOps::{} - using {} kernels", __FUNCTION__, kernels->name);
+    else
+      kernels = expected;
+  }
+
+  return *kernels;
+}
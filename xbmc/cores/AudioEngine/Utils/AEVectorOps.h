@@ -0,0 +1,92 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*!
+ * \brief Runtime dispatched float sample kernels used by the ActiveAE mixer.
+ *
+ * Every instruction set variant produces output that is bit-identical to the
+ * scalar reference implementation, so switching between them never changes
+ * what reaches the sink. The best variant supported by the running CPU is
+ * selected through \ref CCPUInfo once it has been registered with the
+ * service broker.
+ */
+class CAEVectorOps
+{
+public:
+  enum class ISA
+  {
+    SCALAR,
+    SSE,
+    AVX2,
+    NEON
+  };
+
+  struct Kernels
+  {
+    ISA isa;
+    const char* name;
+
+    //! data[i] *= mul
+    void (*MulArray)(float* data, float mul, uint32_t count);
+    //! data[i] += add[i] * mul
+    void (*MulAddArray)(float* data, const float* add, float mul, uint32_t count);
+    //! data[i] = SoftClamp(data[i])
+    void (*ClampArray)(float* data, uint32_t count);
+    //! true if any |data[i]| > 1.0
+    bool (*NeedsClamp)(const float* data, uint32_t count);
+    //! planar src[channel][frame] -> interleaved dst[frame * channels + channel]
+    void (*Interleave)(float* dst, const float* const* src, uint32_t channels, uint32_t frames);
+    //! interleaved src[frame * channels + channel] -> planar dst[channel][frame]
+    void (*Deinterleave)(float* const* dst, const float* src, uint32_t channels, uint32_t frames);
+  };
+
+  /*!
+   * \brief Get the fastest kernel set supported by the running CPU
+   */
+  static const Kernels& Get();
+
+  /*!
+   * \brief Get the kernel set for a specific instruction set
+   * \return nullptr if the variant was not built or the CPU does not support it
+   */
+  static const Kernels* Get(ISA isa);
+
+  /*!
+   * \brief Check whether a variant is built in and usable on the running CPU
+   */
+  static bool IsSupported(ISA isa);
+
+  /*!
+   * \brief Tanh-like rational soft clipper, the scalar reference for ClampArray
+   */
+  static inline float SoftClamp(const float x)
+  {
+    /*
+       This is a rational function to approximate a tanh-like soft clipper.
+       It is based on the pade-approximation of the tanh function with tweaked coefficients.
+       See: http://www.musicdsp.org/showone.php?id=238
+    */
+    if (x < -3.0f)
+      return -1.0f;
+    else if (x > 3.0f)
+      return 1.0f;
+    float y = x * x;
+    return x * (27.0f + y) / (27.0f + 9.0f * y);
+  }
+
+private:
+  // per instruction set tables, only defined when the variant is built in
+  static const Kernels& GetScalar();
+  static const Kernels& GetSSE();
+  static const Kernels& GetAVX2();
+  static const Kernels& GetNEON();
+};
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEVectorOps.h"
+
+#include <arm_neon.h>
+
+namespace
+{
+void MulArrayNEON(float* data, float mul, uint32_t count)
+{
+  const float32x4_t m = vdupq_n_f32(mul);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), m));
+
+  for (; i < count; ++i)
+    data[i] *= mul;
+}
+
+void MulAddArrayNEON(float* data, const float* add, float mul, uint32_t count)
+{
+  const float32x4_t m = vdupq_n_f32(mul);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    // no vmla/vfma, the reference rounds the product before the sum
+    const float32x4_t ad = vld1q_f32(add + i);
+    const float32x4_t to = vld1q_f32(data + i);
+    vst1q_f32(data + i, vaddq_f32(to, vmulq_f32(ad, m)));
+  }
+
+  for (; i < count; ++i)
+    data[i] += add[i] * mul;
+}
+
+void ClampArrayNEON(float* data, uint32_t count)
+{
+  uint32_t i = 0;
+#if defined(__aarch64__)
+  // ARMv7 NEON has no IEEE division, so only AArch64 can match the reference bit for bit
+  const float32x4_t c27 = vdupq_n_f32(27.0f);
+  const float32x4_t c9 = vdupq_n_f32(9.0f);
+  const float32x4_t c3 = vdupq_n_f32(3.0f);
+  const float32x4_t cm3 = vdupq_n_f32(-3.0f);
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  const float32x4_t mone = vdupq_n_f32(-1.0f);
+
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t x = vld1q_f32(data + i);
+    const float32x4_t y = vmulq_f32(x, x);
+    float32x4_t r =
+        vdivq_f32(vmulq_f32(x, vaddq_f32(c27, y)), vaddq_f32(c27, vmulq_f32(c9, y)));
+
+    r = vbslq_f32(vcgtq_f32(x, c3), one, r);
+    r = vbslq_f32(vcltq_f32(x, cm3), mone, r);
+    vst1q_f32(data + i, r);
+  }
+#endif
+
+  for (; i < count; ++i)
+    data[i] = CAEVectorOps::SoftClamp(data[i]);
+}
+
+bool NeedsClampNEON(const float* data, uint32_t count)
+{
+  const float32x4_t one = vdupq_n_f32(1.0f);
+
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const uint32x4_t out = vcagtq_f32(vld1q_f32(data + i), one);
+    const uint32x2_t fold = vorr_u32(vget_low_u32(out), vget_high_u32(out));
+    if (vget_lane_u32(vpmax_u32(fold, fold), 0))
+      return true;
+  }
+
+  for (; i < count; ++i)
+  {
+    if (data[i] > 1.0f || data[i] < -1.0f)
+      return true;
+  }
+  return false;
+}
+
+void InterleaveNEON(float* dst, const float* const* src, uint32_t channels, uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      float32x4x2_t v;
+      v.val[0] = vld1q_f32(src[0] + f);
+      v.val[1] = vld1q_f32(src[1] + f);
+      vst2q_f32(dst + 2 * f, v);
+    }
+  }
+  else if (channels == 4)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      float32x4x4_t v;
+      for (int c = 0; c < 4; ++c)
+        v.val[c] = vld1q_f32(src[c] + f);
+      vst4q_f32(dst + 4 * f, v);
+    }
+  }
+
+  for (; f < frames; ++f)
+  {
+    for (uint32_t c = 0; c < channels; ++c)
+      dst[f * channels + c] = src[c][f];
+  }
+}
+
+void DeinterleaveNEON(float* const* dst, const float* src, uint32_t channels, uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const float32x4x2_t v = vld2q_f32(src + 2 * f);
+      vst1q_f32(dst[0] + f, v.val[0]);
+      vst1q_f32(dst[1] + f, v.val[1]);
+    }
+  }
+  else if (channels == 4)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const float32x4x4_t v = vld4q_f32(src + 4 * f);
+      for (int c = 0; c < 4; ++c)
+        vst1q_f32(dst[c] + f, v.val[c]);
+    }
+  }
+
+  for (; f < frames; ++f)
+  {
+    for (uint32_t c = 0; c < channels; ++c)
+      dst[c][f] = src[f * channels + c];
+  }
+}
+} // namespace
+
+const CAEVectorOps::Kernels& CAEVectorOps::GetNEON()
+{
+  static const Kernels kernels = {ISA::NEON,       "neon",         MulArrayNEON,
+                                  MulAddArrayNEON, ClampArrayNEON, NeedsClampNEON,
+                                  InterleaveNEON,  DeinterleaveNEON};
+  return kernels;
+}
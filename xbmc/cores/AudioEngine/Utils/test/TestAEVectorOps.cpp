@@ -0,0 +1,245 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/Utils/AEVectorOps.h"
+#include "utils/CPUInfo.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr CAEVectorOps::ISA ISAS[] = {CAEVectorOps::ISA::SSE, CAEVectorOps::ISA::AVX2,
+                                      CAEVectorOps::ISA::NEON};
+
+// odd sizes and offsets so every variant runs its unaligned head and scalar tail
+constexpr uint32_t COUNTS[] = {0, 1, 3, 7, 8, 15, 17, 64, 1023};
+constexpr uint32_t OFFSETS[] = {0, 1, 3};
+
+std::vector<float> RandomSamples(size_t count, float range, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-range, range);
+  std::vector<float> samples(count);
+  for (auto& sample : samples)
+    sample = dist(gen);
+  return samples;
+}
+
+bool BitEqual(const float* a, const float* b, size_t count)
+{
+  return std::memcmp(a, b, count * sizeof(float)) == 0;
+}
+} // namespace
+
+class TestAEVectorOps : public ::testing::Test
+{
+protected:
+  TestAEVectorOps() { CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo()); }
+  ~TestAEVectorOps() override { CServiceBroker::UnregisterCPUInfo(); }
+
+  const CAEVectorOps::Kernels& m_scalar = *CAEVectorOps::Get(CAEVectorOps::ISA::SCALAR);
+};
+
+TEST_F(TestAEVectorOps, ScalarAlwaysAvailable)
+{
+  EXPECT_TRUE(CAEVectorOps::IsSupported(CAEVectorOps::ISA::SCALAR));
+  EXPECT_EQ(CAEVectorOps::ISA::SCALAR, m_scalar.isa);
+  EXPECT_TRUE(CAEVectorOps::IsSupported(CAEVectorOps::Get().isa));
+}
+
+TEST_F(TestAEVectorOps, MulArray)
+{
+  for (const auto isa : ISAS)
+  {
+    const CAEVectorOps::Kernels* kernels = CAEVectorOps::Get(isa);
+    if (!kernels)
+      continue;
+
+    for (const uint32_t offset : OFFSETS)
+    {
+      for (const uint32_t count : COUNTS)
+      {
+        auto expected = RandomSamples(count + offset, 2.0f, count);
+        auto actual = expected;
+        m_scalar.MulArray(expected.data() + offset, 0.7071f, count);
+        kernels->MulArray(actual.data() + offset, 0.7071f, count);
+        EXPECT_TRUE(BitEqual(expected.data(), actual.data(), expected.size()))
+            << kernels->name << " count " << count << " offset " << offset;
+      }
+    }
+  }
+}
+
+TEST_F(TestAEVectorOps, MulAddArray)
+{
+  for (const auto isa : ISAS)
+  {
+    const CAEVectorOps::Kernels* kernels = CAEVectorOps::Get(isa);
+    if (!kernels)
+      continue;
+
+    for (const uint32_t offset : OFFSETS)
+    {
+      for (const uint32_t count : COUNTS)
+      {
+        const auto add = RandomSamples(count + 1, 1.0f, count + 100);
+        auto expected = RandomSamples(count + offset, 1.0f, count);
+        auto actual = expected;
+        m_scalar.MulAddArray(expected.data() + offset, add.data() + 1, 0.3333f, count);
+        kernels->MulAddArray(actual.data() + offset, add.data() + 1, 0.3333f, count);
+        EXPECT_TRUE(BitEqual(expected.data(), actual.data(), expected.size()))
+            << kernels->name << " count " << count << " offset " << offset;
+      }
+    }
+  }
+}
+
+TEST_F(TestAEVectorOps, ClampArray)
+{
+  for (const auto isa : ISAS)
+  {
+    const CAEVectorOps::Kernels* kernels = CAEVectorOps::Get(isa);
+    if (!kernels)
+      continue;
+
+    for (const uint32_t offset : OFFSETS)
+    {
+      for (const uint32_t count : COUNTS)
+      {
+        // covers the rational part as well as the saturated range beyond +-3
+        auto expected = RandomSamples(count + offset, 5.0f, count);
+        auto actual = expected;
+        m_scalar.ClampArray(expected.data() + offset, count);
+        kernels->ClampArray(actual.data() + offset, count);
+        EXPECT_TRUE(BitEqual(expected.data(), actual.data(), expected.size()))
+            << kernels->name << " count " << count << " offset " << offset;
+      }
+    }
+  }
+}
+
+TEST_F(TestAEVectorOps, ClampArrayLimits)
+{
+  std::vector<float> data = {-10.0f, -3.0f, -1.0f, 0.0f, 1.0f, 3.0f, 10.0f, 0.5f};
+  m_scalar.ClampArray(data.data(), static_cast<uint32_t>(data.size()));
+  EXPECT_EQ(-1.0f, data[0]);
+  EXPECT_FLOAT_EQ(-1.0f, data[1]);
+  EXPECT_EQ(0.0f, data[3]);
+  EXPECT_FLOAT_EQ(1.0f, data[5]);
+  EXPECT_EQ(1.0f, data[6]);
+  EXPECT_LT(data[7], 0.5f);
+}
+
+TEST_F(TestAEVectorOps, NeedsClamp)
+{
+  for (const auto isa : ISAS)
+  {
+    const CAEVectorOps::Kernels* kernels = CAEVectorOps::Get(isa);
+    if (!kernels)
+      continue;
+
+    for (const uint32_t count : COUNTS)
+    {
+      auto data = RandomSamples(count, 1.0f, count);
+      EXPECT_EQ(m_scalar.NeedsClamp(data.data(), count), kernels->NeedsClamp(data.data(), count))
+          << kernels->name << " count " << count;
+
+      // a single overshoot anywhere, including the tail, must be found
+      for (uint32_t i = 0; i < count; i += 5)
+      {
+        auto copy = data;
+        copy[i] = (i & 1) ? -1.001f : 1.001f;
+        EXPECT_TRUE(kernels->NeedsClamp(copy.data(), count)) << kernels->name << " index " << i;
+      }
+    }
+  }
+}
+
+TEST_F(TestAEVectorOps, InterleaveDeinterleave)
+{
+  for (const auto isa : ISAS)
+  {
+    const CAEVectorOps::Kernels* kernels = CAEVectorOps::Get(isa);
+    if (!kernels)
+      continue;
+
+    for (const uint32_t channels : {1u, 2u, 4u, 6u, 8u})
+    {
+      for (const uint32_t frames : COUNTS)
+      {
+        std::vector<std::vector<float>> planes;
+        std::vector<const float*> src;
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+          planes.emplace_back(RandomSamples(frames, 1.0f, c * 1000 + frames));
+          src.emplace_back(planes.back().data());
+        }
+
+        std::vector<float> expected(channels * frames);
+        std::vector<float> actual(channels * frames);
+        m_scalar.Interleave(expected.data(), src.data(), channels, frames);
+        kernels->Interleave(actual.data(), src.data(), channels, frames);
+        EXPECT_TRUE(BitEqual(expected.data(), actual.data(), expected.size()))
+            << kernels->name << " channels " << channels << " frames " << frames;
+
+        std::vector<std::vector<float>> back(channels, std::vector<float>(frames));
+        std::vector<float*> dst;
+        for (auto& plane : back)
+          dst.emplace_back(plane.data());
+        kernels->Deinterleave(dst.data(), actual.data(), channels, frames);
+        for (uint32_t c = 0; c < channels; ++c)
+          EXPECT_TRUE(BitEqual(planes[c].data(), back[c].data(), frames))
+              << kernels->name << " channels " << channels << " frames " << frames;
+      }
+    }
+  }
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST_F(TestAEVectorOps, DISABLED_Throughput)
+{
+  // 8ch, 1024 frames, about one ActiveAE period per call
+  constexpr uint32_t SAMPLES = 8 * 1024;
+  constexpr int ITERATIONS = 2000;
+
+  const auto add = RandomSamples(SAMPLES, 1.0f, 1);
+  auto data = RandomSamples(SAMPLES, 1.0f, 2);
+
+  for (const auto isa : {CAEVectorOps::ISA::SCALAR, CAEVectorOps::ISA::SSE,
+                         CAEVectorOps::ISA::AVX2, CAEVectorOps::ISA::NEON})
+  {
+    const CAEVectorOps::Kernels* kernels = CAEVectorOps::Get(isa);
+    if (!kernels)
+      continue;
+
+    auto measure = [&](const char* name, auto&& func) {
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < ITERATIONS; ++i)
+        func();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      const double msamples = static_cast<double>(SAMPLES) * ITERATIONS / elapsed.count() / 1e6;
+      std::cout << "[ AEVectorOps ] " << kernels->name << " " << name << ": " << msamples
+                << " Msamples/s" << std::endl;
+    };
+
+    measure("mul", [&] { kernels->MulArray(data.data(), 1.0f, SAMPLES); });
+    measure("muladd", [&] { kernels->MulAddArray(data.data(), add.data(), 0.0f, SAMPLES); });
+    measure("clamp", [&] {
+      kernels->ClampArray(data.data(), SAMPLES);
+      data[0] = 0.0f;
+    });
+    measure("needsclamp", [&] { kernels->NeedsClamp(data.data(), SAMPLES); });
+  }
+}
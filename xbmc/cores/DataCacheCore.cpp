@@ -59,6 +59,14 @@ void CDataCacheCore::Reset()
     m_contentInfo.Reset();
   }
   m_timeInfo = {};
+  {
+    std::unique_lock<CCriticalSection> lock(m_startupSection);
+    m_startupInfo = {};
+  }
+  {
+    std::unique_lock<CCriticalSection> lock(m_playbackStatsSection);
+    m_playbackStats = {};
+  }
 }
 
 bool CDataCacheCore::HasAVInfoChanges()
@@ -808,3 +816,54 @@ float CDataCacheCore::GetPlayPercentage()
 
   return m_timeInfo.m_time * 100 / static_cast<float>(iTotalTime);
 }
+
+void CDataCacheCore::SetDemuxOpenTime(std::chrono::milliseconds time)
+{
+  std::unique_lock<CCriticalSection> lock(m_startupSection);
+  m_startupInfo.m_demuxOpenTime = time;
+}
+
+std::chrono::milliseconds CDataCacheCore::GetDemuxOpenTime()
+{
+  std::unique_lock<CCriticalSection> lock(m_startupSection);
+  return m_startupInfo.m_demuxOpenTime;
+}
+
+void CDataCacheCore::SetStartLatency(std::chrono::milliseconds time)
+{
+  std::unique_lock<CCriticalSection> lock(m_startupSection);
+  m_startupInfo.m_startLatency = time;
+}
+
+std::chrono::milliseconds CDataCacheCore::GetStartLatency()
+{
+  std::unique_lock<CCriticalSection> lock(m_startupSection);
+  return m_startupInfo.m_startLatency;
+}
+
+void CDataCacheCore::SetVideoFrameCounts(uint64_t decoded, uint64_t dropped)
+{
+  std::unique_lock<CCriticalSection> lock(m_playbackStatsSection);
+  m_playbackStats.framesDecoded = decoded;
+  m_playbackStats.framesDropped = dropped;
+}
+
+void CDataCacheCore::SetRenderFrameCounts(uint64_t rendered, uint64_t skipped, int queued)
+{
+  std::unique_lock<CCriticalSection> lock(m_playbackStatsSection);
+  m_playbackStats.framesRendered = rendered;
+  m_playbackStats.framesSkipped = skipped;
+  m_playbackStats.renderQueueLevel = queued;
+}
+
+void CDataCacheCore::SetAVSyncError(double error)
+{
+  std::unique_lock<CCriticalSection> lock(m_playbackStatsSection);
+  m_playbackStats.avSyncError = error;
+}
+
+CDataCacheCore::PlaybackStats CDataCacheCore::GetPlaybackStats()
+{
+  std::unique_lock<CCriticalSection> lock(m_playbackStatsSection);
+  return m_playbackStats;
+}
@@ -248,6 +248,44 @@ public:
    */
   int64_t GetMaxTime();
 
+  /*!
+   * \brief Set the time it took to open the demuxer, stream probing included
+   */
+  void SetDemuxOpenTime(std::chrono::milliseconds time);
+  std::chrono::milliseconds GetDemuxOpenTime();
+
+  /*!
+   * \brief Set the time from the start of opening a file until playback started
+   */
+  void SetStartLatency(std::chrono::milliseconds time);
+  std::chrono::milliseconds GetStartLatency();
+
+  /*!
+   * \brief Frame counts and sync of the current playback, e.g. for benchmarking
+   */
+  struct PlaybackStats
+  {
+    uint64_t framesDecoded = 0; //!< pictures returned by the video decoder
+    uint64_t framesDropped = 0; //!< pictures dropped by the decoder or player before rendering
+    uint64_t framesRendered = 0; //!< pictures presented by the render manager
+    uint64_t framesSkipped = 0; //!< pictures skipped by the render manager for being late
+    int renderQueueLevel = 0; //!< pictures waiting to be presented
+    double avSyncError = 0.0; //!< difference between audio and the clock in seconds
+  };
+
+  /*!
+   * \brief Set the pictures decoded and dropped since the video stream was opened
+   */
+  void SetVideoFrameCounts(uint64_t decoded, uint64_t dropped);
+
+  /*!
+   * \brief Set the pictures presented and skipped since the renderer was set up
+   */
+  void SetRenderFrameCounts(uint64_t rendered, uint64_t skipped, int queued);
+
+  void SetAVSyncError(double error);
+  PlaybackStats GetPlaybackStats();
+
 protected:
   std::atomic_bool m_AVChange = false;
   std::atomic_bool m_hasAVInfoChanges = false;
@@ -410,4 +448,14 @@ protected:
     int64_t m_timeMax;
     int64_t m_timeMin;
   } m_timeInfo = {};
+
+  CCriticalSection m_startupSection;
+  struct SStartupInfo
+  {
+    std::chrono::milliseconds m_demuxOpenTime{0};
+    std::chrono::milliseconds m_startLatency{0};
+  } m_startupInfo;
+
+  CCriticalSection m_playbackStatsSection;
+  PlaybackStats m_playbackStats;
 };
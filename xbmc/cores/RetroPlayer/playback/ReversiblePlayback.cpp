@@ -17,6 +17,7 @@
 #include "cores/RetroPlayer/savestates/ISavestate.h"
 #include "cores/RetroPlayer/savestates/SavestateDatabase.h"
 #include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
+#include "cores/RetroPlayer/streams/memory/SpanDeltaMemoryStream.h"
 #include "filesystem/File.h"
 #include "games/GameServices.h"
 #include "games/GameSettings.h"
@@ -412,10 +413,20 @@ void CReversiblePlayback::UpdateMemoryStream()
 
     unsigned int frameCount = MathUtils::round_int(rewindBufferSec * m_gameLoop.FPS());
 
+    // The history can't be carried over to a stream with a different budget
+    const unsigned int rewindMemoryMB = gameSettings.MaxRewindMemoryMB();
+    if (m_memoryStream && rewindMemoryMB != m_rewindMemoryMB)
+      m_memoryStream.reset();
+
     if (!m_memoryStream)
     {
-      m_memoryStream = std::make_unique<CDeltaPairMemoryStream>();
+      if (rewindMemoryMB > 0)
+        m_memoryStream = std::make_unique<CSpanDeltaMemoryStream>(
+            static_cast<size_t>(rewindMemoryMB) * 1024 * 1024);
+      else
+        m_memoryStream = std::make_unique<CDeltaPairMemoryStream>();
       m_memoryStream->Init(m_gameClient->SerializeSize(), frameCount);
+      m_rewindMemoryMB = rewindMemoryMB;
     }
 
     if (m_memoryStream->MaxFrameCount() != frameCount)
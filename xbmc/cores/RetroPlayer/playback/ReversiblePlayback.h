@@ -89,6 +89,7 @@ private:
   // Gameplay functionality
   CGameLoop m_gameLoop;
   std::unique_ptr<IMemoryStream> m_memoryStream;
+  unsigned int m_rewindMemoryMB = 0;
   CCriticalSection m_mutex;
 
   // Savestate functionality
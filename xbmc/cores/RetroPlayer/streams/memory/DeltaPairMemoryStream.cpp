@@ -31,7 +31,9 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
   uint32_t* currentFrame = m_currentFrame.get();
   uint32_t* nextFrame = m_nextFrame.get();
 
-  for (size_t i = 0; i < m_paddedFrameSize; i++)
+  // m_paddedFrameSize is in bytes
+  const size_t wordCount = m_paddedFrameSize / sizeof(uint32_t);
+  for (size_t i = 0; i < wordCount; i++)
   {
     uint32_t xor_val = currentFrame[i] ^ nextFrame[i];
     if (xor_val)
@@ -0,0 +1,287 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SpanDeltaMemoryStream.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+constexpr size_t BLOCK_SIZE = 16;
+
+// Deltas are aligned in the ring so the span headers can be read directly
+constexpr size_t DELTA_ALIGNMENT = 8;
+
+size_t Align(size_t size)
+{
+  return (size + DELTA_ALIGNMENT - 1) & ~(DELTA_ALIGNMENT - 1);
+}
+
+// Frames without changes still take some room, so the ring is never full and
+// empty at the same position
+size_t RecordSize(size_t deltaSize)
+{
+  return Align(std::max<size_t>(deltaSize, 1));
+}
+
+bool BlockChanged(const uint8_t* a, const uint8_t* b)
+{
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xFFFF;
+#else
+  uint64_t a0, a1, b0, b1;
+  std::memcpy(&a0, a, sizeof(a0));
+  std::memcpy(&a1, a + sizeof(a0), sizeof(a1));
+  std::memcpy(&b0, b, sizeof(b0));
+  std::memcpy(&b1, b + sizeof(b0), sizeof(b1));
+  return ((a0 ^ b0) | (a1 ^ b1)) != 0;
+#endif
+}
+
+// dst may be the same as a
+void XorBytes(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t size)
+{
+  size_t i = 0;
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  for (; i + BLOCK_SIZE <= size; i += BLOCK_SIZE)
+  {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(va, vb));
+  }
+#else
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+  {
+    uint64_t va, vb;
+    std::memcpy(&va, a + i, sizeof(va));
+    std::memcpy(&vb, b + i, sizeof(vb));
+    va ^= vb;
+    std::memcpy(dst + i, &va, sizeof(va));
+  }
+#endif
+  for (; i < size; i++)
+    dst[i] = a[i] ^ b[i];
+}
+} // namespace
+
+CSpanDeltaMemoryStream::CSpanDeltaMemoryStream(size_t memoryBudget)
+  : m_memoryBudget(Align(memoryBudget))
+{
+}
+
+void CSpanDeltaMemoryStream::Reset()
+{
+  CLinearMemoryStream::Reset();
+
+  m_rewindBuffer.clear();
+  m_ring.reset();
+  m_writePos = 0;
+  m_usedBytes = 0;
+  m_scratch.clear();
+  m_scratch.shrink_to_fit();
+}
+
+void CSpanDeltaMemoryStream::SubmitFrameInternal()
+{
+  const uint8_t* currentFrame = reinterpret_cast<const uint8_t*>(m_currentFrame.get());
+  const uint8_t* nextFrame = reinterpret_cast<const uint8_t*>(m_nextFrame.get());
+
+  const size_t deltaSize = EncodeDelta(currentFrame, nextFrame, FrameSize());
+
+  size_t offset;
+  if (Allocate(deltaSize, offset))
+  {
+    std::memcpy(m_ring.get() + offset, m_scratch.data(), deltaSize);
+    m_writePos = offset + RecordSize(deltaSize);
+    m_usedBytes += RecordSize(deltaSize);
+    m_rewindBuffer.push_back({offset, deltaSize, m_currentFrameHistory});
+  }
+  else
+  {
+    // Older deltas can't be applied without this one
+    CLog::Log(LOGDEBUG,
+              "CSpanDeltaMemoryStream: Delta of {} bytes exceeds the rewind budget, dropping "
+              "{} frames",
+              deltaSize, m_rewindBuffer.size());
+    CullPastFrames(m_rewindBuffer.size());
+  }
+
+  m_currentFrameHistory++;
+
+  // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
+  std::swap(m_currentFrame, m_nextFrame);
+
+  m_bHasNextFrame = false;
+
+  if (PastFramesAvailable() + 1 > MaxFrameCount())
+    CullPastFrames(1);
+}
+
+uint64_t CSpanDeltaMemoryStream::PastFramesAvailable() const
+{
+  return static_cast<uint64_t>(m_rewindBuffer.size());
+}
+
+uint64_t CSpanDeltaMemoryStream::RewindFrames(uint64_t frameCount)
+{
+  uint64_t rewound;
+
+  for (rewound = 0; rewound < frameCount; rewound++)
+  {
+    if (m_rewindBuffer.empty())
+      break;
+
+    const MemoryFrame& frame = m_rewindBuffer.back();
+
+    ApplyDelta(reinterpret_cast<uint8_t*>(m_currentFrame.get()), m_ring.get() + frame.offset,
+               frame.size);
+
+    // Restore frame history
+    m_currentFrameHistory = frame.frameHistoryCount;
+
+    // The ring is written back to back, so the space of the newest frame is reused
+    m_writePos = frame.offset;
+    m_usedBytes -= RecordSize(frame.size);
+
+    m_rewindBuffer.pop_back();
+  }
+
+  return rewound;
+}
+
+void CSpanDeltaMemoryStream::CullPastFrames(uint64_t frameCount)
+{
+  for (uint64_t removedCount = 0; removedCount < frameCount; removedCount++)
+  {
+    if (m_rewindBuffer.empty())
+    {
+      CLog::Log(LOGDEBUG,
+                "CSpanDeltaMemoryStream: Tried to cull {} frames too many. Check your math!",
+                frameCount - removedCount);
+      break;
+    }
+    m_usedBytes -= RecordSize(m_rewindBuffer.front().size);
+    m_rewindBuffer.pop_front();
+  }
+
+  if (m_rewindBuffer.empty())
+    m_writePos = 0;
+}
+
+size_t CSpanDeltaMemoryStream::EncodeDelta(const uint8_t* current,
+                                           const uint8_t* next,
+                                           size_t frameSize)
+{
+  // Worst case is a single span over the whole frame
+  const size_t maxSize = sizeof(SpanHeader) + frameSize;
+  if (m_scratch.size() < maxSize)
+    m_scratch.resize(maxSize);
+
+  uint8_t* out = m_scratch.data();
+  size_t written = 0;
+
+  size_t pos = 0;
+  while (pos < frameSize)
+  {
+    // Skip unchanged blocks
+    while (pos + BLOCK_SIZE <= frameSize && !BlockChanged(current + pos, next + pos))
+      pos += BLOCK_SIZE;
+
+    if (pos + BLOCK_SIZE > frameSize)
+    {
+      // Trailing bytes are stored as a span of their own if they changed
+      if (pos < frameSize && std::memcmp(current + pos, next + pos, frameSize - pos) == 0)
+        pos = frameSize;
+      if (pos == frameSize)
+        break;
+    }
+
+    const size_t start = pos;
+    while (pos + BLOCK_SIZE <= frameSize && BlockChanged(current + pos, next + pos))
+      pos += BLOCK_SIZE;
+
+    // Merge the trailing bytes instead of starting another span for them
+    if (pos + BLOCK_SIZE > frameSize)
+      pos = frameSize;
+
+    const SpanHeader header = {static_cast<uint32_t>(start), static_cast<uint32_t>(pos - start)};
+    std::memcpy(out + written, &header, sizeof(header));
+    written += sizeof(header);
+
+    XorBytes(out + written, current + start, next + start, header.length);
+    written += header.length;
+  }
+
+  return written;
+}
+
+bool CSpanDeltaMemoryStream::Allocate(size_t size, size_t& offset)
+{
+  const size_t alignedSize = RecordSize(size);
+  if (alignedSize > m_memoryBudget)
+    return false;
+
+  if (!m_ring)
+    m_ring.reset(new uint8_t[m_memoryBudget]);
+
+  while (!m_rewindBuffer.empty())
+  {
+    const size_t oldest = m_rewindBuffer.front().offset;
+    if (m_writePos > oldest)
+    {
+      // Live deltas are in [oldest, m_writePos)
+      if (m_writePos + alignedSize <= m_memoryBudget)
+      {
+        offset = m_writePos;
+        return true;
+      }
+      if (alignedSize <= oldest)
+      {
+        offset = 0;
+        return true;
+      }
+    }
+    else if (m_writePos + alignedSize <= oldest)
+    {
+      // Live deltas are in [oldest, end of ring) and [0, m_writePos)
+      offset = m_writePos;
+      return true;
+    }
+
+    CullPastFrames(1);
+  }
+
+  offset = 0;
+  return true;
+}
+
+void CSpanDeltaMemoryStream::ApplyDelta(uint8_t* frame, const uint8_t* delta, size_t size)
+{
+  size_t pos = 0;
+  while (pos < size)
+  {
+    SpanHeader header;
+    std::memcpy(&header, delta + pos, sizeof(header));
+    pos += sizeof(header);
+
+    XorBytes(frame + header.offset, frame + header.offset, delta + pos, header.length);
+    pos += header.length;
+  }
+}
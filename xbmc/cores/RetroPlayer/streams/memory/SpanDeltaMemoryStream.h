@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "LinearMemoryStream.h"
+
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Implementation of a linear memory stream using XOR deltas of
+ *        changed spans, stored in a ring with a memory budget
+ *
+ * Frames are compared 16 bytes at a time. Runs of changed blocks are stored
+ * as a span header followed by the XOR delta of the run, so a busy save state
+ * costs little more than the changed bytes themselves, instead of 8 bytes of
+ * bookkeeping per changed word.
+ *
+ * The deltas are written back to back into a single ring buffer. When the
+ * budget is exhausted the oldest frames are dropped, so the rewind depth
+ * adapts to how much of the state changes per frame.
+ */
+class CSpanDeltaMemoryStream : public CLinearMemoryStream
+{
+public:
+  /*!
+   * \param memoryBudget The maximum number of bytes used for deltas
+   */
+  explicit CSpanDeltaMemoryStream(size_t memoryBudget);
+
+  ~CSpanDeltaMemoryStream() override = default;
+
+  // implementation of IMemoryStream via CLinearMemoryStream
+  void Reset() override;
+  uint64_t PastFramesAvailable() const override;
+  uint64_t RewindFrames(uint64_t frameCount) override;
+
+  /*!
+   * \brief Number of bytes held by the deltas of the past frames
+   */
+  size_t UsedMemory() const { return m_usedBytes; }
+
+protected:
+  // implementation of CLinearMemoryStream
+  void SubmitFrameInternal() override;
+  void CullPastFrames(uint64_t frameCount) override;
+
+private:
+  struct SpanHeader
+  {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  struct MemoryFrame
+  {
+    size_t offset; // of the deltas in the ring
+    size_t size;
+    uint64_t frameHistoryCount;
+  };
+
+  /*!
+   * \brief Encode the XOR delta of two frames into m_scratch
+   *
+   * \return The number of bytes written
+   */
+  size_t EncodeDelta(const uint8_t* current, const uint8_t* next, size_t frameSize);
+
+  /*!
+   * \brief Find room for a delta, dropping the oldest frames if needed
+   *
+   * \return False if the delta is larger than the ring
+   */
+  bool Allocate(size_t size, size_t& offset);
+
+  static void ApplyDelta(uint8_t* frame, const uint8_t* delta, size_t size);
+
+  const size_t m_memoryBudget;
+  std::unique_ptr<uint8_t[]> m_ring;
+  size_t m_writePos = 0;
+  size_t m_usedBytes = 0;
+  std::vector<uint8_t> m_scratch;
+  std::deque<MemoryFrame> m_rewindBuffer;
+};
+} // namespace RETRO
+} // namespace KODI
@@ -0,0 +1,283 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
+#include "cores/RetroPlayer/streams/memory/SpanDeltaMemoryStream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+constexpr size_t STATE_SIZE = 256 * 1024 + 5;
+
+/*!
+ * \brief Synthetic save states of a busy game
+ *
+ * Every frame a counter block changes and a few random regions of the state
+ * are rewritten, similar to sprite tables and work RAM changing while the
+ * rest of the state stays the same.
+ */
+class CStateTrace
+{
+public:
+  explicit CStateTrace(size_t regionsPerFrame) : m_state(STATE_SIZE), m_regions(regionsPerFrame)
+  {
+    for (auto& byte : m_state)
+      byte = static_cast<uint8_t>(m_random());
+  }
+
+  const std::vector<uint8_t>& Next()
+  {
+    m_frame++;
+    std::memcpy(m_state.data() + 64, &m_frame, sizeof(m_frame));
+
+    std::uniform_int_distribution<size_t> offsetDist(0, STATE_SIZE - 1);
+    std::uniform_int_distribution<size_t> lengthDist(1, 512);
+    for (size_t i = 0; i < m_regions; i++)
+    {
+      const size_t offset = offsetDist(m_random);
+      const size_t length = std::min(lengthDist(m_random), STATE_SIZE - offset);
+      for (size_t j = 0; j < length; j++)
+        m_state[offset + j] = static_cast<uint8_t>(m_random());
+    }
+    return m_state;
+  }
+
+private:
+  std::vector<uint8_t> m_state;
+  const size_t m_regions;
+  uint64_t m_frame = 0;
+  std::mt19937 m_random{42};
+};
+
+class CMeasuredDeltaPairMemoryStream : public CDeltaPairMemoryStream
+{
+public:
+  size_t UsedMemory() const
+  {
+    size_t bytes = 0;
+    for (const auto& frame : m_rewindBuffer)
+      bytes += frame.buffer.capacity() * sizeof(DeltaPair);
+    return bytes;
+  }
+};
+
+void Submit(IMemoryStream& stream, const std::vector<uint8_t>& state)
+{
+  std::memcpy(stream.BeginFrame(), state.data(), state.size());
+  stream.SubmitFrame();
+}
+
+void ExpectRewinds(IMemoryStream& stream, const std::vector<std::vector<uint8_t>>& history)
+{
+  const uint64_t available = stream.PastFramesAvailable();
+  ASSERT_LT(available, history.size());
+
+  for (uint64_t i = 1; i <= available; i++)
+  {
+    ASSERT_EQ(1, stream.RewindFrames(1));
+    const std::vector<uint8_t>& expected = history[history.size() - 1 - i];
+    ASSERT_EQ(0, std::memcmp(stream.CurrentFrame(), expected.data(), expected.size()))
+        << "frame " << i << " behind";
+  }
+  EXPECT_EQ(0, stream.RewindFrames(1));
+}
+} // namespace
+
+TEST(TestMemoryStreams, DeltaPairRewind)
+{
+  CDeltaPairMemoryStream stream;
+  stream.Init(STATE_SIZE, 100);
+
+  CStateTrace trace(8);
+  std::vector<std::vector<uint8_t>> history;
+  for (int i = 0; i < 30; i++)
+  {
+    history.emplace_back(trace.Next());
+    Submit(stream, history.back());
+  }
+
+  EXPECT_EQ(29, stream.PastFramesAvailable());
+  ExpectRewinds(stream, history);
+}
+
+TEST(TestMemoryStreams, SpanDeltaRewind)
+{
+  CSpanDeltaMemoryStream stream(64 * 1024 * 1024);
+  stream.Init(STATE_SIZE, 100);
+
+  CStateTrace trace(8);
+  std::vector<std::vector<uint8_t>> history;
+  for (int i = 0; i < 60; i++)
+  {
+    history.emplace_back(trace.Next());
+    Submit(stream, history.back());
+  }
+
+  EXPECT_EQ(59, stream.PastFramesAvailable());
+  EXPECT_EQ(0, std::memcmp(stream.CurrentFrame(), history.back().data(), STATE_SIZE));
+  ExpectRewinds(stream, history);
+  EXPECT_EQ(0, stream.UsedMemory());
+}
+
+TEST(TestMemoryStreams, SpanDeltaRewindAndContinue)
+{
+  CSpanDeltaMemoryStream stream(64 * 1024 * 1024);
+  stream.Init(STATE_SIZE, 100);
+
+  CStateTrace trace(4);
+  std::vector<std::vector<uint8_t>> history;
+  for (int i = 0; i < 20; i++)
+  {
+    history.emplace_back(trace.Next());
+    Submit(stream, history.back());
+  }
+
+  // rewind half way and play on from there
+  ASSERT_EQ(10, stream.RewindFrames(10));
+  history.resize(10);
+  ASSERT_EQ(0, std::memcmp(stream.CurrentFrame(), history.back().data(), STATE_SIZE));
+
+  for (int i = 0; i < 20; i++)
+  {
+    history.emplace_back(trace.Next());
+    Submit(stream, history.back());
+  }
+  EXPECT_EQ(29, stream.PastFramesAvailable());
+  ExpectRewinds(stream, history);
+}
+
+TEST(TestMemoryStreams, SpanDeltaMemoryBudget)
+{
+  constexpr size_t budget = 256 * 1024;
+  CSpanDeltaMemoryStream stream(budget);
+  stream.Init(STATE_SIZE, 1000);
+
+  CStateTrace trace(16);
+  std::vector<std::vector<uint8_t>> history;
+  for (int i = 0; i < 200; i++)
+  {
+    history.emplace_back(trace.Next());
+    Submit(stream, history.back());
+    ASSERT_LE(stream.UsedMemory(), budget);
+  }
+
+  // the oldest frames were dropped to stay within the budget
+  EXPECT_GT(stream.PastFramesAvailable(), 0);
+  EXPECT_LT(stream.PastFramesAvailable(), 199);
+  ExpectRewinds(stream, history);
+}
+
+TEST(TestMemoryStreams, SpanDeltaUnchangedFrames)
+{
+  CSpanDeltaMemoryStream stream(1024);
+  stream.Init(STATE_SIZE, 50);
+
+  CStateTrace trace(0);
+  const std::vector<uint8_t> state = trace.Next();
+  for (int i = 0; i < 100; i++)
+    Submit(stream, state);
+
+  EXPECT_EQ(49, stream.PastFramesAvailable());
+  EXPECT_EQ(49, stream.RewindFrames(100));
+  EXPECT_EQ(0, std::memcmp(stream.CurrentFrame(), state.data(), STATE_SIZE));
+}
+
+TEST(TestMemoryStreams, SpanDeltaSmallerThanDeltaPair)
+{
+  constexpr int FRAMES = 120;
+
+  for (const size_t regions : {4, 256})
+  {
+    CStateTrace trace(regions);
+    CMeasuredDeltaPairMemoryStream deltaPair;
+    deltaPair.Init(STATE_SIZE, FRAMES);
+    CSpanDeltaMemoryStream spanDelta(256 * 1024 * 1024);
+    spanDelta.Init(STATE_SIZE, FRAMES);
+
+    std::vector<uint8_t> first;
+    for (int i = 0; i < FRAMES; i++)
+    {
+      const std::vector<uint8_t> state = trace.Next();
+      if (i == 0)
+        first = state;
+      Submit(deltaPair, state);
+      Submit(spanDelta, state);
+    }
+
+    EXPECT_LT(spanDelta.UsedMemory(), deltaPair.UsedMemory());
+
+    spanDelta.RewindFrames(FRAMES);
+    EXPECT_EQ(0, std::memcmp(spanDelta.CurrentFrame(), first.data(), STATE_SIZE));
+  }
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST(TestMemoryStreams, DISABLED_Benchmark)
+{
+  constexpr int FRAMES = 600;
+
+  for (const size_t regions : {4, 32, 256})
+  {
+    // record the trace first, so only the streams are measured
+    CStateTrace trace(regions);
+    std::vector<std::vector<uint8_t>> states;
+    for (int i = 0; i < FRAMES; i++)
+      states.emplace_back(trace.Next());
+
+    CMeasuredDeltaPairMemoryStream deltaPair;
+    deltaPair.Init(STATE_SIZE, FRAMES);
+    CSpanDeltaMemoryStream spanDelta(256 * 1024 * 1024);
+    spanDelta.Init(STATE_SIZE, FRAMES);
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& state : states)
+      Submit(deltaPair, state);
+    const auto deltaPairSubmit = std::chrono::steady_clock::now() - start;
+    const size_t deltaPairMemory = deltaPair.UsedMemory();
+
+    start = std::chrono::steady_clock::now();
+    deltaPair.RewindFrames(FRAMES);
+    const auto deltaPairRewind = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& state : states)
+      Submit(spanDelta, state);
+    const auto spanDeltaSubmit = std::chrono::steady_clock::now() - start;
+    const size_t spanDeltaMemory = spanDelta.UsedMemory();
+
+    start = std::chrono::steady_clock::now();
+    spanDelta.RewindFrames(FRAMES);
+    const auto spanDeltaRewind = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(0, std::memcmp(spanDelta.CurrentFrame(), states.front().data(), STATE_SIZE));
+
+    using std::chrono::microseconds;
+    using std::chrono::duration_cast;
+    std::cout << "[ MemoryStreams ] " << regions << " regions/frame, " << FRAMES << " frames\n"
+              << "  delta pairs: submit " << duration_cast<microseconds>(deltaPairSubmit).count()
+              << " us, rewind " << duration_cast<microseconds>(deltaPairRewind).count()
+              << " us, " << deltaPairMemory / 1024 << " KiB\n"
+              << "  span deltas: submit " << duration_cast<microseconds>(spanDeltaSubmit).count()
+              << " us, rewind " << duration_cast<microseconds>(spanDeltaRewind).count()
+              << " us, " << spanDeltaMemory / 1024 << " KiB" << std::endl;
+
+    EXPECT_LT(spanDeltaMemory, deltaPairMemory);
+  }
+}
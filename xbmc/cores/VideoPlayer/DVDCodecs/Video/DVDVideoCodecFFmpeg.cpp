@@ -46,6 +46,12 @@ extern "C" {
 #define RINT lrint
 #endif
 
+namespace
+{
+// frames queued for, or waiting to be taken from, the filter stage
+constexpr unsigned int FILTER_STAGE_FRAMES = 4;
+} // unnamed namespace
+
 enum DecoderState
 {
   STATE_NONE,
@@ -433,6 +439,10 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     m_pCodecContext->skip_loop_filter = static_cast<AVDiscard>(iSkipLoopFilter);
   }
 
+  // e.g. thumbnail extraction, only the keyframe after a seek is of interest
+  if (hints.codecOptions & CODEC_KEYFRAMES_ONLY)
+    m_pCodecContext->skip_frame = AVDISCARD_NONKEY;
+
   // set any special options
   for(std::vector<CDVDCodecOption>::iterator it = options.m_keys.begin(); it != options.m_keys.end(); ++it)
   {
@@ -762,6 +772,10 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     }
     else if (m_pFilterGraph && !m_filterEof)
     {
+      // the decoder is drained, so are the frames queued for the filter stage
+      if (m_filterStage)
+        m_filterStage->Add(nullptr);
+
       int ret = FilterProcess(nullptr);
       if (ret == VC_PICTURE)
       {
@@ -1203,6 +1217,12 @@ int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
     return -1;
   }
 
+  // the graph runs next to the decoder threads, give its filters a share of the cores
+  // without cpu info, e.g. in tests, the filters run on one thread
+  const auto cpuInfo = CServiceBroker::GetCPUInfo();
+  const int cpuCount = cpuInfo ? cpuInfo->GetCPUCount() : 1;
+  m_pFilterGraph->nb_threads = std::max(1, cpuCount / 2);
+
   const AVFilter* srcFilter = avfilter_get_by_name("buffer");
   const AVFilter* outFilter = avfilter_get_by_name("buffersink"); // should be last filter in the graph for now
 
@@ -1292,12 +1312,22 @@ int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
     }
   }
 
+  // filter while the next frame is decoded, unless there is only one core to do both
+  if (cpuCount > 1)
+  {
+    m_filterStage = std::make_unique<CVideoFilterStage>(FILTER_STAGE_FRAMES);
+    m_filterStage->Start(m_pFilterIn, m_pFilterOut);
+  }
+
   m_filterEof = false;
   return result;
 }
 
 void CDVDVideoCodecFFmpeg::FilterClose()
 {
+  // the stage uses the graph until it is stopped
+  m_filterStage.reset();
+
   if (m_pFilterGraph)
   {
     CLog::Log(LOGDEBUG, LOGVIDEO, "CDVDVideoCodecFFmpeg::FilterClose - Freeing filter graph");
@@ -1313,6 +1343,24 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::FilterProcess(AVFrame* frame)
 {
   int result;
 
+  if (m_filterStage)
+  {
+    if (frame)
+      m_filterStage->Add(frame);
+
+    // wait for the stage only if it cannot take more frames or is being drained
+    const bool wait = !m_filterStage->CanAdd() || m_filterStage->IsEndQueued();
+    CDVDVideoCodec::VCReturn ret = m_filterStage->Get(m_pFrame, wait);
+    if (ret == VC_EOF)
+    {
+      m_filterEof = true;
+      return VC_BUFFER;
+    }
+    if (ret == VC_ERROR)
+      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - filter stage failed");
+    return ret;
+  }
+
   if (frame || (m_codecControlFlags & DVD_CODEC_CTRL_DRAIN))
   {
     result = av_buffersrc_add_frame(m_pFilterIn, frame);
@@ -1404,7 +1452,8 @@ void CDVDVideoCodecFFmpeg::SetCodecControl(int flags)
     }
     else
     {
-      m_pCodecContext->skip_frame = AVDISCARD_DEFAULT;
+      m_pCodecContext->skip_frame =
+          (m_hints.codecOptions & CODEC_KEYFRAMES_ONLY) ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
       m_pCodecContext->skip_idct = AVDISCARD_DEFAULT;
       m_pCodecContext->skip_loop_filter = AVDISCARD_DEFAULT;
     }
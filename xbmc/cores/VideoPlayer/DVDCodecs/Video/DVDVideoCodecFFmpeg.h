@@ -12,6 +12,8 @@
 #include "cores/VideoPlayer/DVDStreamInfo.h"
 #include "DVDVideoCodec.h"
 #include "DVDVideoPPFFmpeg.h"
+#include "VideoFilterStage.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -70,6 +72,7 @@ protected:
   AVFilterContext* m_pFilterIn = nullptr;
   AVFilterContext* m_pFilterOut = nullptr;;
   AVFrame* m_pFilterFrame = nullptr;;
+  std::unique_ptr<CVideoFilterStage> m_filterStage; //!< runs the graph off the decode thread
   bool m_filterEof = false;
   bool m_eof = false;
 
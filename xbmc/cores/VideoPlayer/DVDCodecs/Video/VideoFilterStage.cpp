@@ -0,0 +1,218 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoFilterStage.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <libavfilter/buffersink.h>
+#include <libavfilter/buffersrc.h>
+}
+
+CVideoFilterStage::CVideoFilterStage(unsigned int maxFrames)
+  : CThread("VideoFilter"), m_maxFrames(std::max(maxFrames, 1u))
+{
+}
+
+CVideoFilterStage::~CVideoFilterStage()
+{
+  Stop();
+}
+
+void CVideoFilterStage::Start(AVFilterContext* source, AVFilterContext* sink)
+{
+  Stop();
+
+  m_source = source;
+  m_sink = sink;
+  m_framesIn = 0;
+  m_framesOut = 0;
+  m_busy = {};
+  Create();
+}
+
+void CVideoFilterStage::Stop()
+{
+  if (!m_source)
+    return;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_bStop = true;
+    m_added.notifyAll();
+  }
+  StopThread(true);
+
+  const std::chrono::duration<double, std::milli> busy = m_busy;
+  CLog::Log(LOGDEBUG, LOGVIDEO,
+            "CVideoFilterStage::Stop - filtered {} frames into {} frames in {:.0f} ms", m_framesIn,
+            m_framesOut, busy.count());
+
+  Clear();
+  m_source = nullptr;
+  m_sink = nullptr;
+}
+
+bool CVideoFilterStage::CanAdd() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_input.size() + m_output.size() + (m_filtering ? 1 : 0) < m_maxFrames;
+}
+
+void CVideoFilterStage::Add(AVFrame* frame)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (m_endQueued)
+    return;
+
+  if (frame)
+  {
+    AVFrame* queued = av_frame_alloc();
+    if (!queued)
+    {
+      m_error = true;
+      return;
+    }
+    av_frame_move_ref(queued, frame);
+    m_input.push_back(queued);
+  }
+  else
+  {
+    m_input.push_back(nullptr);
+    m_endQueued = true;
+  }
+
+  m_added.notifyAll();
+}
+
+bool CVideoFilterStage::IsEndQueued() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_endQueued;
+}
+
+CDVDVideoCodec::VCReturn CVideoFilterStage::Get(AVFrame* frame, bool wait)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  while (true)
+  {
+    if (!m_output.empty())
+    {
+      AVFrame* filtered = m_output.front();
+      m_output.pop_front();
+      av_frame_unref(frame);
+      av_frame_move_ref(frame, filtered);
+      av_frame_free(&filtered);
+      return CDVDVideoCodec::VC_PICTURE;
+    }
+
+    if (m_error)
+      return CDVDVideoCodec::VC_ERROR;
+    if (m_end)
+      return CDVDVideoCodec::VC_EOF;
+    if (!wait || (m_input.empty() && !m_filtering))
+      return CDVDVideoCodec::VC_BUFFER;
+
+    m_filtered.wait(lock);
+  }
+}
+
+void CVideoFilterStage::Process()
+{
+  while (true)
+  {
+    AVFrame* frame;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      while (m_input.empty() && !m_bStop)
+        m_added.wait(lock);
+
+      if (m_bStop)
+        break;
+
+      frame = m_input.front();
+      m_input.pop_front();
+      m_filtering = true;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<AVFrame*> filtered;
+    bool end = false;
+    bool error = false;
+
+    // a null frame flushes the graph
+    int result = av_buffersrc_add_frame(m_source, frame);
+    av_frame_free(&frame);
+    if (result < 0)
+    {
+      CLog::Log(LOGERROR, "CVideoFilterStage::Process - av_buffersrc_add_frame");
+      error = true;
+    }
+
+    while (!error)
+    {
+      AVFrame* out = av_frame_alloc();
+      if (!out)
+      {
+        error = true;
+        break;
+      }
+
+      result = av_buffersink_get_frame(m_sink, out);
+      if (result < 0)
+      {
+        av_frame_free(&out);
+        if (result == AVERROR_EOF)
+          end = true;
+        else if (result != AVERROR(EAGAIN))
+        {
+          CLog::Log(LOGERROR, "CVideoFilterStage::Process - av_buffersink_get_frame");
+          error = true;
+        }
+        break;
+      }
+      filtered.push_back(out);
+    }
+
+    const auto busy = std::chrono::steady_clock::now() - start;
+
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_output.insert(m_output.end(), filtered.begin(), filtered.end());
+    m_filtering = false;
+    m_end = m_end || end;
+    m_error = m_error || error;
+    m_framesIn++;
+    m_framesOut += filtered.size();
+    m_busy += busy;
+    m_filtered.notifyAll();
+  }
+}
+
+void CVideoFilterStage::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  for (AVFrame* frame : m_input)
+    av_frame_free(&frame);
+  for (AVFrame* frame : m_output)
+    av_frame_free(&frame);
+  m_input.clear();
+  m_output.clear();
+  m_filtering = false;
+  m_endQueued = false;
+  m_end = false;
+  m_error = false;
+}
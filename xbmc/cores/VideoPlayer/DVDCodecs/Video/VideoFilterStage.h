@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DVDVideoCodec.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <chrono>
+#include <deque>
+#include <stdint.h>
+
+extern "C" {
+#include <libavfilter/avfilter.h>
+#include <libavutil/frame.h>
+}
+
+/*!
+ * \brief Runs a configured filter graph on a thread of its own
+ *
+ * Deinterlacing and scaling in software cost about as much as decoding. Run on
+ * the decode thread the two costs add up, run here the next frame is decoded
+ * while the last one is filtered. The frames keep their properties, timestamps
+ * and flags included, as they go through the graph the same way as on the
+ * decode thread.
+ *
+ * Frames are added and taken from one thread, the decode thread. The stage holds
+ * a few frames at most, the caller waits for filtered frames once it is full.
+ */
+class CVideoFilterStage : private CThread
+{
+public:
+  explicit CVideoFilterStage(unsigned int maxFrames);
+  ~CVideoFilterStage() override;
+
+  /*!
+   * \brief Start filtering
+   * \param source The buffer source of a configured graph
+   * \param sink The buffer sink of the graph
+   * The graph must not be used or freed by anyone else until Stop() returns.
+   */
+  void Start(AVFilterContext* source, AVFilterContext* sink);
+
+  /*!
+   * \brief Stop filtering and drop the frames not taken yet
+   */
+  void Stop();
+
+  /*!
+   * \brief Whether there is room for another frame
+   */
+  bool CanAdd() const;
+
+  /*!
+   * \brief Queue a frame for filtering
+   * \param frame The frame, its reference is taken. nullptr marks the end of the stream,
+   * all frames still in the graph come out after it.
+   */
+  void Add(AVFrame* frame);
+
+  /*!
+   * \brief Whether the end of the stream was queued
+   */
+  bool IsEndQueued() const;
+
+  /*!
+   * \brief Get the next filtered frame
+   * \param frame Gets the reference of the filtered frame
+   * \param wait Wait for a frame if frames are being filtered
+   * \return VC_PICTURE for a frame, VC_BUFFER if none is ready, VC_EOF if the end of the
+   * stream came out, VC_ERROR if the graph failed
+   */
+  CDVDVideoCodec::VCReturn Get(AVFrame* frame, bool wait);
+
+protected:
+  void Process() override;
+
+private:
+  CVideoFilterStage(const CVideoFilterStage&) = delete;
+  CVideoFilterStage& operator=(const CVideoFilterStage&) = delete;
+
+  void Clear();
+
+  const unsigned int m_maxFrames;
+  AVFilterContext* m_source = nullptr;
+  AVFilterContext* m_sink = nullptr;
+
+  mutable CCriticalSection m_critSection;
+  XbmcThreads::ConditionVariable m_added;
+  XbmcThreads::ConditionVariable m_filtered;
+  std::deque<AVFrame*> m_input; //!< nullptr for the end of the stream
+  std::deque<AVFrame*> m_output;
+  bool m_filtering = false;
+  bool m_endQueued = false;
+  bool m_end = false;
+  bool m_error = false;
+
+  uint64_t m_framesIn = 0;
+  uint64_t m_framesOut = 0;
+  std::chrono::steady_clock::duration m_busy{0};
+};
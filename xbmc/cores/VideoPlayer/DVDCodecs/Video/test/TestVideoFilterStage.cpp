@@ -0,0 +1,310 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Video/VideoFilterStage.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavfilter/avfilter.h>
+#include <libavfilter/buffersink.h>
+#include <libavfilter/buffersrc.h>
+#include <libavutil/frame.h>
+}
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr int WIDTH = 1920;
+constexpr int HEIGHT = 1080;
+constexpr int FRAMES = 6;
+constexpr int BENCHMARK_FRAMES = 50;
+
+/*!
+ * \brief A buffer -> filters -> buffersink graph, set up the way the ffmpeg video codec does it
+ */
+class CFilterGraph
+{
+public:
+  ~CFilterGraph() { avfilter_graph_free(&m_graph); }
+
+  bool Open(const std::string& filters, int threads)
+  {
+    m_graph = avfilter_graph_alloc();
+    if (!m_graph)
+      return false;
+    m_graph->nb_threads = threads;
+
+    const std::string args = StringUtils::Format(
+        "video_size={}x{}:pix_fmt={}:time_base=1/25:pixel_aspect=1/1", WIDTH, HEIGHT,
+        static_cast<int>(AV_PIX_FMT_YUV420P));
+    if (avfilter_graph_create_filter(&source, avfilter_get_by_name("buffer"), "src", args.c_str(),
+                                     nullptr, m_graph) < 0)
+      return false;
+    if (avfilter_graph_create_filter(&sink, avfilter_get_by_name("buffersink"), "out", nullptr,
+                                     nullptr, m_graph) < 0)
+      return false;
+
+    AVFilterInOut* outputs = avfilter_inout_alloc();
+    AVFilterInOut* inputs = avfilter_inout_alloc();
+    outputs->name = av_strdup("in");
+    outputs->filter_ctx = source;
+    inputs->name = av_strdup("out");
+    inputs->filter_ctx = sink;
+    const int result = avfilter_graph_parse_ptr(m_graph, filters.c_str(), &inputs, &outputs,
+                                                nullptr);
+    avfilter_inout_free(&outputs);
+    avfilter_inout_free(&inputs);
+
+    return result >= 0 && avfilter_graph_config(m_graph, nullptr) >= 0;
+  }
+
+  AVFilterContext* source = nullptr;
+  AVFilterContext* sink = nullptr;
+
+private:
+  AVFilterGraph* m_graph = nullptr;
+};
+
+/*!
+ * \brief Make an interlaced 1080 frame, drawing it stands in for decoding it
+ */
+AVFrame* MakeFrame(int64_t pts)
+{
+  AVFrame* frame = av_frame_alloc();
+  frame->format = AV_PIX_FMT_YUV420P;
+  frame->width = WIDTH;
+  frame->height = HEIGHT;
+  if (av_frame_get_buffer(frame, 0) < 0)
+  {
+    av_frame_free(&frame);
+    return nullptr;
+  }
+
+  for (int plane = 0; plane < 3; plane++)
+  {
+    const int width = plane ? WIDTH / 2 : WIDTH;
+    const int height = plane ? HEIGHT / 2 : HEIGHT;
+    for (int y = 0; y < height; y++)
+    {
+      uint8_t* line = frame->data[plane] + y * frame->linesize[plane];
+      // the fields move apart, so there is something to deinterlace
+      const int shift = (y & 1) ? static_cast<int>(pts) * 4 : 0;
+      for (int x = 0; x < width; x++)
+        line[x] = static_cast<uint8_t>((x + shift) * 3 + y * 5 + plane * 64);
+    }
+  }
+
+  frame->pts = pts;
+  frame->interlaced_frame = 1;
+  frame->top_field_first = 1;
+  return frame;
+}
+
+/*!
+ * \brief Make and filter frames on one thread, the way the codec did without the stage
+ */
+std::vector<AVFrame*> FilterInline(CFilterGraph& graph, int frames)
+{
+  std::vector<AVFrame*> filtered;
+  for (int i = 0; i <= frames; i++)
+  {
+    AVFrame* frame = i < frames ? MakeFrame(i) : nullptr;
+    av_buffersrc_add_frame(graph.source, frame);
+    av_frame_free(&frame);
+
+    while (true)
+    {
+      AVFrame* out = av_frame_alloc();
+      if (av_buffersink_get_frame(graph.sink, out) < 0)
+      {
+        av_frame_free(&out);
+        break;
+      }
+      filtered.push_back(out);
+    }
+  }
+  return filtered;
+}
+
+/*!
+ * \brief Make frames on this thread and filter them on the stage, the way the codec does it now
+ */
+std::vector<AVFrame*> FilterStaged(CFilterGraph& graph, int frames)
+{
+  std::vector<AVFrame*> filtered;
+  CVideoFilterStage stage(4);
+  stage.Start(graph.source, graph.sink);
+
+  int made = 0;
+  while (true)
+  {
+    if (made < frames)
+    {
+      AVFrame* frame = MakeFrame(made++);
+      stage.Add(frame);
+      av_frame_free(&frame);
+    }
+    else if (!stage.IsEndQueued())
+      stage.Add(nullptr);
+
+    const bool wait = !stage.CanAdd() || stage.IsEndQueued();
+    AVFrame* out = av_frame_alloc();
+    const CDVDVideoCodec::VCReturn ret = stage.Get(out, wait);
+    if (ret == CDVDVideoCodec::VC_PICTURE)
+      filtered.push_back(out);
+    else
+      av_frame_free(&out);
+
+    if (ret == CDVDVideoCodec::VC_EOF || ret == CDVDVideoCodec::VC_ERROR)
+      break;
+  }
+
+  stage.Stop();
+  return filtered;
+}
+
+void FreeFrames(std::vector<AVFrame*>& frames)
+{
+  for (AVFrame* frame : frames)
+    av_frame_free(&frame);
+  frames.clear();
+}
+} // unnamed namespace
+
+TEST(TestVideoFilterStage, KeepsFrameProperties)
+{
+  CFilterGraph graph;
+  ASSERT_TRUE(graph.Open("null", 1));
+
+  CVideoFilterStage stage(2);
+  stage.Start(graph.source, graph.sink);
+
+  AVFrame* frame = MakeFrame(42);
+  ASSERT_NE(nullptr, frame);
+  frame->repeat_pict = 1;
+  stage.Add(frame);
+  av_frame_free(&frame);
+
+  AVFrame* out = av_frame_alloc();
+  ASSERT_EQ(CDVDVideoCodec::VC_PICTURE, stage.Get(out, true));
+  EXPECT_EQ(42, out->pts);
+  EXPECT_EQ(1, out->interlaced_frame);
+  EXPECT_EQ(1, out->top_field_first);
+  EXPECT_EQ(1, out->repeat_pict);
+  av_frame_free(&out);
+
+  stage.Stop();
+}
+
+TEST(TestVideoFilterStage, EndOfStream)
+{
+  CFilterGraph graph;
+  ASSERT_TRUE(graph.Open("null", 1));
+
+  CVideoFilterStage stage(2);
+  stage.Start(graph.source, graph.sink);
+
+  AVFrame* out = av_frame_alloc();
+  EXPECT_EQ(CDVDVideoCodec::VC_BUFFER, stage.Get(out, true));
+
+  stage.Add(nullptr);
+  EXPECT_TRUE(stage.IsEndQueued());
+  EXPECT_EQ(CDVDVideoCodec::VC_EOF, stage.Get(out, true));
+  av_frame_free(&out);
+}
+
+TEST(TestVideoFilterStage, HoldsFewFrames)
+{
+  CFilterGraph graph;
+  ASSERT_TRUE(graph.Open("null", 1));
+
+  CVideoFilterStage stage(2);
+  stage.Start(graph.source, graph.sink);
+  EXPECT_TRUE(stage.CanAdd());
+
+  for (int i = 0; i < 2; i++)
+  {
+    AVFrame* frame = MakeFrame(i);
+    stage.Add(frame);
+    av_frame_free(&frame);
+  }
+  EXPECT_FALSE(stage.CanAdd());
+
+  AVFrame* out = av_frame_alloc();
+  ASSERT_EQ(CDVDVideoCodec::VC_PICTURE, stage.Get(out, true));
+  EXPECT_EQ(0, out->pts);
+  EXPECT_TRUE(stage.CanAdd());
+  av_frame_free(&out);
+
+  // frames not taken are dropped
+  stage.Stop();
+}
+
+TEST(TestVideoFilterStage, DeinterlacesInOrder)
+{
+  // the graph the codec opens for an interlaced stream at full rate
+  const std::string filters = "bwdif=1:-1:1";
+
+  CFilterGraph inlineGraph;
+  ASSERT_TRUE(inlineGraph.Open(filters, 1));
+  std::vector<AVFrame*> inlineFrames = FilterInline(inlineGraph, FRAMES);
+
+  CFilterGraph stagedGraph;
+  ASSERT_TRUE(stagedGraph.Open(filters, 1));
+  std::vector<AVFrame*> stagedFrames = FilterStaged(stagedGraph, FRAMES);
+
+  // a frame for each field, in order and the same with or without the stage
+  EXPECT_EQ(static_cast<size_t>(FRAMES * 2), inlineFrames.size());
+  ASSERT_EQ(inlineFrames.size(), stagedFrames.size());
+  for (size_t i = 0; i < stagedFrames.size(); i++)
+  {
+    EXPECT_EQ(inlineFrames[i]->pts, stagedFrames[i]->pts);
+    if (i > 0)
+    {
+      EXPECT_LT(stagedFrames[i - 1]->pts, stagedFrames[i]->pts);
+    }
+  }
+
+  FreeFrames(inlineFrames);
+  FreeFrames(stagedFrames);
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST(TestVideoFilterStage, DISABLED_DeinterlaceThroughput)
+{
+  // the graph the codec opens for a 1080i stream at full rate, one thread each for the filter
+  // to compare the pipeline itself
+  const std::string filters = "bwdif=1:-1:1";
+
+  CFilterGraph inlineGraph;
+  ASSERT_TRUE(inlineGraph.Open(filters, 1));
+  auto start = std::chrono::steady_clock::now();
+  std::vector<AVFrame*> inlineFrames = FilterInline(inlineGraph, BENCHMARK_FRAMES);
+  const std::chrono::duration<double> inlineTime = std::chrono::steady_clock::now() - start;
+
+  CFilterGraph stagedGraph;
+  ASSERT_TRUE(stagedGraph.Open(filters, 1));
+  start = std::chrono::steady_clock::now();
+  std::vector<AVFrame*> stagedFrames = FilterStaged(stagedGraph, BENCHMARK_FRAMES);
+  const std::chrono::duration<double> stagedTime = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(inlineFrames.size(), stagedFrames.size());
+
+  CLog::Log(LOGINFO, "TestVideoFilterStage - {} 1080i frames: inline {:.1f} fps, staged {:.1f} fps",
+            BENCHMARK_FRAMES, BENCHMARK_FRAMES / inlineTime.count(),
+            BENCHMARK_FRAMES / stagedTime.count());
+
+  FreeFrames(inlineFrames);
+  FreeFrames(stagedFrames);
+}
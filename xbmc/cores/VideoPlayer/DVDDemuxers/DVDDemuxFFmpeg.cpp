@@ -22,6 +22,7 @@
 #include "cores/VideoPlayer/Interface/TimingConstants.h" // for DVD_TIME_BASE
 #include "DVDCodecs/DVDCodecUtils.h"
 #include "DemuxMVC.h"
+#include "DemuxProbeCache.h"
 #include "filesystem/CurlFile.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
@@ -38,6 +39,7 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -556,8 +558,35 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
-    CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
-    int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+    // plain local or LAN files can reuse the result of an earlier probe
+    const bool useProbeCache =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoProbeCache &&
+        m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) && !m_checkTransportStream &&
+        m_pInput->CanSeek() && !URIUtils::IsInternetStream(strFile);
+
+    CDemuxProbeCache::Key probeKey;
+    CDemuxProbeCache::Entry probeEntry;
+    bool probeCacheHit = false;
+    if (useProbeCache && CDemuxProbeCache::GetKey(strFile, probeKey) &&
+        CDemuxProbeCache::Load(probeKey, probeEntry))
+      probeCacheHit = CDemuxProbeCache::Apply(m_pFormatContext, probeKey, probeEntry);
+
+    const auto probeStart = std::chrono::steady_clock::now();
+    int iErr = 0;
+    if (!probeCacheHit)
+    {
+      CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
+      iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+
+      if (iErr >= 0 && !probeKey.path.empty() &&
+          CDemuxProbeCache::Capture(m_pFormatContext, probeKey, probeEntry))
+        CDemuxProbeCache::Store(probeEntry);
+    }
+    const auto probeTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - probeStart);
+    CLog::Log(LOGDEBUG, "{} - stream info {} after {} ms", __FUNCTION__,
+              probeCacheHit ? "restored from probe cache" : "probed", probeTime.count());
+
     if (iErr < 0)
     {
       CLog::Log(LOGWARNING, "could not find codec parameters for {}", CURL::GetRedacted(strFile));
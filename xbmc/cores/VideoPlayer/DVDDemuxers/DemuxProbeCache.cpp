@@ -0,0 +1,532 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxProbeCache.h"
+
+#include "FileItem.h"
+#include "URL.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/mem.h>
+}
+
+using namespace XFILE;
+
+namespace
+{
+// bump whenever the layout of the archive changes
+constexpr int PROBE_CACHE_VERSION = 2;
+// written last, a file without it was cut short while storing
+constexpr uint32_t PROBE_CACHE_END = 0x50434531;
+constexpr unsigned int PROBE_CACHE_MAX_STREAMS = 1024;
+constexpr const char* PROBE_CACHE_PATH = "special://temp/probecache/";
+constexpr int PROBE_CACHE_MAX_ENTRIES = 2000;
+
+std::once_flag pruneFlag;
+} // namespace
+
+std::atomic<uint64_t> CDemuxProbeCache::m_hits{0};
+std::atomic<uint64_t> CDemuxProbeCache::m_misses{0};
+
+std::string CDemuxProbeCache::GetCacheFile(const std::string& path)
+{
+  return StringUtils::Format("{}{:08x}.pc", PROBE_CACHE_PATH, Crc32::Compute(path));
+}
+
+bool CDemuxProbeCache::GetKey(const std::string& path, Key& key)
+{
+  struct __stat64 buffer = {};
+  if (CFile::Stat(path, &buffer) != 0)
+    return false;
+
+  if (buffer.st_size <= 0 || buffer.st_mtime <= 0)
+    return false;
+
+  key.path = path;
+  key.size = buffer.st_size;
+  key.mtime = buffer.st_mtime;
+  return true;
+}
+
+bool CDemuxProbeCache::Load(const Key& key, Entry& entry)
+{
+  const std::string cacheFile = GetCacheFile(key.path);
+
+  CFile file;
+  if (!file.Open(cacheFile))
+  {
+    m_misses++;
+    return false;
+  }
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+
+    int version;
+    ar >> version;
+    if (version != PROBE_CACHE_VERSION)
+    {
+      m_misses++;
+      return false;
+    }
+
+    ar >> entry.key.path;
+    ar >> entry.key.size;
+    ar >> entry.key.mtime;
+    if (entry.key.path != key.path || entry.key.size != key.size || entry.key.mtime != key.mtime)
+    {
+      CLog::Log(LOGDEBUG, "CDemuxProbeCache::{} - stale entry for {}", __FUNCTION__,
+                CURL::GetRedacted(key.path));
+      m_misses++;
+      return false;
+    }
+
+    ar >> entry.format;
+    ar >> entry.startTime;
+    ar >> entry.duration;
+    ar >> entry.bitRate;
+
+    unsigned int count;
+    ar >> count;
+    if (count > PROBE_CACHE_MAX_STREAMS)
+      throw std::out_of_range("too many streams");
+    entry.streams.resize(count);
+    for (auto& stream : entry.streams)
+    {
+      ar >> stream.id;
+      ar >> stream.codecType;
+      ar >> stream.codecId;
+      ar >> stream.codecTag;
+      ar >> stream.extraData;
+      ar >> stream.format;
+      ar >> stream.bitRate;
+      ar >> stream.bitsPerCodedSample;
+      ar >> stream.bitsPerRawSample;
+      ar >> stream.profile;
+      ar >> stream.level;
+      ar >> stream.width;
+      ar >> stream.height;
+      ar >> stream.sarNum;
+      ar >> stream.sarDen;
+      ar >> stream.fieldOrder;
+      ar >> stream.colorRange;
+      ar >> stream.colorPrimaries;
+      ar >> stream.colorTrc;
+      ar >> stream.colorSpace;
+      ar >> stream.chromaLocation;
+      ar >> stream.videoDelay;
+      ar >> stream.chLayoutOrder;
+      ar >> stream.channels;
+      ar >> stream.chLayoutMask;
+      ar >> stream.sampleRate;
+      ar >> stream.blockAlign;
+      ar >> stream.frameSize;
+      ar >> stream.initialPadding;
+      ar >> stream.trailingPadding;
+      ar >> stream.seekPreroll;
+      ar >> stream.timeBaseNum;
+      ar >> stream.timeBaseDen;
+      ar >> stream.avgFrameRateNum;
+      ar >> stream.avgFrameRateDen;
+      ar >> stream.realFrameRateNum;
+      ar >> stream.realFrameRateDen;
+      ar >> stream.startTime;
+      ar >> stream.duration;
+      ar >> stream.frames;
+    }
+
+    ar >> count;
+    if (count > PROBE_CACHE_MAX_STREAMS)
+      throw std::out_of_range("too many chapters");
+    entry.chapters.resize(count);
+    for (auto& chapter : entry.chapters)
+    {
+      ar >> chapter.id;
+      ar >> chapter.start;
+      ar >> chapter.end;
+      ar >> chapter.timeBaseNum;
+      ar >> chapter.timeBaseDen;
+    }
+
+    // a short read yields zeros rather than an error, so a cut off entry ends up here
+    uint32_t end;
+    ar >> end;
+    if (end != PROBE_CACHE_END)
+      throw std::out_of_range("truncated entry");
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "CDemuxProbeCache::{} - corrupt archive: {}", __FUNCTION__, cacheFile);
+    file.Close();
+    CFile::Delete(cacheFile);
+    m_misses++;
+    return false;
+  }
+
+  return true;
+}
+
+bool CDemuxProbeCache::Store(const Entry& entry)
+{
+  std::call_once(pruneFlag, [] { Prune(); });
+
+  CFile file;
+  if (!file.OpenForWrite(GetCacheFile(entry.key.path), true))
+    return false;
+
+  CArchive ar(&file, CArchive::store);
+  ar << PROBE_CACHE_VERSION;
+  ar << entry.key.path;
+  ar << entry.key.size;
+  ar << entry.key.mtime;
+  ar << entry.format;
+  ar << entry.startTime;
+  ar << entry.duration;
+  ar << entry.bitRate;
+
+  ar << static_cast<unsigned int>(entry.streams.size());
+  for (const auto& stream : entry.streams)
+  {
+    ar << stream.id;
+    ar << stream.codecType;
+    ar << stream.codecId;
+    ar << stream.codecTag;
+    ar << stream.extraData;
+    ar << stream.format;
+    ar << stream.bitRate;
+    ar << stream.bitsPerCodedSample;
+    ar << stream.bitsPerRawSample;
+    ar << stream.profile;
+    ar << stream.level;
+    ar << stream.width;
+    ar << stream.height;
+    ar << stream.sarNum;
+    ar << stream.sarDen;
+    ar << stream.fieldOrder;
+    ar << stream.colorRange;
+    ar << stream.colorPrimaries;
+    ar << stream.colorTrc;
+    ar << stream.colorSpace;
+    ar << stream.chromaLocation;
+    ar << stream.videoDelay;
+    ar << stream.chLayoutOrder;
+    ar << stream.channels;
+    ar << stream.chLayoutMask;
+    ar << stream.sampleRate;
+    ar << stream.blockAlign;
+    ar << stream.frameSize;
+    ar << stream.initialPadding;
+    ar << stream.trailingPadding;
+    ar << stream.seekPreroll;
+    ar << stream.timeBaseNum;
+    ar << stream.timeBaseDen;
+    ar << stream.avgFrameRateNum;
+    ar << stream.avgFrameRateDen;
+    ar << stream.realFrameRateNum;
+    ar << stream.realFrameRateDen;
+    ar << stream.startTime;
+    ar << stream.duration;
+    ar << stream.frames;
+  }
+
+  ar << static_cast<unsigned int>(entry.chapters.size());
+  for (const auto& chapter : entry.chapters)
+  {
+    ar << chapter.id;
+    ar << chapter.start;
+    ar << chapter.end;
+    ar << chapter.timeBaseNum;
+    ar << chapter.timeBaseDen;
+  }
+  ar << PROBE_CACHE_END;
+
+  ar.Close();
+  file.Close();
+  return true;
+}
+
+void CDemuxProbeCache::Remove(const std::string& path)
+{
+  const std::string cacheFile = GetCacheFile(path);
+  if (CFile::Exists(cacheFile))
+    CFile::Delete(cacheFile);
+}
+
+void CDemuxProbeCache::Prune()
+{
+  if (!CDirectory::Exists(PROBE_CACHE_PATH))
+  {
+    CDirectory::Create(PROBE_CACHE_PATH);
+    return;
+  }
+
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(PROBE_CACHE_PATH, items, ".pc",
+                                DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE))
+    return;
+
+  if (items.Size() <= PROBE_CACHE_MAX_ENTRIES)
+    return;
+
+  // oldest first, keep the most recently written entries
+  std::vector<std::shared_ptr<CFileItem>> files(items.cbegin(), items.cend());
+  std::sort(files.begin(), files.end(),
+            [](const auto& a, const auto& b) { return a->m_dateTime < b->m_dateTime; });
+
+  const size_t excess = files.size() - PROBE_CACHE_MAX_ENTRIES;
+  for (size_t i = 0; i < excess; ++i)
+    CFile::Delete(files[i]->GetPath());
+
+  CLog::Log(LOGDEBUG, "CDemuxProbeCache::{} - removed {} old entries", __FUNCTION__, excess);
+}
+
+bool CDemuxProbeCache::Capture(const AVFormatContext* context, const Key& key, Entry& entry)
+{
+  if (!context || !context->iformat || !context->iformat->name)
+    return false;
+
+  entry = {};
+  entry.key = key;
+  entry.format = context->iformat->name;
+  entry.startTime = context->start_time;
+  entry.duration = context->duration;
+  entry.bitRate = context->bit_rate;
+
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+  {
+    const AVStream* st = context->streams[i];
+    const AVCodecParameters* par = st->codecpar;
+
+    // custom and ambisonic channel maps can't be expressed by a mask
+    if (par->ch_layout.order != AV_CHANNEL_ORDER_NATIVE &&
+        par->ch_layout.order != AV_CHANNEL_ORDER_UNSPEC)
+      return false;
+
+    Stream stream;
+    stream.id = st->id;
+    stream.codecType = par->codec_type;
+    stream.codecId = par->codec_id;
+    stream.codecTag = par->codec_tag;
+    if (par->extradata && par->extradata_size > 0)
+      stream.extraData.assign(reinterpret_cast<const char*>(par->extradata), par->extradata_size);
+    stream.format = par->format;
+    stream.bitRate = par->bit_rate;
+    stream.bitsPerCodedSample = par->bits_per_coded_sample;
+    stream.bitsPerRawSample = par->bits_per_raw_sample;
+    stream.profile = par->profile;
+    stream.level = par->level;
+    stream.width = par->width;
+    stream.height = par->height;
+    stream.sarNum = par->sample_aspect_ratio.num;
+    stream.sarDen = par->sample_aspect_ratio.den;
+    stream.fieldOrder = par->field_order;
+    stream.colorRange = par->color_range;
+    stream.colorPrimaries = par->color_primaries;
+    stream.colorTrc = par->color_trc;
+    stream.colorSpace = par->color_space;
+    stream.chromaLocation = par->chroma_location;
+    stream.videoDelay = par->video_delay;
+    stream.chLayoutOrder = par->ch_layout.order;
+    stream.channels = par->ch_layout.nb_channels;
+    stream.chLayoutMask = par->ch_layout.order == AV_CHANNEL_ORDER_NATIVE ? par->ch_layout.u.mask : 0;
+    stream.sampleRate = par->sample_rate;
+    stream.blockAlign = par->block_align;
+    stream.frameSize = par->frame_size;
+    stream.initialPadding = par->initial_padding;
+    stream.trailingPadding = par->trailing_padding;
+    stream.seekPreroll = par->seek_preroll;
+    stream.timeBaseNum = st->time_base.num;
+    stream.timeBaseDen = st->time_base.den;
+    stream.avgFrameRateNum = st->avg_frame_rate.num;
+    stream.avgFrameRateDen = st->avg_frame_rate.den;
+    stream.realFrameRateNum = st->r_frame_rate.num;
+    stream.realFrameRateDen = st->r_frame_rate.den;
+    stream.startTime = st->start_time;
+    stream.duration = st->duration;
+    stream.frames = st->nb_frames;
+
+    // probing gave up on this stream, caching it would skip probing for good
+    if (!IsComplete(stream))
+      return false;
+
+    entry.streams.emplace_back(std::move(stream));
+  }
+
+  for (unsigned int i = 0; i < context->nb_chapters; ++i)
+  {
+    const AVChapter* ch = context->chapters[i];
+    Chapter chapter;
+    chapter.id = ch->id;
+    chapter.start = ch->start;
+    chapter.end = ch->end;
+    chapter.timeBaseNum = ch->time_base.num;
+    chapter.timeBaseDen = ch->time_base.den;
+    entry.chapters.emplace_back(chapter);
+  }
+
+  return true;
+}
+
+bool CDemuxProbeCache::IsComplete(const Stream& stream)
+{
+  if (stream.codecId == AV_CODEC_ID_NONE)
+    return false;
+
+  switch (stream.codecType)
+  {
+    case AVMEDIA_TYPE_VIDEO:
+      return stream.width > 0 && stream.height > 0;
+    case AVMEDIA_TYPE_AUDIO:
+      return stream.sampleRate > 0 && stream.channels > 0;
+    default:
+      return true;
+  }
+}
+
+bool CDemuxProbeCache::Apply(AVFormatContext* context, const Key& key, const Entry& entry)
+{
+  const auto mismatch = [&entry](const char* what) {
+    CLog::Log(LOGDEBUG, "CDemuxProbeCache::Apply - {} differs, probing {}", what,
+              CURL::GetRedacted(entry.key.path));
+    m_misses++;
+    return false;
+  };
+
+  // the file changed since the entry was written
+  if (entry.key.path != key.path || entry.key.size != key.size || entry.key.mtime != key.mtime)
+    return mismatch("size or mtime");
+
+  if (context && context->pb)
+  {
+    const int64_t size = avio_size(context->pb);
+    if (size > 0 && size != key.size)
+      return mismatch("size");
+  }
+
+  if (!context || !context->iformat || !context->iformat->name ||
+      entry.format != context->iformat->name)
+    return mismatch("format");
+
+  // streams created only while probing (e.g. late streams) can't be reproduced here
+  if (entry.streams.size() != context->nb_streams)
+    return mismatch("stream count");
+
+  if (entry.chapters.size() != context->nb_chapters)
+    return mismatch("chapter count");
+
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+  {
+    const AVStream* st = context->streams[i];
+    const Stream& stream = entry.streams[i];
+    if (st->id != stream.id || st->codecpar->codec_type != stream.codecType ||
+        st->codecpar->codec_id != stream.codecId || st->time_base.num != stream.timeBaseNum ||
+        st->time_base.den != stream.timeBaseDen)
+      return mismatch("stream layout");
+    if (!IsComplete(stream))
+      return mismatch("stream parameters");
+  }
+
+  for (unsigned int i = 0; i < context->nb_chapters; ++i)
+  {
+    const AVChapter* ch = context->chapters[i];
+    const Chapter& chapter = entry.chapters[i];
+    if (ch->start != chapter.start || ch->end != chapter.end)
+      return mismatch("chapter");
+  }
+
+  // everything matches the header, now fill in what probing would have found
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+  {
+    AVStream* st = context->streams[i];
+    AVCodecParameters* par = st->codecpar;
+    const Stream& stream = entry.streams[i];
+
+    if (!par->extradata && !stream.extraData.empty())
+    {
+      par->extradata = static_cast<uint8_t*>(
+          av_mallocz(stream.extraData.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+      if (par->extradata)
+      {
+        memcpy(par->extradata, stream.extraData.data(), stream.extraData.size());
+        par->extradata_size = static_cast<int>(stream.extraData.size());
+      }
+    }
+
+    par->codec_tag = stream.codecTag;
+    par->format = stream.format;
+    par->bit_rate = stream.bitRate;
+    par->bits_per_coded_sample = stream.bitsPerCodedSample;
+    par->bits_per_raw_sample = stream.bitsPerRawSample;
+    par->profile = stream.profile;
+    par->level = stream.level;
+    par->width = stream.width;
+    par->height = stream.height;
+    par->sample_aspect_ratio = AVRational{stream.sarNum, stream.sarDen};
+    par->field_order = static_cast<AVFieldOrder>(stream.fieldOrder);
+    par->color_range = static_cast<AVColorRange>(stream.colorRange);
+    par->color_primaries = static_cast<AVColorPrimaries>(stream.colorPrimaries);
+    par->color_trc = static_cast<AVColorTransferCharacteristic>(stream.colorTrc);
+    par->color_space = static_cast<AVColorSpace>(stream.colorSpace);
+    par->chroma_location = static_cast<AVChromaLocation>(stream.chromaLocation);
+    par->video_delay = stream.videoDelay;
+    if (stream.channels > 0)
+    {
+      av_channel_layout_uninit(&par->ch_layout);
+      if (stream.chLayoutOrder == AV_CHANNEL_ORDER_NATIVE)
+      {
+        av_channel_layout_from_mask(&par->ch_layout, stream.chLayoutMask);
+      }
+      else
+      {
+        par->ch_layout.order = AV_CHANNEL_ORDER_UNSPEC;
+        par->ch_layout.nb_channels = stream.channels;
+      }
+    }
+    par->sample_rate = stream.sampleRate;
+    par->block_align = stream.blockAlign;
+    par->frame_size = stream.frameSize;
+    par->initial_padding = stream.initialPadding;
+    par->trailing_padding = stream.trailingPadding;
+    par->seek_preroll = stream.seekPreroll;
+
+    st->avg_frame_rate = AVRational{stream.avgFrameRateNum, stream.avgFrameRateDen};
+    st->r_frame_rate = AVRational{stream.realFrameRateNum, stream.realFrameRateDen};
+    if (st->start_time == AV_NOPTS_VALUE)
+      st->start_time = stream.startTime;
+    if (st->duration == AV_NOPTS_VALUE)
+      st->duration = stream.duration;
+    if (st->nb_frames == 0)
+      st->nb_frames = stream.frames;
+  }
+
+  if (context->start_time == AV_NOPTS_VALUE)
+    context->start_time = entry.startTime;
+  if (context->duration == AV_NOPTS_VALUE)
+    context->duration = entry.duration;
+  if (context->bit_rate == 0)
+    context->bit_rate = entry.bitRate;
+
+  m_hits++;
+  return true;
+}
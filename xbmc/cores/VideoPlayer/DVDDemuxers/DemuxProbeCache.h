@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct AVFormatContext;
+
+/*!
+ * \brief Persistent cache of avformat_find_stream_info() results.
+ *
+ * Probing a file can take seconds on network shares, while the result only
+ * depends on the file itself. Entries are keyed by path, size and mtime and
+ * stored below special://temp/probecache/. A valid entry pre-populates the
+ * codec parameters of the freshly opened AVFormatContext so probing can be
+ * skipped; any mismatch against the container header makes the caller fall
+ * back to a full probe.
+ */
+class CDemuxProbeCache
+{
+public:
+  struct Key
+  {
+    std::string path;
+    int64_t size = 0;
+    int64_t mtime = 0;
+  };
+
+  struct Stream
+  {
+    int id = 0;
+    int codecType = -1;
+    int codecId = 0;
+    uint32_t codecTag = 0;
+    std::string extraData;
+    int format = -1;
+    int64_t bitRate = 0;
+    int bitsPerCodedSample = 0;
+    int bitsPerRawSample = 0;
+    int profile = -99;
+    int level = -99;
+    int width = 0;
+    int height = 0;
+    int sarNum = 0;
+    int sarDen = 1;
+    int fieldOrder = 0;
+    int colorRange = 0;
+    int colorPrimaries = 2;
+    int colorTrc = 2;
+    int colorSpace = 2;
+    int chromaLocation = 0;
+    int videoDelay = 0;
+    int chLayoutOrder = 0;
+    int channels = 0;
+    uint64_t chLayoutMask = 0;
+    int sampleRate = 0;
+    int blockAlign = 0;
+    int frameSize = 0;
+    int initialPadding = 0;
+    int trailingPadding = 0;
+    int seekPreroll = 0;
+    int timeBaseNum = 0;
+    int timeBaseDen = 1;
+    int avgFrameRateNum = 0;
+    int avgFrameRateDen = 1;
+    int realFrameRateNum = 0;
+    int realFrameRateDen = 1;
+    int64_t startTime = 0;
+    int64_t duration = 0;
+    int64_t frames = 0;
+  };
+
+  struct Chapter
+  {
+    int64_t id = 0;
+    int64_t start = 0;
+    int64_t end = 0;
+    int timeBaseNum = 0;
+    int timeBaseDen = 1;
+  };
+
+  struct Entry
+  {
+    Key key;
+    std::string format;
+    int64_t startTime = 0;
+    int64_t duration = 0;
+    int64_t bitRate = 0;
+    std::vector<Stream> streams;
+    std::vector<Chapter> chapters;
+  };
+
+  /*!
+   * \brief Build the cache key of a file
+   * \return false if the file can't be stat'ed or has no usable size/mtime
+   */
+  static bool GetKey(const std::string& path, Key& key);
+
+  /*!
+   * \brief Load the entry for a key
+   * \return false if there is no entry or it was written for a different size/mtime
+   */
+  static bool Load(const Key& key, Entry& entry);
+
+  /*!
+   * \brief Persist an entry, replacing any older entry of the same path
+   */
+  static bool Store(const Entry& entry);
+
+  /*!
+   * \brief Remove the entry of a path, e.g. after it turned out to be stale
+   */
+  static void Remove(const std::string& path);
+
+  /*!
+   * \brief Capture the probe result of a context that went through avformat_find_stream_info()
+   * \return false if the result can't be represented in the cache or a stream lacks the
+   * parameters probing should have found
+   */
+  static bool Capture(const AVFormatContext* context, const Key& key, Entry& entry);
+
+  /*!
+   * \brief Apply a cached probe result to a context fresh from avformat_open_input()
+   * \param key the key of the file as it is now, the entry must have been written for it
+   * \return false if the entry is stale, incomplete or doesn't match the container header, the
+   * context is untouched then
+   */
+  static bool Apply(AVFormatContext* context, const Key& key, const Entry& entry);
+
+  /*!
+   * \brief Whether a stream has the codec parameters a decoder needs to be opened
+   */
+  static bool IsComplete(const Stream& stream);
+
+  static uint64_t GetHits() { return m_hits; }
+  static uint64_t GetMisses() { return m_misses; }
+
+private:
+  static std::string GetCacheFile(const std::string& path);
+  static void Prune();
+
+  static std::atomic<uint64_t> m_hits;
+  static std::atomic<uint64_t> m_misses;
+};
@@ -0,0 +1,263 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxProbeCache.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/mem.h>
+}
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+/*!
+ * \brief An AVFormatContext as avformat_open_input() leaves it for a matroska file, the codec
+ * parameters beyond the codec id are only known after probing
+ */
+class CFormatContext
+{
+public:
+  CFormatContext()
+  {
+    m_context = avformat_alloc_context();
+    m_context->iformat = av_find_input_format("matroska");
+
+    AVStream* video = avformat_new_stream(m_context, nullptr);
+    video->id = 1;
+    video->time_base = AVRational{1, 1000};
+    video->codecpar->codec_type = AVMEDIA_TYPE_VIDEO;
+    video->codecpar->codec_id = AV_CODEC_ID_H264;
+
+    AVStream* audio = avformat_new_stream(m_context, nullptr);
+    audio->id = 2;
+    audio->time_base = AVRational{1, 1000};
+    audio->codecpar->codec_type = AVMEDIA_TYPE_AUDIO;
+    audio->codecpar->codec_id = AV_CODEC_ID_AC3;
+  }
+
+  ~CFormatContext() { avformat_free_context(m_context); }
+
+  /*!
+   * \brief Fill in what avformat_find_stream_info() finds
+   */
+  void Probe()
+  {
+    AVCodecParameters* video = m_context->streams[0]->codecpar;
+    video->width = 1920;
+    video->height = 1080;
+    video->extradata = static_cast<uint8_t*>(av_mallocz(6 + AV_INPUT_BUFFER_PADDING_SIZE));
+    memcpy(video->extradata, "\x01\x64\x00\x28\xff\x00", 6);
+    video->extradata_size = 6;
+    m_context->streams[0]->avg_frame_rate = AVRational{24000, 1001};
+
+    AVCodecParameters* audio = m_context->streams[1]->codecpar;
+    av_channel_layout_default(&audio->ch_layout, 6);
+    audio->sample_rate = 48000;
+  }
+
+  AVFormatContext* Get() { return m_context; }
+
+private:
+  AVFormatContext* m_context;
+};
+} // unnamed namespace
+
+class TestDemuxProbeCache : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_file = XBMC_CREATETEMPFILE(".mkv");
+    ASSERT_NE(nullptr, m_file);
+    const char data[] = "not really a matroska file";
+    m_file->Write(data, sizeof(data));
+    m_file->Flush();
+    m_path = XBMC_TEMPFILEPATH(m_file);
+  }
+
+  void TearDown() override
+  {
+    CDemuxProbeCache::Remove(m_path);
+    XBMC_DELETETEMPFILE(m_file);
+  }
+
+  CDemuxProbeCache::Entry MakeEntry(const CDemuxProbeCache::Key& key)
+  {
+    CDemuxProbeCache::Entry entry;
+    entry.key = key;
+    entry.format = "matroska,webm";
+    entry.duration = 5400000000;
+    entry.bitRate = 8000000;
+
+    CDemuxProbeCache::Stream video;
+    video.id = 1;
+    video.codecType = 0;
+    video.codecId = 27;
+    video.extraData = std::string("\x01\x64\x00\x28\xff\x00", 6);
+    video.width = 1920;
+    video.height = 1080;
+    video.timeBaseNum = 1;
+    video.timeBaseDen = 1000;
+    video.avgFrameRateNum = 24000;
+    video.avgFrameRateDen = 1001;
+    entry.streams.emplace_back(video);
+
+    CDemuxProbeCache::Stream audio;
+    audio.id = 2;
+    audio.codecType = 1;
+    audio.codecId = 86019;
+    audio.channels = 6;
+    audio.chLayoutOrder = 1;
+    audio.chLayoutMask = 0x60f;
+    audio.sampleRate = 48000;
+    entry.streams.emplace_back(audio);
+
+    CDemuxProbeCache::Chapter chapter;
+    chapter.id = 1;
+    chapter.end = 600000;
+    chapter.timeBaseDen = 1000;
+    entry.chapters.emplace_back(chapter);
+    return entry;
+  }
+
+  XFILE::CFile* m_file = nullptr;
+  std::string m_path;
+};
+
+TEST_F(TestDemuxProbeCache, GetKey)
+{
+  CDemuxProbeCache::Key key;
+  ASSERT_TRUE(CDemuxProbeCache::GetKey(m_path, key));
+  EXPECT_EQ(m_path, key.path);
+  EXPECT_GT(key.size, 0);
+  EXPECT_GT(key.mtime, 0);
+
+  EXPECT_FALSE(CDemuxProbeCache::GetKey(m_path + ".missing", key));
+}
+
+TEST_F(TestDemuxProbeCache, StoreLoad)
+{
+  CDemuxProbeCache::Key key;
+  ASSERT_TRUE(CDemuxProbeCache::GetKey(m_path, key));
+  ASSERT_TRUE(CDemuxProbeCache::Store(MakeEntry(key)));
+
+  CDemuxProbeCache::Entry entry;
+  ASSERT_TRUE(CDemuxProbeCache::Load(key, entry));
+  EXPECT_EQ("matroska,webm", entry.format);
+  EXPECT_EQ(5400000000, entry.duration);
+  ASSERT_EQ(2u, entry.streams.size());
+  EXPECT_EQ(std::string("\x01\x64\x00\x28\xff\x00", 6), entry.streams[0].extraData);
+  EXPECT_EQ(1080, entry.streams[0].height);
+  EXPECT_EQ(1001, entry.streams[0].avgFrameRateDen);
+  EXPECT_EQ(6, entry.streams[1].channels);
+  EXPECT_EQ(0x60fu, entry.streams[1].chLayoutMask);
+  ASSERT_EQ(1u, entry.chapters.size());
+  EXPECT_EQ(600000, entry.chapters[0].end);
+}
+
+TEST_F(TestDemuxProbeCache, StaleEntry)
+{
+  CDemuxProbeCache::Key key;
+  ASSERT_TRUE(CDemuxProbeCache::GetKey(m_path, key));
+  ASSERT_TRUE(CDemuxProbeCache::Store(MakeEntry(key)));
+
+  CDemuxProbeCache::Entry entry;
+  CDemuxProbeCache::Key changed = key;
+  changed.size++;
+  EXPECT_FALSE(CDemuxProbeCache::Load(changed, entry));
+
+  changed = key;
+  changed.mtime++;
+  EXPECT_FALSE(CDemuxProbeCache::Load(changed, entry));
+
+  CDemuxProbeCache::Remove(m_path);
+  EXPECT_FALSE(CDemuxProbeCache::Load(key, entry));
+}
+
+TEST_F(TestDemuxProbeCache, CaptureApply)
+{
+  CDemuxProbeCache::Key key;
+  ASSERT_TRUE(CDemuxProbeCache::GetKey(m_path, key));
+
+  CFormatContext probed;
+  probed.Probe();
+  CDemuxProbeCache::Entry entry;
+  ASSERT_TRUE(CDemuxProbeCache::Capture(probed.Get(), key, entry));
+  ASSERT_EQ(2u, entry.streams.size());
+
+  CFormatContext opened;
+  ASSERT_TRUE(CDemuxProbeCache::Apply(opened.Get(), key, entry));
+  const AVCodecParameters* video = opened.Get()->streams[0]->codecpar;
+  EXPECT_EQ(1920, video->width);
+  EXPECT_EQ(1080, video->height);
+  ASSERT_EQ(6, video->extradata_size);
+  EXPECT_EQ(0, memcmp(video->extradata, "\x01\x64\x00\x28\xff\x00", 6));
+  EXPECT_EQ(1001, opened.Get()->streams[0]->avg_frame_rate.den);
+  const AVCodecParameters* audio = opened.Get()->streams[1]->codecpar;
+  EXPECT_EQ(6, audio->ch_layout.nb_channels);
+  EXPECT_EQ(48000, audio->sample_rate);
+}
+
+TEST_F(TestDemuxProbeCache, CaptureIncomplete)
+{
+  CDemuxProbeCache::Key key;
+  ASSERT_TRUE(CDemuxProbeCache::GetKey(m_path, key));
+
+  // probing didn't find the video size
+  CFormatContext probed;
+  probed.Probe();
+  probed.Get()->streams[0]->codecpar->width = 0;
+  CDemuxProbeCache::Entry entry;
+  EXPECT_FALSE(CDemuxProbeCache::Capture(probed.Get(), key, entry));
+}
+
+TEST_F(TestDemuxProbeCache, ApplyFallsBack)
+{
+  CDemuxProbeCache::Key key;
+  ASSERT_TRUE(CDemuxProbeCache::GetKey(m_path, key));
+  CFormatContext probed;
+  probed.Probe();
+  CDemuxProbeCache::Entry entry;
+  ASSERT_TRUE(CDemuxProbeCache::Capture(probed.Get(), key, entry));
+
+  // the file changed since the entry was written
+  CDemuxProbeCache::Key changed = key;
+  changed.mtime++;
+  CFormatContext opened;
+  EXPECT_FALSE(CDemuxProbeCache::Apply(opened.Get(), changed, entry));
+  changed = key;
+  changed.size++;
+  EXPECT_FALSE(CDemuxProbeCache::Apply(opened.Get(), changed, entry));
+
+  // an entry without the codec parameters
+  CDemuxProbeCache::Entry partial = entry;
+  partial.streams[1].sampleRate = 0;
+  EXPECT_FALSE(CDemuxProbeCache::Apply(opened.Get(), key, partial));
+
+  // a different container header
+  CDemuxProbeCache::Entry other = entry;
+  other.streams[1].codecId = AV_CODEC_ID_AAC;
+  EXPECT_FALSE(CDemuxProbeCache::Apply(opened.Get(), key, other));
+  other = entry;
+  other.streams.pop_back();
+  EXPECT_FALSE(CDemuxProbeCache::Apply(opened.Get(), key, other));
+
+  // the context is left for the full probe
+  EXPECT_EQ(0, opened.Get()->streams[0]->codecpar->width);
+  EXPECT_EQ(0, opened.Get()->streams[1]->codecpar->sample_rate);
+  EXPECT_EQ(nullptr, opened.Get()->streams[0]->codecpar->extradata);
+}
@@ -45,7 +45,7 @@ bool CDVDInputStreamFile::Open()
 
   // If this file is audio and/or video (= not a subtitle) flag to caller
   if (!m_item.IsSubtitle())
-    flags |= READ_AUDIO_VIDEO;
+    flags |= READ_AUDIO_VIDEO | READ_AHEAD;
   else
     flags |= READ_NO_BUFFER; // disable CFileStreamBuffer for subtitles
 
@@ -0,0 +1,440 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDThumbExtractor.h"
+
+#include "DVDCodecs/DVDFactoryCodec.h"
+#include "DVDCodecs/Video/DVDVideoCodec.h"
+#include "DVDDemuxers/DVDDemux.h"
+#include "DVDDemuxers/DVDDemuxUtils.h"
+#include "DVDDemuxers/DVDFactoryDemuxer.h"
+#include "DVDFileInfo.h"
+#include "DVDInputStreams/DVDFactoryInputStream.h"
+#include "DVDInputStreams/DVDInputStream.h"
+#include "DVDStreamInfo.h"
+#include "FileItem.h"
+#include "Process/ProcessInfo.h"
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "guilib/Texture.h"
+#include "pictures/Picture.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libswscale/swscale.h>
+}
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// how long an opened file is kept around for further chapter images
+constexpr auto SESSION_LINGER = 10s;
+// how often idle files are checked, an idle file is closed within 1.5 times SESSION_LINGER
+constexpr auto SESSION_CHECK_INTERVAL = SESSION_LINGER / 2;
+constexpr size_t MAX_IDLE_SESSIONS = 4;
+
+int DegreeToOrientation(int degrees)
+{
+  switch(degrees)
+  {
+    case 90:
+      return 5;
+    case 180:
+      return 2;
+    case 270:
+      return 7;
+    default:
+      return 0;
+  }
+}
+} // namespace
+
+struct CDVDThumbExtractor::Session
+{
+  std::string path;
+  std::shared_ptr<CDVDInputStream> inputStream;
+  std::unique_ptr<CDVDDemux> demuxer;
+  std::unique_ptr<CProcessInfo> processInfo;
+  std::unique_ptr<CDVDVideoCodec> codec;
+  CDVDStreamInfo hint;
+  int videoStream = -1;
+  std::chrono::steady_clock::time_point lastUsed;
+};
+
+CDVDThumbExtractor::CDVDThumbExtractor()
+  : m_maxActive(
+        [] {
+          const auto cpuInfo = CServiceBroker::GetCPUInfo();
+          const int cpus = cpuInfo ? cpuInfo->GetCPUCount() : 1;
+          // leave room for playback and the gui, decoding is single threaded per extraction
+          return static_cast<unsigned int>(std::clamp(cpus / 2, 1, 4));
+        }()),
+    m_timer(this)
+{
+}
+
+CDVDThumbExtractor::~CDVDThumbExtractor()
+{
+  Deinitialize();
+}
+
+void CDVDThumbExtractor::Deinitialize()
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_stopped = true;
+  }
+  m_condition.notifyAll();
+
+  m_timer.Stop(true);
+  Flush();
+}
+
+std::unique_ptr<CTexture> CDVDThumbExtractor::Extract(const CFileItem& fileItem, int chapterNumber)
+{
+  if (!CDVDFileInfo::CanExtract(fileItem))
+    return {};
+
+  const std::string path = fileItem.GetDynPath();
+  const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
+
+  std::unique_ptr<Session> session;
+  if (!AcquireSession(path, session))
+    return {};
+
+  const auto start = std::chrono::steady_clock::now();
+
+  const bool reused = session != nullptr;
+  if (!session)
+    session = OpenSession(fileItem);
+
+  std::unique_ptr<CTexture> result;
+  if (session)
+    result = ExtractFromSession(*session, chapterNumber);
+
+  const auto duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  CLog::LogF(LOGDEBUG, "measured {} ms to extract {} from file <{}>{}", duration.count(),
+             chapterNumber > 0 ? "chapter image " + std::to_string(chapterNumber) : "thumb",
+             redactPath, reused ? " (reused)" : "");
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_stats.busyTime += duration;
+    if (result)
+      m_stats.extracted++;
+    else
+      m_stats.failed++;
+    if (reused)
+      m_stats.reused++;
+  }
+
+  // a session that failed to produce an image is in an unknown state, don't reuse it
+  if (!result)
+    session.reset();
+
+  ReleaseSession(path, std::move(session));
+  return result;
+}
+
+bool CDVDThumbExtractor::AcquireSession(const std::string& path,
+                                        std::unique_ptr<Session>& session)
+{
+  CloseExpiredSessions(false);
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_stopped)
+    return false;
+
+  m_stats.requested++;
+  m_stats.pending++;
+
+  // requests for a file that is being extracted from wait, they can take over its session then
+  m_condition.wait(lock, [this, &path] {
+    return m_stopped ||
+           (m_stats.active < m_maxActive &&
+            std::find(m_busyPaths.begin(), m_busyPaths.end(), path) == m_busyPaths.end());
+  });
+
+  m_stats.pending--;
+  if (m_stopped)
+  {
+    m_stats.failed++;
+    return false;
+  }
+
+  m_stats.active++;
+  m_busyPaths.emplace_back(path);
+
+  auto it = std::find_if(m_idleSessions.begin(), m_idleSessions.end(),
+                         [&path](const auto& session) { return session->path == path; });
+  if (it != m_idleSessions.end())
+  {
+    session = std::move(*it);
+    m_idleSessions.erase(it);
+  }
+  return true;
+}
+
+void CDVDThumbExtractor::ReleaseSession(const std::string& path,
+                                        std::unique_ptr<Session> session)
+{
+  std::unique_ptr<Session> evicted;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_stats.active--;
+
+    auto it = std::find(m_busyPaths.begin(), m_busyPaths.end(), path);
+    if (it != m_busyPaths.end())
+      m_busyPaths.erase(it);
+
+    // on shutdown the session is closed right away
+    if (session && !m_stopped)
+    {
+      session->lastUsed = std::chrono::steady_clock::now();
+      m_idleSessions.emplace_back(std::move(session));
+
+      if (m_idleSessions.size() > MAX_IDLE_SESSIONS)
+      {
+        evicted = std::move(m_idleSessions.front());
+        m_idleSessions.erase(m_idleSessions.begin());
+      }
+
+      // the timer repeats until Deinitialize(), a one shot timer could be exiting right now
+      // and miss a restart
+      if (!m_timer.IsRunning())
+        m_timer.Start(SESSION_CHECK_INTERVAL, true);
+    }
+  }
+  m_condition.notifyAll();
+
+  // closing may block on network filesystems, do it unlocked
+  evicted.reset();
+}
+
+void CDVDThumbExtractor::CloseExpiredSessions(bool all)
+{
+  std::vector<std::unique_ptr<Session>> expired;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = m_idleSessions.begin(); it != m_idleSessions.end();)
+    {
+      if (all || now - (*it)->lastUsed >= SESSION_LINGER)
+      {
+        expired.emplace_back(std::move(*it));
+        it = m_idleSessions.erase(it);
+      }
+      else
+        ++it;
+    }
+
+    if (!all && !expired.empty() && m_idleSessions.empty() && m_stats.active == 0)
+    {
+      const auto busy = m_stats.busyTime.count();
+      CLog::LogF(LOGDEBUG,
+                 "extracted {} images ({} failed, {} from reused files) in {} ms, {:.1f} images/s",
+                 m_stats.extracted, m_stats.failed, m_stats.reused, busy,
+                 busy > 0 ? m_stats.extracted * 1000.0 / busy : 0.0);
+    }
+  }
+}
+
+void CDVDThumbExtractor::Flush()
+{
+  CloseExpiredSessions(true);
+}
+
+void CDVDThumbExtractor::OnTimeout()
+{
+  CloseExpiredSessions(false);
+}
+
+CDVDThumbExtractor::Stats CDVDThumbExtractor::GetStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_stats;
+}
+
+std::unique_ptr<CDVDThumbExtractor::Session> CDVDThumbExtractor::OpenSession(
+    const CFileItem& fileItem) const
+{
+  const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
+
+  auto session = std::make_unique<Session>();
+  session->path = fileItem.GetDynPath();
+
+  CFileItem item(fileItem);
+  item.SetMimeTypeForInternetFile();
+  session->inputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
+  if (!session->inputStream)
+  {
+    CLog::Log(LOGERROR, "InputStream: Error creating stream for {}", redactPath);
+    return {};
+  }
+
+  if (!session->inputStream->Open())
+  {
+    CLog::Log(LOGERROR, "InputStream: Error opening, {}", redactPath);
+    return {};
+  }
+
+  session->demuxer.reset(CDVDFactoryDemuxer::CreateDemuxer(session->inputStream, true));
+  if (!session->demuxer)
+  {
+    CLog::LogF(LOGERROR, "Error creating demuxer");
+    return {};
+  }
+
+  int64_t demuxerId = -1;
+  for (CDemuxStream* pStream : session->demuxer->GetStreams())
+  {
+    if (pStream)
+    {
+      // ignore if it's a picture attachment (e.g. jpeg artwork)
+      if (pStream->type == STREAM_VIDEO && !(pStream->flags & AV_DISPOSITION_ATTACHED_PIC))
+      {
+        session->videoStream = pStream->uniqueId;
+        demuxerId = pStream->demuxerId;
+      }
+      else
+        session->demuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
+    }
+  }
+
+  if (session->videoStream == -1)
+    return {};
+
+  session->processInfo.reset(CProcessInfo::CreateInstance());
+  std::vector<AVPixelFormat> pixFmts;
+  pixFmts.push_back(AV_PIX_FMT_YUV420P);
+  session->processInfo->SetPixFormats(pixFmts);
+
+  session->hint = CDVDStreamInfo(*session->demuxer->GetStream(demuxerId, session->videoStream), true);
+  session->hint.codecOptions = CODEC_FORCE_SOFTWARE | CODEC_KEYFRAMES_ONLY;
+
+  session->codec = CDVDFactoryCodec::CreateVideoCodec(session->hint, *session->processInfo);
+  if (!session->codec)
+    return {};
+
+  return session;
+}
+
+std::unique_ptr<CTexture> CDVDThumbExtractor::ExtractFromSession(Session& session,
+                                                                 int chapterNumber) const
+{
+  const std::string redactPath = CURL::GetRedacted(session.path);
+  CDVDDemux* demuxer = session.demuxer.get();
+  CDVDVideoCodec* videoCodec = session.codec.get();
+
+  // drop anything left over from a previous image of the same file
+  videoCodec->Reset();
+
+  int nTotalLen = demuxer->GetStreamLength();
+
+  bool seekToChapter = chapterNumber > 0 && demuxer->GetChapterCount() > 0;
+  int64_t nSeekTo = seekToChapter ? demuxer->GetChapterPos(chapterNumber) * 1000 : nTotalLen / 3;
+
+  // Seek to chapter @ 0 not likley to be a very useful result, use 5 sec instead.
+  if (seekToChapter && (nSeekTo == 0))
+    nSeekTo = 5000;
+
+  CLog::LogF(LOGDEBUG, "seeking to pos {}ms (total: {}ms) in {}", nSeekTo, nTotalLen, redactPath);
+
+  if (!demuxer->SeekTime(static_cast<double>(nSeekTo), true))
+    return {};
+
+  std::unique_ptr<CTexture> result{};
+  CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+  VideoPicture picture;
+  picture.Reset();
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  // non keyframes are discarded by the decoder, so this mostly costs demuxing
+  int packetsTried = 0;
+  int abort_index = demuxer->GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = demuxer->Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != session.videoStream || pPacket->isELPackage)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    videoCodec->AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
+    {
+      picture.Reset();
+      iDecoderState = videoCodec->GetPicture(&picture);
+    }
+
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    {
+      if (!(picture.iFlags & DVP_FLAG_DROPPED))
+        break;
+    }
+
+  } while (abort_index--);
+
+  if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
+  {
+    unsigned int nWidth =
+        std::min(picture.iDisplayWidth,
+                 CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+    double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+    if (session.hint.forced_aspect && session.hint.aspect != 0)
+      aspect = session.hint.aspect;
+    unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+    result = CTexture::CreateTexture(nWidth, nHeight);
+    result->SetAlpha(false);
+    struct SwsContext* context =
+        sws_getContext(picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P, nWidth, nHeight,
+                       AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
+
+    if (context)
+    {
+      uint8_t* planes[YuvImage::MAX_PLANES];
+      int stride[YuvImage::MAX_PLANES];
+      picture.videoBuffer->GetPlanes(planes);
+      picture.videoBuffer->GetStrides(stride);
+      uint8_t* src[4] = {planes[0], planes[1], planes[2], 0};
+      int srcStride[] = {stride[0], stride[1], stride[2], 0};
+      uint8_t* dst[] = {result->GetPixels(), 0, 0, 0};
+      int dstStride[] = {static_cast<int>(result->GetPitch()), 0, 0, 0};
+      result->SetOrientation(DegreeToOrientation(session.hint.orientation));
+      sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
+      sws_freeContext(context);
+    }
+  }
+  else
+  {
+    CLog::LogF(LOGDEBUG, "decode failed in {} after {} packets.", redactPath, packetsTried);
+  }
+  picture.Reset();
+
+  return result;
+}
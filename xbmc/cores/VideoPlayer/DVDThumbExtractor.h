@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Timer.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CFileItem;
+class CTexture;
+
+/*!
+ * \brief Extracts video thumbnails and chapter images
+ *
+ * Extraction seeks to the keyframe in front of the requested position and only
+ * decodes keyframes from there, so no GOP is decoded in full. The number of
+ * concurrent extractions is bounded, callers beyond the limit wait for a free
+ * slot. After an extraction the opened input stream, demuxer and decoder of a
+ * file are kept for a few seconds, so requesting all chapter images of a file
+ * only opens and probes it once.
+ */
+class CDVDThumbExtractor : public ITimerCallback
+{
+public:
+  struct Stats
+  {
+    uint64_t requested = 0; ///< extractions requested
+    uint64_t extracted = 0; ///< extractions that produced an image
+    uint64_t failed = 0; ///< extractions that failed
+    uint64_t reused = 0; ///< extractions served by an already opened file
+    unsigned int pending = 0; ///< extractions waiting for a slot
+    unsigned int active = 0; ///< extractions in progress
+    std::chrono::milliseconds busyTime{0}; ///< accumulated time spent extracting
+  };
+
+  CDVDThumbExtractor();
+  ~CDVDThumbExtractor() override;
+
+  /*!
+   * \brief Close all files and fail current and further requests, called on shutdown
+   */
+  void Deinitialize();
+
+  /*!
+   * \brief Extract a thumbnail, blocks until the image is available
+   * \param item the video file
+   * \param chapterNumber the chapter to take the image from, 0 for a position in the middle of the file
+   * \return the image or nullptr on failure or after Deinitialize()
+   */
+  std::unique_ptr<CTexture> Extract(const CFileItem& item, int chapterNumber = 0);
+
+  /*!
+   * \brief Close all files that are kept open for reuse
+   */
+  void Flush();
+
+  Stats GetStats() const;
+
+  // implementation of ITimerCallback
+  void OnTimeout() override;
+
+private:
+  struct Session;
+
+  std::unique_ptr<Session> OpenSession(const CFileItem& item) const;
+  std::unique_ptr<CTexture> ExtractFromSession(Session& session, int chapterNumber) const;
+
+  bool AcquireSession(const std::string& path, std::unique_ptr<Session>& session);
+  void ReleaseSession(const std::string& path, std::unique_ptr<Session> session);
+  void CloseExpiredSessions(bool all);
+
+  mutable CCriticalSection m_critSection;
+  XbmcThreads::ConditionVariable m_condition;
+  const unsigned int m_maxActive;
+  std::vector<std::unique_ptr<Session>> m_idleSessions;
+  std::vector<std::string> m_busyPaths;
+  Stats m_stats;
+  bool m_stopped = false;
+  CTimer m_timer;
+};
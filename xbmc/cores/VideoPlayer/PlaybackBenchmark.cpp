@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PlaybackBenchmark.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr auto SAMPLE_INTERVAL = 1s;
+} // unnamed namespace
+
+void CPlaybackBenchmark::CLevel::Add(int level)
+{
+  if (m_count == 0 || level < m_level.min)
+    m_level.min = level;
+  if (m_count == 0 || level > m_level.max)
+    m_level.max = level;
+
+  m_sum += level;
+  m_count++;
+  m_level.avg = static_cast<double>(m_sum) / m_count;
+}
+
+CPlaybackBenchmark::QueueLevel CPlaybackBenchmark::CLevel::Get() const
+{
+  return m_level;
+}
+
+uint64_t CPlaybackBenchmark::Advance(uint64_t& last, uint64_t current)
+{
+  const uint64_t delta = current >= last ? current - last : current;
+  last = current;
+  return delta;
+}
+
+void CPlaybackBenchmark::Sample(std::chrono::steady_clock::time_point now)
+{
+  if (m_samples > 0 && now - m_last < SAMPLE_INTERVAL)
+    return;
+
+  const CDataCacheCore::PlaybackStats stats = m_dataCache.GetPlaybackStats();
+  const int videoQueue = m_dataCache.GetVideoQueueLevel();
+  const int audioQueue = m_dataCache.GetAudioQueueLevel();
+
+  if (m_samples == 0)
+  {
+    // frames counted from here on, so the rates cover the time sampled
+    m_first = now;
+    m_lastStats = stats;
+  }
+  else
+  {
+    m_framesDecoded += Advance(m_lastStats.framesDecoded, stats.framesDecoded);
+    m_framesDropped += Advance(m_lastStats.framesDropped, stats.framesDropped);
+    m_framesRendered += Advance(m_lastStats.framesRendered, stats.framesRendered);
+    m_framesSkipped += Advance(m_lastStats.framesSkipped, stats.framesSkipped);
+  }
+
+  m_last = now;
+  m_samples++;
+
+  const double syncError = std::abs(stats.avSyncError);
+  m_sumAVSyncError += syncError;
+  m_maxAVSyncError = std::max(m_maxAVSyncError, syncError);
+  m_videoQueue.Add(videoQueue);
+  m_audioQueue.Add(audioQueue);
+  m_renderQueue.Add(stats.renderQueueLevel);
+
+  CLog::Log(LOGINFO,
+            "CPlaybackBenchmark - decoded:{} dropped:{} rendered:{} late:{} a/v:{:.3f}s "
+            "vq:{}% aq:{}% rq:{}",
+            m_framesDecoded, m_framesDropped, m_framesRendered, m_framesSkipped,
+            stats.avSyncError, videoQueue, audioQueue, stats.renderQueueLevel);
+}
+
+CPlaybackBenchmark::Result CPlaybackBenchmark::GetResult() const
+{
+  Result result;
+  if (m_samples == 0)
+    return result;
+
+  result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(m_last - m_first);
+  result.samples = m_samples;
+  result.framesDecoded = m_framesDecoded;
+  result.framesDropped = m_framesDropped;
+  result.framesRendered = m_framesRendered;
+  result.framesSkipped = m_framesSkipped;
+
+  const double seconds = std::chrono::duration<double>(m_last - m_first).count();
+  if (seconds > 0.0)
+  {
+    result.decodeFps = m_framesDecoded / seconds;
+    result.renderFps = m_framesRendered / seconds;
+  }
+
+  result.avgAVSyncError = m_sumAVSyncError / m_samples;
+  result.maxAVSyncError = m_maxAVSyncError;
+  result.videoQueue = m_videoQueue.Get();
+  result.audioQueue = m_audioQueue.Get();
+  result.renderQueue = m_renderQueue.Get();
+  return result;
+}
+
+void CPlaybackBenchmark::Report() const
+{
+  const Result result = GetResult();
+  if (result.samples == 0)
+    return;
+
+  CLog::Log(LOGINFO,
+            "CPlaybackBenchmark - {} ms: decoded {} frames ({:.2f} fps), rendered {} ({:.2f} fps), "
+            "dropped {}, late {}",
+            result.duration.count(), result.framesDecoded, result.decodeFps, result.framesRendered,
+            result.renderFps, result.framesDropped, result.framesSkipped);
+  CLog::Log(LOGINFO, "CPlaybackBenchmark - a/v sync error avg {:.3f}s max {:.3f}s",
+            result.avgAVSyncError, result.maxAVSyncError);
+  CLog::Log(LOGINFO,
+            "CPlaybackBenchmark - queues min/avg/max: video {}/{:.0f}/{}%, audio {}/{:.0f}/{}%, "
+            "render {}/{:.1f}/{}",
+            result.videoQueue.min, result.videoQueue.avg, result.videoQueue.max,
+            result.audioQueue.min, result.audioQueue.avg, result.audioQueue.max,
+            result.renderQueue.min, result.renderQueue.avg, result.renderQueue.max);
+}
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/DataCacheCore.h"
+
+#include <chrono>
+#include <stdint.h>
+
+/*!
+ * \brief Samples the player state in the data cache while a file plays and sums it up
+ *
+ * The video player runs it when the null renderer is enabled in advanced settings,
+ * so a playback started with that setting, e.g. from the command line on a build
+ * server, logs the decode rate, dropped and late frames, A/V sync error and the
+ * levels of the demux (audio and video message queues) and render queues once
+ * a second and a summary when the playback ends.
+ */
+class CPlaybackBenchmark
+{
+public:
+  struct QueueLevel
+  {
+    int min = 0;
+    int max = 0;
+    double avg = 0.0;
+  };
+
+  struct Result
+  {
+    std::chrono::milliseconds duration{0}; //!< time between the first and last sample
+    unsigned int samples = 0;
+    uint64_t framesDecoded = 0;
+    uint64_t framesDropped = 0;
+    uint64_t framesRendered = 0;
+    uint64_t framesSkipped = 0;
+    double decodeFps = 0.0;
+    double renderFps = 0.0;
+    double avgAVSyncError = 0.0; //!< mean of the absolute error in seconds
+    double maxAVSyncError = 0.0; //!< largest absolute error in seconds
+    QueueLevel videoQueue; //!< percent
+    QueueLevel audioQueue; //!< percent
+    QueueLevel renderQueue; //!< pictures
+  };
+
+  explicit CPlaybackBenchmark(CDataCacheCore& dataCache) : m_dataCache(dataCache) {}
+
+  /*!
+   * \brief Take a sample if the last one is at least a second old
+   */
+  void Sample() { Sample(std::chrono::steady_clock::now()); }
+  void Sample(std::chrono::steady_clock::time_point now);
+
+  Result GetResult() const;
+
+  /*!
+   * \brief Log the result of all samples taken
+   */
+  void Report() const;
+
+private:
+  class CLevel
+  {
+  public:
+    void Add(int level);
+    QueueLevel Get() const;
+
+  private:
+    QueueLevel m_level;
+    int64_t m_sum = 0;
+    unsigned int m_count = 0;
+  };
+
+  static uint64_t Advance(uint64_t& last, uint64_t current);
+
+  CDataCacheCore& m_dataCache;
+
+  std::chrono::steady_clock::time_point m_first;
+  std::chrono::steady_clock::time_point m_last;
+  unsigned int m_samples = 0;
+
+  // counters restart when the player reopens a stream, these are summed up across reopens
+  CDataCacheCore::PlaybackStats m_lastStats;
+  uint64_t m_framesDecoded = 0;
+  uint64_t m_framesDropped = 0;
+  uint64_t m_framesRendered = 0;
+  uint64_t m_framesSkipped = 0;
+
+  double m_sumAVSyncError = 0.0;
+  double m_maxAVSyncError = 0.0;
+  CLevel m_videoQueue;
+  CLevel m_audioQueue;
+  CLevel m_renderQueue;
+};
@@ -680,6 +680,18 @@ int64_t CProcessInfo::GetMaxTime()
   return m_timeMax;
 }
 
+void CProcessInfo::SetDemuxOpenTime(std::chrono::milliseconds time)
+{
+  if (m_dataCache)
+    m_dataCache->SetDemuxOpenTime(time);
+}
+
+void CProcessInfo::SetStartLatency(std::chrono::milliseconds time)
+{
+  if (m_dataCache)
+    m_dataCache->SetStartLatency(time);
+}
+
 //******************************************************************************
 // settings
 //******************************************************************************
@@ -16,6 +16,7 @@
 #include "threads/CriticalSection.h"
 
 #include <atomic>
+#include <chrono>
 #include <list>
 #include <map>
 #include <string>
@@ -116,6 +117,9 @@ public:
   void SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max);
   int64_t GetMaxTime();
 
+  void SetDemuxOpenTime(std::chrono::milliseconds time);
+  void SetStartLatency(std::chrono::milliseconds time);
+
   // settings
   CVideoSettings GetVideoSettings();
   void SetVideoSettings(CVideoSettings &settings);
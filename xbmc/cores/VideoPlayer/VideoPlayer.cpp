@@ -26,6 +26,7 @@
 #include "FileItem.h"
 #include "GUIUserMessages.h"
 #include "LangInfo.h"
+#include "PlaybackBenchmark.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "Util.h"
@@ -58,6 +59,7 @@
 #include "utils/StreamDetails.h"
 #include "utils/StreamUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -1036,6 +1038,7 @@ void CVideoPlayer::OpenDefaultStreams(bool reset)
 
 bool CVideoPlayer::ReadPacket(DemuxPacket*& packet, CDemuxStream*& stream)
 {
+  KODI_TRACE_SCOPE("player", "CVideoPlayer::ReadPacket");
 
   // check if we should read from subtitle demuxer
   if (m_pSubtitleDemuxer && m_VideoPlayerSubtitle->AcceptsData())
@@ -1226,6 +1229,7 @@ void CVideoPlayer::CheckBetterStream(CCurrentStream& current, CDemuxStream* stre
 
 void CVideoPlayer::Prepare()
 {
+  m_prepareStart = std::chrono::steady_clock::now();
   CFFmpegLog::SetLogLevel(1);
   SetPlaySpeed(DVD_PLAYSPEED_NORMAL);
   m_processInfo->SetSpeed(1.0);
@@ -1271,12 +1275,16 @@ void CVideoPlayer::Prepare()
     }
   }
 
+  const auto demuxStart = std::chrono::steady_clock::now();
   if (!OpenDemuxStream())
   {
     m_bAbortRequest = true;
     m_error = true;
     return;
   }
+  m_processInfo->SetDemuxOpenTime(std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - demuxStart));
+
   // give players a chance to reconsider now codecs are known
   CreatePlayers();
 
@@ -1375,6 +1383,9 @@ void CVideoPlayer::Process()
 
   CServiceBroker::GetWinSystem()->RegisterRenderLoop(this);
 
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoNullRenderer > 0)
+    m_playbackBenchmark = std::make_unique<CPlaybackBenchmark>(CServiceBroker::GetDataCacheCore());
+
   Prepare();
 
   while (!m_bAbortRequest)
@@ -1435,6 +1446,9 @@ void CVideoPlayer::Process()
     // update player state
     UpdatePlayState(200);
 
+    if (m_playbackBenchmark)
+      m_playbackBenchmark->Sample();
+
     // make sure we run subtitle process here
     m_VideoPlayerSubtitle->Process(m_clock.GetClock() + m_State.time_offset - m_VideoPlayerVideo->GetSubtitleDelay(), m_State.time_offset);
 
@@ -1652,6 +1666,8 @@ bool CVideoPlayer::CheckIsCurrent(const CCurrentStream& current,
 
 void CVideoPlayer::ProcessPacket(CDemuxStream* pStream, DemuxPacket* pPacket)
 {
+  KODI_TRACE_SCOPE("player", "CVideoPlayer::ProcessPacket");
+
   // process packet if it belongs to selected stream.
   // for dvd's don't allow automatic opening of streams*/
 
@@ -2127,6 +2143,11 @@ void CVideoPlayer::HandlePlaySpeed()
           CServiceBroker::GetAppMessenger()->PostMsg(TMSG_SWITCHTOFULLSCREEN);
         }
 
+        const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_prepareStart);
+        m_processInfo->SetStartLatency(latency);
+        CLog::Log(LOGDEBUG, "VideoPlayer::HandlePlaySpeed - playback started after {} ms", latency.count());
+
         IPlayerCallback *cb = &m_callback;
         CFileItem fileItem = m_item;
         m_outboundEvents->Submit([=]() {
@@ -2575,6 +2596,12 @@ void CVideoPlayer::OnExit()
   // subtitles are added from video player. after video player has finished, overlays have to be cleared.
   CloseStream(m_CurrentSubtitle, false);  // clear overlay container
 
+  if (m_playbackBenchmark)
+  {
+    m_playbackBenchmark->Report();
+    m_playbackBenchmark.reset();
+  }
+
   CServiceBroker::GetWinSystem()->UnregisterRenderLoop(this);
 
   IPlayerCallback *cb = &m_callback;
@@ -96,6 +96,7 @@ class CDemuxStreamVideo;
 class CDemuxStreamAudio;
 class CStreamInfo;
 class CDVDDemuxCC;
+class CPlaybackBenchmark;
 class CVideoPlayer;
 
 #define DVDSTATE_NORMAL           0x00000001 // normal dvd state
@@ -493,6 +494,7 @@ protected:
   XbmcThreads::EndTime<> m_cachingTimer;
 
   std::unique_ptr<CProcessInfo> m_processInfo;
+  std::unique_ptr<CPlaybackBenchmark> m_playbackBenchmark;
 
   CCurrentStream m_CurrentAudio;
   CCurrentStream m_CurrentVideo;
@@ -584,6 +586,7 @@ protected:
   SPlayerState m_State;
   mutable CCriticalSection m_StateSection;
   XbmcThreads::EndTime<> m_syncTimer;
+  std::chrono::steady_clock::time_point m_prepareStart; ///< start of Prepare(), for start latency
 
   CEdl m_Edl;
   bool m_SkipCommercials;
@@ -237,6 +237,7 @@ void CVideoPlayerAudio::UpdatePlayerInfo()
   m_dataCacheCore.SetAudioLiveBitRate(m_audioStats.GetBitrate());  
   m_dataCacheCore.SetAudioQueueLevel(std::min(99,m_messageQueue.GetLevel()));
   m_dataCacheCore.SetAudioQueueDataLevel(std::min(99,m_messageQueue.GetLevel(true)));
+  m_dataCacheCore.SetAVSyncError(m_audioSink.GetSyncError() / DVD_TIME_BASE);
 }
 
 void CVideoPlayerAudio::Process()
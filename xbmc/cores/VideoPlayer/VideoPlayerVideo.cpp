@@ -18,6 +18,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/MathUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -75,6 +76,7 @@ CVideoPlayerVideo::CVideoPlayerVideo(CDVDClock* pClock
   m_messageQueue.SetMaxTimeSize(8.0);
 
   m_iDroppedFrames = 0;
+  m_iDecodedFrames = 0;
   m_fFrameRate = 25;
   m_fStableFrameRate = 0.0;
   m_iFrameRateCount = 0;
@@ -355,6 +357,7 @@ void CVideoPlayerVideo::Process()
   m_videoStats.Start();
   m_droppingStats.Reset();
   m_iDroppedFrames = 0;
+  m_iDecodedFrames = 0;
   m_rewindStalled = false;
   m_outputSate = OUTPUT_NORMAL;
 
@@ -622,7 +625,13 @@ void CVideoPlayerVideo::Process()
         codecControl |= DVD_CODEC_CTRL_ROTATE;
       m_pVideoCodec->SetCodecControl(codecControl);
 
-      if (m_pVideoCodec->AddData(*pPacket))
+      bool added;
+      {
+        KODI_TRACE_SCOPE("video", "CDVDVideoCodec::AddData");
+        added = m_pVideoCodec->AddData(*pPacket);
+      }
+
+      if (added)
       {
         // buffer packets so we can recover should decoder flush for some reason
         if (m_pVideoCodec->GetConvergeCount() > 0)
@@ -665,10 +674,13 @@ void CVideoPlayerVideo::UpdatePlayerInfo()
   m_dataCacheCore.SetVideoLiveBitRate(GetVideoBitrate());  
   m_dataCacheCore.SetVideoQueueLevel(std::min(99, m_messageQueue.GetLevel()));
   m_dataCacheCore.SetVideoQueueDataLevel(std::min(99, m_messageQueue.GetLevel(true)));
+  m_dataCacheCore.SetVideoFrameCounts(m_iDecodedFrames, m_iDroppedFrames);
 }
 
 bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
 {
+  KODI_TRACE_SCOPE("video", "CVideoPlayerVideo::ProcessDecoderOutput");
+
   CDVDVideoCodec::VCReturn decoderState = m_pVideoCodec->GetPicture(&m_picture);
 
   if (decoderState == CDVDVideoCodec::VC_BUFFER)
@@ -735,6 +747,7 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
   if (decoderState == CDVDVideoCodec::VC_PICTURE)
   {
     bool hasTimestamp = true;
+    m_iDecodedFrames++;
 
     if (m_processInfo.GetVideoInterlaced() &&
         MathUtils::FloatEquals(static_cast<float>(m_picture.iDuration), static_cast<float>(2 * DVD_TIME_BASE) / m_processInfo.GetVideoFps(), 700.0f))
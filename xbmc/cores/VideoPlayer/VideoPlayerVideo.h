@@ -112,6 +112,7 @@ protected:
   int m_retryProgressive;
   int m_iLateFrames;
   int m_iDroppedFrames;
+  int m_iDecodedFrames;
   int m_iDroppedRequest;
 
   double m_fFrameRate;       //framerate of the video currently playing
@@ -14,6 +14,7 @@
 #include "VideoShaders/ShaderFormats.h"
 #include "cores/IPlayer.h"
 #include "cores/VideoPlayer/Buffers/VideoBuffer.h"
+#include "settings/lib/SettingHandle.h"
 #include "utils/Geometry.h"
 
 #include <utility>
@@ -145,4 +146,6 @@ protected:
 
 private:
   bool m_alwaysClip = false;
+  CSettingIntHandle m_stretch43;
+  CSettingIntHandle m_errorInAspect;
 };
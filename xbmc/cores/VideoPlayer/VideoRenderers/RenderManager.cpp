@@ -13,6 +13,7 @@
 #include "RenderCapture.h"
 #include "RenderFactory.h"
 #include "RenderFlags.h"
+#include "RendererNull.h"
 #include "ServiceBroker.h"
 #include "application/Application.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
@@ -24,6 +25,7 @@
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
@@ -278,6 +280,8 @@ bool CRenderManager::IsPresenting()
 
 void CRenderManager::FrameMove()
 {
+  KODI_TRACE_SCOPE("render", "CRenderManager::FrameMove");
+
   bool firstFrame = false;
   UpdateResolution();
 
@@ -319,6 +323,14 @@ void CRenderManager::FrameMove()
       m_presentevent.notifyAll();
     }
 
+    // nothing is drawn for the null renderer, the frame is done once presented. Render
+    // isn't called at all when the GUI isn't rendered, e.g. with the null window system
+    if (m_nullRenderer && (m_presentstep == PRESENT_FRAME || m_presentstep == PRESENT_FRAME2))
+    {
+      m_presentstep = m_queued.empty() ? PRESENT_IDLE : PRESENT_READY;
+      m_presentevent.notifyAll();
+    }
+
     // release all previous
     for (std::deque<int>::iterator it = m_discard.begin(); it != m_discard.end(); )
     {
@@ -371,6 +383,7 @@ void CRenderManager::PreInit()
 
   m_QueueSize   = 2;
   m_QueueSkip   = 0;
+  m_presentCount = 0;
   m_presentstep = PRESENT_IDLE;
   m_bRenderGUI = true;
 
@@ -470,6 +483,17 @@ void CRenderManager::CreateRenderer()
     if (m_pConfigPicture)
       buffer = m_pConfigPicture->videoBuffer;
 
+    // the null renderer isn't in the factory, it's used when asked for or when there's no other
+    const int nullRenderer =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoNullRenderer;
+    m_nullRenderer = nullRenderer > 0;
+    m_presentAll = nullRenderer == 2;
+    if (m_nullRenderer)
+    {
+      m_pRenderer = new CRendererNull();
+      return;
+    }
+
     auto renderers = VIDEOPLAYER::CRendererFactory::GetRenderers();
     for (auto &id : renderers)
     {
@@ -483,6 +507,12 @@ void CRenderManager::CreateRenderer()
       }
     }
     m_pRenderer = VIDEOPLAYER::CRendererFactory::CreateRenderer("default", buffer);
+    if (!m_pRenderer && renderers.empty())
+    {
+      // the window system registered no renderers, e.g. the null window system
+      m_pRenderer = new CRendererNull();
+      m_nullRenderer = true;
+    }
   }
 }
 
@@ -698,6 +728,8 @@ RESOLUTION CRenderManager::GetResolution()
 
 void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
 {
+  KODI_TRACE_SCOPE("render", "CRenderManager::Render");
+
   CSingleExit exitLock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   {
@@ -993,6 +1025,8 @@ void CRenderManager::SetSubtitleVerticalPosition(int value, bool save)
 
 bool CRenderManager::AddVideoPicture(const VideoPicture& picture, volatile std::atomic_bool& bStop, EINTERLACEMETHOD deintMethod, bool wait)
 {
+  KODI_TRACE_SCOPE("render", "CRenderManager::AddVideoPicture");
+
   std::unique_lock<CCriticalSection> lock(m_presentlock);
 
   if (m_free.empty())
@@ -1169,6 +1203,8 @@ void CRenderManager::UpdateAudioLatencyTweak(double audioLatency)
 
 void CRenderManager::PrepareNextRender()
 {
+  KODI_TRACE_SCOPE("render", "CRenderManager::PrepareNextRender");
+
   if (m_queued.empty())
   {
     CLog::Log(LOGERROR, "CRenderManager::PrepareNextRender - asked to prepare with nothing available");
@@ -1237,13 +1273,13 @@ void CRenderManager::PrepareNextRender()
     combined = true;
   }
  
-  if (renderPts >= nextFramePts || m_forceNext)
+  if (renderPts >= nextFramePts || m_forceNext || m_presentAll)
   {
     // push back present source index before other lates to keep order
     if (m_presentstarted) m_discard.push_back(m_presentsource);
 
     double diff = (renderPts - nextFramePts);
-    while (diff > 62000 && m_queued.size() > 2)
+    while (diff > 62000 && m_queued.size() > 2 && !m_presentAll)
     {
       // skip late frames if possible; if the queue is almost empty, we don't skip
       // even if we should to avoid emptying the queue too fast
@@ -1266,6 +1302,7 @@ void CRenderManager::PrepareNextRender()
     m_presentstarted = true;
     m_queued.pop_front();
     m_presentpts = m_Queue[m_presentsource].pts;
+    m_presentCount++;
     m_presentevent.notifyAll();
 
   }
@@ -1278,10 +1315,13 @@ void CRenderManager::PrepareNextRender()
     m_presentstarted = true;
     m_queued.pop_front();
     m_presentpts = m_Queue[m_presentsource].pts - frametime / 2;
+    m_presentCount++;
     m_presentevent.notifyAll();
   }
 
   if (m_presentstarted) m_dataCacheCore.SetRenderPts(m_Queue[m_presentsource].pts);
+  m_dataCacheCore.SetRenderFrameCounts(m_presentCount, m_QueueSkip,
+                                       static_cast<int>(m_queued.size()));
 
 }
 
@@ -202,6 +202,9 @@ protected:
 
   int m_QueueSize = 2;
   int m_QueueSkip = 0;
+  uint64_t m_presentCount = 0; ///< frames presented since PreInit
+  bool m_nullRenderer = false; ///< the pictures are not drawn, nothing calls Render
+  bool m_presentAll = false; ///< present every queued picture, don't skip late ones
 
   struct SPresent
   {
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RendererNull.h"
+
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodec.h"
+#include "utils/log.h"
+
+CRendererNull::~CRendererNull()
+{
+  ReleaseBuffers();
+}
+
+bool CRendererNull::Configure(const VideoPicture& picture, float fps, unsigned int orientation)
+{
+  m_sourceWidth = picture.iWidth;
+  m_sourceHeight = picture.iHeight;
+  m_renderOrientation = orientation;
+  m_fps = fps;
+  m_format = picture.videoBuffer ? picture.videoBuffer->GetFormat() : AV_PIX_FMT_NONE;
+
+  CalculateFrameAspectRatio(picture.iDisplayWidth, picture.iDisplayHeight);
+  SetViewMode(m_videoSettings.m_ViewMode);
+
+  CLog::Log(LOGINFO, "CRendererNull::Configure - {}x{} {:.3f} fps, video is not drawn",
+            m_sourceWidth, m_sourceHeight, m_fps);
+
+  m_configured = true;
+  return true;
+}
+
+void CRendererNull::AddVideoPicture(const VideoPicture& picture, int index)
+{
+  if (m_buffers[index])
+    m_buffers[index]->Release();
+
+  m_buffers[index] = picture.videoBuffer;
+  if (m_buffers[index])
+    m_buffers[index]->Acquire();
+}
+
+void CRendererNull::UnInit()
+{
+  ReleaseBuffers();
+  m_configured = false;
+}
+
+bool CRendererNull::Flush(bool saveBuffers)
+{
+  if (!saveBuffers)
+    ReleaseBuffers();
+
+  return saveBuffers;
+}
+
+void CRendererNull::ReleaseBuffer(int idx)
+{
+  if (m_buffers[idx])
+  {
+    m_buffers[idx]->Release();
+    m_buffers[idx] = nullptr;
+  }
+}
+
+CRenderInfo CRendererNull::GetRenderInfo()
+{
+  CRenderInfo info;
+  info.max_buffer_size = NUM_BUFFERS;
+  return info;
+}
+
+bool CRendererNull::Supports(ERENDERFEATURE feature) const
+{
+  // same as the GL renderer, so the player does the same work on the pictures
+  return feature == RENDERFEATURE_ZOOM || feature == RENDERFEATURE_STRETCH ||
+         feature == RENDERFEATURE_NONLINSTRETCH || feature == RENDERFEATURE_PIXEL_RATIO ||
+         feature == RENDERFEATURE_VERTICAL_SHIFT || feature == RENDERFEATURE_ROTATION;
+}
+
+void CRendererNull::ReleaseBuffers()
+{
+  for (int i = 0; i < NUM_BUFFERS; i++)
+    ReleaseBuffer(i);
+}
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "BaseRenderer.h"
+
+/*!
+ \brief Renderer that takes the pictures of the player without drawing them
+
+ The decoded pictures go through the render manager as usual, but nothing is
+ uploaded or drawn. It isn't in the renderer factory, the render manager
+ creates it when the window system registered no renderers, e.g. the null window
+ system, or when enabled with <video><nullrenderer> in advancedsettings.xml or
+ --playback-benchmark, for measuring demux and decode performance independent
+ of the GPU: 1 presents the pictures according to the clock, 2 presents every
+ queued picture on the next render pass and skips none for being late. Both
+ are paced by the player and the render loop, decoding doesn't run ahead
+ of playback.
+ */
+class CRendererNull : public CBaseRenderer
+{
+public:
+  CRendererNull() = default;
+  ~CRendererNull() override;
+
+  // Player functions
+  bool Configure(const VideoPicture& picture, float fps, unsigned int orientation) override;
+  bool IsConfigured() override { return m_configured; }
+  void AddVideoPicture(const VideoPicture& picture, int index) override;
+  void UnInit() override;
+  bool Flush(bool saveBuffers) override;
+  void ReleaseBuffer(int idx) override;
+  CRenderInfo GetRenderInfo() override;
+  void Update() override {}
+  void RenderUpdate(
+      int index, int index2, bool clear, unsigned int flags, unsigned int alpha) override
+  {
+  }
+  bool RenderCapture(int index, CRenderCapture* capture) override { return false; }
+  bool ConfigChanged(const VideoPicture& picture) override { return false; }
+
+  // Feature support
+  bool SupportsMultiPassRendering() override { return false; }
+  bool Supports(ERENDERFEATURE feature) const override;
+  bool Supports(ESCALINGMETHOD method) const override { return false; }
+
+private:
+  void ReleaseBuffers();
+
+  bool m_configured = false;
+  CVideoBuffer* m_buffers[NUM_BUFFERS] = {};
+};
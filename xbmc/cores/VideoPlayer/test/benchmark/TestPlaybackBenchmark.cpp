@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/DataCacheCore.h"
+#include "cores/VideoPlayer/PlaybackBenchmark.h"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+class TestPlaybackBenchmark : public ::testing::Test
+{
+protected:
+  CDataCacheCore m_dataCache;
+  CPlaybackBenchmark m_benchmark{m_dataCache};
+  const std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+};
+
+TEST_F(TestPlaybackBenchmark, NoSamples)
+{
+  const CPlaybackBenchmark::Result result = m_benchmark.GetResult();
+  EXPECT_EQ(0u, result.samples);
+  EXPECT_EQ(0u, result.framesDecoded);
+  EXPECT_EQ(0.0, result.decodeFps);
+}
+
+TEST_F(TestPlaybackBenchmark, FrameRates)
+{
+  m_dataCache.SetVideoFrameCounts(10, 0);
+  m_dataCache.SetRenderFrameCounts(5, 0, 2);
+  m_benchmark.Sample(m_start);
+
+  m_dataCache.SetVideoFrameCounts(110, 3);
+  m_dataCache.SetRenderFrameCounts(85, 1, 4);
+  m_benchmark.Sample(m_start + 2s);
+
+  const CPlaybackBenchmark::Result result = m_benchmark.GetResult();
+  EXPECT_EQ(2u, result.samples);
+  EXPECT_EQ(2000, result.duration.count());
+  EXPECT_EQ(100u, result.framesDecoded);
+  EXPECT_EQ(3u, result.framesDropped);
+  EXPECT_EQ(80u, result.framesRendered);
+  EXPECT_EQ(1u, result.framesSkipped);
+  EXPECT_DOUBLE_EQ(50.0, result.decodeFps);
+  EXPECT_DOUBLE_EQ(40.0, result.renderFps);
+  EXPECT_EQ(2, result.renderQueue.min);
+  EXPECT_EQ(4, result.renderQueue.max);
+  EXPECT_DOUBLE_EQ(3.0, result.renderQueue.avg);
+}
+
+TEST_F(TestPlaybackBenchmark, OneSampleASecond)
+{
+  m_benchmark.Sample(m_start);
+  m_benchmark.Sample(m_start + 500ms);
+  m_benchmark.Sample(m_start + 999ms);
+  EXPECT_EQ(1u, m_benchmark.GetResult().samples);
+
+  m_benchmark.Sample(m_start + 1s);
+  EXPECT_EQ(2u, m_benchmark.GetResult().samples);
+}
+
+TEST_F(TestPlaybackBenchmark, CountersRestart)
+{
+  m_dataCache.SetVideoFrameCounts(100, 0);
+  m_benchmark.Sample(m_start);
+  m_dataCache.SetVideoFrameCounts(150, 0);
+  m_benchmark.Sample(m_start + 1s);
+
+  // the player reopened the video stream
+  m_dataCache.SetVideoFrameCounts(20, 0);
+  m_benchmark.Sample(m_start + 2s);
+
+  EXPECT_EQ(70u, m_benchmark.GetResult().framesDecoded);
+}
+
+TEST_F(TestPlaybackBenchmark, SyncErrorAndQueues)
+{
+  m_dataCache.SetAVSyncError(-0.2);
+  m_dataCache.SetVideoQueueLevel(80);
+  m_dataCache.SetAudioQueueLevel(40);
+  m_benchmark.Sample(m_start);
+
+  m_dataCache.SetAVSyncError(0.1);
+  m_dataCache.SetVideoQueueLevel(20);
+  m_dataCache.SetAudioQueueLevel(60);
+  m_benchmark.Sample(m_start + 1s);
+
+  const CPlaybackBenchmark::Result result = m_benchmark.GetResult();
+  EXPECT_DOUBLE_EQ(0.2, result.maxAVSyncError);
+  EXPECT_NEAR(0.15, result.avgAVSyncError, 1e-9);
+  EXPECT_EQ(20, result.videoQueue.min);
+  EXPECT_EQ(80, result.videoQueue.max);
+  EXPECT_DOUBLE_EQ(50.0, result.videoQueue.avg);
+  EXPECT_EQ(40, result.audioQueue.min);
+  EXPECT_EQ(60, result.audioQueue.max);
+}
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "cores/VideoPlayer/DVDThumbExtractor.h"
+#include "filesystem/File.h"
+#include "guilib/Texture.h"
+#include "test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+class TestDVDThumbExtractor : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_file = XBMC_CREATETEMPFILE(".mkv");
+    ASSERT_NE(nullptr, m_file);
+    const char data[] = "not really a matroska file";
+    m_file->Write(data, sizeof(data));
+    m_file->Flush();
+    m_path = XBMC_TEMPFILEPATH(m_file);
+  }
+
+  void TearDown() override { XBMC_DELETETEMPFILE(m_file); }
+
+  XFILE::CFile* m_file = nullptr;
+  std::string m_path;
+};
+
+TEST_F(TestDVDThumbExtractor, NotExtractable)
+{
+  CDVDThumbExtractor extractor;
+
+  CFileItem folder(m_path, true);
+  EXPECT_EQ(nullptr, extractor.Extract(folder));
+  CFileItem playlist("/home/user/videos.m3u", false);
+  EXPECT_EQ(nullptr, extractor.Extract(playlist));
+
+  // turned down before asking for a slot
+  EXPECT_EQ(0u, extractor.GetStats().requested);
+}
+
+TEST_F(TestDVDThumbExtractor, BrokenFile)
+{
+  CDVDThumbExtractor extractor;
+
+  CFileItem item(m_path, false);
+  EXPECT_EQ(nullptr, extractor.Extract(item));
+  EXPECT_EQ(nullptr, extractor.Extract(item, 2));
+
+  // a failed file isn't kept open, the second request opens it again
+  const CDVDThumbExtractor::Stats stats = extractor.GetStats();
+  EXPECT_EQ(2u, stats.requested);
+  EXPECT_EQ(0u, stats.extracted);
+  EXPECT_EQ(2u, stats.failed);
+  EXPECT_EQ(0u, stats.reused);
+  EXPECT_EQ(0u, stats.pending);
+  EXPECT_EQ(0u, stats.active);
+}
+
+TEST_F(TestDVDThumbExtractor, Deinitialize)
+{
+  CDVDThumbExtractor extractor;
+  extractor.Deinitialize();
+
+  CFileItem item(m_path, false);
+  EXPECT_EQ(nullptr, extractor.Extract(item));
+  EXPECT_EQ(0u, extractor.GetStats().requested);
+
+  // a second call, as the destructor does, is harmless
+  extractor.Deinitialize();
+}
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dbiplus
+{
+
+/*!
+ \brief Idle connections of closed databases, kept for the next connect()
+
+ Only the bookkeeping, the pool never checks or closes a connection itself. The
+ connections it hands back from Acquire(), TakeExpired() and TakeAll() are the
+ caller's again, and whatever closing them involves, e.g. a goodbye to the
+ server, happens outside the pool's lock.
+ */
+template<typename Connection>
+class CConnectionPool
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   \param maxPerKey idle connections kept per key
+   \param timeout time after which an idle connection is expired
+   */
+  CConnectionPool(size_t maxPerKey, Clock::duration timeout)
+    : m_maxPerKey(maxPerKey), m_timeout(timeout)
+  {
+  }
+
+  /*!
+   \brief Take the connection of a key released last, unless it has expired
+   \return false if there is none
+   */
+  bool Acquire(const std::string& key, Connection& connection, Clock::time_point now = Clock::now())
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    auto it = m_connections.find(key);
+    if (it == m_connections.end() || it->second.empty() ||
+        it->second.back().released + m_timeout < now)
+      return false;
+
+    connection = it->second.back().connection;
+    it->second.pop_back();
+    return true;
+  }
+
+  /*!
+   \brief Keep a connection for the next Acquire() of its key
+   \return false if the key has enough idle connections already, the connection stays the caller's
+   */
+  bool Release(const std::string& key,
+               const Connection& connection,
+               Clock::time_point now = Clock::now())
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    std::vector<Idle>& connections = m_connections[key];
+    if (connections.size() >= m_maxPerKey)
+      return false;
+    connections.push_back({connection, now});
+    return true;
+  }
+
+  /*!
+   \brief Take the connections idle for longer than the timeout
+   */
+  std::vector<Connection> TakeExpired(Clock::time_point now = Clock::now())
+  {
+    std::vector<Connection> expired;
+    std::unique_lock<CCriticalSection> lock(m_section);
+    for (auto& connections : m_connections)
+    {
+      // released in order, the expired ones are at the front
+      auto& list = connections.second;
+      const auto it = std::find_if(list.begin(), list.end(), [this, &now](const Idle& idle) {
+        return idle.released + m_timeout >= now;
+      });
+      for (auto expiredIt = list.begin(); expiredIt != it; ++expiredIt)
+        expired.push_back(expiredIt->connection);
+      list.erase(list.begin(), it);
+    }
+    return expired;
+  }
+
+  /*!
+   \brief Take all idle connections, e.g. to close them on shutdown
+   */
+  std::vector<Connection> TakeAll()
+  {
+    std::vector<Connection> all;
+    std::unique_lock<CCriticalSection> lock(m_section);
+    for (auto& connections : m_connections)
+    {
+      for (const Idle& idle : connections.second)
+        all.push_back(idle.connection);
+    }
+    m_connections.clear();
+    return all;
+  }
+
+private:
+  struct Idle
+  {
+    Connection connection;
+    Clock::time_point released;
+  };
+
+  const size_t m_maxPerKey;
+  const Clock::duration m_timeout;
+
+  CCriticalSection m_section;
+  std::map<std::string, std::vector<Idle>> m_connections;
+};
+
+} // namespace dbiplus
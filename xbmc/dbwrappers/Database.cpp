@@ -816,6 +816,43 @@ void CDatabase::UpdateVersionNumber()
   m_pDS->exec(strSQL);
 }
 
+void CDatabase::CloseIdleConnections()
+{
+#if defined(HAS_MYSQL) || defined(HAS_MARIADB)
+  MysqlDatabase::close_idle_connections();
+#endif
+}
+
+std::string CDatabase::GetTriggerSQL(bool sqlite,
+                                     const std::string& name,
+                                     const std::string& event,
+                                     const std::string& table,
+                                     const std::string& condition,
+                                     const std::vector<std::string>& statements)
+{
+  const std::string trigger =
+      StringUtils::Format("CREATE TRIGGER {} AFTER {} ON {} FOR EACH ROW ", name, event, table);
+  const std::string body = StringUtils::Join(statements, "; ") + "; ";
+  if (condition.empty())
+    return trigger + "BEGIN " + body + "END";
+  if (sqlite)
+    return trigger + "WHEN " + condition + " BEGIN " + body + "END";
+  return trigger + "BEGIN IF " + condition + " THEN " + body + "END IF; END";
+}
+
+std::string CDatabase::GetChangedSQL(bool sqlite, const std::vector<std::string>& columns)
+{
+  std::vector<std::string> changed;
+  for (const std::string& column : columns)
+  {
+    if (sqlite)
+      changed.push_back(StringUtils::Format("OLD.{0} IS NOT NEW.{0}", column));
+    else
+      changed.push_back(StringUtils::Format("NOT (OLD.{0} <=> NEW.{0})", column));
+  }
+  return "(" + StringUtils::Join(changed, " OR ") + ")";
+}
+
 bool CDatabase::BuildSQL(const std::string& strQuery,
                          const Filter& filter,
                          std::string& strSQL) const
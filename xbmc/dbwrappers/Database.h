@@ -213,6 +213,8 @@ public:
 
   /*!
    * @brief Commit all queries in the queue.
+   *        On MySQL consecutive single-row inserts into the same table and columns are sent as
+   *        multi-row inserts. Only queued queries are merged, not the ones run by ExecuteQuery.
    * @return True if all queries were executed successfully, false otherwise.
    */
   bool CommitInsertQueries();
@@ -257,9 +259,41 @@ public:
 
   bool Connect(const std::string& dbName, const DatabaseSettings& db, bool create);
 
+  /*!
+   * @brief Get the statement creating an AFTER trigger that runs only if a condition holds.
+   *        SQLite checks the condition in a WHEN clause, MySQL has no WHEN and checks it in an
+   *        IF around the statements.
+   * @param sqlite Use the syntax of SQLite, the one of MySQL otherwise.
+   * @param name The name of the trigger.
+   * @param event INSERT, UPDATE or DELETE.
+   * @param table The table the trigger is on.
+   * @param condition Checked for every row, may use OLD and NEW. Empty to always run.
+   * @param statements The statements to run, without a trailing semicolon.
+   * @return The statement.
+   */
+  static std::string GetTriggerSQL(bool sqlite,
+                                   const std::string& name,
+                                   const std::string& event,
+                                   const std::string& table,
+                                   const std::string& condition,
+                                   const std::vector<std::string>& statements);
+
+  /*!
+   * @brief Get a trigger condition that holds if an update changed one of the columns.
+   * @param sqlite Use the syntax of SQLite, the one of MySQL otherwise.
+   * @param columns The columns, NULL is compared like any other value.
+   * @return The condition.
+   */
+  static std::string GetChangedSQL(bool sqlite, const std::vector<std::string>& columns);
+
 protected:
   friend class CDatabaseManager;
 
+  /*! \brief Close the connections to database servers kept open for the next Connect().
+   Called on shutdown, while the client library is still there.
+   */
+  static void CloseIdleConnections();
+
   void Split(const std::string& strFileNameAndPath, std::string& strPath, std::string& strFileName);
 
   virtual bool Open();
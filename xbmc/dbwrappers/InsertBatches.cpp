@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "InsertBatches.h"
+
+#include "utils/StringUtils.h"
+
+namespace dbiplus
+{
+
+std::string SplitInsert(const std::string& sql, std::string& values)
+{
+  if (!StringUtils::StartsWithNoCase(sql, "INSERT INTO ") &&
+      !StringUtils::StartsWithNoCase(sql, "REPLACE INTO "))
+    return "";
+
+  const size_t pos = StringUtils::FindWords(sql.c_str(), "values");
+  if (pos == std::string::npos || sql.find_first_of("'\"") < pos)
+    return "";
+  const size_t start = sql.find('(', pos);
+  if (start == std::string::npos)
+    return "";
+
+  const size_t end = sql.find_last_not_of(" \t\r\n;");
+  if (end == std::string::npos || sql[end] != ')')
+    return "";
+
+  // the row has to be all that follows VALUES, nothing like ON DUPLICATE KEY
+  int depth = 0;
+  char quote = 0;
+  for (size_t i = start; i <= end; i++)
+  {
+    const char c = sql[i];
+    if (quote)
+    {
+      if (c == '\\')
+        i++;
+      else if (c == quote)
+        quote = 0;
+    }
+    else if (c == '\'' || c == '"')
+      quote = c;
+    else if (c == '(')
+      depth++;
+    else if (c == ')' && --depth == 0 && i != end)
+      return "";
+  }
+  if (depth != 0 || quote)
+    return "";
+
+  values = sql.substr(start, end - start + 1);
+  return sql.substr(0, start);
+}
+
+StringList BatchInserts(const StringList& statements, size_t maxSize)
+{
+  StringList batches;
+  std::string batchPrefix;
+  for (const std::string& statement : statements)
+  {
+    std::string values;
+    const std::string prefix = SplitInsert(statement, values);
+    if (!prefix.empty() && prefix == batchPrefix &&
+        batches.back().size() + 2 + values.size() <= maxSize)
+    {
+      batches.back() += ", " + values;
+      continue;
+    }
+
+    if (prefix.empty())
+      batches.push_back(statement);
+    else
+      batches.push_back(prefix + values);
+    batchPrefix = prefix;
+  }
+  return batches;
+}
+
+} // namespace dbiplus
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "dbwrappers/dataset.h"
+
+#include <string>
+
+namespace dbiplus
+{
+
+// multi-row inserts stay well below the default max_allowed_packet of the MySQL servers
+constexpr size_t MAX_INSERT_BATCH_SIZE = 1024 * 1024;
+
+/*!
+ \brief Split a single-row "INSERT/REPLACE INTO ... VALUES (...)" statement
+ \param sql the statement, quoted with MySQL's backslash escapes
+ \param values set to the row, including its parentheses
+ \return the statement up to the row, or an empty string if it can't be merged with others,
+         e.g. because something like ON DUPLICATE KEY follows the row
+ */
+std::string SplitInsert(const std::string& sql, std::string& values);
+
+/*!
+ \brief Merge consecutive inserts into the same table and columns into multi-row inserts
+ \param statements the statements in the order they are run, any statement that isn't a
+        single-row insert is kept as it is
+ \param maxSize the size a multi-row insert doesn't grow beyond
+ \return the statements to run instead
+ */
+StringList BatchInserts(const StringList& statements, size_t maxSize = MAX_INSERT_BATCH_SIZE);
+
+} // namespace dbiplus
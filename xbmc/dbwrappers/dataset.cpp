@@ -553,6 +553,11 @@ size_t Dataset::insert_sql_count()
   return insert_sql.size();
 }
 
+const StringList& Dataset::get_insert_sql() const
+{
+  return insert_sql;
+}
+
 size_t Dataset::delete_sql_count()
 {
   return delete_sql.size();
@@ -441,6 +441,8 @@ public:
 
   /* size of insert_sql*/
   size_t insert_sql_count();
+  /*get insert_sql, e.g. to run the queries one by one once post failed*/
+  const StringList& get_insert_sql() const;
   /* size of delete_sql*/
   size_t delete_sql_count();
 
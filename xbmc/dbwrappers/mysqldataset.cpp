@@ -8,17 +8,22 @@
 
 #include "mysqldataset.h"
 
+#include "ConnectionPool.h"
+#include "InsertBatches.h"
 #include "Util.h"
 #include "network/DNSNameCache.h"
 #include "network/WakeOnAccess.h"
+#include "utils/Digest.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <iostream>
 #include <set>
 #include <string>
+#include <vector>
 #ifdef HAS_MYSQL
 #include <mysql/errmsg.h>
 #elif defined(HAS_MARIADB)
@@ -32,9 +37,46 @@
 #define MYSQL_OK 0
 #define ER_BAD_DB_ERROR 1049
 
+using KODI::UTILITY::CDigest;
+
 namespace dbiplus
 {
 
+namespace
+{
+// idle connections kept per server, user and database
+constexpr size_t MAX_POOLED_CONNECTIONS = 4;
+
+// idle connections are closed well before the server's wait_timeout would drop them
+constexpr auto POOLED_CONNECTION_TIMEOUT = std::chrono::minutes(5);
+
+struct PooledConnection
+{
+  MYSQL* conn = nullptr;
+  std::string defaultCharset;
+};
+
+/* Keeps the connections of closed databases open for the next connect().
+   Kodi opens and closes a database for nearly every listing, and for a remote
+   server the TCP and TLS handshakes, the login and the session setup easily
+   take longer than the queries themselves. The pool is drained on shutdown by
+   close_idle_connections(), not by its destructor, the client library may be
+   gone by then. */
+CConnectionPool<PooledConnection>& GetConnectionPool()
+{
+  static CConnectionPool<PooledConnection> pool(MAX_POOLED_CONNECTIONS,
+                                                POOLED_CONNECTION_TIMEOUT);
+  return pool;
+}
+
+// closing says goodbye to the server, the pool isn't locked meanwhile
+void CloseConnections(const std::vector<PooledConnection>& connections)
+{
+  for (const PooledConnection& connection : connections)
+    mysql_close(connection.conn);
+}
+} // unnamed namespace
+
 //************* MysqlDatabase implementation ***************
 
 MysqlDatabase::MysqlDatabase()
@@ -42,6 +84,7 @@ MysqlDatabase::MysqlDatabase()
 
   active = false;
   _in_transaction = false; // for transaction
+  _temporary_tables = false;
 
   error = "Unknown database error"; //S_NO_CONNECTION;
   host = "localhost";
@@ -170,6 +213,22 @@ int MysqlDatabase::connect(bool create_new)
   {
     disconnect();
 
+    // reuse an idle connection to the database if there is one
+    CloseConnections(GetConnectionPool().TakeExpired());
+    PooledConnection pooled;
+    while (GetConnectionPool().Acquire(pool_key(), pooled))
+    {
+      // selecting the database again checks the connection is still alive as well
+      if (mysql_select_db(pooled.conn, db.c_str()) == 0)
+      {
+        conn = pooled.conn;
+        default_charset = pooled.defaultCharset;
+        active = true;
+        return DB_CONNECTION_OK;
+      }
+      mysql_close(pooled.conn);
+    }
+
     if (conn == NULL)
     {
       conn = mysql_init(conn);
@@ -276,13 +335,33 @@ void MysqlDatabase::disconnect(void)
 {
   if (conn != NULL)
   {
-    mysql_close(conn);
+    // only a connection in a clean session state is reused, a lost one isn't active anymore
+    if (!active || _in_transaction || _temporary_tables ||
+        !GetConnectionPool().Release(pool_key(), {conn, default_charset}))
+      mysql_close(conn);
     conn = NULL;
+    CloseConnections(GetConnectionPool().TakeExpired());
   }
 
+  _temporary_tables = false;
   active = false;
 }
 
+void MysqlDatabase::close_idle_connections()
+{
+  CloseConnections(GetConnectionPool().TakeAll());
+}
+
+std::string MysqlDatabase::pool_key() const
+{
+  // the password and the SSL settings only as a hash, the key stays around until shutdown
+  const std::string credentials =
+      StringUtils::Format("{}|{}|{}|{}|{}|{}|{}", passwd, key, cert, ca, capath, ciphers,
+                          compression);
+  return StringUtils::Format("{}@{}:{}/{}#{}", login, host, port, db,
+                             CDigest::Calculate(CDigest::Type::SHA256, credentials));
+}
+
 int MysqlDatabase::create()
 {
   return connect(true);
@@ -1712,7 +1791,8 @@ void MysqlDataset::make_query(StringList& _sql)
 
 void MysqlDataset::make_insert()
 {
-  make_query(insert_sql);
+  StringList batches = BatchInserts(insert_sql);
+  make_query(batches);
   last();
 }
 
@@ -1832,6 +1912,9 @@ int MysqlDataset::exec(const std::string& sql)
     }
     else
       qry += " CHARACTER SET utf8 COLLATE utf8_general_ci";
+
+    if (ci_find(qry, "CREATE TEMPORARY TABLE") != std::string::npos)
+      static_cast<MysqlDatabase*>(db)->set_temporary_tables();
   }
 
   CLog::Log(LOGDEBUG, "Mysql execute: {}", qry);
@@ -1883,8 +1966,10 @@ bool MysqlDataset::query(const std::string& query)
       MYSQL_OK)
     throw DbErrors(db->getErrorMsg());
 
+  // stream the rows from the server instead of buffering the whole result in the client
+  // library first, the rows end up in the records anyway
   MYSQL* conn = handle();
-  stmt = mysql_store_result(conn);
+  stmt = mysql_use_result(conn);
   if (stmt == NULL)
     throw DbErrors("Missing result set!");
 
@@ -1965,7 +2050,17 @@ bool MysqlDataset::query(const std::string& query)
     }
     result.records.push_back(res);
   }
+
+  // the connection can drop while the rows are streamed
+  const unsigned int error = mysql_errno(conn);
   mysql_free_result(stmt);
+  if (error != MYSQL_OK)
+  {
+    result.clear();
+    db->setErr(error, qry.c_str());
+    throw DbErrors(db->getErrorMsg());
+  }
+
   active = true;
   ds_state = dsSelect;
   this->first();
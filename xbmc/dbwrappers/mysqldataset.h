@@ -30,6 +30,7 @@ protected:
   /* connect descriptor */
   MYSQL* conn;
   bool _in_transaction;
+  bool _temporary_tables;
   int last_err;
 
 public:
@@ -80,9 +81,18 @@ public:
   int query_with_reconnect(const char* query);
   void configure_connection();
 
+  /* a connection with temporary tables is not reused by the next connect() */
+  void set_temporary_tables() { _temporary_tables = true; }
+
+  /* close the connections kept for reuse, on shutdown before the client library is gone */
+  static void close_idle_connections();
+
 private:
   typedef struct StrAccum StrAccum;
 
+  /* identifies the connections that can be reused for this database */
+  std::string pool_key() const;
+
   char et_getdigit(double* val, int* cnt);
   void appendSpace(StrAccum* pAccum, int N);
   void mysqlVXPrintf(StrAccum* pAccum, int useExtended, const char* fmt, va_list ap);
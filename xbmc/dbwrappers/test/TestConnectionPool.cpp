@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/ConnectionPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace dbiplus;
+using namespace std::chrono_literals;
+
+namespace
+{
+using Pool = CConnectionPool<int>;
+} // unnamed namespace
+
+TEST(TestConnectionPool, ReusesTheLastReleased)
+{
+  Pool pool(4, 5min);
+  const auto now = Pool::Clock::now();
+
+  EXPECT_TRUE(pool.Release("server", 1, now));
+  EXPECT_TRUE(pool.Release("server", 2, now + 1s));
+
+  int connection = 0;
+  EXPECT_TRUE(pool.Acquire("server", connection, now + 2s));
+  EXPECT_EQ(2, connection);
+  EXPECT_TRUE(pool.Acquire("server", connection, now + 2s));
+  EXPECT_EQ(1, connection);
+  EXPECT_FALSE(pool.Acquire("server", connection, now + 2s));
+}
+
+TEST(TestConnectionPool, KeysAreSeparate)
+{
+  Pool pool(4, 5min);
+  EXPECT_TRUE(pool.Release("user@server:3306/MyVideos131#1", 1));
+
+  int connection = 0;
+  EXPECT_FALSE(pool.Acquire("user@server:3306/MyMusic83#1", connection));
+  EXPECT_FALSE(pool.Acquire("user@server:3306/MyVideos131#2", connection));
+  EXPECT_TRUE(pool.Acquire("user@server:3306/MyVideos131#1", connection));
+  EXPECT_EQ(1, connection);
+}
+
+TEST(TestConnectionPool, KeepsFewConnectionsPerKey)
+{
+  Pool pool(2, 5min);
+  EXPECT_TRUE(pool.Release("server", 1));
+  EXPECT_TRUE(pool.Release("server", 2));
+  // the caller closes what the pool doesn't take
+  EXPECT_FALSE(pool.Release("server", 3));
+  EXPECT_TRUE(pool.Release("other", 4));
+
+  std::vector<int> all = pool.TakeAll();
+  std::sort(all.begin(), all.end());
+  EXPECT_EQ((std::vector<int>{1, 2, 4}), all);
+  EXPECT_TRUE(pool.TakeAll().empty());
+}
+
+TEST(TestConnectionPool, Expiry)
+{
+  Pool pool(4, 5min);
+  const auto now = Pool::Clock::now();
+
+  pool.Release("server", 1, now);
+  pool.Release("server", 2, now + 2min);
+  pool.Release("other", 3, now + 1min);
+
+  // nothing is expired right at the timeout
+  EXPECT_TRUE(pool.TakeExpired(now + 5min).empty());
+
+  std::vector<int> expired = pool.TakeExpired(now + 6min + 1s);
+  std::sort(expired.begin(), expired.end());
+  EXPECT_EQ((std::vector<int>{1, 3}), expired);
+
+  // an expired connection isn't handed out even if it wasn't taken yet
+  int connection = 0;
+  EXPECT_FALSE(pool.Acquire("server", connection, now + 8min));
+  EXPECT_TRUE(pool.Acquire("server", connection, now + 7min));
+  EXPECT_EQ(2, connection);
+  EXPECT_TRUE(pool.TakeAll().empty());
+}
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/InsertBatches.h"
+#include "utils/StringUtils.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace dbiplus;
+
+TEST(TestInsertBatches, SplitInsert)
+{
+  std::string values;
+  EXPECT_EQ("INSERT INTO tag (tag_id, name) VALUES ",
+            SplitInsert("INSERT INTO tag (tag_id, name) VALUES (1, 'a')", values));
+  EXPECT_EQ("(1, 'a')", values);
+
+  EXPECT_EQ("REPLACE INTO epgtags (idBroadcast, sTitle) values ",
+            SplitInsert("REPLACE INTO epgtags (idBroadcast, sTitle) values (2, 'b');\n", values));
+  EXPECT_EQ("(2, 'b')", values);
+
+  // quotes, escapes and parentheses inside the values
+  EXPECT_EQ("INSERT INTO tag (name) VALUES ",
+            SplitInsert("INSERT INTO tag (name) VALUES ('it''s (a) \\'quote\\')')", values));
+  EXPECT_EQ("('it''s (a) \\'quote\\')')", values);
+  EXPECT_EQ("INSERT INTO tag (name) VALUES ",
+            SplitInsert("INSERT INTO tag (name) VALUES (\")\")", values));
+  EXPECT_EQ("(\")\")", values);
+}
+
+TEST(TestInsertBatches, SplitInsertKeepsOthers)
+{
+  std::string values;
+  EXPECT_EQ("", SplitInsert("UPDATE tag SET name='a' WHERE tag_id=1", values));
+  EXPECT_EQ("", SplitInsert("DELETE FROM tag", values));
+  EXPECT_EQ("", SplitInsert("INSERT INTO tag (name) SELECT name FROM genre", values));
+  // several rows, a row followed by anything and rows not closed
+  EXPECT_EQ("", SplitInsert("INSERT INTO tag (name) VALUES ('a'), ('b')", values));
+  EXPECT_EQ("", SplitInsert("INSERT INTO tag (tag_id, name) VALUES (1, 'a') "
+                            "ON DUPLICATE KEY UPDATE name='a'",
+                            values));
+  EXPECT_EQ("", SplitInsert("INSERT INTO tag (name) VALUES ('a)", values));
+  EXPECT_EQ("", SplitInsert("INSERT INTO tag (name) VALUES (('a')", values));
+  // a quote before VALUES, e.g. in a quoted table name
+  EXPECT_EQ("", SplitInsert("INSERT INTO \"tag\" (name) VALUES ('a')", values));
+}
+
+TEST(TestInsertBatches, MergesConsecutiveInserts)
+{
+  const StringList batches = BatchInserts({"INSERT INTO tag (name) VALUES ('a')",
+                                           "INSERT INTO tag (name) VALUES ('b')",
+                                           "INSERT INTO genre (name) VALUES ('c')",
+                                           "DELETE FROM tag WHERE name='a'",
+                                           "INSERT INTO tag (name) VALUES ('d')",
+                                           "INSERT INTO tag (name) VALUES ('e');",
+                                           "REPLACE INTO tag (name) VALUES ('f')"});
+
+  // the order of the statements is kept, a table or statement in between starts a new batch
+  const std::vector<std::string> expected = {"INSERT INTO tag (name) VALUES ('a'), ('b')",
+                                             "INSERT INTO genre (name) VALUES ('c')",
+                                             "DELETE FROM tag WHERE name='a'",
+                                             "INSERT INTO tag (name) VALUES ('d'), ('e')",
+                                             "REPLACE INTO tag (name) VALUES ('f')"};
+  EXPECT_EQ(expected, std::vector<std::string>(batches.begin(), batches.end()));
+}
+
+TEST(TestInsertBatches, SplitsLargeBatches)
+{
+  const std::string prefix = "INSERT INTO tag (name) VALUES ";
+  const std::string row = "('" + std::string(1000, 'x') + "')";
+  const size_t rowsPerBatch = (MAX_INSERT_BATCH_SIZE - prefix.size() + 2) / (row.size() + 2);
+  const size_t rows = 3 * rowsPerBatch;
+
+  StringList statements;
+  for (size_t i = 0; i < rows; i++)
+    statements.push_back(prefix + row);
+  const StringList batches = BatchInserts(statements);
+
+  EXPECT_EQ(3u, batches.size());
+  size_t merged = 0;
+  for (const std::string& batch : batches)
+  {
+    EXPECT_LE(batch.size(), MAX_INSERT_BATCH_SIZE);
+    EXPECT_TRUE(StringUtils::StartsWith(batch, prefix));
+    // the rows and the ", " between them
+    EXPECT_EQ(0u, (batch.size() - prefix.size() + 2) % (row.size() + 2));
+    merged += (batch.size() - prefix.size() + 2) / (row.size() + 2);
+  }
+  EXPECT_EQ(rows, merged);
+
+  // exactly at the limit
+  const std::string statement = prefix + row;
+  const StringList limit =
+      BatchInserts({statement, statement, statement}, 2 * statement.size() - prefix.size() + 2);
+  ASSERT_EQ(2u, limit.size());
+  EXPECT_EQ(prefix + row + ", " + row, limit.front());
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
+#include "video/VideoDatabase.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr int ROWS = 5000;
+
+class CTestDatabase : public CVideoDatabase
+{
+public:
+  using CDatabase::CloseIdleConnections;
+};
+} // unnamed namespace
+
+/*!
+ * \brief Runs against the MySQL server set up as video database with --add-advancedsettings-file,
+ *        skipped without one.
+ */
+class TestMysqlDatabase : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_settings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseVideo;
+    if (!StringUtils::EqualsNoCase(m_settings.type, "mysql"))
+      GTEST_SKIP() << "no MySQL server configured as video database";
+
+    ASSERT_TRUE(m_database.Connect("TestMysqlDatabase", m_settings, true));
+    ASSERT_TRUE(m_database.ExecuteQuery("DROP TABLE IF EXISTS batches"));
+    ASSERT_TRUE(m_database.ExecuteQuery("CREATE TABLE batches (id integer primary key, "
+                                        "name text)"));
+  }
+
+  void TearDown() override
+  {
+    m_database.Close();
+    CTestDatabase::CloseIdleConnections();
+  }
+
+  DatabaseSettings m_settings;
+  CTestDatabase m_database;
+};
+
+TEST_F(TestMysqlDatabase, ReusesConnections)
+{
+  const int connection = m_database.GetSingleValueInt("SELECT CONNECTION_ID()");
+  m_database.Close();
+  ASSERT_TRUE(m_database.Connect("TestMysqlDatabase", m_settings, false));
+  EXPECT_EQ(connection, m_database.GetSingleValueInt("SELECT CONNECTION_ID()"));
+
+  // a connection with temporary tables is closed instead
+  ASSERT_TRUE(m_database.ExecuteQuery("CREATE TEMPORARY TABLE scratch (id integer)"));
+  m_database.Close();
+  ASSERT_TRUE(m_database.Connect("TestMysqlDatabase", m_settings, false));
+  EXPECT_NE(connection, m_database.GetSingleValueInt("SELECT CONNECTION_ID()"));
+  EXPECT_EQ("", m_database.GetSingleValue("SELECT COUNT(*) FROM scratch"));
+
+  // and none is kept after shutdown
+  const int next = m_database.GetSingleValueInt("SELECT CONNECTION_ID()");
+  m_database.Close();
+  CTestDatabase::CloseIdleConnections();
+  ASSERT_TRUE(m_database.Connect("TestMysqlDatabase", m_settings, false));
+  EXPECT_NE(next, m_database.GetSingleValueInt("SELECT CONNECTION_ID()"));
+}
+
+TEST_F(TestMysqlDatabase, BatchedInserts)
+{
+  // more rows than fit in one batch, with quotes and parentheses in the values
+  const std::string name = "it's (" + std::string(500, 'x') + ")";
+  for (int id = 1; id <= ROWS; id++)
+  {
+    ASSERT_TRUE(m_database.QueueInsertQuery(m_database.PrepareSQL(
+        "INSERT INTO batches (id, name) VALUES (%i, '%s')", id, name.c_str())));
+  }
+  EXPECT_TRUE(m_database.CommitInsertQueries());
+
+  EXPECT_EQ(ROWS, m_database.GetSingleValueInt("SELECT COUNT(*) FROM batches"));
+  EXPECT_EQ(name, m_database.GetSingleValue(
+                      m_database.PrepareSQL("SELECT name FROM batches WHERE id=%i", ROWS)));
+}
@@ -9,6 +9,7 @@
 #include "CurlFile.h"
 
 #include "File.h"
+#include "ReadAheadBuffer.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "filesystem/SpecialProtocol.h"
@@ -18,11 +19,17 @@
 #include "settings/SettingsComponent.h"
 #include "threads/SystemClock.h"
 #include "utils/Base64.h"
+#include "utils/HttpRangeUtils.h"
 #include "utils/XTimeUtils.h"
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <climits>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #ifdef TARGET_POSIX
@@ -53,6 +60,11 @@ curl_proxytype proxyType2CUrlProxyType[] = {
 #define FILLBUFFER_NO_DATA    1
 #define FILLBUFFER_FAIL       2
 
+// the size of the ranges of a segmented download
+static constexpr size_t SEGMENT_SIZE = 1024 * 1024;
+// another segment is kept if it raises the throughput at least by this factor
+static constexpr double SEGMENT_GAIN = 1.1;
+
 // curl calls this routine to debug
 extern "C" int debug_callback(CURL_HANDLE *handle, curl_infotype info, char *output, size_t size, void *data)
 {
@@ -148,6 +160,7 @@ static constexpr int CURL_ON = 1L;
 
 size_t CCurlFile::CReadState::HeaderCallback(void *ptr, size_t size, size_t nmemb)
 {
+  std::unique_lock<CCriticalSection> lock(m_section);
   std::string inString;
   // libcurl doc says that this info is not always \0 terminated
   const char* strBuf = (const char*)ptr;
@@ -164,12 +177,14 @@ size_t CCurlFile::CReadState::HeaderCallback(void *ptr, size_t size, size_t nmem
 
 size_t CCurlFile::CReadState::ReadCallback(char *buffer, size_t size, size_t nitems)
 {
+  std::unique_lock<CCriticalSection> lock(m_section);
   if (m_fileSize == 0)
     return 0;
 
   if (m_filePos >= m_fileSize)
   {
     m_isPaused = true;
+    m_transferEvent.notifyAll();
     return CURL_READFUNC_PAUSE;
   }
 
@@ -182,6 +197,7 @@ size_t CCurlFile::CReadState::ReadCallback(char *buffer, size_t size, size_t nit
 
 size_t CCurlFile::CReadState::WriteCallback(char *buffer, size_t size, size_t nitems)
 {
+  std::unique_lock<CCriticalSection> lock(m_section);
   unsigned int amount = size * nitems;
   if (m_overflowSize)
   {
@@ -207,6 +223,14 @@ size_t CCurlFile::CReadState::WriteCallback(char *buffer, size_t size, size_t ni
       m_overflowBuffer = (char*)realloc_simple(m_overflowBuffer, m_overflowSize);
     }
   }
+  // the reader is behind, leave the data in curl until it caught up
+  if (m_bufferSize > 0 && (m_overflowSize || m_buffer.getMaxWriteSize() == 0))
+  {
+    m_recvPaused = true;
+    if (m_releasable)
+      g_curlInterface.GetLoop().Paused(m_easyHandle);
+    return CURL_WRITEFUNC_PAUSE;
+  }
   // ok, now copy the data into our ring buffer
   unsigned int maxWriteable = std::min(m_buffer.getMaxWriteSize(), amount);
   if (maxWriteable)
@@ -239,13 +263,13 @@ size_t CCurlFile::CReadState::WriteCallback(char *buffer, size_t size, size_t ni
     memcpy(m_overflowBuffer + m_overflowSize, buffer, amount);
     m_overflowSize += amount;
   }
+  m_transferEvent.notifyAll();
   return size * nitems;
 }
 
 CCurlFile::CReadState::CReadState()
 {
   m_easyHandle = NULL;
-  m_multiHandle = NULL;
   m_overflowBuffer = NULL;
   m_overflowSize = 0;
   m_stillRunning = 0;
@@ -261,6 +285,14 @@ CCurlFile::CReadState::CReadState()
   m_bRetry = true;
   m_curlHeaderList = NULL;
   m_curlAliasList = NULL;
+  m_connected = false;
+  m_recvPaused = false;
+  m_releasable = false;
+  m_released = false;
+  m_done = false;
+  m_resultPending = false;
+  m_result = CURLE_OK;
+  m_httpCode = 0;
 }
 
 CCurlFile::CReadState::~CReadState()
@@ -268,7 +300,75 @@ CCurlFile::CReadState::~CReadState()
   Disconnect();
 
   if(m_easyHandle)
-    g_curlInterface.easy_release(&m_easyHandle, &m_multiHandle);
+    g_curlInterface.easy_release(&m_easyHandle, NULL);
+}
+
+void CCurlFile::CReadState::OnTransferDone(int result)
+{
+  long httpCode = 0;
+  if (result == CURLE_HTTP_RETURNED_ERROR)
+    g_curlInterface.easy_getinfo(m_easyHandle, CURLINFO_RESPONSE_CODE, &httpCode);
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  m_result = result;
+  m_httpCode = httpCode;
+  m_done = true;
+  m_resultPending = true;
+  m_transferEvent.notifyAll();
+}
+
+void CCurlFile::CReadState::OnReleased()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  // the reader may have asked to unpause already, it has to restart the transfer now
+  m_recvPaused = true;
+  m_released = true;
+  m_transferEvent.notifyAll();
+}
+
+void CCurlFile::CReadState::Start()
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_recvPaused = false;
+    m_released = false;
+    m_done = false;
+    m_resultPending = false;
+  }
+  m_connected = true;
+  g_curlInterface.GetLoop().Add(m_easyHandle, this);
+}
+
+void CCurlFile::CReadState::Continue(std::unique_lock<CCriticalSection>& lock)
+{
+  m_recvPaused = false;
+  if (!m_released)
+  {
+    lock.unlock();
+    g_curlInterface.GetLoop().Unpause(m_easyHandle);
+    lock.lock();
+    return;
+  }
+
+  // the connection is gone, request the rest from behind the data we have
+  const int64_t pos = m_filePos + m_buffer.getMaxReadSize() + m_overflowSize;
+  CLog::Log(LOGDEBUG, "CCurlFile::CReadState::{} - ({}) Reconnect at position {}", __FUNCTION__,
+            fmt::ptr(this), pos);
+  lock.unlock();
+  g_curlInterface.easy_setopt(m_easyHandle, CURLOPT_RANGE, NULL);
+  g_curlInterface.easy_setopt(m_easyHandle, CURLOPT_RESUME_FROM_LARGE, pos);
+  Start();
+  lock.lock();
+}
+
+void CCurlFile::CReadState::Stop()
+{
+  if (!m_connected)
+    return;
+
+  // no callback runs anymore once this returns
+  g_curlInterface.GetLoop().Remove(m_easyHandle);
+  m_connected = false;
 }
 
 bool CCurlFile::CReadState::Seek(int64_t pos)
@@ -343,7 +443,6 @@ long CCurlFile::CReadState::Connect(unsigned int size)
               fmt::ptr(this), m_filePos);
 
   SetResume();
-  g_curlInterface.multi_add_handle(m_multiHandle, m_easyHandle);
 
   m_bufferSize = size;
   m_buffer.Destroy();
@@ -353,6 +452,7 @@ long CCurlFile::CReadState::Connect(unsigned int size)
   // read some data in to try and obtain the length
   // maybe there's a better way to get this info??
   m_stillRunning = 1;
+  Start();
 
   // (Try to) fill buffer
   if (FillBuffer(1) != FILLBUFFER_OK)
@@ -388,8 +488,7 @@ long CCurlFile::CReadState::Connect(unsigned int size)
 
 void CCurlFile::CReadState::Disconnect()
 {
-  if(m_multiHandle && m_easyHandle)
-    g_curlInterface.multi_remove_handle(m_multiHandle, m_easyHandle);
+  Stop();
 
   m_buffer.Clear();
   free(m_overflowBuffer);
@@ -411,6 +510,291 @@ void CCurlFile::CReadState::Disconnect()
 }
 
 
+/*!
+ * \brief Downloads the chunks of the read-ahead window as range requests, each
+ * on a connection of its own
+ *
+ * Servers and CDNs often limit the speed of a single connection, several
+ * adjacent segments of the file are downloaded at the same time on the curl
+ * loop instead. Only some of the queued segments run at once: after every
+ * round of them the throughput is measured, another segment is allowed as long
+ * as the last one raised it, and one less when it dropped. Rounds in which the
+ * reader didn't keep enough segments queued are not judged.
+ */
+class CCurlFile::CReadAhead : public CReadAheadBuffer
+{
+public:
+  CReadAhead(CCurlFile& file, unsigned int depth)
+    : CReadAheadBuffer(SEGMENT_SIZE, depth), m_file(file), m_fileSize(file.GetLength())
+  {
+    for (size_t i = 0; i < GetDepth(); i++)
+      m_segments.emplace_back(std::make_unique<CSegment>(*this, GetChunk(i)));
+  }
+
+  ~CReadAhead() override
+  {
+    for (size_t i = 0; i < m_segments.size(); i++)
+    {
+      Cancel(GetChunk(i));
+      // finished ranges are still in the loop
+      if (m_segments[i]->m_added)
+        g_curlInterface.GetLoop().Remove(m_segments[i]->m_state.m_easyHandle);
+    }
+  }
+
+protected:
+  // implementation of CReadAheadBuffer
+  void Submit(Chunk& chunk) override
+  {
+    CSegment& segment = *m_segments[IndexOf(chunk)];
+    if (segment.m_added)
+    {
+      g_curlInterface.GetLoop().Remove(segment.m_state.m_easyHandle);
+      segment.m_added = false;
+    }
+
+    const bool configured = chunk.offset < m_fileSize && Configure(segment);
+
+    std::unique_lock<CCriticalSection> lock(m_section);
+    if (!configured)
+    {
+      // nothing to request behind the end of the file
+      chunk.result = chunk.offset < m_fileSize ? -EIO : 0;
+      chunk.state = ChunkState::DONE;
+      return;
+    }
+
+    chunk.state = ChunkState::PENDING;
+    m_queue.push_back(&segment);
+    StartSegments();
+  }
+
+  void Wait(Chunk& chunk) override
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_finished.wait(lock, [&chunk] { return chunk.state != ChunkState::PENDING; });
+  }
+
+  void Cancel(Chunk& chunk) override
+  {
+    CSegment& segment = *m_segments[IndexOf(chunk)];
+    std::unique_lock<CCriticalSection> lock(m_section);
+    if (chunk.state != ChunkState::PENDING)
+      return;
+
+    if (!segment.m_running)
+    {
+      // still waiting for its turn
+      m_queue.erase(std::find(m_queue.begin(), m_queue.end(), &segment));
+    }
+    else
+    {
+      // the loop calls into the segment with its lock held
+      lock.unlock();
+      g_curlInterface.GetLoop().Remove(segment.m_state.m_easyHandle);
+      lock.lock();
+      segment.m_added = false;
+      if (chunk.state != ChunkState::PENDING)
+        return;
+
+      Account();
+      m_active--;
+      segment.m_running = false;
+    }
+
+    chunk.result = -ECANCELED;
+    chunk.state = ChunkState::DONE;
+  }
+
+private:
+  class CSegment : public XCURL::CCurlMultiLoop::ITransfer
+  {
+  public:
+    CSegment(CReadAhead& owner, Chunk& chunk) : m_owner(owner), m_chunk(chunk) {}
+
+    void OnTransferDone(int result) override { m_owner.OnSegmentDone(*this, result); }
+
+    CReadAhead& m_owner;
+    Chunk& m_chunk;
+    CReadState m_state; // the handle and the request headers
+    bool m_added = false; // the handle is in the loop, running or finished
+    bool m_running = false;
+    bool m_checked = false; // the response is the requested range
+    size_t m_size = 0;
+    size_t m_received = 0;
+  };
+
+  static size_t WriteCallback(char* buffer, size_t size, size_t nitems, void* userp)
+  {
+    CSegment& segment = *static_cast<CSegment*>(userp);
+    const size_t amount = size * nitems;
+
+    if (!segment.m_checked)
+    {
+      // a server that ignores the range sends the whole file instead
+      const int64_t first = segment.m_chunk.offset;
+      const std::string expected = HttpRangeUtils::GenerateContentRangeHeaderValue(
+          first, first + segment.m_size - 1, segment.m_owner.m_fileSize);
+      std::unique_lock<CCriticalSection> lock(segment.m_state.m_section);
+      const std::string received = segment.m_state.m_httpheader.GetValue("Content-Range");
+      if (!StringUtils::EqualsNoCase(received, expected))
+      {
+        CLog::Log(LOGERROR, "CCurlFile::CReadAhead::{} - Expected range {}, got \"{}\"",
+                  __FUNCTION__, expected, received);
+        return 0;
+      }
+      segment.m_checked = true;
+    }
+
+    if (segment.m_received + amount > segment.m_size)
+      return 0;
+
+    std::memcpy(segment.m_chunk.data.get() + segment.m_received, buffer, amount);
+    segment.m_received += amount;
+    return amount;
+  }
+
+  bool Configure(CSegment& segment)
+  {
+    CReadState& state = segment.m_state;
+    if (!state.m_easyHandle)
+    {
+      const CURL url(m_file.m_url);
+      g_curlInterface.easy_acquire(url.GetProtocol().c_str(), url.GetHostName().c_str(),
+                                   &state.m_easyHandle, NULL);
+      if (!state.m_easyHandle)
+        return false;
+    }
+
+    m_file.SetCommonOptions(&state);
+    m_file.SetRequestHeaders(&state);
+    state.m_httpheader.Clear();
+
+    CURL_HANDLE* h = state.m_easyHandle;
+    g_curlInterface.easy_setopt(h, CURLOPT_WRITEDATA, &segment);
+    g_curlInterface.easy_setopt(h, CURLOPT_WRITEFUNCTION, WriteCallback);
+    // multiplexed on one HTTP/2 connection the segments would share its limit
+    g_curlInterface.easy_setopt(h, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+    g_curlInterface.easy_setopt(h, CURLOPT_PIPEWAIT, CURL_OFF);
+    // the data is put together by position, it has to arrive as is
+    g_curlInterface.easy_setopt(h, CURLOPT_ACCEPT_ENCODING, NULL);
+
+    const int64_t first = segment.m_chunk.offset;
+    const int64_t last = std::min<int64_t>(first + m_chunkSize, m_fileSize) - 1;
+    const std::string range = StringUtils::Format("{}-{}", first, last);
+    g_curlInterface.easy_setopt(h, CURLOPT_RANGE, range.c_str());
+
+    segment.m_size = static_cast<size_t>(last - first + 1);
+    segment.m_received = 0;
+    segment.m_checked = false;
+    return true;
+  }
+
+  void OnSegmentDone(CSegment& segment, int result)
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    Chunk& chunk = segment.m_chunk;
+    if (result == CURLE_OK && segment.m_received == segment.m_size)
+    {
+      chunk.result = static_cast<ssize_t>(segment.m_received);
+      m_roundBytes += segment.m_received;
+      m_roundSegments++;
+    }
+    else
+    {
+      CLog::Log(LOGERROR, "CCurlFile::CReadAhead::{} - Range at {} failed: {}({})", __FUNCTION__,
+                chunk.offset, g_curlInterface.easy_strerror(static_cast<CURLcode>(result)),
+                result);
+      chunk.result = -EIO;
+    }
+    chunk.state = ChunkState::DONE;
+
+    Account();
+    m_active--;
+    segment.m_running = false;
+
+    if (m_roundSegments >= m_limit)
+      Adapt();
+
+    StartSegments();
+    m_finished.notifyAll();
+  }
+
+  void StartSegments()
+  {
+    while (m_active < m_limit && !m_queue.empty())
+    {
+      CSegment& segment = *m_queue.front();
+      m_queue.pop_front();
+
+      Account();
+      m_active++;
+      segment.m_running = true;
+      segment.m_added = true;
+      g_curlInterface.GetLoop().Add(segment.m_state.m_easyHandle, &segment);
+    }
+
+    // the reader didn't queue enough, the limit wasn't what held the round back
+    if (m_active < m_limit)
+      m_starved = true;
+  }
+
+  /*!
+   * \brief Sum up the time segments were running, the throughput doesn't
+   * count the time the reader didn't ask for more
+   */
+  void Account()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_active > 0)
+      m_busyTime += now - m_busySince;
+    m_busySince = now;
+  }
+
+  void Adapt()
+  {
+    Account();
+    if (!m_starved)
+    {
+      const double rate = m_busyTime.count() > 0 ? m_roundBytes / m_busyTime.count() : 0.0;
+
+      const unsigned int limit = m_limit;
+      if (rate > m_lastRate * SEGMENT_GAIN && m_limit < GetDepth())
+        m_limit++;
+      else if (rate * SEGMENT_GAIN < m_lastRate && m_limit > 1)
+        m_limit--;
+
+      if (m_limit != limit)
+        CLog::Log(LOGDEBUG, "CCurlFile::CReadAhead::{} - {} KiB/s with {} segments, now {}",
+                  __FUNCTION__, static_cast<int64_t>(rate / 1024), limit, m_limit);
+
+      m_lastRate = rate;
+    }
+
+    m_starved = false;
+    m_roundBytes = 0;
+    m_roundSegments = 0;
+    m_busyTime = std::chrono::duration<double>::zero();
+  }
+
+  CCurlFile& m_file;
+  const int64_t m_fileSize;
+  std::vector<std::unique_ptr<CSegment>> m_segments; // one per chunk
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_finished;
+  std::deque<CSegment*> m_queue;
+  unsigned int m_active = 0;
+  unsigned int m_limit = 1; // segments running at once
+
+  std::chrono::steady_clock::time_point m_busySince;
+  std::chrono::duration<double> m_busyTime{0};
+  uint64_t m_roundBytes = 0;
+  unsigned int m_roundSegments = 0;
+  bool m_starved = false;
+  double m_lastRate = 0.0;
+};
+
 CCurlFile::~CCurlFile()
 {
   Close();
@@ -452,6 +836,7 @@ void CCurlFile::Close()
   if (m_opened && m_forWrite && !m_inError)
       Write(NULL, 0);
 
+  m_readAhead.reset();
   m_state->Disconnect();
   delete m_oldState;
   m_oldState = NULL;
@@ -534,8 +919,8 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
   if (!m_verifyPeer)
     g_curlInterface.easy_setopt(h, CURLOPT_SSL_VERIFYPEER, 0);
 
-  g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_URL, m_url.c_str());
-  g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_TRANSFERTEXT, CURL_OFF);
+  g_curlInterface.easy_setopt(h, CURLOPT_URL, m_url.c_str());
+  g_curlInterface.easy_setopt(h, CURLOPT_TRANSFERTEXT, CURL_OFF);
 
   // setup POST data if it is set (and it may be empty)
   if (m_postdataset)
@@ -674,8 +1059,12 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
   if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_curlDisableHTTP2)
     g_curlInterface.easy_setopt(h, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
   else
+  {
     // enable HTTP2 support. default: CURL_HTTP_VERSION_1_1. Curl >= 7.62.0 defaults to CURL_HTTP_VERSION_2TLS
     g_curlInterface.easy_setopt(h, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    // wait for a connection that can be multiplexed rather than opening another one
+    g_curlInterface.easy_setopt(h, CURLOPT_PIPEWAIT, CURL_ON);
+  }
 
   // set CA bundle file
   std::string caCert = CSpecialProtocol::TranslatePath(
@@ -1081,12 +1470,10 @@ bool CCurlFile::Open(const CURL& url)
   std::string redactPath = CURL::GetRedacted(m_url);
   CLog::Log(LOGDEBUG, "CurlFile::{} - <{}>", __FUNCTION__, redactPath);
 
-  assert(!(!m_state->m_easyHandle ^ !m_state->m_multiHandle));
   if( m_state->m_easyHandle == NULL )
     g_curlInterface.easy_acquire(url2.GetProtocol().c_str(),
                                 url2.GetHostName().c_str(),
-                                &m_state->m_easyHandle,
-                                &m_state->m_multiHandle);
+                                &m_state->m_easyHandle, NULL);
 
   // setup common curl options
   SetCommonOptions(m_state,
@@ -1160,6 +1547,11 @@ bool CCurlFile::Open(const CURL& url)
     }
   }
 
+  {
+    std::unique_lock<CCriticalSection> lock(m_state->m_section);
+    m_state->m_releasable = m_seekable;
+  }
+
   std::string efurl = GetInfoString(CURLINFO_EFFECTIVE_URL);
   if (!efurl.empty())
   {
@@ -1191,8 +1583,7 @@ bool CCurlFile::OpenForWrite(const CURL& url, bool bOverWrite)
   assert(m_state->m_easyHandle == NULL);
   g_curlInterface.easy_acquire(url2.GetProtocol().c_str(),
                               url2.GetHostName().c_str(),
-                              &m_state->m_easyHandle,
-                              &m_state->m_multiHandle);
+                              &m_state->m_easyHandle, NULL);
 
   // setup common curl options
   SetCommonOptions(m_state);
@@ -1207,12 +1598,9 @@ bool CCurlFile::OpenForWrite(const CURL& url, bool bOverWrite)
   m_inError = false;
   m_writeOffset = 0;
 
-  assert(m_state->m_multiHandle);
-
   g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_UPLOAD, 1);
 
-  g_curlInterface.multi_add_handle(m_state->m_multiHandle, m_state->m_easyHandle);
-
+  // the transfer starts with the first write
   m_state->SetReadBuffer(NULL, 0);
 
   return true;
@@ -1223,31 +1611,30 @@ ssize_t CCurlFile::Write(const void* lpBuf, size_t uiBufSize)
   if (!(m_opened && m_forWrite) || m_inError)
     return -1;
 
-  assert(m_state->m_multiHandle);
+  {
+    std::unique_lock<CCriticalSection> lock(m_state->m_section);
+    m_state->SetReadBuffer(lpBuf, uiBufSize);
+    m_state->m_isPaused = false;
+  }
 
-  m_state->SetReadBuffer(lpBuf, uiBufSize);
-  m_state->m_isPaused = false;
-  g_curlInterface.easy_pause(m_state->m_easyHandle, CURLPAUSE_CONT);
+  if (!m_state->m_connected)
+    m_state->Start();
+  else
+    g_curlInterface.GetLoop().Unpause(m_state->m_easyHandle);
 
-  CURLMcode result = CURLM_OK;
+  // the read callback pauses the transfer once it took the whole buffer
+  std::unique_lock<CCriticalSection> lock(m_state->m_section);
+  m_state->m_transferEvent.wait(lock,
+                                [this] { return m_state->m_isPaused || m_state->m_done; });
 
-  m_stillRunning = 1;
-  while (m_stillRunning && !m_state->m_isPaused)
+  m_stillRunning = m_state->m_done ? 0 : 1;
+  if (m_state->m_done && m_state->m_result != CURLE_OK)
   {
-    while ((result = g_curlInterface.multi_perform(m_state->m_multiHandle, &m_stillRunning)) == CURLM_CALL_MULTI_PERFORM);
-
-    if (!m_stillRunning)
-      break;
-
-    if (result != CURLM_OK)
-    {
-      long code;
-      if(g_curlInterface.easy_getinfo(m_state->m_easyHandle, CURLINFO_RESPONSE_CODE, &code) == CURLE_OK )
-        CLog::Log(LOGERROR, "CCurlFile::{} - <{}> Unable to write curl resource with code {}",
-                  __FUNCTION__, CURL::GetRedacted(m_url), code);
-      m_inError = true;
-      return -1;
-    }
+    CLog::Log(LOGERROR, "CCurlFile::{} - <{}> Unable to write curl resource with code {}",
+              __FUNCTION__, CURL::GetRedacted(m_url),
+              m_state->m_httpCode ? m_state->m_httpCode : m_state->m_result);
+    m_inError = true;
+    return -1;
   }
 
   m_writeOffset += m_state->m_filePos;
@@ -1329,7 +1716,8 @@ bool CCurlFile::Exists(const CURL& url)
       g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_FTP_FILEMETHOD, CURLFTPMETHOD_NOCWD);
   }
 
-  CURLcode result = g_curlInterface.easy_perform(m_state->m_easyHandle);
+  CURLcode result =
+      static_cast<CURLcode>(g_curlInterface.GetLoop().Perform(m_state->m_easyHandle));
 
   if (result == CURLE_WRITE_ERROR || result == CURLE_OK)
   {
@@ -1355,7 +1743,8 @@ bool CCurlFile::Exists(const CURL& url)
         list = g_curlInterface.slist_append(list, "Range: bytes=0-1"); /* try to only request 1 byte */
         g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_HTTPHEADER, list);
 
-        CURLcode result = g_curlInterface.easy_perform(m_state->m_easyHandle);
+        CURLcode result =
+            static_cast<CURLcode>(g_curlInterface.GetLoop().Perform(m_state->m_easyHandle));
         g_curlInterface.slist_free_all(list);
 
         if (result == CURLE_WRITE_ERROR || result == CURLE_OK)
@@ -1389,7 +1778,7 @@ bool CCurlFile::Exists(const CURL& url)
 
 int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
 {
-  int64_t nextPos = m_state->m_filePos;
+  int64_t nextPos = m_readAhead ? m_readAheadPos : m_state->m_filePos;
 
   if(!m_seekable)
     return -1;
@@ -1415,6 +1804,13 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
   // We can't seek beyond EOF
   if (m_state->m_fileSize && nextPos > m_state->m_fileSize) return -1;
 
+  if (m_readAhead)
+  {
+    // the segments follow with the next read
+    m_readAheadPos = nextPos;
+    return nextPos;
+  }
+
   if(m_state->Seek(nextPos))
     return nextPos;
 
@@ -1428,8 +1824,7 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
       m_state->m_fileSize = m_oldState->m_fileSize;
       g_curlInterface.easy_acquire(url.GetProtocol().c_str(),
                                   url.GetHostName().c_str(),
-                                  &m_state->m_easyHandle,
-                                  &m_state->m_multiHandle );
+                                  &m_state->m_easyHandle, NULL);
     }
     else
     {
@@ -1457,6 +1852,10 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
   m_state->m_filePos = nextPos;
   m_state->m_sendRange = true;
   m_state->m_bRetry = m_allowRetry;
+  {
+    std::unique_lock<CCriticalSection> lock(m_state->m_section);
+    m_state->m_releasable = true;
+  }
 
   long response = m_state->Connect(m_bufferSize);
   if(response < 0 && (m_state->m_fileSize == 0 || m_state->m_fileSize != m_state->m_filePos))
@@ -1494,9 +1893,30 @@ int64_t CCurlFile::GetLength()
 int64_t CCurlFile::GetPosition()
 {
   if (!m_opened) return 0;
+  if (m_readAhead)
+    return m_readAheadPos;
   return m_state->m_filePos;
 }
 
+ssize_t CCurlFile::Read(void* lpBuf, size_t uiBufSize)
+{
+  if (m_readAhead)
+  {
+    const ssize_t bytesRead = m_readAhead->Read(m_readAheadPos, lpBuf, uiBufSize);
+    if (bytesRead >= 0)
+    {
+      m_readAheadPos += bytesRead;
+      return bytesRead;
+    }
+
+    CLog::Log(LOGERROR, "CCurlFile::{} - <{}> Segmented download failed ({}), continuing with a "
+              "single transfer", __FUNCTION__, CURL::GetRedacted(m_url), strerror(errno));
+    SetReadAhead(false);
+  }
+
+  return m_state->Read(lpBuf, uiBufSize);
+}
+
 int CCurlFile::Stat(const CURL& url, struct __stat64* buffer)
 {
   // if file is already running, get info from it
@@ -1536,7 +1956,8 @@ int CCurlFile::Stat(const CURL& url, struct __stat64* buffer)
       g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_FTP_FILEMETHOD, CURLFTPMETHOD_NOCWD);
   }
 
-  CURLcode result = g_curlInterface.easy_perform(m_state->m_easyHandle);
+  CURLcode result =
+      static_cast<CURLcode>(g_curlInterface.GetLoop().Perform(m_state->m_easyHandle));
 
   if(result == CURLE_HTTP_RETURNED_ERROR)
   {
@@ -1567,7 +1988,7 @@ int CCurlFile::Stat(const CURL& url, struct __stat64* buffer)
 #endif
     g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_NOPROGRESS, 0);
 
-    result = g_curlInterface.easy_perform(m_state->m_easyHandle);
+    result = static_cast<CURLcode>(g_curlInterface.GetLoop().Perform(m_state->m_easyHandle));
 
   }
 
@@ -1678,9 +2099,12 @@ ssize_t CCurlFile::CReadState::Read(void* lpBuf, size_t uiBufSize)
 int8_t CCurlFile::CReadState::FillBuffer(unsigned int want)
 {
   int retry = 0;
-  fd_set fdread;
-  fd_set fdwrite;
-  fd_set fdexcep;
+  std::unique_lock<CCriticalSection> lock(m_section);
+
+  // resume a transfer that was held back by a full buffer once a whole
+  // buffer size fits again
+  if (m_recvPaused && m_buffer.getMaxWriteSize() >= m_bufferSize)
+    Continue(lock);
 
   // only attempt to fill buffer if transactions still running and buffer
   // doesn't exceed required size already
@@ -1704,108 +2128,107 @@ int8_t CCurlFile::CReadState::FillBuffer(unsigned int want)
       continue;
     }
 
-    CURLMcode result = g_curlInterface.multi_perform(m_multiHandle, &m_stillRunning);
-    if (!m_stillRunning)
+    if (m_recvPaused)
+    {
+      Continue(lock);
+      continue;
+    }
+
+    if (m_done)
     {
-      if (result == CURLM_OK)
+      m_stillRunning = 0;
+
+      /* if we still have stuff in buffer, we are fine */
+      if (m_buffer.getMaxReadSize())
+        return FILLBUFFER_OK;
+
+      // check for errors
+      bool bRetryNow = true;
+      bool bError = false;
+      if (m_resultPending)
       {
-        /* if we still have stuff in buffer, we are fine */
-        if (m_buffer.getMaxReadSize())
+        m_resultPending = false;
+        if (m_result == CURLE_OK)
           return FILLBUFFER_OK;
 
-        // check for errors
-        int msgs;
-        CURLMsg* msg;
-        bool bRetryNow = true;
-        bool bError = false;
-        while ((msg = g_curlInterface.multi_info_read(m_multiHandle, &msgs)))
+        if (m_result == CURLE_HTTP_RETURNED_ERROR)
         {
-          if (msg->msg == CURLMSG_DONE)
-          {
-            if (msg->data.result == CURLE_OK)
-              return FILLBUFFER_OK;
-
-            long httpCode = 0;
-            if (msg->data.result == CURLE_HTTP_RETURNED_ERROR)
-            {
-              g_curlInterface.easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &httpCode);
-
-              // Don't log 404 not-found errors to prevent log-spam
-              if (httpCode != 404)
-                CLog::Log(LOGERROR,
-                          "CCurlFile::CReadState::{} - ({}) Failed: HTTP returned code {}",
-                          __FUNCTION__, fmt::ptr(this), httpCode);
-            }
-            else
-            {
-              CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed: {}({})", __FUNCTION__,
-                        fmt::ptr(this), g_curlInterface.easy_strerror(msg->data.result),
-                        msg->data.result);
-            }
-
-            if ( (msg->data.result == CURLE_OPERATION_TIMEDOUT ||
-                  msg->data.result == CURLE_PARTIAL_FILE       ||
-                  msg->data.result == CURLE_COULDNT_CONNECT    ||
-                  msg->data.result == CURLE_RECV_ERROR)        &&
-                  !m_bFirstLoop)
-            {
-              bRetryNow = false; // Leave it to caller whether the operation is retried
-              bError = true;
-            }
-            else if ( (msg->data.result == CURLE_HTTP_RANGE_ERROR              ||
-                       httpCode == 416 /* = Requested Range Not Satisfiable */ ||
-                       httpCode == 406 /* = Not Acceptable (fixes issues with non compliant HDHomerun servers */) &&
-                       m_bFirstLoop                                   &&
-                       m_filePos == 0                                 &&
-                       m_sendRange)
-            {
-              // If server returns a (possible) range error, disable range and retry (handled below)
-              bRetryNow = true;
-              bError = true;
-              m_sendRange = false;
-            }
-            else
-            {
-              // For all other errors, abort the operation
-              return FILLBUFFER_FAIL;
-            }
-          }
+          // Don't log 404 not-found errors to prevent log-spam
+          if (m_httpCode != 404)
+            CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed: HTTP returned code {}",
+                      __FUNCTION__, fmt::ptr(this), m_httpCode);
+        }
+        else
+        {
+          CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed: {}({})", __FUNCTION__,
+                    fmt::ptr(this), g_curlInterface.easy_strerror(static_cast<CURLcode>(m_result)),
+                    m_result);
         }
 
-        // Check for an actual error, if not, just return no-data
-        if (!bError && !m_bLastError)
-          return FILLBUFFER_NO_DATA;
+        if ( (m_result == CURLE_OPERATION_TIMEDOUT ||
+              m_result == CURLE_PARTIAL_FILE       ||
+              m_result == CURLE_COULDNT_CONNECT    ||
+              m_result == CURLE_RECV_ERROR)        &&
+              !m_bFirstLoop)
+        {
+          bRetryNow = false; // Leave it to caller whether the operation is retried
+          bError = true;
+        }
+        else if ( (m_result == CURLE_HTTP_RANGE_ERROR              ||
+                   m_httpCode == 416 /* = Requested Range Not Satisfiable */ ||
+                   m_httpCode == 406 /* = Not Acceptable (fixes issues with non compliant HDHomerun servers */) &&
+                   m_bFirstLoop                                   &&
+                   m_filePos == 0                                 &&
+                   m_sendRange)
+        {
+          // If server returns a (possible) range error, disable range and retry (handled below)
+          bRetryNow = true;
+          bError = true;
+          m_sendRange = false;
+        }
+        else
+        {
+          // For all other errors, abort the operation
+          return FILLBUFFER_FAIL;
+        }
+      }
 
-        // Close handle
-        if (m_multiHandle && m_easyHandle)
-          g_curlInterface.multi_remove_handle(m_multiHandle, m_easyHandle);
+      // Check for an actual error, if not, just return no-data
+      if (!bError && !m_bLastError)
+        return FILLBUFFER_NO_DATA;
 
-        // Reset all the stuff like we would in Disconnect()
-        m_buffer.Clear();
-        free(m_overflowBuffer);
-        m_overflowBuffer = NULL;
-        m_overflowSize = 0;
-        m_bLastError = true; // Flag error for the next run
+      // Close handle
+      lock.unlock();
+      Stop();
+      lock.lock();
 
-        // Retry immediately or leave it up to the caller?
-        if ((m_bRetry && retry < CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_curlretries) || (bRetryNow && retry == 0))
-        {
-          retry++;
+      // Reset all the stuff like we would in Disconnect()
+      m_buffer.Clear();
+      free(m_overflowBuffer);
+      m_overflowBuffer = NULL;
+      m_overflowSize = 0;
+      m_bLastError = true; // Flag error for the next run
 
-          // Connect + seek to current position (again)
-          SetResume();
-          g_curlInterface.multi_add_handle(m_multiHandle, m_easyHandle);
+      // Retry immediately or leave it up to the caller?
+      if ((m_bRetry && retry < CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_curlretries) || (bRetryNow && retry == 0))
+      {
+        retry++;
 
-          CLog::Log(LOGWARNING, "CCurlFile::CReadState::{} - ({}) Reconnect, (re)try {}",
-                    __FUNCTION__, fmt::ptr(this), retry);
+        // Connect + seek to current position (again)
+        SetResume();
+        m_stillRunning = 1;
+        lock.unlock();
+        Start();
+        lock.lock();
 
-          // Return to the beginning of the loop:
-          continue;
-        }
+        CLog::Log(LOGWARNING, "CCurlFile::CReadState::{} - ({}) Reconnect, (re)try {}",
+                  __FUNCTION__, fmt::ptr(this), retry);
 
-        return FILLBUFFER_NO_DATA; // We failed but flag no data to caller, so it can retry the operation
+        // Return to the beginning of the loop:
+        continue;
       }
-      return FILLBUFFER_FAIL;
+
+      return FILLBUFFER_NO_DATA; // We failed but flag no data to caller, so it can retry the operation
     }
 
     // We've finished out first loop
@@ -1815,94 +2238,9 @@ int8_t CCurlFile::CReadState::FillBuffer(unsigned int want)
     // No error this run
     m_bLastError = false;
 
-    switch (result)
-    {
-      case CURLM_OK:
-      {
-        int maxfd = -1;
-        FD_ZERO(&fdread);
-        FD_ZERO(&fdwrite);
-        FD_ZERO(&fdexcep);
-
-        // get file descriptors from the transfers
-        g_curlInterface.multi_fdset(m_multiHandle, &fdread, &fdwrite, &fdexcep, &maxfd);
-
-        long timeout = 0;
-        if (CURLM_OK != g_curlInterface.multi_timeout(m_multiHandle, &timeout) || timeout == -1 || timeout < 200)
-          timeout = 200;
-
-        XbmcThreads::EndTime<> endTime{std::chrono::milliseconds(timeout)};
-        int rc;
-
-        do
-        {
-          /* On success the value of maxfd is guaranteed to be >= -1. We call
-           * select(maxfd + 1, ...); specially in case of (maxfd == -1) there are
-           * no fds ready yet so we call select(0, ...) --or Sleep() on Windows--
-           * to sleep 100ms, which is the minimum suggested value in the
-           * curl_multi_fdset() doc.
-           */
-          if (maxfd == -1)
-          {
-#ifdef TARGET_WINDOWS
-            /* Windows does not support using select() for sleeping without a dummy
-             * socket. Instead use Windows' Sleep() and sleep for 100ms which is the
-             * minimum suggested value in the curl_multi_fdset() doc.
-             */
-            KODI::TIME::Sleep(100ms);
-            rc = 0;
-#else
-            /* Portable sleep for platforms other than Windows. */
-            struct timeval wait = { 0, 100 * 1000 }; /* 100ms */
-            rc = select(0, NULL, NULL, NULL, &wait);
-#endif
-          }
-          else
-          {
-            unsigned int time_left = endTime.GetTimeLeft().count();
-            struct timeval wait = { (int)time_left / 1000, ((int)time_left % 1000) * 1000 };
-            rc = select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &wait);
-          }
-#ifdef TARGET_WINDOWS
-        } while(rc == SOCKET_ERROR && WSAGetLastError() == WSAEINTR);
-#else
-        } while(rc == SOCKET_ERROR && errno == EINTR);
-#endif
-
-        if(rc == SOCKET_ERROR)
-        {
-#ifdef TARGET_WINDOWS
-          char buf[256];
-          strerror_s(buf, 256, WSAGetLastError());
-          CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed with socket error:{}",
-                    __FUNCTION__, fmt::ptr(this), buf);
-#else
-          char const * str = strerror(errno);
-          CLog::Log(LOGERROR, "CCurlFile::CReadState::{} - ({}) Failed with socket error:{}",
-                    __FUNCTION__, fmt::ptr(this), str);
-#endif
-
-          return FILLBUFFER_FAIL;
-        }
-      }
-      break;
-      case CURLM_CALL_MULTI_PERFORM:
-      {
-        // we don't keep calling here as that can easily overwrite our buffer which we want to avoid
-        // docs says we should call it soon after, but as long as we are reading data somewhere
-        // this aught to be soon enough. should stay in socket otherwise
-        continue;
-      }
-      break;
-      default:
-      {
-        CLog::Log(LOGERROR,
-                  "CCurlFile::CReadState::{} - ({}) Multi perform failed with code {}, aborting",
-                  __FUNCTION__, fmt::ptr(this), result);
-        return FILLBUFFER_FAIL;
-      }
-      break;
-    }
+    // the callbacks signal new data and the end of the transfer, the timeout
+    // only makes sure a cancel is noticed
+    m_transferEvent.wait(lock, std::chrono::milliseconds(200));
   }
   return FILLBUFFER_OK;
 }
@@ -2023,12 +2361,11 @@ bool CCurlFile::GetCookies(const CURL &url, std::string &cookies)
   std::string cookiesStr;
   curl_slist* curlCookies;
   CURL_HANDLE* easyHandle;
-  CURLM* multiHandle;
 
   // get the cookies list
   g_curlInterface.easy_acquire(url.GetProtocol().c_str(),
                               url.GetHostName().c_str(),
-                              &easyHandle, &multiHandle);
+                              &easyHandle, NULL);
   if (CURLE_OK == g_curlInterface.easy_getinfo(easyHandle, CURLINFO_COOKIELIST, &curlCookies))
   {
     // iterate over each cookie and format it into an RFC 2109 formatted Set-Cookie string
@@ -2066,7 +2403,7 @@ bool CCurlFile::GetCookies(const CURL &url, std::string &cookies)
     g_curlInterface.slist_free_all(curlCookies);
 
     // release our handles
-    g_curlInterface.easy_release(&easyHandle, &multiHandle);
+    g_curlInterface.easy_release(&easyHandle, NULL);
 
     // if we have a non-empty cookie string, return it
     if (!cookiesStr.empty())
@@ -2091,9 +2428,68 @@ int CCurlFile::IoControl(EIoControl request, void* param)
     return 0;
   }
 
+  if (request == IOCTRL_SET_READAHEAD)
+  {
+    if (!param)
+      return -1;
+    // the number of segments is configured, the request only turns them on or off
+    return SetReadAhead(*static_cast<unsigned int*>(param) > 0) ? 0 : -1;
+  }
+
   return -1;
 }
 
+bool CCurlFile::SetReadAhead(bool enable)
+{
+  if (!m_opened || m_forWrite)
+    return false;
+
+  if (m_readAhead)
+  {
+    m_readAhead.reset();
+
+    // continue with a single transfer where the segments left off
+    m_state->Disconnect();
+    SetCommonOptions(m_state);
+    SetRequestHeaders(m_state);
+    m_state->m_filePos = m_readAheadPos;
+    m_state->m_sendRange = true;
+    m_state->m_bRetry = m_allowRetry;
+    m_state->Connect(m_bufferSize);
+  }
+
+  if (!enable)
+    return true;
+
+  const auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const int segments = settings ? settings->GetInt(CSettings::SETTING_NETWORK_HTTPSEGMENTS) : 0;
+  if (segments <= 0 || !m_seekable)
+    return false;
+
+  // only servers that answer range requests can be downloaded in segments
+  const CURL url(m_url);
+  const CHttpHeader& header = m_state->m_httpheader;
+  if ((!url.IsProtocol("http") && !url.IsProtocol("https")) ||
+      (!StringUtils::EqualsNoCase(header.GetValue("Accept-Ranges"), "bytes") &&
+       header.GetValue("Content-Range").empty()))
+    return false;
+
+  // not worth it for files that fit into a few segments anyway
+  if (m_state->m_fileSize <= static_cast<int64_t>(segments * SEGMENT_SIZE))
+    return false;
+
+  // the transfer of the open would only hold a connection
+  m_readAheadPos = m_state->m_filePos;
+  m_state->Stop();
+  if (m_oldState)
+    m_oldState->Disconnect();
+
+  m_readAhead = std::make_unique<CReadAhead>(*this, segments);
+  CLog::Log(LOGDEBUG, "CCurlFile::{} - <{}> Downloading up to {} segments of {} bytes at once",
+            __FUNCTION__, CURL::GetRedacted(m_url), segments, SEGMENT_SIZE);
+  return true;
+}
+
 const std::string CCurlFile::GetProperty(XFILE::FileProperty type, const std::string &name) const
 {
   switch (type)
@@ -8,11 +8,15 @@
 
 #pragma once
 
+#include "CurlMultiLoop.h"
 #include "IFile.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
 #include "utils/HttpHeader.h"
 #include "utils/RingBuffer.h"
 
 #include <map>
+#include <memory>
 #include <string>
 
 typedef void CURL_HANDLE;
@@ -47,7 +51,7 @@ namespace XFILE
       int Stat(const CURL& url, struct __stat64* buffer) override;
       void Close() override;
       bool ReadString(char *szLine, int iLineLength) override { return m_state->ReadString(szLine, iLineLength); }
-      ssize_t Read(void* lpBuf, size_t uiBufSize) override { return m_state->Read(lpBuf, uiBufSize); }
+      ssize_t Read(void* lpBuf, size_t uiBufSize) override;
       ssize_t Write(const void* lpBuf, size_t uiBufSize) override;
       const std::string GetProperty(XFILE::FileProperty type, const std::string &name = "") const override;
       const std::vector<std::string> GetPropertyValues(XFILE::FileProperty type, const std::string &name = "") const override;
@@ -91,13 +95,12 @@ namespace XFILE
       /* static function that will get cookies stored by CURL in RFC 2109 format */
       static bool GetCookies(const CURL &url, std::string &cookies);
 
-      class CReadState
+      class CReadState : public XCURL::CCurlMultiLoop::ITransfer
       {
       public:
           CReadState();
-          ~CReadState();
+          ~CReadState() override;
           CURL_HANDLE* m_easyHandle;
-          CURLM* m_multiHandle;
 
           CRingBuffer m_buffer; // our ringhold buffer
           unsigned int m_bufferSize;
@@ -123,6 +126,25 @@ namespace XFILE
           curl_slist* m_curlHeaderList;
           curl_slist* m_curlAliasList;
 
+          /* the transfer runs on the curl loop thread, m_section guards what
+           * its callbacks share with the reader */
+          CCriticalSection m_section;
+          XbmcThreads::ConditionVariable m_transferEvent;
+          bool m_connected; // handle is in the loop
+          bool m_recvPaused; // write callback paused the transfer, buffer was full
+          bool m_releasable; // the transfer can restart at its position, see OnReleased()
+          bool m_released; // the loop dropped the paused transfer
+          bool m_done; // transfer finished with m_result
+          bool m_resultPending; // m_result not yet handled by FillBuffer
+          int m_result;
+          long m_httpCode;
+
+          void OnTransferDone(int result) override;
+          void OnReleased() override;
+          void Start();
+          void Continue(std::unique_lock<CCriticalSection>& lock);
+          void Stop();
+
           size_t ReadCallback(char *buffer, size_t size, size_t nitems);
           size_t WriteCallback(char *buffer, size_t size, size_t nitems);
           size_t HeaderCallback(void *ptr, size_t size, size_t nmemb);
@@ -139,16 +161,21 @@ namespace XFILE
       };
 
     protected:
+      class CReadAhead;
+
       void ParseAndCorrectUrl(CURL &url);
       void SetCommonOptions(CReadState* state, bool failOnError = true);
       void SetRequestHeaders(CReadState* state);
       void SetCorrectHeaders(CReadState* state);
       bool Service(const std::string& strURL, std::string& strHTML);
       std::string GetInfoString(int infoType);
+      bool SetReadAhead(bool enable);
 
     protected:
       CReadState* m_state;
       CReadState* m_oldState;
+      std::unique_ptr<CReadAhead> m_readAhead;
+      int64_t m_readAheadPos = 0; // the segments don't move the position of m_state
       unsigned int m_bufferSize;
       int64_t m_writeOffset = 0;
 
@@ -0,0 +1,288 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CurlMultiLoop.h"
+
+#include "DllLibCurl.h"
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/log.h"
+
+#include <mutex>
+
+using namespace XCURL;
+
+namespace
+{
+// a paused transfer holds its connection and a place of the connection limit of the host
+constexpr std::chrono::seconds PAUSE_RELEASE_TIME(10);
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+// how long the loop sleeps without activity, commands wake it up earlier
+constexpr int POLL_TIMEOUT_MS = 1000;
+#else
+// without curl_multi_wakeup() new commands are only seen after the timeout
+constexpr int WAIT_TIMEOUT_MS = 10;
+#endif
+} // unnamed namespace
+
+CCurlMultiLoop::CCurlMultiLoop() : CThread("CurlMultiLoop")
+{
+  m_multi = curl_multi_init();
+
+  // transfers to a host share its connections, HTTP/2 ones on a single connection
+  curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+  const auto advancedSettings = CServiceBroker::GetSettingsComponent()
+                                    ? CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()
+                                    : nullptr;
+  if (advancedSettings && advancedSettings->m_curlMaxHostConnections > 0)
+    curl_multi_setopt(m_multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(advancedSettings->m_curlMaxHostConnections));
+
+  Create();
+}
+
+CCurlMultiLoop::~CCurlMultiLoop()
+{
+  m_bStop = true;
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  curl_multi_wakeup(m_multi);
+#endif
+  StopThread();
+
+  for (const auto& transfer : m_transfers)
+    curl_multi_remove_handle(m_multi, transfer.first);
+  curl_multi_cleanup(m_multi);
+}
+
+void CCurlMultiLoop::Add(CURL_HANDLE* easy, ITransfer* transfer)
+{
+  Queue({CommandType::ADD, easy, transfer});
+}
+
+void CCurlMultiLoop::Remove(CURL_HANDLE* easy)
+{
+  Queue({CommandType::REMOVE, easy, nullptr});
+}
+
+void CCurlMultiLoop::Unpause(CURL_HANDLE* easy)
+{
+  Queue({CommandType::UNPAUSE, easy, nullptr});
+}
+
+void CCurlMultiLoop::Paused(CURL_HANDLE* easy)
+{
+  std::unique_lock<CCriticalSection> lock(m_handleSection);
+  m_paused.emplace(easy, std::chrono::steady_clock::now());
+}
+
+int CCurlMultiLoop::Perform(CURL_HANDLE* easy)
+{
+  class CBlockingTransfer : public ITransfer
+  {
+  public:
+    void OnTransferDone(int result) override
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      m_result = result;
+      m_done = true;
+      m_finished.notifyAll();
+    }
+
+    int Wait()
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      m_finished.wait(lock, [this] { return m_done; });
+      return m_result;
+    }
+
+  private:
+    CCriticalSection m_section;
+    XbmcThreads::ConditionVariable m_finished;
+    bool m_done = false;
+    int m_result = CURLE_OK;
+  };
+
+  CBlockingTransfer transfer;
+  Add(easy, &transfer);
+  const int result = transfer.Wait();
+  Remove(easy);
+  return result;
+}
+
+std::map<std::string, CCurlMultiLoop::HostStats> CCurlMultiLoop::GetStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_commandSection);
+  return m_stats;
+}
+
+void CCurlMultiLoop::Queue(const Command& command)
+{
+  uint64_t ticket;
+  {
+    std::unique_lock<CCriticalSection> lock(m_commandSection);
+    m_commands.push_back(command);
+    ticket = ++m_queued;
+  }
+
+  if (IsCurrentThread())
+  {
+    // called from a callback, the command runs on the next round
+    return;
+  }
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  curl_multi_wakeup(m_multi);
+#endif
+
+  // removed handles must not see callbacks anymore when the caller continues
+  if (command.type == CommandType::REMOVE)
+  {
+    std::unique_lock<CCriticalSection> lock(m_commandSection);
+    m_commandsDone.wait(lock, [this, ticket] { return m_done >= ticket; });
+  }
+}
+
+void CCurlMultiLoop::RunCommands()
+{
+  std::deque<Command> commands;
+  {
+    std::unique_lock<CCriticalSection> lock(m_commandSection);
+    commands.swap(m_commands);
+  }
+  if (commands.empty())
+    return;
+
+  for (const Command& command : commands)
+  {
+    switch (command.type)
+    {
+      case CommandType::ADD:
+        if (curl_multi_add_handle(m_multi, command.easy) == CURLM_OK)
+          m_transfers[command.easy] = command.transfer;
+        else
+          command.transfer->OnTransferDone(CURLE_FAILED_INIT);
+        break;
+      case CommandType::REMOVE:
+        m_paused.erase(command.easy);
+        if (m_transfers.erase(command.easy))
+          curl_multi_remove_handle(m_multi, command.easy);
+        break;
+      case CommandType::UNPAUSE:
+        m_paused.erase(command.easy);
+        if (m_transfers.find(command.easy) != m_transfers.end())
+          curl_easy_pause(command.easy, CURLPAUSE_CONT);
+        break;
+    }
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_commandSection);
+  m_done += commands.size();
+  m_commandsDone.notifyAll();
+}
+
+void CCurlMultiLoop::Finish(CURL_HANDLE* easy, int result)
+{
+  const auto it = m_transfers.find(easy);
+  if (it == m_transfers.end())
+    return;
+
+  char* url = nullptr;
+  long connections = 0;
+  double time = 0.0;
+  curl_easy_getinfo(easy, CURLINFO_EFFECTIVE_URL, &url);
+  curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connections);
+  curl_easy_getinfo(easy, CURLINFO_TOTAL_TIME, &time);
+#if LIBCURL_VERSION_NUM >= 0x073700 // 7.55.0
+  curl_off_t bytes = 0;
+  curl_easy_getinfo(easy, CURLINFO_SIZE_DOWNLOAD_T, &bytes);
+#else
+  double bytes = 0.0;
+  curl_easy_getinfo(easy, CURLINFO_SIZE_DOWNLOAD, &bytes);
+#endif
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_commandSection);
+    HostStats& stats = m_stats[url ? CURL(url).GetHostName() : ""];
+    stats.transfers++;
+    if (result != CURLE_OK)
+      stats.failed++;
+    stats.connections += connections;
+    stats.bytesReceived += static_cast<uint64_t>(bytes);
+    stats.transferTime += time;
+  }
+
+  // the transfer stays in the multi handle until it is removed
+  it->second->OnTransferDone(result);
+}
+
+void CCurlMultiLoop::ReleasePaused()
+{
+  const auto now = std::chrono::steady_clock::now();
+  for (auto it = m_paused.begin(); it != m_paused.end();)
+  {
+    if (now - it->second < PAUSE_RELEASE_TIME)
+    {
+      ++it;
+      continue;
+    }
+
+    const auto transfer = m_transfers.find(it->first);
+    if (transfer != m_transfers.end())
+    {
+      // an unfinished transfer does not give its connection back to the pool, it is closed
+      curl_multi_remove_handle(m_multi, it->first);
+      ITransfer* released = transfer->second;
+      m_transfers.erase(transfer);
+      released->OnReleased();
+    }
+    it = m_paused.erase(it);
+  }
+}
+
+void CCurlMultiLoop::Process()
+{
+  while (!m_bStop)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_handleSection);
+      RunCommands();
+
+      int running = 0;
+      const CURLMcode code = curl_multi_perform(m_multi, &running);
+      if (code != CURLM_OK)
+        CLog::Log(LOGERROR, "CCurlMultiLoop::{} - Multi perform failed with code {}", __FUNCTION__,
+                  code);
+
+      int queued = 0;
+      while (CURLMsg* msg = curl_multi_info_read(m_multi, &queued))
+      {
+        if (msg->msg == CURLMSG_DONE)
+          Finish(msg->easy_handle, msg->data.result);
+      }
+
+      ReleasePaused();
+    }
+
+    {
+      // commands queued by the callbacks
+      std::unique_lock<CCriticalSection> lock(m_commandSection);
+      if (!m_commands.empty())
+        continue;
+    }
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+    curl_multi_poll(m_multi, nullptr, 0, POLL_TIMEOUT_MS, nullptr);
+#else
+    curl_multi_wait(m_multi, nullptr, 0, WAIT_TIMEOUT_MS, nullptr);
+#endif
+  }
+}
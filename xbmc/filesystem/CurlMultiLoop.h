@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <stdint.h>
+#include <string>
+
+typedef void CURL_HANDLE;
+typedef void CURLM;
+
+namespace XCURL
+{
+
+/*!
+ * \brief Runs the curl transfers of all callers on one multi handle and thread
+ *
+ * The multi handle owns the connection pool, so transfers to the same host
+ * reuse connections no matter which file opened them, and HTTP/2 transfers are
+ * multiplexed on a single connection. The number of connections per host is
+ * limited by the curlmaxhostconnections advanced setting, transfers beyond it
+ * wait inside curl for a free connection. A paused transfer keeps its
+ * connection, transfers that can restart at their position report their pause
+ * with Paused() and are dropped if they are not continued soon.
+ *
+ * Callbacks of the transfers (write, read, header, progress) are called on the
+ * loop thread with the handle lock held, see GetHandleLock(). Callers must not
+ * hold locks that these callbacks take while calling into the loop.
+ */
+class CCurlMultiLoop : private CThread
+{
+public:
+  class ITransfer
+  {
+  public:
+    virtual ~ITransfer() = default;
+
+    /*!
+     * \brief Called on the loop thread once the transfer finished
+     * \param result The CURLcode of the transfer
+     */
+    virtual void OnTransferDone(int result) = 0;
+
+    /*!
+     * \brief Called on the loop thread once the loop dropped the transfer and
+     * closed its connection, because it stayed paused too long, see Paused()
+     *
+     * The handle is not in the loop anymore, Add() it again to continue.
+     */
+    virtual void OnReleased() {}
+  };
+
+  struct HostStats
+  {
+    uint64_t transfers = 0; // finished transfers
+    uint64_t failed = 0;
+    uint64_t connections = 0; // connections opened, the others were reused
+    uint64_t bytesReceived = 0;
+    double transferTime = 0.0; // seconds, summed over all transfers
+  };
+
+  CCurlMultiLoop();
+  ~CCurlMultiLoop() override;
+
+  /*!
+   * \brief Start the transfer of a configured easy handle
+   */
+  void Add(CURL_HANDLE* easy, ITransfer* transfer);
+
+  /*!
+   * \brief Stop the transfer of the handle, if running, and wait until no
+   * callback of it can be called anymore
+   */
+  void Remove(CURL_HANDLE* easy);
+
+  /*!
+   * \brief Continue a transfer that paused itself in a callback
+   */
+  void Unpause(CURL_HANDLE* easy);
+
+  /*!
+   * \brief Report that a transfer paused itself in a callback and can be
+   * dropped, to free its connection for other transfers to the host, when it
+   * is not continued within a few seconds. Only called from a callback.
+   */
+  void Paused(CURL_HANDLE* easy);
+
+  /*!
+   * \brief Run the transfer of the handle to its end, like curl_easy_perform()
+   * \return The CURLcode of the transfer
+   */
+  int Perform(CURL_HANDLE* easy);
+
+  /*!
+   * \brief The lock held by the loop thread while it works on handles, take it
+   * to read the info of a handle in a transfer
+   */
+  CCriticalSection& GetHandleLock() { return m_handleSection; }
+
+  std::map<std::string, HostStats> GetStats() const;
+
+private:
+  enum class CommandType
+  {
+    ADD,
+    REMOVE,
+    UNPAUSE,
+  };
+
+  struct Command
+  {
+    CommandType type;
+    CURL_HANDLE* easy;
+    ITransfer* transfer;
+  };
+
+  void Process() override;
+  void Queue(const Command& command);
+  void RunCommands();
+  void Finish(CURL_HANDLE* easy, int result);
+  void ReleasePaused();
+
+  CURLM* m_multi = nullptr;
+
+  CCriticalSection m_handleSection;
+  std::map<CURL_HANDLE*, ITransfer*> m_transfers;
+  std::map<CURL_HANDLE*, std::chrono::steady_clock::time_point> m_paused;
+
+  mutable CCriticalSection m_commandSection;
+  XbmcThreads::ConditionVariable m_commandsDone;
+  std::deque<Command> m_commands;
+  uint64_t m_queued = 0;
+  uint64_t m_done = 0;
+  std::map<std::string, HostStats> m_stats;
+};
+
+} // namespace XCURL
@@ -123,6 +123,9 @@ DllLibCurlGlobal::DllLibCurlGlobal()
 
 DllLibCurlGlobal::~DllLibCurlGlobal()
 {
+  // stop the transfers before their handles go away
+  m_loop.reset();
+
   for (auto& session : m_sessions)
   {
     if (session.m_multi && session.m_easy)
@@ -136,6 +139,14 @@ DllLibCurlGlobal::~DllLibCurlGlobal()
   curl_global_cleanup();
 }
 
+CCurlMultiLoop& DllLibCurlGlobal::GetLoop()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (!m_loop)
+    m_loop = std::make_unique<CCurlMultiLoop>();
+  return *m_loop;
+}
+
 void DllLibCurlGlobal::CheckIdle()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -8,8 +8,11 @@
 
 #pragma once
 
+#include "CurlMultiLoop.h"
 #include "threads/CriticalSection.h"
 
+#include <memory>
+#include <mutex>
 #include <stdio.h>
 #include <string>
 #include <sys/time.h>
@@ -80,8 +83,20 @@ public:
                       CURL_HANDLE** easy_out,
                       CURLM** multi_out);
   CURL_HANDLE* easy_duphandle(CURL_HANDLE* easy_handle) override;
+  template<typename... Args>
+  CURLcode easy_getinfo(CURL_HANDLE* curl, CURLINFO info, Args... args)
+  {
+    // the handle may be in a transfer run by the loop thread
+    std::unique_lock<CCriticalSection> lock(GetLoop().GetHandleLock());
+    return DllLibCurl::easy_getinfo(curl, info, std::forward<Args>(args)...);
+  }
   void CheckIdle();
 
+  /*!
+   * \brief The loop running the transfers of all sessions, started on first use
+   */
+  CCurlMultiLoop& GetLoop();
+
   /* overloaded load and unload with reference counter */
 
   /* structure holding a session info */
@@ -100,6 +115,9 @@ public:
 
   VEC_CURLSESSIONS m_sessions;
   CCriticalSection m_critSection;
+
+private:
+  std::unique_ptr<CCurlMultiLoop> m_loop;
 };
 } // namespace XCURL
 
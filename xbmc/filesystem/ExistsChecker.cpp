@@ -0,0 +1,179 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ExistsChecker.h"
+
+#include "Directory.h"
+#include "File.h"
+#include "FileItem.h"
+#include "URL.h"
+#include "utils/JobGroup.h"
+#include "utils/URIUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+namespace
+{
+// below this many files a folder is cheaper to check file by file than to list
+constexpr size_t MIN_LISTING_FILES = 3;
+
+constexpr auto PROGRESS_INTERVAL = 100ms;
+} // unnamed namespace
+
+CExistsChecker::CExistsChecker(unsigned int hostConnections)
+  : m_hostConnections(std::max(hostConnections, 1u))
+{
+}
+
+size_t CExistsChecker::AddFile(const std::string& path)
+{
+  m_paths.push_back({path, false});
+  return m_paths.size() - 1;
+}
+
+size_t CExistsChecker::AddDirectory(const std::string& path)
+{
+  m_paths.push_back({path, true});
+  return m_paths.size() - 1;
+}
+
+bool CExistsChecker::Run(const std::function<bool(size_t checked, size_t total)>& progress)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  // the files of a folder become one task, folders are checked on their own
+  std::map<std::string, std::vector<Task>> hosts;
+  std::map<std::string, size_t> folderTasks;
+  for (size_t i = 0; i < m_paths.size(); i++)
+  {
+    const CURL url(m_paths[i].path);
+    std::vector<Task>& tasks = hosts[url.GetProtocol() + "://" + url.GetHostName()];
+    if (m_paths[i].directory)
+    {
+      tasks.push_back({m_paths[i].path, {i}});
+      continue;
+    }
+
+    const std::string folder = URIUtils::GetDirectory(m_paths[i].path);
+    const auto it = folderTasks.emplace(folder, tasks.size());
+    if (it.second)
+      tasks.push_back({folder, {}});
+    tasks[it.first->second].paths.push_back(i);
+  }
+
+  CJobGroup jobs(m_hostConnections);
+  for (auto& host : hosts)
+  {
+    for (Task& task : host.second)
+    {
+      jobs.Submit(host.first, [this, task = std::move(task)] {
+        Check(task);
+        std::unique_lock<CCriticalSection> lock(m_section);
+        m_pathsChecked += task.paths.size();
+      });
+    }
+  }
+
+  bool cancelled = false;
+  if (progress)
+  {
+    cancelled = !jobs.Wait(PROGRESS_INTERVAL, [this, &progress] {
+      size_t checked;
+      {
+        std::unique_lock<CCriticalSection> lock(m_section);
+        checked = m_pathsChecked;
+      }
+      return progress(checked, m_paths.size());
+    });
+    // running checks finish, the queued ones are dropped
+    if (cancelled)
+      jobs.Cancel();
+  }
+  jobs.Wait();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  m_stats.paths = m_paths.size();
+  m_stats.missing = std::count_if(m_paths.begin(), m_paths.end(),
+                                  [](const Path& path) { return !path.exists; });
+  m_stats.seconds = elapsed.count();
+  return !cancelled;
+}
+
+void CExistsChecker::Check(const Task& task)
+{
+  if (task.paths.size() == 1 && m_paths[task.paths[0]].directory)
+  {
+    Path& path = m_paths[task.paths[0]];
+    path.exists = CDirectory::Exists(path.path, false);
+
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_stats.requests++;
+    return;
+  }
+
+  CheckFiles(task);
+}
+
+void CExistsChecker::CheckFiles(const Task& task)
+{
+  size_t listings = 0;
+  size_t requests = 0;
+  bool listed = false;
+  std::set<std::string> files;
+
+  if (task.paths.size() >= MIN_LISTING_FILES)
+  {
+    CFileItemList items;
+    listings++;
+    listed = CDirectory::GetDirectory(task.folder, items, "",
+                                      DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO |
+                                          DIR_FLAG_GET_HIDDEN | DIR_FLAG_BYPASS_CACHE);
+    if (listed)
+    {
+      for (const auto& item : items)
+        files.insert(item->GetPath());
+    }
+    else
+    {
+      // a folder that is gone takes its files with it
+      requests++;
+      if (!CDirectory::Exists(task.folder, false))
+      {
+        std::unique_lock<CCriticalSection> lock(m_section);
+        m_stats.listings += listings;
+        m_stats.requests += requests;
+        return;
+      }
+    }
+  }
+
+  for (const size_t index : task.paths)
+  {
+    Path& path = m_paths[index];
+    if (listed && files.find(path.path) != files.end())
+    {
+      path.exists = true;
+      continue;
+    }
+
+    // listings may spell a path differently, confirm a file that is missing in one
+    requests++;
+    path.exists = CFile::Exists(path.path, false);
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_section);
+  m_stats.listings += listings;
+  m_stats.requests += requests;
+}
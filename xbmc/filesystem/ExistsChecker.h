@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace XFILE
+{
+
+/*!
+ * \brief Checks whether many files and folders exist, several at once per host
+ *
+ * Cleaning a library checks every one of its items. The paths are grouped by
+ * the host they are on and every host runs a limited number of checks at once,
+ * so a slow share doesn't hold up the others and no server gets flooded.
+ * Files in the same folder are checked with one listing of the folder instead
+ * of a request per file.
+ */
+class CExistsChecker
+{
+public:
+  struct Stats
+  {
+    size_t paths = 0;
+    size_t missing = 0;
+    size_t listings = 0; //!< folders listed to check their files
+    size_t requests = 0; //!< single files and folders checked
+    double seconds = 0.0;
+  };
+
+  /*!
+   * \param hostConnections Number of checks running at once per host
+   */
+  explicit CExistsChecker(unsigned int hostConnections);
+
+  /*!
+   * \brief Add a file to check
+   * \return The index of the file for Exists()
+   */
+  size_t AddFile(const std::string& path);
+
+  /*!
+   * \brief Add a folder to check
+   * \return The index of the folder for Exists()
+   */
+  size_t AddDirectory(const std::string& path);
+
+  /*!
+   * \brief Check all paths added
+   * \param progress Called regularly on the calling thread with the number of
+   * paths checked so far and the total, return false to cancel the checks
+   * \return false if the checks were cancelled
+   */
+  bool Run(const std::function<bool(size_t checked, size_t total)>& progress = nullptr);
+
+  bool Exists(size_t index) const { return m_paths[index].exists; }
+
+  const Stats& GetStats() const { return m_stats; }
+
+private:
+  struct Path
+  {
+    std::string path;
+    bool directory;
+    bool exists = false;
+  };
+
+  //! The files of a folder, or a single folder
+  struct Task
+  {
+    std::string folder;
+    std::vector<size_t> paths;
+  };
+
+  void Check(const Task& task);
+  void CheckFiles(const Task& task);
+
+  const unsigned int m_hostConnections;
+  std::vector<Path> m_paths;
+
+  CCriticalSection m_section;
+  size_t m_pathsChecked = 0;
+  Stats m_stats;
+};
+
+} // namespace XFILE
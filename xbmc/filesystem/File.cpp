@@ -29,6 +29,12 @@
 
 using namespace XFILE;
 
+namespace
+{
+// reads kept in flight for files opened with READ_AHEAD
+constexpr unsigned int READ_AHEAD_REQUESTS = 8;
+} // namespace
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -364,6 +370,12 @@ bool CFile::Open(const CURL& file, const unsigned int flags)
       return false;
     }
 
+    if (m_flags & READ_AHEAD)
+    {
+      unsigned int requests = READ_AHEAD_REQUESTS;
+      m_pFile->IoControl(IOCTRL_SET_READAHEAD, &requests);
+    }
+
     if (ShouldUseStreamBuffer(url))
     {
       m_pBuffer = std::make_unique<CFileStreamBuffer>(0);
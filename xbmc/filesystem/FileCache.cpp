@@ -104,7 +104,8 @@ bool CFileCache::Open(const CURL& url)
   // Opening the source file.
   // The READ_NO_CACHE and READ_NO_BUFFER flags are required to avoid create other intances of
   // FileCache or StreamBuffer since CFile::Open is called again in loop
-  if (!m_source.Open(url.Get(), READ_NO_CACHE | READ_TRUNCATED | READ_NO_BUFFER))
+  // READ_AHEAD keeps several reads of local sources in flight while the cache is filled
+  if (!m_source.Open(url.Get(), READ_NO_CACHE | READ_TRUNCATED | READ_NO_BUFFER | READ_AHEAD))
   {
     CLog::Log(LOGERROR, "CFileCache::{} - <{}> failed to open", __FUNCTION__, m_sourcePath);
     Close();
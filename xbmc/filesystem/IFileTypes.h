@@ -43,6 +43,9 @@ namespace XFILE
 /* indicate that caller want open a file without intermediate buffer regardless to file type */
   static const unsigned int READ_NO_BUFFER = 0x200;
 
+/* indicate that caller reads the file mostly sequentially and wants reads issued ahead (if supported) */
+  static const unsigned int READ_AHEAD = 0x400;
+
 struct SNativeIoControl
 {
   unsigned long int   request;
@@ -74,6 +77,7 @@ typedef enum {
   IOCTRL_CACHE_SETRATE = 4,  /**< unsigned int with speed limit for caching in bytes per second */
   IOCTRL_SET_CACHE     = 8,  /**< CFileCache */
   IOCTRL_SET_RETRY     = 16, /**< Enable/disable retry within the protocol handler (if supported) */
+  IOCTRL_SET_READAHEAD = 32, /**< unsigned int with the number of reads to keep in flight ahead of the position, 0 to disable. Network protocols use their configured number instead */
 } EIoControl;
 
 enum CURLOPTIONTYPE
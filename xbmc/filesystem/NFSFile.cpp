@@ -12,6 +12,7 @@
 
 #include "NFSFile.h"
 
+#include "ReadAheadBuffer.h"
 #include "ServiceBroker.h"
 #include "network/DNSNameCache.h"
 #include "settings/AdvancedSettings.h"
@@ -21,6 +22,8 @@
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
 #include <inttypes.h>
 #include <mutex>
 
@@ -30,6 +33,8 @@
 #ifdef TARGET_WINDOWS
 #include <fcntl.h>
 #include <sys\stat.h>
+#else
+#include <poll.h>
 #endif
 
 #if defined(TARGET_WINDOWS)
@@ -57,6 +62,24 @@ constexpr int NFS4ERR_EXPIRED = -11; // client session expired due idle time gre
 
 constexpr auto SETTING_NFS_VERSION = "nfs.version";
 constexpr auto SETTING_NFS_CHUNKSIZE = "nfs.chunksize";
+constexpr auto SETTING_NFS_READAHEAD = "nfs.readahead";
+
+constexpr int READ_AHEAD_POLL_INTERVAL_MS = 100;
+
+int PollContext(struct nfs_context* context, int timeoutMs)
+{
+  struct pollfd pfd = {};
+  pfd.fd = nfs_get_fd(context);
+  pfd.events = nfs_which_events(context);
+#if defined(TARGET_WINDOWS)
+  if (WSAPoll(&pfd, 1, timeoutMs) < 0)
+#else
+  if (poll(&pfd, 1, timeoutMs) < 0 && errno != EINTR)
+#endif
+    return -1;
+
+  return nfs_service(context, pfd.revents);
+}
 } // unnamed namespace
 
 CNfsConnection::CNfsConnection()
@@ -581,6 +604,111 @@ void CNfsConnection::setOptions(struct nfs_context* context)
 
 CNfsConnection gNfsConnection;
 
+namespace XFILE
+{
+/*!
+ * \brief Read-ahead with asynchronous reads on the NFS context of the file
+ *
+ * The replies are processed by whichever thread drives the context next, all
+ * of them hold the connection lock while doing so.
+ */
+class CNFSReadAhead : public CReadAheadBuffer
+{
+public:
+  CNFSReadAhead(struct nfs_context* context,
+                struct nfsfh* fileHandle,
+                size_t chunkSize,
+                unsigned int depth)
+    : CReadAheadBuffer(chunkSize, depth),
+      m_context(context),
+      m_fileHandle(fileHandle),
+      m_generations(GetDepth(), 0)
+  {
+  }
+
+  ~CNFSReadAhead() override
+  {
+    std::unique_lock<CCriticalSection> lock(gNfsConnection);
+    WaitAll();
+    // replies of reads that were given up find the object gone
+    m_alive.reset();
+  }
+
+protected:
+  // implementation of CReadAheadBuffer
+  void Submit(Chunk& chunk) override
+  {
+    std::unique_lock<CCriticalSection> lock(gNfsConnection);
+
+    const size_t index = IndexOf(chunk);
+    auto request = std::make_unique<Request>(Request{m_alive, this, index, ++m_generations[index]});
+    chunk.state = ChunkState::PENDING;
+    if (nfs_pread_async(m_context, m_fileHandle, chunk.offset, m_chunkSize, OnRead,
+                        request.get()) != 0)
+    {
+      CLog::Log(LOGERROR, "NFS: Failed to queue read ahead ({})", nfs_get_error(m_context));
+      Fail(chunk);
+      return;
+    }
+    // owned by the callback now
+    request.release();
+  }
+
+  void Wait(Chunk& chunk) override
+  {
+    std::unique_lock<CCriticalSection> lock(gNfsConnection);
+    while (chunk.state == ChunkState::PENDING)
+    {
+      if (PollContext(m_context, READ_AHEAD_POLL_INTERVAL_MS) < 0)
+      {
+        CLog::Log(LOGERROR, "NFS: Failed to read ahead ({})", nfs_get_error(m_context));
+        Fail(chunk);
+      }
+    }
+  }
+
+private:
+  struct Request
+  {
+    std::weak_ptr<bool> alive;
+    CNFSReadAhead* owner;
+    size_t index;
+    uint64_t generation;
+  };
+
+  static void OnRead(int status, struct nfs_context* nfs, void* data, void* privateData)
+  {
+    std::unique_ptr<Request> request(static_cast<Request*>(privateData));
+    if (request->alive.expired() ||
+        request->owner->m_generations[request->index] != request->generation)
+      return;
+
+    Chunk& chunk = request->owner->GetChunk(request->index);
+    if (status >= 0)
+    {
+      chunk.result = std::min<ssize_t>(status, request->owner->m_chunkSize);
+      std::memcpy(chunk.data.get(), data, chunk.result);
+    }
+    else
+      chunk.result = status;
+    chunk.state = ChunkState::DONE;
+  }
+
+  void Fail(Chunk& chunk)
+  {
+    // a late reply must not touch the chunk anymore
+    m_generations[IndexOf(chunk)]++;
+    chunk.result = -EIO;
+    chunk.state = ChunkState::DONE;
+  }
+
+  struct nfs_context* const m_context;
+  struct nfsfh* const m_fileHandle;
+  std::vector<uint64_t> m_generations;
+  std::shared_ptr<bool> m_alive = std::make_shared<bool>(true);
+};
+} // namespace XFILE
+
 CNFSFile::CNFSFile()
 : m_pFileHandle(NULL)
 , m_pNfsContext(NULL)
@@ -602,6 +730,9 @@ int64_t CNFSFile::GetPosition()
 
   if (gNfsConnection.GetNfsContext() == NULL || m_pFileHandle == NULL) return 0;
 
+  if (m_readAhead)
+    return m_readAheadPos;
+
   ret = nfs_lseek(gNfsConnection.GetNfsContext(), m_pFileHandle, 0, SEEK_CUR, &offset);
 
   if (ret < 0)
@@ -617,6 +748,57 @@ int64_t CNFSFile::GetLength()
   return m_fileSize;
 }
 
+int CNFSFile::IoControl(EIoControl request, void* param)
+{
+  switch (request)
+  {
+    case IOCTRL_SEEK_POSSIBLE:
+      return 1;
+    case IOCTRL_SET_READAHEAD:
+      if (!param)
+        return -1;
+      // the depth is configured per protocol, the request only turns it on or off
+      return SetReadAhead(*static_cast<unsigned int*>(param) > 0) ? 0 : -1;
+    default:
+      return -1;
+  }
+}
+
+bool CNFSFile::SetReadAhead(bool enable)
+{
+  std::unique_lock<CCriticalSection> lock(gNfsConnection);
+  if (m_pFileHandle == NULL || m_pNfsContext == NULL)
+    return false;
+
+  if (m_readAhead)
+  {
+    m_readAhead.reset();
+    // continue the plain reads where the reads ahead left off
+    uint64_t offset = 0;
+    nfs_lseek(m_pNfsContext, m_pFileHandle, m_readAheadPos, SEEK_SET, &offset);
+  }
+
+  if (!enable)
+    return true;
+
+  const auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const int depth = settings ? settings->GetInt(SETTING_NFS_READAHEAD) : 0;
+  const uint64_t chunkSize = gNfsConnection.GetMaxReadChunkSize();
+  // not worth it for files that fit into a few requests anyway
+  if (depth <= 0 || chunkSize == 0 || m_fileSize <= static_cast<int64_t>(depth * chunkSize))
+    return false;
+
+  uint64_t offset = 0;
+  if (nfs_lseek(m_pNfsContext, m_pFileHandle, 0, SEEK_CUR, &offset) < 0)
+    return false;
+
+  m_readAheadPos = static_cast<int64_t>(offset);
+  m_readAhead = std::make_unique<CNFSReadAhead>(m_pNfsContext, m_pFileHandle, chunkSize, depth);
+  CLog::Log(LOGDEBUG, "NFS: reading ahead {} chunks of {} bytes for {}", depth, chunkSize,
+            m_url.GetFileName());
+  return true;
+}
+
 bool CNFSFile::Open(const CURL& url)
 {
   Close();
@@ -675,6 +857,7 @@ bool CNFSFile::Open(const CURL& url)
   }
 
   m_fileSize = tmpBuffer.st_size;//cache the size of this file
+  m_readAheadPos = 0;
   // We've successfully opened the file!
   return true;
 }
@@ -742,6 +925,21 @@ ssize_t CNFSFile::Read(void *lpBuf, size_t uiBufSize)
   if (m_pFileHandle == NULL || m_pNfsContext == NULL )
     return -1;
 
+  if (m_readAhead)
+  {
+    numberOfBytesRead = m_readAhead->Read(m_readAheadPos, lpBuf, uiBufSize);
+    if (numberOfBytesRead >= 0)
+    {
+      m_readAheadPos += numberOfBytesRead;
+      lock.unlock();
+      gNfsConnection.resetKeepAlive(m_exportPath, m_pFileHandle);
+      return numberOfBytesRead;
+    }
+
+    CLog::Log(LOGERROR, "{} - Reading ahead failed, continuing with single reads", __FUNCTION__);
+    SetReadAhead(false);
+  }
+
   numberOfBytesRead = nfs_read(m_pNfsContext, m_pFileHandle, uiBufSize, (char *)lpBuf);
 
   lock.unlock(); //no need to keep the connection lock after that
@@ -764,6 +962,11 @@ int64_t CNFSFile::Seek(int64_t iFilePosition, int iWhence)
   std::unique_lock<CCriticalSection> lock(gNfsConnection);
   if (m_pFileHandle == NULL || m_pNfsContext == NULL) return -1;
 
+  if (m_readAhead && iWhence == SEEK_CUR)
+  {
+    iFilePosition += m_readAheadPos;
+    iWhence = SEEK_SET;
+  }
 
   ret = nfs_lseek(m_pNfsContext, m_pFileHandle, iFilePosition, iWhence, &offset);
   if (ret < 0)
@@ -772,6 +975,7 @@ int64_t CNFSFile::Seek(int64_t iFilePosition, int iWhence)
               iFilePosition, iWhence, m_fileSize, nfs_get_error(m_pNfsContext));
     return -1;
   }
+  m_readAheadPos = static_cast<int64_t>(offset);
   return (int64_t)offset;
 }
 
@@ -804,6 +1008,7 @@ void CNFSFile::Close()
     // remove it from keep alive list before closing
     // so keep alive code doesn't process it anymore
     gNfsConnection.removeFromKeepAliveList(m_pFileHandle);
+    m_readAhead.reset();
     ret = nfs_close(m_pNfsContext, m_pFileHandle);
 
 	  if (ret < 0)
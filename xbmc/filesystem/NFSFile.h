@@ -17,6 +17,7 @@
 #include <chrono>
 #include <list>
 #include <map>
+#include <memory>
 
 struct nfs_stat_64;
 
@@ -108,6 +109,8 @@ extern CNfsConnection gNfsConnection;
 
 namespace XFILE
 {
+  class CNFSReadAhead;
+
   class CNFSFile : public IFile
   {
   public:
@@ -127,10 +130,7 @@ namespace XFILE
 
     //implement iocontrol for seek_possible for preventing the stat in File class for
     //getting this info ...
-    int IoControl(EIoControl request, void* param) override
-    {
-      return request == IOCTRL_SEEK_POSSIBLE ? 1 : -1;
-    }
+    int IoControl(EIoControl request, void* param) override;
     int GetChunkSize() override {return static_cast<int>(gNfsConnection.GetMaxReadChunkSize());}
 
     bool OpenForWrite(const CURL& url, bool bOverWrite = false) override;
@@ -139,10 +139,13 @@ namespace XFILE
   protected:
     CURL m_url;
     bool IsValidFile(const std::string& strFileName);
+    bool SetReadAhead(bool enable);
     int64_t m_fileSize = 0;
     struct nfsfh *m_pFileHandle;
     struct nfs_context *m_pNfsContext;//current nfs context
     std::string m_exportPath;
+    std::unique_ptr<CNFSReadAhead> m_readAhead;
+    int64_t m_readAheadPos = 0; // the reads ahead don't move the offset of the file handle
   };
 }
 
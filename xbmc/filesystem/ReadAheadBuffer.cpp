@@ -0,0 +1,113 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ReadAheadBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+
+using namespace XFILE;
+
+CReadAheadBuffer::CReadAheadBuffer(size_t chunkSize, unsigned int depth)
+  : m_chunkSize(chunkSize),
+    m_windowSize(static_cast<int64_t>(std::clamp(depth, 1u, MAX_DEPTH)) * chunkSize),
+    m_chunks(m_windowSize / chunkSize)
+{
+  for (Chunk& chunk : m_chunks)
+    chunk.data = std::make_unique<uint8_t[]>(m_chunkSize);
+}
+
+void CReadAheadBuffer::WaitAll()
+{
+  for (Chunk& chunk : m_chunks)
+    Wait(chunk);
+}
+
+void CReadAheadBuffer::SubmitAt(Chunk& chunk, int64_t offset)
+{
+  chunk.offset = offset;
+  Submit(chunk);
+}
+
+void CReadAheadBuffer::Restart(int64_t position)
+{
+  for (Chunk& chunk : m_chunks)
+    Cancel(chunk);
+
+  m_windowStart = position - position % m_chunkSize;
+  for (int64_t offset = m_windowStart; offset < m_windowStart + m_windowSize; offset += m_chunkSize)
+    SubmitAt(ChunkAt(offset), offset);
+}
+
+void CReadAheadBuffer::Slide(int64_t position)
+{
+  // hand the chunks in front of the position to the end of the window
+  while (m_windowStart + static_cast<int64_t>(m_chunkSize) <= position)
+  {
+    Chunk& chunk = ChunkAt(m_windowStart);
+    Wait(chunk);
+    SubmitAt(chunk, m_windowStart + m_windowSize);
+    m_windowStart += m_chunkSize;
+  }
+}
+
+ssize_t CReadAheadBuffer::Read(int64_t position, void* buffer, size_t size)
+{
+  if (position < 0)
+  {
+    errno = EINVAL;
+    return -1;
+  }
+
+  if (m_windowStart < 0 || position < m_windowStart || position >= m_windowStart + m_windowSize)
+    Restart(position);
+
+  uint8_t* out = static_cast<uint8_t*>(buffer);
+  size_t total = 0;
+  bool reread = false;
+  while (total < size)
+  {
+    Slide(position);
+
+    Chunk& chunk = ChunkAt(position);
+    Wait(chunk);
+
+    if (chunk.result < 0)
+    {
+      const int error = static_cast<int>(-chunk.result);
+      // try again with the next read
+      SubmitAt(chunk, chunk.offset);
+      if (total > 0)
+        break;
+      errno = error;
+      return -1;
+    }
+
+    const int64_t end = chunk.offset + chunk.result;
+    if (position >= end)
+    {
+      // the chunk ended at the end of the file, which may have grown since
+      if (total > 0 || reread)
+        break;
+      reread = true;
+      SubmitAt(chunk, chunk.offset);
+      continue;
+    }
+
+    const size_t length = static_cast<size_t>(std::min<int64_t>(size - total, end - position));
+    std::memcpy(out + total, chunk.data.get() + (position - chunk.offset), length);
+    total += length;
+    position += length;
+  }
+
+  // queue the next read right away if the chunk is used up
+  Slide(position);
+
+  return static_cast<ssize_t>(total);
+}
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include <sys/types.h>
+#include <vector>
+
+namespace XFILE
+{
+
+/*!
+ * \brief Keeps several chunk reads of a file in flight ahead of the reader
+ *
+ * The file is read in aligned chunks into a ring of buffers. Once the reader
+ * is done with a chunk, its buffer is queued for the chunk one ring length
+ * further ahead, so up to depth reads are outstanding while the reader
+ * consumes the data. How the reads are issued is up to the implementation.
+ *
+ * A read in front of or too far behind the chunks in flight (a seek) cancels
+ * the outstanding reads and starts over at the new position. Chunks that ended
+ * at the end of the file are read again when they are reached, so files that
+ * are still being written can be followed.
+ *
+ * Implementations have to wait for all outstanding reads in their destructor,
+ * see WaitAll().
+ */
+class CReadAheadBuffer
+{
+public:
+  static constexpr unsigned int MAX_DEPTH = 32;
+
+  virtual ~CReadAheadBuffer() = default;
+
+  CReadAheadBuffer(const CReadAheadBuffer&) = delete;
+  CReadAheadBuffer& operator=(const CReadAheadBuffer&) = delete;
+
+  /*!
+   * \brief Read from the given position
+   *
+   * \return The number of bytes read, 0 at the end of the file or -1 with
+   * errno set on error
+   */
+  ssize_t Read(int64_t position, void* buffer, size_t size);
+
+  size_t GetChunkSize() const { return m_chunkSize; }
+  unsigned int GetDepth() const { return static_cast<unsigned int>(m_chunks.size()); }
+
+protected:
+  enum class ChunkState
+  {
+    EMPTY,
+    PENDING,
+    DONE,
+  };
+
+  struct Chunk
+  {
+    int64_t offset = -1;
+    ssize_t result = 0; // bytes read or -errno
+    ChunkState state = ChunkState::EMPTY;
+    std::unique_ptr<uint8_t[]> data;
+  };
+
+  /*!
+   * \param chunkSize The size of the aligned reads
+   * \param depth The number of reads to keep in flight
+   */
+  CReadAheadBuffer(size_t chunkSize, unsigned int depth);
+
+  /*!
+   * \brief Start reading m_chunkSize bytes at chunk.offset into chunk.data
+   *
+   * The implementation sets the state to PENDING, and to DONE with the result
+   * once the read finished.
+   */
+  virtual void Submit(Chunk& chunk) = 0;
+
+  /*!
+   * \brief Block until the chunk isn't PENDING anymore
+   */
+  virtual void Wait(Chunk& chunk) = 0;
+
+  /*!
+   * \brief Give up a read whose data isn't needed anymore, after a seek
+   *
+   * Like Wait(), the chunk must not be PENDING anymore when this returns. The
+   * default waits for the read to finish.
+   */
+  virtual void Cancel(Chunk& chunk) { Wait(chunk); }
+
+  void WaitAll();
+
+  size_t IndexOf(const Chunk& chunk) const { return &chunk - m_chunks.data(); }
+  Chunk& GetChunk(size_t index) { return m_chunks[index]; }
+
+  const size_t m_chunkSize;
+
+private:
+  Chunk& ChunkAt(int64_t position)
+  {
+    return m_chunks[static_cast<size_t>(position / m_chunkSize) % m_chunks.size()];
+  }
+
+  void SubmitAt(Chunk& chunk, int64_t offset);
+  void Restart(int64_t position);
+  void Slide(int64_t position);
+
+  const int64_t m_windowSize;
+  // the chunks are never moved while reads are in flight
+  std::vector<Chunk> m_chunks;
+  int64_t m_windowStart = -1;
+};
+
+} // namespace XFILE
@@ -0,0 +1,357 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "filesystem/CurlFile.h"
+#include "filesystem/FileCache.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/HttpRangeUtils.h"
+#include "utils/StringUtils.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr int64_t FILE_SIZE = 12 * 1024 * 1024 + 777;
+constexpr size_t CONNECTION_RATE = 8 * 1024 * 1024; // bytes per second
+constexpr int SEGMENTS = 8;
+
+uint8_t PatternAt(int64_t position)
+{
+  return static_cast<uint8_t>(position * 13 + position / 1000);
+}
+
+::testing::AssertionResult MatchesPattern(const uint8_t* data, size_t size, int64_t position)
+{
+  for (size_t i = 0; i < size; i++)
+  {
+    if (data[i] != PatternAt(position + i))
+      return ::testing::AssertionFailure() << "mismatch at " << position + i;
+  }
+  return ::testing::AssertionSuccess();
+}
+
+/*!
+ * \brief HTTP server that sends every connection no faster than
+ * CONNECTION_RATE, like a CDN limiting single downloads
+ */
+class CThrottledServer
+{
+public:
+  explicit CThrottledServer(bool ranges) : m_ranges(ranges), m_content(FILE_SIZE)
+  {
+    for (int64_t i = 0; i < FILE_SIZE; i++)
+      m_content[i] = PatternAt(i);
+  }
+
+  ~CThrottledServer()
+  {
+    m_stop = true;
+    if (m_socket >= 0)
+      shutdown(m_socket, SHUT_RDWR);
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      for (const int fd : m_clients)
+        shutdown(fd, SHUT_RDWR);
+    }
+    if (m_acceptThread.joinable())
+      m_acceptThread.join();
+    for (auto& thread : m_threads)
+      thread.join();
+    for (const int fd : m_clients)
+      close(fd);
+    if (m_socket >= 0)
+      close(m_socket);
+  }
+
+  bool Start()
+  {
+    m_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_socket < 0)
+      return false;
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(addr);
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(m_socket, 64) < 0 ||
+        getsockname(m_socket, reinterpret_cast<sockaddr*>(&addr), &length) < 0)
+      return false;
+
+    m_port = ntohs(addr.sin_port);
+    m_acceptThread = std::thread([this] { Accept(); });
+    return true;
+  }
+
+  std::string GetUrl() const
+  {
+    return StringUtils::Format("http://127.0.0.1:{}/file.bin", m_port);
+  }
+  int GetConnections() const { return m_connections; }
+
+private:
+  void Accept()
+  {
+    while (!m_stop)
+    {
+      const int fd = accept(m_socket, nullptr, nullptr);
+      if (fd < 0)
+        continue;
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_stop)
+      {
+        close(fd);
+        return;
+      }
+      m_connections++;
+      m_clients.push_back(fd);
+      m_threads.emplace_back([this, fd] { Serve(fd); });
+    }
+  }
+
+  void Serve(int fd)
+  {
+    std::string pending;
+    char buffer[4096];
+
+    while (!m_stop)
+    {
+      const size_t end = pending.find("\r\n\r\n");
+      if (end == std::string::npos)
+      {
+        const ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+          return;
+        pending.append(buffer, received);
+        continue;
+      }
+
+      const std::string request = pending.substr(0, end);
+      pending.erase(0, end + 4);
+
+      CHttpRanges ranges;
+      for (const std::string& line : StringUtils::Split(request, "\r\n"))
+      {
+        if (m_ranges && StringUtils::StartsWithNoCase(line, "range:"))
+        {
+          std::string value = line.substr(6);
+          ranges.Parse(StringUtils::Trim(value), m_content.size());
+        }
+      }
+
+      CHttpRange range(0, m_content.size() - 1);
+      std::string header;
+      if (ranges.GetFirst(range))
+      {
+        header = "HTTP/1.1 206 Partial Content\r\nContent-Range: " +
+                 HttpRangeUtils::GenerateContentRangeHeaderValue(
+                     range.GetFirstPosition(), range.GetLastPosition(), m_content.size()) +
+                 "\r\n";
+      }
+      else
+        header = "HTTP/1.1 200 OK\r\n";
+      if (m_ranges)
+        header += "Accept-Ranges: bytes\r\n";
+      header += StringUtils::Format("Content-Length: {}\r\n\r\n", range.GetLength());
+      if (!Send(fd, header.data(), header.size()))
+        return;
+
+      const bool head = StringUtils::StartsWith(request, "HEAD");
+      const auto start = std::chrono::steady_clock::now();
+      uint64_t sent = 0;
+      uint64_t position = range.GetFirstPosition();
+      while (!head && position <= range.GetLastPosition())
+      {
+        const size_t size = std::min<uint64_t>(16 * 1024, range.GetLastPosition() + 1 - position);
+        if (!Send(fd, m_content.data() + position, size))
+          return;
+        position += size;
+        sent += size;
+        std::this_thread::sleep_until(
+            start + std::chrono::microseconds(sent * 1000000 / CONNECTION_RATE));
+      }
+    }
+  }
+
+  static bool Send(int fd, const void* data, size_t size)
+  {
+    const char* buffer = static_cast<const char*>(data);
+    while (size > 0)
+    {
+      const ssize_t sent = send(fd, buffer, size, MSG_NOSIGNAL);
+      if (sent <= 0)
+        return false;
+      buffer += sent;
+      size -= sent;
+    }
+    return true;
+  }
+
+  const bool m_ranges;
+  std::vector<uint8_t> m_content;
+  int m_socket = -1;
+  uint16_t m_port = 0;
+  std::atomic<bool> m_stop{false};
+  std::atomic<int> m_connections{0};
+  std::mutex m_mutex;
+  std::vector<int> m_clients;
+  std::vector<std::thread> m_threads;
+  std::thread m_acceptThread;
+};
+
+double ReadAll(IFile& file)
+{
+  std::vector<uint8_t> buffer(64 * 1024);
+  const auto start = std::chrono::steady_clock::now();
+  int64_t position = 0;
+  ssize_t read;
+  while ((read = file.Read(buffer.data(), buffer.size())) > 0)
+  {
+    EXPECT_TRUE(MatchesPattern(buffer.data(), read, position));
+    position += read;
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(0, read);
+  EXPECT_EQ(FILE_SIZE, position);
+  return position / elapsed.count() / (1024 * 1024);
+}
+} // namespace
+
+class TestCurlReadAhead : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+    m_segments = m_settings->GetInt(CSettings::SETTING_NETWORK_HTTPSEGMENTS);
+    m_settings->SetInt(CSettings::SETTING_NETWORK_HTTPSEGMENTS, SEGMENTS);
+  }
+
+  void TearDown() override
+  {
+    m_settings->SetInt(CSettings::SETTING_NETWORK_HTTPSEGMENTS, m_segments);
+  }
+
+  std::shared_ptr<CSettings> m_settings;
+  int m_segments = 0;
+};
+
+TEST_F(TestCurlReadAhead, Segments)
+{
+  CThrottledServer server(true);
+  ASSERT_TRUE(server.Start());
+
+  CCurlFile file;
+  ASSERT_TRUE(file.Open(CURL(server.GetUrl())));
+  EXPECT_EQ(-1, file.IoControl(IOCTRL_SET_READAHEAD, nullptr));
+  unsigned int requests = 1;
+  ASSERT_EQ(0, file.IoControl(IOCTRL_SET_READAHEAD, &requests));
+  ReadAll(file);
+
+  // the segments are requested on connections of their own
+  EXPECT_GT(server.GetConnections(), 2);
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST_F(TestCurlReadAhead, DISABLED_Throughput)
+{
+  CThrottledServer server(true);
+  ASSERT_TRUE(server.Start());
+
+  double single = 0;
+  double segmented = 0;
+  for (unsigned int requests : {0u, 1u})
+  {
+    CCurlFile file;
+    ASSERT_TRUE(file.Open(CURL(server.GetUrl())));
+    if (requests > 0)
+    {
+      ASSERT_EQ(0, file.IoControl(IOCTRL_SET_READAHEAD, &requests));
+    }
+
+    const double throughput = ReadAll(file);
+    std::cout << "[ CurlReadAhead ] " << (requests > 0 ? "segments" : "single transfer") << ": "
+              << static_cast<int>(throughput) << " MiB/s" << std::endl;
+    (requests > 0 ? segmented : single) = throughput;
+  }
+
+  // the throttle only applies per connection
+  EXPECT_GT(server.GetConnections(), 2);
+  EXPECT_GT(segmented, 1.5 * single);
+}
+
+TEST_F(TestCurlReadAhead, Seek)
+{
+  CThrottledServer server(true);
+  ASSERT_TRUE(server.Start());
+
+  CCurlFile file;
+  ASSERT_TRUE(file.Open(CURL(server.GetUrl())));
+  unsigned int requests = 1;
+  ASSERT_EQ(0, file.IoControl(IOCTRL_SET_READAHEAD, &requests));
+
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int64_t> positions(0, FILE_SIZE - 1);
+  std::vector<uint8_t> buffer(100000);
+  for (int i = 0; i < 20; i++)
+  {
+    const int64_t position = positions(random);
+    ASSERT_EQ(position, file.Seek(position, SEEK_SET));
+    const ssize_t read = file.Read(buffer.data(), buffer.size());
+    ASSERT_EQ(std::min<int64_t>(buffer.size(), FILE_SIZE - position), read);
+    ASSERT_TRUE(MatchesPattern(buffer.data(), read, position));
+    EXPECT_EQ(position + read, file.GetPosition());
+  }
+}
+
+TEST_F(TestCurlReadAhead, NoRanges)
+{
+  CThrottledServer server(false);
+  ASSERT_TRUE(server.Start());
+
+  // a server without ranges is read in one piece
+  CCurlFile file;
+  ASSERT_TRUE(file.Open(CURL(server.GetUrl())));
+  unsigned int requests = 1;
+  EXPECT_EQ(-1, file.IoControl(IOCTRL_SET_READAHEAD, &requests));
+  ReadAll(file);
+}
+
+TEST_F(TestCurlReadAhead, FileCache)
+{
+  CThrottledServer server(true);
+  ASSERT_TRUE(server.Start());
+
+  // the cache opens its source with READ_AHEAD
+  CFileCache cache(0);
+  ASSERT_TRUE(cache.Open(CURL(server.GetUrl())));
+  ReadAll(cache);
+  cache.Close();
+
+  EXPECT_GT(server.GetConnections(), 2);
+}
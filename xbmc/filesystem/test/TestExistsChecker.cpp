@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/ExistsChecker.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+class TestExistsChecker : public testing::Test
+{
+protected:
+  TestExistsChecker()
+  {
+    CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+    m_root = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"),
+                                       "TestExistsChecker");
+  }
+
+  ~TestExistsChecker() override
+  {
+    CDirectory::RemoveRecursive(m_root);
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  std::string CreateTestFile(const std::string& folder, const std::string& name)
+  {
+    const std::string path = URIUtils::AddFileToFolder(m_root, folder, name);
+    CDirectory::Create(URIUtils::GetDirectory(path));
+    CFile file;
+    EXPECT_TRUE(file.OpenForWrite(path, true));
+    EXPECT_EQ(1, file.Write("x", 1));
+    return path;
+  }
+
+  std::string m_root;
+};
+
+TEST_F(TestExistsChecker, Exists)
+{
+  CExistsChecker checker(2);
+  std::vector<size_t> existing;
+  std::vector<size_t> missing;
+
+  // enough files to list their folder
+  for (int i = 0; i < 5; i++)
+  {
+    const std::string name = StringUtils::Format("{}.mkv", i);
+    existing.push_back(checker.AddFile(CreateTestFile("many", name)));
+  }
+  missing.push_back(checker.AddFile(URIUtils::AddFileToFolder(m_root, "many", "5.mkv")));
+  missing.push_back(checker.AddFile(URIUtils::AddFileToFolder(m_root, "many", "6.mkv")));
+
+  // too few files for a listing
+  existing.push_back(checker.AddFile(CreateTestFile("few", "0.mkv")));
+  missing.push_back(checker.AddFile(URIUtils::AddFileToFolder(m_root, "few", "1.mkv")));
+
+  // a folder that is gone
+  for (int i = 0; i < 3; i++)
+  {
+    missing.push_back(checker.AddFile(
+        URIUtils::AddFileToFolder(m_root, "gone", StringUtils::Format("{}.mkv", i))));
+  }
+
+  existing.push_back(checker.AddDirectory(URIUtils::AddFileToFolder(m_root, "many")));
+  missing.push_back(checker.AddDirectory(URIUtils::AddFileToFolder(m_root, "gone")));
+
+  size_t lastChecked = 0;
+  EXPECT_TRUE(checker.Run([&lastChecked](size_t checked, size_t total) {
+    EXPECT_LE(lastChecked, checked);
+    EXPECT_LE(checked, total);
+    lastChecked = checked;
+    return true;
+  }));
+
+  for (const size_t index : existing)
+    EXPECT_TRUE(checker.Exists(index)) << index;
+  for (const size_t index : missing)
+    EXPECT_FALSE(checker.Exists(index)) << index;
+
+  const CExistsChecker::Stats& stats = checker.GetStats();
+  EXPECT_EQ(existing.size() + missing.size(), stats.paths);
+  EXPECT_EQ(missing.size(), stats.missing);
+  EXPECT_EQ(2u, stats.listings);
+  // the missing files of the listed folder are confirmed, the gone folder is checked once
+  EXPECT_EQ(2u + 2u + 1u + 2u, stats.requests);
+}
+
+TEST_F(TestExistsChecker, Cancel)
+{
+  CExistsChecker checker(1);
+  for (int i = 0; i < 20; i++)
+  {
+    checker.AddFile(
+        URIUtils::AddFileToFolder(m_root, StringUtils::Format("{}", i), "movie.mkv"));
+  }
+
+  EXPECT_FALSE(checker.Run([](size_t checked, size_t total) { return false; }));
+}
+
+TEST_F(TestExistsChecker, Empty)
+{
+  CExistsChecker checker(4);
+  EXPECT_TRUE(checker.Run());
+  EXPECT_EQ(0u, checker.GetStats().paths);
+}
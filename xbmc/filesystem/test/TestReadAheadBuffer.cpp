@@ -0,0 +1,225 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "filesystem/ReadAheadBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr int64_t FILE_SIZE = 8 * 1024 * 1024 + 777;
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+constexpr auto LATENCY = std::chrono::milliseconds(2);
+
+uint8_t PatternAt(int64_t position)
+{
+  return static_cast<uint8_t>(position * 13 + position / 1000);
+}
+
+::testing::AssertionResult MatchesPattern(const uint8_t* data, size_t size, int64_t position)
+{
+  for (size_t i = 0; i < size; i++)
+  {
+    if (data[i] != PatternAt(position + i))
+      return ::testing::AssertionFailure() << "mismatch at " << position + i;
+  }
+  return ::testing::AssertionSuccess();
+}
+
+/*!
+ * \brief A file on a link where every request takes the same round trip,
+ * however many of them are outstanding
+ */
+class CHighLatencyReadAhead : public CReadAheadBuffer
+{
+public:
+  explicit CHighLatencyReadAhead(unsigned int depth)
+    : CReadAheadBuffer(CHUNK_SIZE, depth), m_deadlines(GetDepth())
+  {
+  }
+
+  ~CHighLatencyReadAhead() override { WaitAll(); }
+
+  int m_submitted = 0;
+  int m_pending = 0;
+  int m_maxPending = 0;
+
+protected:
+  void Submit(Chunk& chunk) override
+  {
+    m_submitted++;
+    m_maxPending = std::max(m_maxPending, ++m_pending);
+    const int64_t end = std::min<int64_t>(FILE_SIZE, chunk.offset + m_chunkSize);
+    for (int64_t position = chunk.offset; position < end; position++)
+      chunk.data[position - chunk.offset] = PatternAt(position);
+
+    chunk.result = std::max<int64_t>(0, end - chunk.offset);
+    chunk.state = ChunkState::PENDING;
+    m_deadlines[IndexOf(chunk)] = std::chrono::steady_clock::now() + LATENCY;
+  }
+
+  void Wait(Chunk& chunk) override
+  {
+    if (chunk.state != ChunkState::PENDING)
+      return;
+    std::this_thread::sleep_until(m_deadlines[IndexOf(chunk)]);
+    chunk.state = ChunkState::DONE;
+    m_pending--;
+  }
+
+private:
+  std::vector<std::chrono::steady_clock::time_point> m_deadlines;
+};
+
+double ReadAll(CReadAheadBuffer& readAhead, size_t readSize)
+{
+  std::vector<uint8_t> buffer(readSize);
+  const auto start = std::chrono::steady_clock::now();
+  int64_t position = 0;
+  ssize_t read;
+  while ((read = readAhead.Read(position, buffer.data(), buffer.size())) > 0)
+    position += read;
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(FILE_SIZE, position);
+  return FILE_SIZE / elapsed.count() / (1024 * 1024);
+}
+} // namespace
+
+TEST(TestReadAheadBuffer, Sequential)
+{
+  CHighLatencyReadAhead readAhead(4);
+
+  std::vector<uint8_t> buffer(100003);
+  int64_t position = 0;
+  ssize_t read;
+  while ((read = readAhead.Read(position, buffer.data(), buffer.size())) > 0)
+  {
+    ASSERT_TRUE(MatchesPattern(buffer.data(), read, position));
+    position += read;
+  }
+  EXPECT_EQ(0, read);
+  EXPECT_EQ(FILE_SIZE, position);
+}
+
+TEST(TestReadAheadBuffer, Seek)
+{
+  CHighLatencyReadAhead readAhead(8);
+
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int64_t> positions(0, FILE_SIZE - 1);
+  std::uniform_int_distribution<int64_t> skips(0, 3 * CHUNK_SIZE);
+  std::vector<uint8_t> buffer(30000);
+  int64_t position = 0;
+  for (int i = 0; i < 300; i++)
+  {
+    position = i % 10 == 0 ? positions(random) : position + skips(random);
+    const ssize_t read = readAhead.Read(position, buffer.data(), buffer.size());
+    const int64_t expected =
+        std::max<int64_t>(0, std::min<int64_t>(buffer.size(), FILE_SIZE - position));
+    ASSERT_EQ(expected, read) << "at " << position;
+    ASSERT_TRUE(MatchesPattern(buffer.data(), read, position));
+    if (read == 0)
+      position = 0;
+  }
+}
+
+TEST(TestReadAheadBuffer, Depth)
+{
+  CHighLatencyReadAhead readAhead(CReadAheadBuffer::MAX_DEPTH + 10);
+  EXPECT_EQ(CReadAheadBuffer::MAX_DEPTH, readAhead.GetDepth());
+
+  // a read at the start fills the whole window
+  uint8_t byte;
+  EXPECT_EQ(1, readAhead.Read(0, &byte, 1));
+  EXPECT_EQ(static_cast<int>(CReadAheadBuffer::MAX_DEPTH), readAhead.m_submitted);
+}
+
+TEST(TestReadAheadBuffer, ReadsInFlight)
+{
+  for (const unsigned int depth : {1u, 4u, 8u})
+  {
+    CHighLatencyReadAhead readAhead(depth);
+    ReadAll(readAhead, 32 * 1024);
+    // the window is kept full while reading, every request waits its round trip at once
+    EXPECT_EQ(static_cast<int>(depth), readAhead.m_maxPending);
+  }
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST(TestReadAheadBuffer, DISABLED_Throughput)
+{
+  // the size of a typical demuxer read
+  constexpr size_t READ_SIZE = 32 * 1024;
+
+  double single = 0;
+  double pipelined = 0;
+  for (const unsigned int depth : {1u, 4u, 8u})
+  {
+    CHighLatencyReadAhead readAhead(depth);
+    const double throughput = ReadAll(readAhead, READ_SIZE);
+    std::cout << "[ ReadAheadBuffer ] " << depth << " requests: " << static_cast<int>(throughput)
+              << " MiB/s" << std::endl;
+
+    if (depth == 1)
+      single = throughput;
+    else if (depth == 4)
+      pipelined = throughput;
+  }
+
+  // ideally four times as fast, leave room for loaded machines
+  EXPECT_GT(pipelined, 2 * single);
+}
+
+/*!
+ * Compares reading a file with and without read-ahead on a real server, e.g.
+ * KODI_TEST_READAHEAD_URL=smb://server/share/movie.mkv
+ */
+TEST(TestReadAheadBuffer, Server)
+{
+  const char* url = std::getenv("KODI_TEST_READAHEAD_URL");
+  if (!url)
+    GTEST_SKIP() << "KODI_TEST_READAHEAD_URL is not set";
+
+  constexpr size_t READ_SIZE = 64 * 1024;
+  constexpr int64_t MAX_SIZE = 256 * 1024 * 1024;
+
+  std::vector<std::vector<uint8_t>> contents;
+  for (const unsigned int flags : {READ_NO_CACHE, READ_NO_CACHE | READ_AHEAD})
+  {
+    CFile file;
+    ASSERT_TRUE(file.Open(url, flags));
+
+    std::vector<uint8_t> content;
+    std::vector<uint8_t> buffer(READ_SIZE);
+    const auto start = std::chrono::steady_clock::now();
+    ssize_t read;
+    while (static_cast<int64_t>(content.size()) < MAX_SIZE &&
+           (read = file.Read(buffer.data(), buffer.size())) > 0)
+      content.insert(content.end(), buffer.begin(), buffer.begin() + read);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "[ ReadAheadBuffer ] " << ((flags & READ_AHEAD) ? "read-ahead" : "single reads")
+              << ": " << static_cast<int>(content.size() / elapsed.count() / (1024 * 1024))
+              << " MiB/s" << std::endl;
+    contents.emplace_back(std::move(content));
+  }
+
+  EXPECT_TRUE(contents[0] == contents[1]);
+}
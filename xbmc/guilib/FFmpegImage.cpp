@@ -143,7 +143,8 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
                                       unsigned int width, unsigned int height)
 {
 
-  if (!Initialize(buffer, bufSize))
+  // only downscale while decoding when asked to, the image may be shown larger than requested
+  if (!Initialize(buffer, bufSize, m_scaledDecode ? width : 0, m_scaledDecode ? height : 0))
   {
     //log
     return false;
@@ -155,7 +156,10 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
   return !(m_pFrame == nullptr);
 }
 
-bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
+bool CFFmpegImage::Initialize(unsigned char* buffer,
+                              size_t bufSize,
+                              unsigned int maxWidth,
+                              unsigned int maxHeight)
 {
   int bufferSize = 4096;
   uint8_t* fbuffer = (uint8_t*)av_malloc(bufferSize + AV_INPUT_BUFFER_PADDING_SIZE);
@@ -262,6 +266,9 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
     return false;
   }
 
+  // let the decoder skip the high frequencies we would scale away anyway
+  m_codec_ctx->lowres = GetLowres(codec, codec_params, maxWidth, maxHeight);
+
   if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
   {
     avformat_close_input(&m_fctx);
@@ -273,6 +280,27 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
   return true;
 }
 
+int CFFmpegImage::GetLowres(const AVCodec* codec,
+                            const AVCodecParameters* codecParams,
+                            unsigned int maxWidth,
+                            unsigned int maxHeight)
+{
+  if (!codec || codec->id != AV_CODEC_ID_MJPEG || maxWidth == 0 || maxHeight == 0)
+    return 0;
+
+  const unsigned int width = static_cast<unsigned int>(std::max(codecParams->width, 0));
+  const unsigned int height = static_cast<unsigned int>(std::max(codecParams->height, 0));
+
+  // the image is scaled to fit in maxWidth x maxHeight keeping its aspect ratio,
+  // so one side at least as large as the target is enough
+  int lowres = 0;
+  while (lowres < codec->max_lowres &&
+         ((width >> (lowres + 1)) >= maxWidth || (height >> (lowres + 1)) >= maxHeight))
+    ++lowres;
+
+  return lowres;
+}
+
 AVFrame* CFFmpegImage::ExtractFrame()
 {
   if (!m_fctx || !m_fctx->streams[0])
@@ -316,6 +344,13 @@ AVFrame* CFFmpegImage::ExtractFrame()
   m_width = frame->width;
   m_originalWidth = m_width;
   m_originalHeight = m_height;
+  if (m_codec_ctx->lowres > 0)
+  {
+    // report the coded size, the decoder downscaled the image
+    const AVCodecParameters* codecParams = m_fctx->streams[0]->codecpar;
+    m_originalWidth = std::max(codecParams->width, frame->width);
+    m_originalHeight = std::max(codecParams->height, frame->height);
+  }
 
   const AVPixFmtDescriptor* pixDescriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
   if (pixDescriptor && ((pixDescriptor->flags & (AV_PIX_FMT_FLAG_ALPHA | AV_PIX_FMT_FLAG_PAL)) != 0))
@@ -489,8 +524,8 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
 
   // assumption quadratic maximums e.g. 2048x2048
   float ratio = m_width / (float)m_height;
-  unsigned int nHeight = m_originalHeight;
-  unsigned int nWidth = m_originalWidth;
+  unsigned int nHeight = frame->height;
+  unsigned int nWidth = frame->width;
   if (nHeight > height)
   {
     nHeight = height;
@@ -502,7 +537,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     nHeight = (unsigned int)(nWidth / ratio + 0.5f);
   }
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
+  struct SwsContext* context = sws_getContext(frame->width, frame->height, pixFormat,
     nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -515,7 +550,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
@@ -51,7 +51,9 @@ struct MemBuffer
 struct AVFrame;
 struct AVIOContext;
 struct AVFormatContext;
+struct AVCodec;
 struct AVCodecContext;
+struct AVCodecParameters;
 struct AVPacket;
 
 class CFFmpegImage : public IImage
@@ -70,11 +72,29 @@ public:
                                   unsigned char* &bufferout,
                                   unsigned int &bufferoutSize) override;
   void ReleaseThumbnailBuffer() override;
-
-  bool Initialize(unsigned char* buffer, size_t bufSize);
+  void SetScaledDecode(bool scaledDecode) override { m_scaledDecode = scaledDecode; }
+
+  /*!
+   * \brief Open the image for decoding
+   * \param maxWidth, maxHeight the size the image will be scaled to fit in, 0 for the full size.
+   * JPEG images are downscaled by the decoder when they are at least twice as large.
+   */
+  bool Initialize(unsigned char* buffer,
+                  size_t bufSize,
+                  unsigned int maxWidth = 0,
+                  unsigned int maxHeight = 0);
 
   std::shared_ptr<Frame> ReadFrame();
 
+  /*!
+   * \brief The lowres level of the JPEG decoder for an image scaled to fit in maxWidth x maxHeight
+   * \return 0 to decode at full size, else the image is decoded at 1/2^lowres of its size
+   */
+  static int GetLowres(const AVCodec* codec,
+                       const AVCodecParameters* codecParams,
+                       unsigned int maxWidth,
+                       unsigned int maxHeight);
+
 private:
   static void FreeIOCtx(AVIOContext** ioctx);
   AVFrame* ExtractFrame();
@@ -83,6 +103,7 @@ private:
   static int DecodeFFmpegFrame(AVCodecContext *avctx, AVFrame *frame, int *got_frame, AVPacket *pkt);
   static AVPixelFormat ConvertFormats(AVFrame* frame);
   std::string m_strMimeType;
+  bool m_scaledDecode = false;
   void CleanupLocalOutputBuffer();
 
 
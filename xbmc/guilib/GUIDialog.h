@@ -50,6 +50,7 @@ public:
   bool OnBack(int actionID) override;
 
   bool IsDialogRunning() const override { return m_active; }
+  bool HasAutoVisibility() const override { return HasVisibleCondition(); }
   bool IsDialog() const override { return true; }
   bool IsModalDialog() const override { return m_modalityType == DialogModalityType::MODAL; }
   virtual DialogModalityType GetModalityType() const { return m_modalityType; }
@@ -279,6 +279,9 @@ void GUIFontManager::ReloadTTFFonts(void)
   if (m_vecFonts.empty() || !winSystem)
     return; // we haven't even loaded fonts in yet
 
+  // the texts are measured with the rescaled fonts
+  m_textLayoutCache.Clear();
+
   for (size_t i = 0; i < m_vecFonts.size(); ++i)
   {
     const auto& font = m_vecFonts[i];
@@ -320,6 +323,7 @@ void GUIFontManager::Unload(const std::string& strFontName)
   {
     if (StringUtils::EqualsNoCase((*iFont)->GetFontName(), strFontName))
     {
+      m_textLayoutCache.Clear();
       m_vecFonts.erase(iFont);
       return;
     }
@@ -405,6 +409,7 @@ CGUIFont* GUIFontManager::GetDefaultFont(bool border)
 
 void GUIFontManager::Clear()
 {
+  m_textLayoutCache.Clear();
   m_vecFonts.clear();
   m_vecFontFiles.clear();
   m_vecFontInfo.clear();
@@ -13,6 +13,7 @@
 \brief
 */
 
+#include "GUITextLayoutCache.h"
 #include "IMsgTargetCallback.h"
 #include "threads/CriticalSection.h"
 #include "threads/SingleLock.h"
@@ -109,6 +110,12 @@ public:
    */
   std::vector<std::string> GetUserFontsFamilyNames();
 
+  /*!
+   * \brief Get the layouts of the texts rendered with the fonts
+   * \return The text layout cache shared by all text layouts
+   */
+  CGUITextLayoutCache& GetTextLayoutCache() { return m_textLayoutCache; }
+
 protected:
   void ReloadTTFFonts();
   static void RescaleFontSizeAndAspect(CGraphicContext& context,
@@ -134,6 +141,7 @@ private:
 
   mutable CCriticalSection m_critSection;
   std::vector<FontMetadata> m_userFontsCache;
+  CGUITextLayoutCache m_textLayoutCache;
 };
 
 /*!
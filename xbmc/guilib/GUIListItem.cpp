@@ -10,17 +10,142 @@
 
 #include "GUIListItemLayout.h"
 #include "utils/Archive.h"
+#include "utils/AtomTable.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
 #include <utility>
 
-bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
+namespace
 {
-  return StringUtils::CompareNoCase(s1, s2) < 0;
+// property keys have always been case insensitive, art types are not
+CAtomTable& PropertyAtoms()
+{
+  static CAtomTable atoms(true);
+  return atoms;
+}
+
+// property keys as the callers spelled them
+CAtomTable& PropertyNames()
+{
+  static CAtomTable names(false);
+  return names;
+}
+
+CAtomTable& ArtAtoms()
+{
+  static CAtomTable atoms(false);
+  return atoms;
+}
+
+uint32_t AtomOf(uint32_t atom)
+{
+  return atom;
+}
+
+template<typename K>
+uint32_t AtomOf(const K& key)
+{
+  return key.atom;
+}
+
+template<typename T>
+auto FindAtom(T& entries, uint32_t atom)
+{
+  auto it = std::lower_bound(entries.begin(), entries.end(), atom,
+                             [](const auto& entry, uint32_t a) { return AtomOf(entry.first) < a; });
+  return (it != entries.end() && AtomOf(it->first) == atom) ? it : entries.end();
+}
+
+template<typename T, typename K, typename V>
+bool SetAtom(T& entries, const K& key, V&& value)
+{
+  const uint32_t atom = AtomOf(key);
+  auto it = std::lower_bound(entries.begin(), entries.end(), atom,
+                             [](const auto& entry, uint32_t a) { return AtomOf(entry.first) < a; });
+  // an existing entry keeps its key, like the spelling of a map key
+  if (it != entries.end() && AtomOf(it->first) == atom)
+  {
+    if (it->second == value)
+      return false;
+    it->second = std::forward<V>(value);
+    return true;
+  }
+  entries.emplace(it, key, std::forward<V>(value));
+  return true;
 }
 
+/*!
+ * \brief The entries in the order of their names, as archives had them with maps
+ */
+template<typename T, typename N, typename L>
+std::vector<const typename T::value_type*> SortByName(const T& entries, N&& name, L&& less)
+{
+  std::vector<const typename T::value_type*> sorted;
+  sorted.reserve(entries.size());
+  for (const auto& entry : entries)
+    sorted.emplace_back(&entry);
+  std::sort(sorted.begin(), sorted.end(), [&name, &less](const auto* a, const auto* b) {
+    return less(name(a->first), name(b->first));
+  });
+  return sorted;
+}
+
+bool LessNoCase(const std::string& a, const std::string& b)
+{
+  return StringUtils::CompareNoCase(a, b) < 0;
+}
+
+bool Less(const std::string& a, const std::string& b)
+{
+  return a < b;
+}
+
+const std::string& ArtName(uint32_t atom)
+{
+  return ArtAtoms().GetName(atom);
+}
+
+size_t StringHeapBytes(const std::string& str)
+{
+  // small strings live in the object itself
+  return str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0;
+}
+
+size_t StringHeapBytes(const std::wstring& str)
+{
+  return str.capacity() > std::wstring().capacity() ? (str.capacity() + 1) * sizeof(wchar_t) : 0;
+}
+
+size_t VariantHeapBytes(const CVariant& value)
+{
+  if (value.isString())
+    return StringHeapBytes(value.asString());
+  if (value.isWideString())
+    return StringHeapBytes(value.asWideString());
+
+  size_t bytes = 0;
+  if (value.isArray())
+  {
+    bytes += value.size() * sizeof(CVariant);
+    for (auto it = value.begin_array(); it != value.end_array(); ++it)
+      bytes += VariantHeapBytes(*it);
+  }
+  else if (value.isObject())
+  {
+    for (auto it = value.begin_map(); it != value.end_map(); ++it)
+    {
+      // red-black tree node: 3 pointers and the color next to the value
+      bytes += sizeof(*it) + 4 * sizeof(void*);
+      bytes += StringHeapBytes(it->first) + VariantHeapBytes(it->second);
+    }
+  }
+  return bytes;
+}
+} // namespace
+
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
 {
   *this = item;
@@ -97,23 +222,22 @@ const std::wstring& CGUIListItem::GetSortLabel() const
 
 void CGUIListItem::SetArt(const std::string &type, const std::string &url)
 {
-  ArtMap::iterator i = m_art.find(type);
-  if (i == m_art.end() || i->second != url)
-  {
-    m_art[type] = url;
+  if (SetAtom(m_art, ArtAtoms().Intern(type), url))
     SetInvalid();
-  }
 }
 
 void CGUIListItem::SetArt(const ArtMap &art)
 {
-  m_art = art;
+  m_art.clear();
+  m_art.reserve(art.size());
+  for (const auto& i : art)
+    SetAtom(m_art, ArtAtoms().Intern(i.first), i.second);
   SetInvalid();
 }
 
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
-  m_artFallbacks[from] = to;
+  SetAtom(m_artFallbacks, ArtAtoms().Intern(from), ArtAtoms().Intern(to));
 }
 
 void CGUIListItem::ClearArt()
@@ -131,22 +255,29 @@ void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
 
 std::string CGUIListItem::GetArt(const std::string &type) const
 {
-  ArtMap::const_iterator i = m_art.find(type);
+  const uint32_t atom = ArtAtoms().Find(type);
+  if (atom == CAtomTable::NONE)
+    return "";
+
+  auto i = FindAtom(m_art, atom);
   if (i != m_art.end())
     return i->second;
-  i = m_artFallbacks.find(type);
-  if (i != m_artFallbacks.end())
+  auto j = FindAtom(m_artFallbacks, atom);
+  if (j != m_artFallbacks.end())
   {
-    ArtMap::const_iterator j = m_art.find(i->second);
-    if (j != m_art.end())
-      return j->second;
+    i = FindAtom(m_art, j->second);
+    if (i != m_art.end())
+      return i->second;
   }
   return "";
 }
 
-const CGUIListItem::ArtMap &CGUIListItem::GetArt() const
+CGUIListItem::ArtMap CGUIListItem::GetArt() const
 {
-  return m_art;
+  ArtMap art;
+  for (const auto& i : m_art)
+    art.emplace(ArtAtoms().GetName(i.first), i.second);
+  return art;
 }
 
 bool CGUIListItem::HasArt(const std::string &type) const
@@ -226,22 +357,22 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << m_bSelected;
     ar << m_overlayIcon;
     ar << (int)m_mapProperties.size();
-    for (const auto& it : m_mapProperties)
+    for (const auto* it : SortByName(m_mapProperties, GetPropertyName, LessNoCase))
     {
-      ar << it.first;
-      ar << it.second;
+      ar << GetPropertyName(it->first);
+      ar << it->second;
     }
     ar << (int)m_art.size();
-    for (const auto& i : m_art)
+    for (const auto* i : SortByName(m_art, ArtName, Less))
     {
-      ar << i.first;
-      ar << i.second;
+      ar << ArtName(i->first);
+      ar << i->second;
     }
     ar << (int)m_artFallbacks.size();
-    for (const auto& i : m_artFallbacks)
+    for (const auto* i : SortByName(m_artFallbacks, ArtName, Less))
     {
-      ar << i.first;
-      ar << i.second;
+      ar << ArtName(i->first);
+      ar << ArtName(i->second);
     }
   }
   else
@@ -272,7 +403,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_art.insert(make_pair(key, value));
+      SetAtom(m_art, ArtAtoms().Intern(key), std::move(value));
     }
     ar >> mapSize;
     for (int i = 0; i < mapSize; i++)
@@ -280,7 +411,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_artFallbacks.insert(make_pair(key, value));
+      SetAtom(m_artFallbacks, ArtAtoms().Intern(key), ArtAtoms().Intern(value));
     }
     SetInvalid();
   }
@@ -295,10 +426,10 @@ void CGUIListItem::Serialize(CVariant &value)
 
   for (const auto& it : m_mapProperties)
   {
-    value["properties"][it.first] = it.second;
+    value["properties"][GetPropertyName(it.first)] = it.second;
   }
   for (const auto& it : m_art)
-    value["art"][it.first] = it.second;
+    value["art"][ArtAtoms().GetName(it.first)] = it.second;
 }
 
 void CGUIListItem::FreeIcons()
@@ -350,24 +481,24 @@ void CGUIListItem::SetInvalid()
 
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
-  {
-    m_mapProperties.insert(make_pair(strKey, value));
-    SetInvalid();
-  }
-  else if (iter->second != value)
-  {
-    iter->second = value;
+  SetProperty(PropertyKey{PropertyAtoms().Intern(strKey), PropertyNames().Intern(strKey)}, value);
+}
+
+void CGUIListItem::SetProperty(const PropertyKey& key, const CVariant& value)
+{
+  if (SetAtom(m_mapProperties, key, value))
     SetInvalid();
-  }
 }
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
 
+  const uint32_t atom = PropertyAtoms().Find(strKey);
+  if (atom == CAtomTable::NONE)
+    return nullVariant;
+
+  auto iter = FindAtom(m_mapProperties, atom);
   if (iter == m_mapProperties.end())
     return nullVariant;
 
@@ -376,16 +507,25 @@ const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
+  const uint32_t atom = PropertyAtoms().Find(strKey);
+  if (atom == CAtomTable::NONE)
     return false;
 
-  return true;
+  return FindAtom(m_mapProperties, atom) != m_mapProperties.end();
+}
+
+bool CGUIListItem::HasProperties() const
+{
+  return !m_mapProperties.empty();
 }
 
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  const uint32_t atom = PropertyAtoms().Find(strKey);
+  if (atom == CAtomTable::NONE)
+    return;
+
+  auto iter = FindAtom(m_mapProperties, atom);
   if (iter != m_mapProperties.end())
   {
     m_mapProperties.erase(iter);
@@ -429,6 +569,16 @@ void CGUIListItem::AppendProperties(const CGUIListItem &item)
     SetProperty(i.first, i.second);
 }
 
+const std::string& CGUIListItem::GetPropertyName(const PropertyKey& key)
+{
+  return PropertyNames().GetName(key.name);
+}
+
+size_t CGUIListItem::GetStringHeapUsage(const std::string& str)
+{
+  return StringHeapBytes(str);
+}
+
 void CGUIListItem::SetCurrentItem(unsigned int position)
 {
   m_currentItem = position;
@@ -438,3 +588,21 @@ unsigned int CGUIListItem::GetCurrentItem() const
 {
   return m_currentItem;
 }
+
+size_t CGUIListItem::GetMemoryUsage() const
+{
+  size_t bytes = sizeof(CGUIListItem);
+  bytes += StringHeapBytes(m_strLabel) + StringHeapBytes(m_strLabel2);
+  bytes += StringHeapBytes(m_sortLabel);
+
+  bytes += m_mapProperties.capacity() * sizeof(PropertyMap::value_type);
+  for (const auto& i : m_mapProperties)
+    bytes += VariantHeapBytes(i.second);
+
+  bytes += m_art.capacity() * sizeof(decltype(m_art)::value_type);
+  for (const auto& i : m_art)
+    bytes += StringHeapBytes(i.second);
+  bytes += m_artFallbacks.capacity() * sizeof(decltype(m_artFallbacks)::value_type);
+
+  return bytes;
+}
@@ -15,7 +15,10 @@
 
 #include <map>
 #include <memory>
+#include <stdint.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -101,11 +104,18 @@ public:
   std::string GetArt(const std::string &type) const;
 
   /*! \brief get artwork for an item
-   Retrieves artwork in a type:url map
+   Retrieves artwork in a type:url map. The map is a copy built on each call
+   and doesn't follow later changes of the item, use GetArt(type) or HasArt()
+   to query single art types.
    \return a type:url map for artwork
    \sa SetArt
    */
-  const ArtMap &GetArt() const;
+  ArtMap GetArt() const;
+
+  /*! \brief Check whether an item has any art
+   \return true if at least one art type is set, false otherwise.
+   */
+  bool HasArt() const { return !m_art.empty(); }
 
   /*! \brief Check whether an item has a particular piece of art
    Equivalent to !GetArt(type).empty()
@@ -155,7 +165,7 @@ public:
   void Serialize(CVariant& value);
 
   bool       HasProperty(const std::string &strKey) const;
-  bool HasProperties() const { return !m_mapProperties.empty(); }
+  bool HasProperties() const;
   void       ClearProperty(const std::string &strKey);
 
   const CVariant &GetProperty(const std::string &strKey) const;
@@ -174,6 +184,11 @@ public:
    */
   unsigned int GetCurrentItem() const;
 
+  /*! \brief Approximate number of bytes used by this item, including heap allocations
+   Interned property names and art types are shared by all items and not included.
+   */
+  virtual size_t GetMemoryUsage() const;
+
 protected:
   std::string m_strLabel2;     // text of column2
   GUIIconOverlay m_overlayIcon; // type of overlay icon
@@ -183,18 +198,34 @@ protected:
   bool m_bSelected;     // item is selected or not
   unsigned int m_currentItem; // current item number within container (starting at 1)
 
-  struct icompare
+  struct PropertyKey
   {
-    bool operator()(const std::string &s1, const std::string &s2) const;
+    uint32_t atom; ///< atom of the key, case insensitive
+    uint32_t name; ///< atom of the key as it was first set on this item
   };
 
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  /*! \brief Get the name of a property key as it was first set on this item
+   Properties are found by an atom of their case insensitive key.
+   \sa CAtomTable
+   */
+  static const std::string& GetPropertyName(const PropertyKey& key);
+
+  /*! \brief Number of bytes a string allocated outside of its object, for GetMemoryUsage()
+   */
+  static size_t GetStringHeapUsage(const std::string& str);
+
+  /*! Properties sorted by the atom of their key. A flat vector instead of a
+   map node per property, most items have a handful of properties only. */
+  typedef std::vector<std::pair<PropertyKey, CVariant>> PropertyMap;
   PropertyMap m_mapProperties;
 private:
+  void SetProperty(const PropertyKey& key, const CVariant& value);
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
-  ArtMap m_art;
-  ArtMap m_artFallbacks;
+  // art type atom:url and art type atom:art type atom, sorted by the first atom
+  std::vector<std::pair<uint32_t, std::string>> m_art;
+  std::vector<std::pair<uint32_t, uint32_t>> m_artFallbacks;
 };
 
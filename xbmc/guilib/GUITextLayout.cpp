@@ -12,11 +12,15 @@
 #include "GUIComponent.h"
 #include "GUIControl.h"
 #include "GUIFont.h"
+#include "GUIFontManager.h"
+#include "GUITextLayoutCache.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <limits>
+#include <memory>
+#include <utility>
 
 CGUIString::CGUIString(iString start, iString end, bool carriageReturn)
 {
@@ -246,13 +250,42 @@ bool CGUITextLayout::UpdateW(const std::wstring &text, float maxWidth /*= 0*/, b
 
 void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool forceLTRReadingOrder)
 {
+  CGUITextLayoutCache::Key key;
+  key.font = m_font;
+  key.style = m_font ? m_font->GetStyle() : 0;
+  key.color = m_textColor;
+  key.wrap = m_wrap;
+  key.forceLTRReadingOrder = forceLTRReadingOrder;
+  key.maxWidth = maxWidth;
+  key.maxHeight = m_maxHeight;
+  key.text = text;
+
+  // the same text is often laid out the same way by other labels, or by this one before
+  CGUITextLayoutCache& cache = g_fontManager.GetTextLayoutCache();
+  const std::shared_ptr<const CGUITextLayoutCache::Layout> cached = cache.Get(key);
+  if (cached)
+  {
+    m_lines = cached->lines;
+    m_colors = cached->colors;
+    m_textWidth = cached->width;
+    m_textHeight = cached->height;
+    return;
+  }
+
   // parse the text for style information
   vecText parsedText;
   std::vector<UTILS::COLOR::Color> colors;
-  ParseText(text, m_font ? m_font->GetStyle() : 0, m_textColor, colors, parsedText);
+  ParseText(text, key.style, m_textColor, colors, parsedText);
 
   // and update
   UpdateStyled(parsedText, colors, maxWidth, forceLTRReadingOrder);
+
+  auto layout = std::make_shared<CGUITextLayoutCache::Layout>();
+  layout->lines = m_lines;
+  layout->colors = m_colors;
+  layout->width = m_textWidth;
+  layout->height = m_textHeight;
+  cache.Add(std::move(key), std::move(layout));
 }
 
 void CGUITextLayout::UpdateStyled(const vecText& text,
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextLayoutCache.h"
+
+#include "utils/log.h"
+
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+void HashCombine(size_t& hash, size_t value)
+{
+  hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+} // unnamed namespace
+
+CGUITextLayoutCache::CGUITextLayoutCache(size_t maxSize, size_t maxLayoutSize)
+  : m_maxSize(maxSize), m_maxLayoutSize(maxLayoutSize)
+{
+}
+
+bool CGUITextLayoutCache::Key::operator==(const Key& other) const
+{
+  return font == other.font && style == other.style && color == other.color &&
+         wrap == other.wrap && forceLTRReadingOrder == other.forceLTRReadingOrder &&
+         maxWidth == other.maxWidth && maxHeight == other.maxHeight && text == other.text;
+}
+
+size_t CGUITextLayoutCache::KeyHash::operator()(const Key& key) const
+{
+  size_t hash = std::hash<std::wstring>{}(key.text);
+  HashCombine(hash, std::hash<const CGUIFont*>{}(key.font));
+  HashCombine(hash, key.style);
+  HashCombine(hash, key.color);
+  HashCombine(hash, std::hash<float>{}(key.maxWidth));
+  HashCombine(hash, std::hash<float>{}(key.maxHeight));
+  HashCombine(hash, (key.wrap ? 1 : 0) | (key.forceLTRReadingOrder ? 2 : 0));
+  return hash;
+}
+
+size_t CGUITextLayoutCache::GetSize(const Key& key, const Layout& layout)
+{
+  // the text of the key is held by the entry and the index
+  size_t size = sizeof(Entry) + sizeof(Key) + sizeof(Layout) +
+                2 * key.text.size() * sizeof(wchar_t) +
+                layout.colors.size() * sizeof(UTILS::COLOR::Color);
+  for (const CGUIString& line : layout.lines)
+    size += sizeof(CGUIString) + line.m_text.size() * sizeof(character_t);
+  return size;
+}
+
+std::shared_ptr<const CGUITextLayoutCache::Layout> CGUITextLayoutCache::Get(const Key& key)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    m_stats.misses++;
+    return {};
+  }
+
+  m_stats.hits++;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->layout;
+}
+
+void CGUITextLayoutCache::Add(Key key, std::shared_ptr<const Layout> layout)
+{
+  const size_t size = GetSize(key, *layout);
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto it = m_index.find(key);
+  if (it != m_index.end())
+    Remove(it->second);
+
+  if (size > m_maxLayoutSize)
+  {
+    m_stats.skipped++;
+    return;
+  }
+
+  while (!m_entries.empty() && m_size + size > m_maxSize)
+  {
+    Remove(std::prev(m_entries.end()));
+    m_stats.evictions++;
+  }
+
+  m_entries.push_front({std::move(key), std::move(layout), size});
+  m_index.emplace(m_entries.front().key, m_entries.begin());
+  m_size += size;
+}
+
+void CGUITextLayoutCache::Remove(std::list<Entry>::iterator entry)
+{
+  m_size -= entry->size;
+  m_index.erase(entry->key);
+  m_entries.erase(entry);
+}
+
+void CGUITextLayoutCache::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (m_stats.hits + m_stats.misses > 0)
+    CLog::LogF(LOGDEBUG,
+               "Dropping {} layouts ({} bytes), {} hits, {} misses ({:.1f}% hit rate), "
+               "{} evictions, {} skipped",
+               m_entries.size(), m_size, m_stats.hits, m_stats.misses, m_stats.HitRate() * 100.0,
+               m_stats.evictions, m_stats.skipped);
+
+  m_index.clear();
+  m_entries.clear();
+  m_size = 0;
+  m_stats = {};
+}
+
+CGUITextLayoutCache::Stats CGUITextLayoutCache::GetStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  Stats stats = m_stats;
+  stats.layouts = m_entries.size();
+  stats.size = m_size;
+  return stats;
+}
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GUITextLayout.h"
+#include "threads/CriticalSection.h"
+#include "utils/ColorUtils.h"
+
+#include <list>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CGUIFont;
+
+/*!
+ \ingroup textures
+ \brief Keeps the most recently laid out texts so identical labels are laid out once
+
+ Parsing the text for formatting, wrapping it and the bidi transform are done
+ again whenever a label gets another text, which happens all the time while a
+ list scrolls, and the same texts show up in many labels. The layouts are kept
+ for the font, style and width they were made for and shared by all text
+ layouts. The cache is bounded by the bytes the layouts take, the least
+ recently used ones are dropped when it is full. A layout taking more than a
+ 64th of the cache by default, e.g. of a long plot in a text box, isn't cached.
+
+ The font is part of the key by its address, it isn't used otherwise.
+
+ The font manager clears the cache whenever fonts are reloaded or unloaded.
+
+ \sa CGUITextLayout, GUIFontManager
+ */
+class CGUITextLayoutCache
+{
+public:
+  struct Key
+  {
+    bool operator==(const Key& other) const;
+
+    const CGUIFont* font = nullptr;
+    uint32_t style = 0;
+    UTILS::COLOR::Color color = 0;
+    bool wrap = false;
+    bool forceLTRReadingOrder = false;
+    float maxWidth = 0.0f;
+    float maxHeight = 0.0f;
+    std::wstring text;
+  };
+
+  struct Layout
+  {
+    std::vector<CGUIString> lines;
+    std::vector<UTILS::COLOR::Color> colors;
+    float width = 0.0f;
+    float height = 0.0f;
+  };
+
+  struct Stats
+  {
+    double HitRate() const { return hits + misses > 0 ? double(hits) / (hits + misses) : 0.0; }
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0; //!< layouts dropped to make room for others
+    uint64_t skipped = 0; //!< layouts too big to be cached
+    size_t layouts = 0; //!< layouts in the cache
+    size_t size = 0; //!< bytes taken by the layouts in the cache
+  };
+
+  //! enough for the labels of a few full lists and their neighbours while scrolling
+  static constexpr size_t DEFAULT_MAX_SIZE = 4 * 1024 * 1024;
+  static constexpr size_t DEFAULT_MAX_LAYOUT_SIZE = DEFAULT_MAX_SIZE / 64;
+
+  /*!
+   \param maxSize bytes the layouts may take
+   \param maxLayoutSize bytes a layout may take to be cached
+   */
+  explicit CGUITextLayoutCache(size_t maxSize = DEFAULT_MAX_SIZE,
+                               size_t maxLayoutSize = DEFAULT_MAX_LAYOUT_SIZE);
+
+  /*! \brief Get the layout of a text
+   \param key the text and what it is laid out for
+   \return the layout, nullptr if it's not in the cache
+   */
+  std::shared_ptr<const Layout> Get(const Key& key);
+
+  /*! \brief Add the layout of a text, dropping the least recently used ones if the cache is full
+   */
+  void Add(Key key, std::shared_ptr<const Layout> layout);
+
+  /*! \brief Drop all layouts, e.g. when the fonts they were made with are gone
+   */
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    Key key;
+    std::shared_ptr<const Layout> layout;
+    size_t size = 0;
+  };
+
+  static size_t GetSize(const Key& key, const Layout& layout);
+
+  void Remove(std::list<Entry>::iterator entry);
+
+  const size_t m_maxSize;
+  const size_t m_maxLayoutSize;
+
+  mutable CCriticalSection m_critSection;
+  std::list<Entry> m_entries; //!< most recently used first
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+  size_t m_size = 0;
+  Stats m_stats;
+};
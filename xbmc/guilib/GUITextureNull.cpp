@@ -0,0 +1,31 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextureNull.h"
+
+void CGUITextureNull::Register()
+{
+  CGUITexture::Register(CGUITextureNull::CreateTexture, CGUITextureNull::DrawQuad);
+}
+
+CGUITexture* CGUITextureNull::CreateTexture(
+    float posX, float posY, float width, float height, const CTextureInfo& texture)
+{
+  return new CGUITextureNull(posX, posY, width, height, texture);
+}
+
+CGUITextureNull::CGUITextureNull(
+    float posX, float posY, float width, float height, const CTextureInfo& texture)
+  : CGUITexture(posX, posY, width, height, texture)
+{
+}
+
+CGUITextureNull* CGUITextureNull::Clone() const
+{
+  return new CGUITextureNull(*this);
+}
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GUITexture.h"
+
+/*!
+ \brief GUI texture of the null render system, nothing is drawn
+ */
+class CGUITextureNull : public CGUITexture
+{
+public:
+  static void Register();
+  static CGUITexture* CreateTexture(
+      float posX, float posY, float width, float height, const CTextureInfo& texture);
+
+  static void DrawQuad(const CRect& coords,
+                       UTILS::COLOR::Color color,
+                       CTexture* texture = nullptr,
+                       const CRect* texCoords = nullptr)
+  {
+  }
+
+  CGUITextureNull(float posX, float posY, float width, float height, const CTextureInfo& texture);
+  ~CGUITextureNull() override = default;
+
+  CGUITextureNull* Clone() const override;
+
+protected:
+  void Begin(UTILS::COLOR::Color color) override {}
+  void Draw(float* x,
+            float* y,
+            float* z,
+            const CRect& texture,
+            const CRect& diffuse,
+            int orientation) override
+  {
+  }
+  void End() override {}
+
+private:
+  CGUITextureNull(const CGUITextureNull& texture) = default;
+};
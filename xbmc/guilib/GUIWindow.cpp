@@ -112,6 +112,9 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
     m_windowLoaded = true;
     OnWindowLoaded();
 
+    if (IsDialog() && CServiceBroker::GetGUI())
+      CServiceBroker::GetGUI()->GetWindowManager().InvalidateAutoVisibleDialogs();
+
 #ifdef _DEBUG
     const auto end = std::chrono::steady_clock::now();
     const std::chrono::duration<double, std::milli> duration = end - start;
@@ -817,6 +820,9 @@ void CGUIWindow::ClearAll()
   m_windowLoaded = false;
   m_dynamicResourceAlloc = true;
   m_visibleCondition.reset();
+
+  if (IsDialog() && CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetWindowManager().InvalidateAutoVisibleDialogs();
 }
 
 bool CGUIWindow::Initialize()
@@ -123,6 +123,11 @@ public:
   void DynamicResourceAlloc(bool bOnOff) override;
   virtual bool IsDialog() const { return false; }
   virtual bool IsDialogRunning() const { return false; }
+  /*!
+   \brief Return if the dialog may open or close itself from UpdateVisibility(), so it
+    has to be processed while it is not running
+   */
+  virtual bool HasAutoVisibility() const { return false; }
   virtual bool IsModalDialog() const { return false; }
   virtual bool IsMediaWindow() const { return false; }
   virtual bool HasListItems() const { return false; }
@@ -44,6 +44,7 @@
 #include "settings/windows/GUIWindowSettingsScreenCalibration.h"
 #include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -66,6 +67,7 @@
 #include "windows/GUIWindowStartup.h"
 #include "windows/GUIWindowSystemInfo.h"
 
+#include <algorithm>
 #include <mutex>
 
 // Dialog includes
@@ -633,6 +635,7 @@ void CGUIWindowManager::Add(CGUIWindow* pWindow)
 
     m_mapWindows.insert(std::make_pair(id, pWindow));
   }
+  m_autoVisibleDialogsValid = false;
 }
 
 void CGUIWindowManager::AddCustomWindow(CGUIWindow* pWindow)
@@ -652,6 +655,27 @@ void CGUIWindowManager::RegisterDialog(CGUIWindow* dialog)
       return;
   }
   m_activeDialogs.emplace_back(dialog);
+  m_renderDialogsValid = false;
+}
+
+void CGUIWindowManager::InvalidateAutoVisibleDialogs()
+{
+  std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  m_autoVisibleDialogsValid = false;
+  // the render order is loaded with the skin as well
+  m_renderDialogsValid = false;
+}
+
+void CGUIWindowManager::UpdateAutoVisibleDialogs()
+{
+  m_autoVisibleDialogs.clear();
+  for (const auto& entry : m_mapWindows)
+  {
+    CGUIWindow* window = entry.second;
+    if (window->IsDialog() && window->HasAutoVisibility())
+      m_autoVisibleDialogs.emplace_back(window);
+  }
+  m_autoVisibleDialogsValid = true;
 }
 
 void CGUIWindowManager::Remove(int id)
@@ -670,7 +694,11 @@ void CGUIWindowManager::Remove(int id)
                                          m_activeDialogs.end(),
                                          [window](CGUIWindow* w){ return w == window; }),
                           m_activeDialogs.end());
+    m_stoppedDialogs.erase(std::remove(m_stoppedDialogs.begin(), m_stoppedDialogs.end(), window),
+                           m_stoppedDialogs.end());
     m_mapWindows.erase(it);
+    m_autoVisibleDialogsValid = false;
+    m_renderDialogsValid = false;
   }
   else
   {
@@ -1216,6 +1244,8 @@ bool RenderOrderSortFunction(CGUIWindow *first, CGUIWindow *second)
 
 void CGUIWindowManager::Process(unsigned int currentTime)
 {
+  KODI_TRACE_SCOPE("gui", "CGUIWindowManager::Process");
+
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
   std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
@@ -1225,12 +1255,29 @@ void CGUIWindowManager::Process(unsigned int currentTime)
   if (pWindow)
     pWindow->DoProcess(currentTime, m_dirtyregions);
 
-  // process all dialogs - visibility may change etc.
-  for (const auto& entry : m_mapWindows)
+  // process the running dialogs, the dialogs that stopped running so they mark
+  // their region dirty and the dialogs that may open themselves - skins define
+  // hundreds of dialogs and almost all of them are idle. We take a copy as
+  // dialogs may open or close during this call.
+  if (!m_autoVisibleDialogsValid)
+    UpdateAutoVisibleDialogs();
+
+  std::vector<CGUIWindow*> dialogs;
+  dialogs.reserve(m_autoVisibleDialogs.size() + m_activeDialogs.size() + m_stoppedDialogs.size());
+  dialogs.insert(dialogs.end(), m_autoVisibleDialogs.begin(), m_autoVisibleDialogs.end());
+  dialogs.insert(dialogs.end(), m_activeDialogs.begin(), m_activeDialogs.end());
+  dialogs.insert(dialogs.end(), m_stoppedDialogs.begin(), m_stoppedDialogs.end());
+  m_stoppedDialogs.clear();
+
+  // in the order of their ids, as they were processed when all windows were visited
+  std::sort(dialogs.begin(), dialogs.end(),
+            [](const CGUIWindow* a, const CGUIWindow* b) { return a->GetID() < b->GetID(); });
+  dialogs.erase(std::unique(dialogs.begin(), dialogs.end()), dialogs.end());
+
+  for (const auto& window : dialogs)
   {
-    CGUIWindow *pWindow = entry.second;
-    if (pWindow && pWindow->IsDialog())
-      pWindow->DoProcess(currentTime, m_dirtyregions);
+    if (window->IsDialog())
+      window->DoProcess(currentTime, m_dirtyregions);
   }
 
   for (auto& itr : m_dirtyregions)
@@ -1267,10 +1314,14 @@ void CGUIWindowManager::RenderPass() const
   }
 
   // we render the dialogs based on their render order.
-  auto renderList = m_activeDialogs;
-  stable_sort(renderList.begin(), renderList.end(), RenderOrderSortFunction);
+  if (!m_renderDialogsValid)
+  {
+    m_renderDialogs = m_activeDialogs;
+    stable_sort(m_renderDialogs.begin(), m_renderDialogs.end(), RenderOrderSortFunction);
+    m_renderDialogsValid = true;
+  }
 
-  for (const auto& window : renderList)
+  for (const auto& window : m_renderDialogs)
   {
     if (window->IsDialogRunning())
       window->DoRender();
@@ -1297,6 +1348,8 @@ void CGUIWindowManager::RenderEx() const
 
 bool CGUIWindowManager::Render()
 {
+  KODI_TRACE_SCOPE("gui", "CGUIWindowManager::Render");
+
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
   CSingleExit lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
@@ -1479,6 +1532,8 @@ void CGUIWindowManager::DeInitialize()
   // clear our vectors of windows
   m_vecCustomWindows.clear();
   m_activeDialogs.clear();
+  m_stoppedDialogs.clear();
+  m_renderDialogsValid = false;
 
   m_initialized = false;
 }
@@ -1488,10 +1543,12 @@ void CGUIWindowManager::DeInitialize()
 void CGUIWindowManager::RemoveDialog(int id)
 {
   std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
-  m_activeDialogs.erase(std::remove_if(m_activeDialogs.begin(),
-                                       m_activeDialogs.end(),
-                                       [id](CGUIWindow* dialog) { return dialog->GetID() == id; }),
-                         m_activeDialogs.end());
+  const auto it = std::stable_partition(m_activeDialogs.begin(), m_activeDialogs.end(),
+                                        [id](CGUIWindow* dialog) { return dialog->GetID() != id; });
+  // process it once more, so it marks its region dirty
+  m_stoppedDialogs.insert(m_stoppedDialogs.end(), it, m_activeDialogs.end());
+  m_activeDialogs.erase(it, m_activeDialogs.end());
+  m_renderDialogsValid = false;
 }
 
 bool CGUIWindowManager::HasModalDialog(bool ignoreClosing) const
@@ -178,6 +178,13 @@ public:
   void RegisterDialog(CGUIWindow* dialog);
   void RemoveDialog(int id);
 
+  /*! \brief Rebuild the list of dialogs that may open themselves before the next frame
+   *
+   * Called when a dialog loads or unloads its skin, which sets or clears its
+   * visible condition.
+   */
+  void InvalidateAutoVisibleDialogs();
+
   /*! \brief Get the ID of the topmost dialog
    *
    * \param ignoreClosing ignore dialog is closing
@@ -231,6 +238,7 @@ public:
 #endif
 private:
   void RenderPass() const;
+  void UpdateAutoVisibleDialogs();
 
   void LoadNotOnDemandWindows();
   void UnloadNotOnDemandWindows();
@@ -268,6 +276,12 @@ private:
   std::vector<CGUIWindow*> m_activeDialogs;
   std::vector<CGUIWindow*> m_deleteWindows;
 
+  std::vector<CGUIWindow*> m_autoVisibleDialogs; ///< dialogs that may open themselves
+  bool m_autoVisibleDialogsValid{false};
+  std::vector<CGUIWindow*> m_stoppedDialogs; ///< dialogs that stopped running since the last Process()
+  mutable std::vector<CGUIWindow*> m_renderDialogs; ///< active dialogs sorted by render order
+  mutable bool m_renderDialogsValid{false};
+
   std::deque<int> m_windowHistory;
 
   IWindowManagerCallback* m_pCallback;
@@ -193,7 +193,8 @@ std::unique_ptr<CTexture> CTexture::LoadFromFile(const std::string& texturePath,
                                                  unsigned int idealWidth,
                                                  unsigned int idealHeight,
                                                  bool requirePixels,
-                                                 const std::string& strMimeType)
+                                                 const std::string& strMimeType,
+                                                 bool scaledDecode)
 {
 #if defined(TARGET_ANDROID)
   CURL url(texturePath);
@@ -218,7 +219,8 @@ std::unique_ptr<CTexture> CTexture::LoadFromFile(const std::string& texturePath,
   }
 #endif
   std::unique_ptr<CTexture> texture = CTexture::CreateTexture();
-  if (texture->LoadFromFileInternal(texturePath, idealWidth, idealHeight, requirePixels, strMimeType))
+  if (texture->LoadFromFileInternal(texturePath, idealWidth, idealHeight, requirePixels, strMimeType,
+                                    scaledDecode))
     return texture;
   return {};
 }
@@ -239,7 +241,8 @@ bool CTexture::LoadFromFileInternal(const std::string& texturePath,
                                     unsigned int maxWidth,
                                     unsigned int maxHeight,
                                     bool requirePixels,
-                                    const std::string& strMimeType)
+                                    const std::string& strMimeType,
+                                    bool scaledDecode)
 {
   if (URIUtils::HasExtension(texturePath, ".dds"))
   { // special case for DDS images
@@ -291,6 +294,9 @@ bool CTexture::LoadFromFileInternal(const std::string& texturePath,
   else
     pImage = ImageFactory::CreateLoaderFromMimeType(strMimeType);
 
+  if (pImage)
+    pImage->SetScaledDecode(scaledDecode);
+
   if (!LoadIImage(pImage, buf.data(), buf.size(), width, height))
   {
     CLog::Log(LOGDEBUG, "{} - Load of {} failed.", __FUNCTION__, CURL::GetRedacted(texturePath));
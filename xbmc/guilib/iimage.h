@@ -54,6 +54,11 @@ public:
    \brief Frees the output buffer allocated by CreateThumbnailFromSurface
    */
   virtual void ReleaseThumbnailBuffer() {}
+  /*!
+   \brief Allow the decoder to drop detail that scaling to the ideal size removes anyway
+   \remarks Call before LoadImageFromMemory(). Only for images that are not shown larger than the ideal size.
+   */
+  virtual void SetScaledDecode(bool scaledDecode) {}
 
   unsigned int Width() const              { return m_width; }
   unsigned int Height() const             { return m_height; }
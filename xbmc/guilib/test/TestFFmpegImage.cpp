@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/FFmpegImage.h"
+#include "guilib/TextureFormats.h"
+
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr unsigned int WIDTH = 1600;
+constexpr unsigned int HEIGHT = 1200;
+
+/*!
+ * \brief Encode a grey JPEG of WIDTH x HEIGHT
+ */
+std::vector<unsigned char> MakeJpeg()
+{
+  std::vector<unsigned char> pixels(WIDTH * HEIGHT * 4, 0x80);
+  CFFmpegImage encoder("image/jpeg");
+  unsigned char* buffer = nullptr;
+  unsigned int size = 0;
+  if (!encoder.CreateThumbnailFromSurface(pixels.data(), WIDTH, HEIGHT, XB_FMT_A8R8G8B8, WIDTH * 4,
+                                          "test.jpg", buffer, size))
+    return {};
+
+  std::vector<unsigned char> jpeg(buffer, buffer + size);
+  encoder.ReleaseThumbnailBuffer();
+  return jpeg;
+}
+} // unnamed namespace
+
+TEST(TestFFmpegImage, GetLowres)
+{
+  const AVCodec* mjpeg = avcodec_find_decoder(AV_CODEC_ID_MJPEG);
+  ASSERT_NE(nullptr, mjpeg);
+  const AVCodec* png = avcodec_find_decoder(AV_CODEC_ID_PNG);
+
+  AVCodecParameters* params = avcodec_parameters_alloc();
+  params->width = 4000;
+  params->height = 3000;
+
+  // no size asked for, the full size
+  EXPECT_EQ(0, CFFmpegImage::GetLowres(mjpeg, params, 0, 0));
+  // not twice as large
+  EXPECT_EQ(0, CFFmpegImage::GetLowres(mjpeg, params, 2500, 2500));
+  // a half still covers 1920 wide, a quarter does not
+  EXPECT_EQ(1, CFFmpegImage::GetLowres(mjpeg, params, 1920, 1080));
+  EXPECT_EQ(2, CFFmpegImage::GetLowres(mjpeg, params, 1000, 1000));
+  // never more than the decoder can do
+  EXPECT_EQ(mjpeg->max_lowres, CFFmpegImage::GetLowres(mjpeg, params, 1, 1));
+  // only JPEG is downscaled
+  if (png)
+  {
+    EXPECT_EQ(0, CFFmpegImage::GetLowres(png, params, 1000, 1000));
+  }
+
+  avcodec_parameters_free(&params);
+}
+
+TEST(TestFFmpegImage, ScaledDecodeOnlyWhenAsked)
+{
+  std::vector<unsigned char> jpeg = MakeJpeg();
+  ASSERT_FALSE(jpeg.empty());
+
+  // the max size alone does not downscale, the image may be shown larger
+  CFFmpegImage full("image/jpeg");
+  ASSERT_TRUE(full.LoadImageFromMemory(jpeg.data(), jpeg.size(), 400, 300));
+  EXPECT_EQ(WIDTH, full.Width());
+  EXPECT_EQ(WIDTH, full.originalWidth());
+
+  CFFmpegImage scaled("image/jpeg");
+  scaled.SetScaledDecode(true);
+  ASSERT_TRUE(scaled.LoadImageFromMemory(jpeg.data(), jpeg.size(), 400, 300));
+  EXPECT_EQ(WIDTH / 4, scaled.Width());
+  EXPECT_EQ(WIDTH, scaled.originalWidth());
+}
@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUITextLayoutCache.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// the cache doesn't use the fonts, only their addresses
+int fontA;
+int fontB;
+const CGUIFont* FONT_A = reinterpret_cast<const CGUIFont*>(&fontA);
+const CGUIFont* FONT_B = reinterpret_cast<const CGUIFont*>(&fontB);
+
+CGUITextLayoutCache::Key MakeKey(const std::wstring& text, const CGUIFont* font = FONT_A)
+{
+  CGUITextLayoutCache::Key key;
+  key.font = font;
+  key.maxWidth = 100.0f;
+  key.text = text;
+  return key;
+}
+
+//! a single line layout of the given number of characters
+std::shared_ptr<const CGUITextLayoutCache::Layout> MakeLayout(size_t length)
+{
+  auto layout = std::make_shared<CGUITextLayoutCache::Layout>();
+  const vecText text(length, L'a');
+  layout->lines.emplace_back(text.begin(), text.end(), false);
+  layout->colors.emplace_back(0xFFFFFFFF);
+  layout->width = 10.0f * length;
+  layout->height = 20.0f;
+  return layout;
+}
+
+//! bytes taken by a layout of MakeLayout(length) with a key of the same number of characters
+size_t GetSize(size_t length)
+{
+  CGUITextLayoutCache cache;
+  cache.Add(MakeKey(std::wstring(length, L'a')), MakeLayout(length));
+  return cache.GetStats().size;
+}
+} // unnamed namespace
+
+TEST(TestGUITextLayoutCache, GetsLayoutAdded)
+{
+  CGUITextLayoutCache cache;
+  const auto layout = MakeLayout(5);
+  cache.Add(MakeKey(L"hello"), layout);
+
+  EXPECT_EQ(layout, cache.Get(MakeKey(L"hello")));
+  EXPECT_EQ(nullptr, cache.Get(MakeKey(L"world")));
+
+  const CGUITextLayoutCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(1u, stats.layouts);
+  EXPECT_GT(stats.size, 0u);
+}
+
+TEST(TestGUITextLayoutCache, KeyedByFontAndMetrics)
+{
+  CGUITextLayoutCache cache;
+  cache.Add(MakeKey(L"text"), MakeLayout(4));
+
+  // a text laid out for another font, width or style is another layout
+  EXPECT_EQ(nullptr, cache.Get(MakeKey(L"text", FONT_B)));
+
+  CGUITextLayoutCache::Key key = MakeKey(L"text");
+  key.maxWidth = 101.0f;
+  EXPECT_EQ(nullptr, cache.Get(key));
+
+  key = MakeKey(L"text");
+  key.maxHeight = 50.0f;
+  EXPECT_EQ(nullptr, cache.Get(key));
+
+  key = MakeKey(L"text");
+  key.style = 1;
+  EXPECT_EQ(nullptr, cache.Get(key));
+
+  key = MakeKey(L"text");
+  key.color = 0xFF000000;
+  EXPECT_EQ(nullptr, cache.Get(key));
+
+  key = MakeKey(L"text");
+  key.wrap = true;
+  EXPECT_EQ(nullptr, cache.Get(key));
+
+  key = MakeKey(L"text");
+  key.forceLTRReadingOrder = true;
+  EXPECT_EQ(nullptr, cache.Get(key));
+
+  EXPECT_NE(nullptr, cache.Get(MakeKey(L"text")));
+}
+
+TEST(TestGUITextLayoutCache, EvictsLeastRecentlyUsed)
+{
+  // room for three layouts
+  CGUITextLayoutCache cache(3 * GetSize(1) + 1);
+  cache.Add(MakeKey(L"a"), MakeLayout(1));
+  cache.Add(MakeKey(L"b"), MakeLayout(1));
+  cache.Add(MakeKey(L"c"), MakeLayout(1));
+
+  // using a makes b the least recently used
+  EXPECT_NE(nullptr, cache.Get(MakeKey(L"a")));
+  cache.Add(MakeKey(L"d"), MakeLayout(1));
+
+  EXPECT_EQ(nullptr, cache.Get(MakeKey(L"b")));
+  EXPECT_NE(nullptr, cache.Get(MakeKey(L"a")));
+  EXPECT_NE(nullptr, cache.Get(MakeKey(L"c")));
+  EXPECT_NE(nullptr, cache.Get(MakeKey(L"d")));
+
+  const CGUITextLayoutCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(3u, stats.layouts);
+  EXPECT_EQ(3 * GetSize(1), stats.size);
+}
+
+TEST(TestGUITextLayoutCache, BoundedByBytes)
+{
+  CGUITextLayoutCache cache(100 * GetSize(1));
+  for (int i = 0; i < 1000; i++)
+    cache.Add(MakeKey(std::to_wstring(i)), MakeLayout(1));
+
+  const CGUITextLayoutCache::Stats before = cache.GetStats();
+  EXPECT_LE(before.size, 100 * GetSize(1));
+  EXPECT_GT(before.evictions, 0u);
+
+  // a long text takes the room of several short ones
+  cache.Add(MakeKey(std::wstring(100, L'x')), MakeLayout(100));
+  const CGUITextLayoutCache::Stats after = cache.GetStats();
+  EXPECT_LE(after.size, 100 * GetSize(1));
+  EXPECT_GT(after.evictions, before.evictions + 1);
+  EXPECT_LT(after.layouts, before.layouts);
+}
+
+TEST(TestGUITextLayoutCache, SkipsBigLayouts)
+{
+  CGUITextLayoutCache cache(CGUITextLayoutCache::DEFAULT_MAX_SIZE, GetSize(100) - 1);
+  cache.Add(MakeKey(L"short"), MakeLayout(5));
+  cache.Add(MakeKey(std::wstring(100, L'x')), MakeLayout(100));
+
+  EXPECT_EQ(nullptr, cache.Get(MakeKey(std::wstring(100, L'x'))));
+  EXPECT_NE(nullptr, cache.Get(MakeKey(L"short")));
+
+  const CGUITextLayoutCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.skipped);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(1u, stats.layouts);
+}
+
+TEST(TestGUITextLayoutCache, ReplacesLayout)
+{
+  CGUITextLayoutCache cache;
+  cache.Add(MakeKey(L"text"), MakeLayout(4));
+  const auto layout = MakeLayout(4);
+  cache.Add(MakeKey(L"text"), layout);
+
+  EXPECT_EQ(layout, cache.Get(MakeKey(L"text")));
+  EXPECT_EQ(1u, cache.GetStats().layouts);
+  EXPECT_EQ(GetSize(4), cache.GetStats().size);
+}
+
+TEST(TestGUITextLayoutCache, Clear)
+{
+  CGUITextLayoutCache cache;
+  cache.Add(MakeKey(L"text"), MakeLayout(4));
+  cache.Clear();
+
+  EXPECT_EQ(nullptr, cache.Get(MakeKey(L"text")));
+  EXPECT_EQ(0u, cache.GetStats().layouts);
+  EXPECT_EQ(0u, cache.GetStats().size);
+}
@@ -13,12 +13,13 @@
 #include "music/tags/MusicInfoTag.h"
 #include "playlists/PlayListTypes.h"
 #include "pvr/channels/PVRChannel.h"
-#include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <stdio.h>
@@ -26,11 +27,21 @@
 #define LOOKUP_PROPERTY "database-lookup"
 
 using namespace ANNOUNCEMENT;
+using namespace std::chrono_literals;
+
+namespace
+{
+// a library scan updates an item several times in a row, e.g. once added and once its art is set
+constexpr auto LIBRARY_UPDATE_WINDOW = 500ms;
+constexpr size_t QUEUE_LIMIT = 10000;
+} // unnamed namespace
 
 const std::string CAnnouncementManager::ANNOUNCEMENT_SENDER = "xbmc";
 
-CAnnouncementManager::CAnnouncementManager() : CThread("Announce")
+CAnnouncementManager::CAnnouncementManager() : CThread("Announce"), m_queueLimit(QUEUE_LIMIT)
 {
+  m_windows[{VideoLibrary, "OnUpdate"}] = LIBRARY_UPDATE_WINDOW;
+  m_windows[{AudioLibrary, "OnUpdate"}] = LIBRARY_UPDATE_WINDOW;
 }
 
 CAnnouncementManager::~CAnnouncementManager()
@@ -48,6 +59,13 @@ void CAnnouncementManager::Deinitialize()
   m_bStop = true;
   m_queueEvent.Set();
   StopThread();
+
+  const Stats stats = GetStats();
+  CLog::Log(LOGDEBUG, LOGANNOUNCE,
+            "CAnnouncementManager - {} announcements, {} merged, {} dropped, {} delivered, "
+            "{} queued at most",
+            stats.announced, stats.coalesced, stats.dropped, stats.delivered, stats.maxQueued);
+
   std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
   m_announcers.clear();
 }
@@ -77,6 +95,28 @@ void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
   }
 }
 
+void CAnnouncementManager::SetCoalescingWindow(AnnouncementFlag flag,
+                                               const std::string& message,
+                                               std::chrono::milliseconds window)
+{
+  std::unique_lock<CCriticalSection> lock(m_queueCritSection);
+  m_windows[{flag, message}] = window;
+}
+
+void CAnnouncementManager::SetQueueLimit(size_t limit)
+{
+  std::unique_lock<CCriticalSection> lock(m_queueCritSection);
+  m_queueLimit = limit;
+}
+
+CAnnouncementManager::Stats CAnnouncementManager::GetStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_queueCritSection);
+  Stats stats = m_stats;
+  stats.queued = m_announcementQueue.size();
+  return stats;
+}
+
 void CAnnouncementManager::Announce(AnnouncementFlag flag, const std::string& message)
 {
   CVariant data;
@@ -138,11 +178,123 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag,
   if (item != nullptr)
     announcement.item = std::make_shared<CFileItem>(*item);
 
+  const auto now = std::chrono::steady_clock::now();
+  announcement.due = now;
+
+  bool wake;
   {
     std::unique_lock<CCriticalSection> lock(m_queueCritSection);
-    m_announcementQueue.push_back(announcement);
+    m_stats.announced++;
+
+    const auto window = m_windows.find({flag, message});
+    const bool coalesced = window != m_windows.end() && window->second.count() > 0;
+    if (coalesced)
+      announcement.key = GetItemKey(announcement);
+
+    if (!announcement.key.empty())
+    {
+      const auto heldBack = m_heldBack.find(announcement.key);
+      if (heldBack != m_heldBack.end())
+      {
+        // keep the place of the first one, with the latest item and data
+        CAnnounceData& queued = *heldBack->second;
+        if (announcement.item)
+          queued.item = announcement.item;
+        if (queued.data.isObject() && announcement.data.isObject())
+        {
+          for (auto it = announcement.data.begin_map(); it != announcement.data.end_map(); ++it)
+            queued.data[it->first] = it->second;
+        }
+        else if (!announcement.data.isNull())
+          queued.data = announcement.data;
+
+        m_stats.coalesced++;
+        return;
+      }
+      announcement.due = now + window->second;
+    }
+    else
+    {
+      // deliver the held back announcements of the flag first, to keep them in order
+      for (auto it = m_heldBack.begin(); it != m_heldBack.end();)
+      {
+        if (it->second->flag == flag)
+        {
+          it->second->due = now;
+          it->second->key.clear();
+          it = m_heldBack.erase(it);
+        }
+        else
+          ++it;
+      }
+    }
+
+    // only the updates are dropped, e.g. OnQuit or OnStop always go through
+    if (coalesced && m_announcementQueue.size() >= m_queueLimit)
+    {
+      if (m_stats.dropped++ == 0)
+        CLog::Log(LOGWARNING, "CAnnouncementManager - queue is full, dropping updates");
+      return;
+    }
+
+    // held back announcements are picked up by the next timed wait, unless there is none
+    wake = announcement.key.empty() || m_announcementQueue.empty();
+
+    const std::string key = announcement.key;
+    m_announcementQueue.push_back(std::move(announcement));
+    if (!key.empty())
+      m_heldBack[key] = std::prev(m_announcementQueue.end());
+
+    m_stats.maxQueued = std::max(m_stats.maxQueued, m_announcementQueue.size());
   }
-  m_queueEvent.Set();
+
+  if (wake)
+    m_queueEvent.Set();
+}
+
+std::string CAnnouncementManager::GetItemKey(const CAnnounceData& announcement)
+{
+  std::string type;
+  int id = 0;
+
+  // only items known by their database id, the others are looked up when they are delivered
+  if (announcement.item)
+  {
+    const std::shared_ptr<CFileItem>& item = announcement.item;
+    if (item->HasPVRChannelInfoTag())
+      return "";
+    if (item->HasVideoInfoTag() && !item->HasPVRRecordingInfoTag())
+    {
+      id = item->GetVideoInfoTag()->m_iDbId;
+      type = item->GetVideoInfoTag()->m_type;
+    }
+    else if (item->HasMusicInfoTag())
+    {
+      // a song and an album can have the same id
+      id = item->GetMusicInfoTag()->GetDatabaseId();
+      type = item->GetMusicInfoTag()->GetType();
+    }
+  }
+  else if (announcement.data["type"].isString() && announcement.data["id"].isInteger())
+  {
+    type = announcement.data["type"].asString();
+    id = static_cast<int>(announcement.data["id"].asInteger());
+  }
+
+  if (id <= 0 || type.empty())
+    return "";
+
+  return StringUtils::Format("{}.{}.{}.{}", static_cast<int>(announcement.flag),
+                             announcement.message, type, id);
+}
+
+void CAnnouncementManager::FlushAnnouncers()
+{
+  std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
+
+  std::vector<IAnnouncer*> announcers(m_announcers);
+  for (IAnnouncer* announcer : announcers)
+    announcer->FlushAnnouncements();
 }
 
 void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
@@ -323,21 +475,45 @@ void CAnnouncementManager::Process()
 
   while (!m_bStop)
   {
-    std::unique_lock<CCriticalSection> lock(m_queueCritSection);
-    if (!m_announcementQueue.empty())
+    std::vector<CAnnounceData> announcements;
+    std::chrono::steady_clock::duration wait = std::chrono::steady_clock::duration::max();
     {
-      auto announcement = m_announcementQueue.front();
-      m_announcementQueue.pop_front();
+      std::unique_lock<CCriticalSection> lock(m_queueCritSection);
+      const auto now = std::chrono::steady_clock::now();
+      for (auto it = m_announcementQueue.begin(); it != m_announcementQueue.end();)
       {
-        CSingleExit ex(m_queueCritSection);
-        DoAnnounce(announcement.flag, announcement.sender, announcement.message, announcement.item,
-                   announcement.data);
+        if (it->due <= now)
+        {
+          if (!it->key.empty())
+            m_heldBack.erase(it->key);
+          announcements.push_back(std::move(*it));
+          it = m_announcementQueue.erase(it);
+        }
+        else
+        {
+          wait = std::min(wait, it->due - now);
+          ++it;
+        }
       }
+      m_stats.delivered += announcements.size();
     }
-    else
+
+    if (announcements.empty())
+    {
+      if (wait == std::chrono::steady_clock::duration::max())
+        m_queueEvent.Wait();
+      else
+        m_queueEvent.Wait(std::chrono::duration_cast<std::chrono::milliseconds>(wait) + 1ms);
+      continue;
+    }
+
+    for (const CAnnounceData& announcement : announcements)
     {
-      CSingleExit ex(m_queueCritSection);
-      m_queueEvent.Wait();
+      if (m_bStop)
+        break;
+      DoAnnounce(announcement.flag, announcement.sender, announcement.message, announcement.item,
+                 announcement.data);
     }
+    FlushAnnouncers();
   }
 }
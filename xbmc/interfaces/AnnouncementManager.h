@@ -14,8 +14,13 @@
 #include "threads/Thread.h"
 #include "utils/Variant.h"
 
+#include <chrono>
 #include <list>
+#include <map>
 #include <memory>
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 class CFileItem;
@@ -23,9 +28,29 @@ class CVariant;
 
 namespace ANNOUNCEMENT
 {
+  /*!
+   * \brief Queues announcements and delivers them to the announcers on a thread of its own
+   *
+   * Announcements of a topic with a coalescing window, e.g. VideoLibrary.OnUpdate, are held back
+   * for the window. Repeated ones for the same item are merged in that time, so a library scan
+   * or a mark-watched job sends each item once with its last data. An announcement without a
+   * window flushes the held back ones of its flag first, so OnScanFinished still comes after the
+   * updates of the scan. The announcements due at the same time are delivered as one run,
+   * followed by IAnnouncer::FlushAnnouncements().
+   */
   class CAnnouncementManager : public CThread
   {
   public:
+    struct Stats
+    {
+      uint64_t announced = 0; //!< announcements queued or merged
+      uint64_t coalesced = 0; //!< announcements merged into a queued one for the same item
+      uint64_t dropped = 0; //!< held back announcements dropped because the queue was full
+      uint64_t delivered = 0; //!< announcements handed to the announcers
+      size_t queued = 0;
+      size_t maxQueued = 0; //!< most announcements queued at once
+    };
+
     CAnnouncementManager();
     ~CAnnouncementManager() override;
 
@@ -56,6 +81,27 @@ namespace ANNOUNCEMENT
                   const std::shared_ptr<const CFileItem>& item,
                   const CVariant& data);
 
+    /*!
+     * \brief Hold back announcements of a topic to merge the ones for the same item
+     * \param flag The flag of the topic
+     * \param message The message of the topic, e.g. "OnUpdate"
+     * \param window How long the first announcement for an item is held back, 0 to deliver
+     * every announcement of the topic as it comes
+     */
+    void SetCoalescingWindow(AnnouncementFlag flag,
+                             const std::string& message,
+                             std::chrono::milliseconds window);
+
+    /*!
+     * \brief Set the number of announcements queued at most
+     *
+     * Only announcements of a topic with a coalescing window are dropped when the queue is full,
+     * the others are queued anyway.
+     */
+    void SetQueueLimit(size_t limit);
+
+    Stats GetStats() const;
+
     // The sender is not related to the application name.
     // Also it's part of Kodi's API - changing it will break
     // a big number of python addons and third party json consumers.
@@ -80,6 +126,8 @@ namespace ANNOUNCEMENT
       std::string message;
       std::shared_ptr<CFileItem> item;
       CVariant data;
+      std::string key; //!< the item of a held back announcement, empty if it is not merged into
+      std::chrono::steady_clock::time_point due;
     };
     std::list<CAnnounceData> m_announcementQueue;
     CEvent m_queueEvent;
@@ -88,8 +136,16 @@ namespace ANNOUNCEMENT
     CAnnouncementManager(const CAnnouncementManager&) = delete;
     CAnnouncementManager const& operator=(CAnnouncementManager const&) = delete;
 
+    static std::string GetItemKey(const CAnnounceData& announcement);
+    void FlushAnnouncers();
+
     CCriticalSection m_announcersCritSection;
-    CCriticalSection m_queueCritSection;
+    mutable CCriticalSection m_queueCritSection;
     std::vector<IAnnouncer *> m_announcers;
+
+    std::map<std::pair<AnnouncementFlag, std::string>, std::chrono::milliseconds> m_windows;
+    std::unordered_map<std::string, std::list<CAnnounceData>::iterator> m_heldBack;
+    size_t m_queueLimit;
+    Stats m_stats;
   };
 }
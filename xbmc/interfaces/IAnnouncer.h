@@ -76,5 +76,11 @@ namespace ANNOUNCEMENT
                           const std::string& sender,
                           const std::string& message,
                           const CVariant& data) = 0;
+
+    /*!
+     \brief Called after a run of announcements was delivered, e.g. the library
+     updates merged over a coalescing window, to pass on what was collected
+     */
+    virtual void FlushAnnouncements() {}
   };
 }
@@ -22,6 +22,7 @@
 #include "settings/SettingsComponent.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -113,6 +114,27 @@ static int SetVolume(const std::vector<std::string>& params)
   return 0;
 }
 
+/*! \brief Start recording a performance trace.
+ *  \param params (ignored)
+ */
+static int StartTrace(const std::vector<std::string>& params)
+{
+  CTraceRecorder::GetInstance().Start();
+
+  return 0;
+}
+
+/*! \brief Stop recording a performance trace and write it.
+ *  \param params The parameters.
+ *  \details params[0] = The name of the file to write in special://logpath (optional).
+ */
+static int StopTrace(const std::vector<std::string>& params)
+{
+  CTraceRecorder::GetInstance().Stop(params.empty() ? "" : params[0]);
+
+  return 0;
+}
+
 /*! \brief Toggle debug info.
  *  \param params (ignored)
  */
@@ -189,6 +211,26 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 ///     @param[in] showvolumebar         Add "showVolumeBar" to show volume bar (optional).
 ///   }
 ///   \table_row2_l{
+///     <b>`StartTrace`</b>
+///     \anchor Builtin_StartTrace,
+///     Starts recording how long the application\, GUI\, player\, render and
+///     audio threads spend in their main stages.
+///     <p><hr>
+///     @skinning_v21 **[New builtin]** \link Builtin_StartTrace `StartTrace`\endlink
+///     <p>
+///   }
+///   \table_row2_l{
+///     <b>`StopTrace([filename])`</b>
+///     \anchor Builtin_StopTrace,
+///     Stops recording and writes the trace in Chrome trace event format\, it can
+///     be opened with https://ui.perfetto.dev or chrome://tracing.
+///     @param[in] filename              Name of the file to write in special://logpath (optional).
+///             @note If not given\, writes special://logpath/kodi-trace.json. Paths are refused.
+///     <p><hr>
+///     @skinning_v21 **[New builtin]** \link Builtin_StopTrace `StopTrace`\endlink
+///     <p>
+///   }
+///   \table_row2_l{
 ///     <b>`ToggleDebug`</b>
 ///     ,
 ///     Toggles debug mode on/off
@@ -215,6 +257,8 @@ CBuiltins::CommandMap CApplicationBuiltins::GetOperations() const
            {"mute", {"Mute the player", 0, Mute}},
            {"notifyall", {"Notify all connected clients", 2, NotifyAll}},
            {"setvolume", {"Set the current volume", 1, SetVolume}},
+           {"starttrace", {"Start recording a performance trace", 0, StartTrace}},
+           {"stoptrace", {"Stop recording a performance trace and write it", 0, StopTrace}},
            {"toggledebug", {"Enables/disables debug mode", 0, ToggleDebug}},
            {"toggledpms", {"Toggle DPMS mode manually", 0, ToggleDPMS}},
            {"wakeonlan", {"Sends the wake-up packet to the broadcast address for the specified MAC address", 1, WakeOnLAN}}
@@ -17,5 +17,7 @@ namespace JSONRPC
     virtual int GetPermissionFlags() = 0;
     virtual int GetAnnouncementFlags() = 0;
     virtual bool SetAnnouncementFlags(int flags) = 0;
+    virtual bool GetBatchAnnouncements() { return false; }
+    virtual bool SetBatchAnnouncements(bool batch) { return !batch; }
   };
 }
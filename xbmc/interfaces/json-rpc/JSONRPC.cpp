@@ -175,14 +175,16 @@ JSONRPC_STATUS CJSONRPC::GetConfiguration(const std::string &method, ITransportL
 
   for (int i = 1; i <= ANNOUNCEMENT::ANNOUNCE_ALL; i *= 2)
     result["notifications"][AnnouncementFlagToString((ANNOUNCEMENT::AnnouncementFlag)i)] = (flags & i) == i;
+  result["batchnotifications"] = client->GetBatchAnnouncements();
 
   return OK;
 }
 
 JSONRPC_STATUS CJSONRPC::SetConfiguration(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result)
 {
-  int flags = 0;
+  // without "notifications" the flags are kept, e.g. when only batchnotifications is set
   int oldFlags = client->GetAnnouncementFlags();
+  int flags = parameterObject["notifications"].isObject() ? 0 : oldFlags;
 
   if (parameterObject.isMember("notifications"))
   {
@@ -216,8 +218,17 @@ JSONRPC_STATUS CJSONRPC::SetConfiguration(const std::string &method, ITransportL
       flags |= ANNOUNCEMENT::Other;
   }
 
+  // batching first, a client that can't batch must not have its flags changed
+  const bool oldBatch = client->GetBatchAnnouncements();
+  if (parameterObject["batchnotifications"].isBoolean() &&
+      !client->SetBatchAnnouncements(parameterObject["batchnotifications"].asBoolean()))
+    return BadPermission;
+
   if (!client->SetAnnouncementFlags(flags))
+  {
+    client->SetBatchAnnouncements(oldBatch);
     return BadPermission;
+  }
 
   return GetConfiguration(method, transport, client, parameterObject, result);
 }
@@ -254,7 +254,9 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.StartTrace",                              CXBMCOperations::StartTrace },
+  { "XBMC.StopTrace",                               CXBMCOperations::StopTrace }
 };
 
 // clang-format on
@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
 #include "powermanagement/PowerManager.h"
+#include "utils/TraceRecorder.h"
 #include "utils/Variant.h"
 
 using namespace JSONRPC;
@@ -86,3 +87,30 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::StartTrace(const std::string& method,
+                                           ITransportLayer* transport,
+                                           IClient* client,
+                                           const CVariant& parameterObject,
+                                           CVariant& result)
+{
+  CTraceRecorder::GetInstance().Start();
+  result = "OK";
+
+  return OK;
+}
+
+JSONRPC_STATUS CXBMCOperations::StopTrace(const std::string& method,
+                                          ITransportLayer* transport,
+                                          IClient* client,
+                                          const CVariant& parameterObject,
+                                          CVariant& result)
+{
+  const std::string path =
+      CTraceRecorder::GetInstance().Stop(parameterObject["filename"].asString());
+  if (path.empty())
+    return InternalError;
+
+  result = path;
+  return OK;
+}
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/IAnnouncer.h"
+#include "interfaces/json-rpc/IClient.h"
+#include "interfaces/json-rpc/JSONRPC.h"
+#include "utils/Variant.h"
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+
+namespace
+{
+class CTestClient : public IClient
+{
+public:
+  int GetPermissionFlags() override { return OPERATION_PERMISSION_ALL; }
+  int GetAnnouncementFlags() override { return m_flags; }
+  bool SetAnnouncementFlags(int flags) override
+  {
+    m_flags = flags;
+    return true;
+  }
+  bool GetBatchAnnouncements() override { return m_batch; }
+  bool SetBatchAnnouncements(bool batch) override
+  {
+    if (batch && !m_canBatch)
+      return false;
+    m_batch = batch;
+    return true;
+  }
+
+  int m_flags = ANNOUNCEMENT::Player | ANNOUNCEMENT::VideoLibrary;
+  bool m_batch = false;
+  bool m_canBatch = true;
+};
+} // unnamed namespace
+
+TEST(TestJSONRPC, SetConfigurationKeepsNotificationsLeftOut)
+{
+  CTestClient client;
+  CVariant parameters;
+  parameters["batchnotifications"] = true;
+
+  CVariant result;
+  EXPECT_EQ(OK, CJSONRPC::SetConfiguration("JSONRPC.SetConfiguration", nullptr, &client,
+                                           parameters, result));
+  EXPECT_EQ(ANNOUNCEMENT::Player | ANNOUNCEMENT::VideoLibrary, client.m_flags);
+  EXPECT_TRUE(client.m_batch);
+  EXPECT_TRUE(result["notifications"]["Player"].asBoolean());
+  EXPECT_FALSE(result["notifications"]["GUI"].asBoolean());
+  EXPECT_TRUE(result["batchnotifications"].asBoolean());
+}
+
+TEST(TestJSONRPC, SetConfigurationKeepsFlagsLeftOut)
+{
+  CTestClient client;
+  CVariant parameters;
+  parameters["notifications"]["GUI"] = true;
+  parameters["notifications"]["Player"] = false;
+
+  CVariant result;
+  EXPECT_EQ(OK, CJSONRPC::SetConfiguration("JSONRPC.SetConfiguration", nullptr, &client,
+                                           parameters, result));
+  EXPECT_EQ(ANNOUNCEMENT::GUI | ANNOUNCEMENT::VideoLibrary, client.m_flags);
+  EXPECT_FALSE(client.m_batch);
+}
+
+TEST(TestJSONRPC, SetConfigurationRejectsBatchFirst)
+{
+  CTestClient client;
+  client.m_canBatch = false;
+  CVariant parameters;
+  parameters["notifications"]["GUI"] = true;
+  parameters["batchnotifications"] = true;
+
+  CVariant result;
+  EXPECT_EQ(BadPermission, CJSONRPC::SetConfiguration("JSONRPC.SetConfiguration", nullptr,
+                                                      &client, parameters, result));
+  EXPECT_EQ(ANNOUNCEMENT::Player | ANNOUNCEMENT::VideoLibrary, client.m_flags);
+  EXPECT_FALSE(client.m_batch);
+}
@@ -0,0 +1,271 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "interfaces/AnnouncementManager.h"
+#include "music/tags/MusicInfoTag.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ANNOUNCEMENT;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr int SCAN_ITEMS = 1000;
+constexpr int SCAN_UPDATES = 4;
+
+/*!
+ * \brief Records the announcements and serializes them like the JSON-RPC server does
+ */
+class CRecordingAnnouncer : public IAnnouncer
+{
+public:
+  void Announce(AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override
+  {
+    std::string json;
+    CJSONVariantWriter::Write(data, json, true);
+
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_messages.push_back(message);
+    m_data.push_back(data);
+    m_bytes += json.size();
+    if (message == "OnScanFinished")
+      m_scanFinished.Set();
+  }
+
+  void FlushAnnouncements() override
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_flushes++;
+  }
+
+  bool WaitForScan() { return m_scanFinished.Wait(10s); }
+
+  CCriticalSection m_critSection;
+  std::vector<std::string> m_messages;
+  std::vector<CVariant> m_data;
+  size_t m_bytes = 0;
+  unsigned int m_flushes = 0;
+
+private:
+  CEvent m_scanFinished;
+};
+
+CVariant MakeUpdate(int id)
+{
+  CVariant data;
+  data["type"] = "movie";
+  data["id"] = id;
+  data["transaction"] = true;
+  return data;
+}
+
+std::shared_ptr<CFileItem> MakeMusicItem(int id, const std::string& type)
+{
+  auto item = std::make_shared<CFileItem>();
+  item->GetMusicInfoTag()->SetDatabaseId(id, type);
+  return item;
+}
+
+struct ScanResult
+{
+  size_t delivered = 0;
+  size_t bytes = 0;
+  double cpuMs = 0.0;
+};
+
+/*!
+ * \brief Announce what a scan of a library does, each item is added and then updated a few times
+ */
+ScanResult SimulateScan(std::chrono::milliseconds window)
+{
+  CAnnouncementManager manager;
+  manager.SetCoalescingWindow(VideoLibrary, "OnUpdate", window);
+  CRecordingAnnouncer announcer;
+  manager.AddAnnouncer(&announcer);
+  manager.Start();
+
+  const std::clock_t start = std::clock();
+
+  manager.Announce(VideoLibrary, "OnScanStarted");
+  for (int id = 1; id <= SCAN_ITEMS; id++)
+  {
+    for (int update = 0; update < SCAN_UPDATES; update++)
+    {
+      CVariant data = MakeUpdate(id);
+      if (update == 0)
+        data["added"] = true;
+      else
+        data["update"] = update;
+      manager.Announce(VideoLibrary, "OnUpdate", data);
+    }
+  }
+  manager.Announce(VideoLibrary, "OnScanFinished");
+
+  EXPECT_TRUE(announcer.WaitForScan());
+  const std::clock_t end = std::clock();
+
+  manager.RemoveAnnouncer(&announcer);
+  manager.Deinitialize();
+
+  std::unique_lock<CCriticalSection> lock(announcer.m_critSection);
+  ScanResult result;
+  result.delivered = announcer.m_messages.size();
+  result.bytes = announcer.m_bytes;
+  result.cpuMs = 1000.0 * (end - start) / CLOCKS_PER_SEC;
+  return result;
+}
+} // unnamed namespace
+
+TEST(TestAnnouncementManager, MergesUpdatesForTheSameItem)
+{
+  // not started, the announcements stay queued
+  CAnnouncementManager manager;
+
+  CVariant added = MakeUpdate(1);
+  added["added"] = true;
+  manager.Announce(VideoLibrary, "OnUpdate", added);
+  CVariant watched = MakeUpdate(1);
+  watched["playcount"] = 1;
+  manager.Announce(VideoLibrary, "OnUpdate", watched);
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(2));
+
+  const CAnnouncementManager::Stats stats = manager.GetStats();
+  EXPECT_EQ(3u, stats.announced);
+  EXPECT_EQ(1u, stats.coalesced);
+  EXPECT_EQ(2u, stats.queued);
+}
+
+TEST(TestAnnouncementManager, OtherTopicsAreNotMerged)
+{
+  CAnnouncementManager manager;
+
+  manager.Announce(VideoLibrary, "OnRemove", MakeUpdate(1));
+  manager.Announce(VideoLibrary, "OnRemove", MakeUpdate(1));
+  manager.SetCoalescingWindow(VideoLibrary, "OnUpdate", 0ms);
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(1));
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(1));
+
+  const CAnnouncementManager::Stats stats = manager.GetStats();
+  EXPECT_EQ(0u, stats.coalesced);
+  EXPECT_EQ(4u, stats.queued);
+}
+
+TEST(TestAnnouncementManager, MergesMusicItemsOfTheSameType)
+{
+  CAnnouncementManager manager;
+
+  manager.Announce(AudioLibrary, "OnUpdate", MakeMusicItem(1, MediaTypeSong));
+  manager.Announce(AudioLibrary, "OnUpdate", MakeMusicItem(1, MediaTypeAlbum));
+  manager.Announce(AudioLibrary, "OnUpdate", MakeMusicItem(1, MediaTypeSong));
+
+  const CAnnouncementManager::Stats stats = manager.GetStats();
+  EXPECT_EQ(1u, stats.coalesced);
+  EXPECT_EQ(2u, stats.queued);
+}
+
+TEST(TestAnnouncementManager, DropsUpdatesWhenFull)
+{
+  CAnnouncementManager manager;
+  manager.SetQueueLimit(3);
+
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(1));
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(2));
+  manager.Announce(Player, "OnPropertyChanged");
+  // the queue is full, only a merge takes an update
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(3));
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(1));
+
+  CAnnouncementManager::Stats stats = manager.GetStats();
+  EXPECT_EQ(1u, stats.dropped);
+  EXPECT_EQ(1u, stats.coalesced);
+  EXPECT_EQ(3u, stats.queued);
+
+  // the other announcements are never dropped
+  manager.Announce(Player, "OnStop");
+  manager.Announce(System, "OnSleep");
+  manager.Announce(System, "OnQuit");
+
+  stats = manager.GetStats();
+  EXPECT_EQ(1u, stats.dropped);
+  EXPECT_EQ(6u, stats.queued);
+  EXPECT_EQ(6u, stats.maxQueued);
+}
+
+TEST(TestAnnouncementManager, KeepsOrderOfTheFlag)
+{
+  CAnnouncementManager manager;
+  // held back far longer than the test takes, only OnScanFinished lets the updates through
+  manager.SetCoalescingWindow(VideoLibrary, "OnUpdate", 1h);
+  CRecordingAnnouncer announcer;
+  manager.AddAnnouncer(&announcer);
+  manager.Start();
+
+  CVariant added = MakeUpdate(1);
+  added["added"] = true;
+  manager.Announce(VideoLibrary, "OnUpdate", added);
+  manager.Announce(VideoLibrary, "OnUpdate", MakeUpdate(2));
+  CVariant watched = MakeUpdate(1);
+  watched["playcount"] = 1;
+  manager.Announce(VideoLibrary, "OnUpdate", watched);
+  manager.Announce(VideoLibrary, "OnScanFinished");
+
+  ASSERT_TRUE(announcer.WaitForScan());
+  manager.RemoveAnnouncer(&announcer);
+  manager.Deinitialize();
+
+  ASSERT_EQ(3u, announcer.m_messages.size());
+  EXPECT_EQ("OnUpdate", announcer.m_messages[0]);
+  EXPECT_EQ(1, announcer.m_data[0]["id"].asInteger());
+  EXPECT_TRUE(announcer.m_data[0]["added"].asBoolean());
+  EXPECT_EQ(1, announcer.m_data[0]["playcount"].asInteger());
+  EXPECT_EQ("OnUpdate", announcer.m_messages[1]);
+  EXPECT_EQ(2, announcer.m_data[1]["id"].asInteger());
+  EXPECT_EQ("OnScanFinished", announcer.m_messages[2]);
+  EXPECT_GE(announcer.m_flushes, 1u);
+}
+
+TEST(TestAnnouncementManager, SimulatedScan)
+{
+  const ScanResult every = SimulateScan(0ms);
+  const ScanResult merged = SimulateScan(1h);
+
+  // OnScanStarted, the updates and OnScanFinished
+  EXPECT_EQ(static_cast<size_t>(SCAN_ITEMS * SCAN_UPDATES + 2), every.delivered);
+  EXPECT_EQ(static_cast<size_t>(SCAN_ITEMS + 2), merged.delivered);
+  EXPECT_LT(merged.bytes, every.bytes);
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST(TestAnnouncementManager, DISABLED_SimulatedScanCpu)
+{
+  const ScanResult every = SimulateScan(0ms);
+  const ScanResult merged = SimulateScan(1h);
+
+  CLog::Log(LOGINFO,
+            "TestAnnouncementManager - scan of {} items: {} announcements, {} bytes, {:.1f} ms "
+            "cpu delivered one by one, {} announcements, {} bytes, {:.1f} ms cpu merged",
+            SCAN_ITEMS, every.delivered, every.bytes, every.cpuMs, merged.delivered, merged.bytes,
+            merged.cpuMs);
+}
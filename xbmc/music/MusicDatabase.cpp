@@ -31,6 +31,7 @@
 #include "events/NotificationEvent.h"
 #include "filesystem/Directory.h"
 #include "filesystem/DirectoryCache.h"
+#include "filesystem/ExistsChecker.h"
 #include "filesystem/File.h"
 #include "filesystem/MusicDatabaseDirectory/DirectoryNode.h"
 #include "guilib/GUIComponent.h"
@@ -206,6 +207,9 @@ void CMusicDatabase::CreateTables()
               " strVideoURL TEXT, "
               " strReplayGain text, "
               " dateAdded TEXT, dateNew TEXT, dateModified TEXT)");
+  CLog::Log(LOGINFO, "create album_counts table");
+  m_pDS->exec("CREATE TABLE album_counts (idAlbum integer primary key, iTimesPlayed integer, "
+              "lastPlayed varchar(20) default NULL)");
   CLog::Log(LOGINFO, "create song_artist table");
   m_pDS->exec("CREATE TABLE song_artist (idArtist integer, idSong integer, idRole integer, iOrder "
               "integer, strArtist text)");
@@ -291,12 +295,19 @@ void CMusicDatabase::CreateAnalytics()
 
   m_pDS->exec("CREATE INDEX ix_art ON art(media_id, media_type(20), type(20))");
 
+  // the counts are not maintained while the triggers are dropped for an update
+  CLog::Log(LOGINFO, "fill album counts");
+  m_pDS->exec("DELETE FROM album_counts");
+  for (const std::string& sql : GetAlbumCountsSQL("SELECT idAlbum FROM album"))
+    m_pDS->exec(sql);
+
   CLog::Log(LOGINFO, "create triggers");
   m_pDS->exec("CREATE TRIGGER tgrDeleteAlbum AFTER delete ON album FOR EACH ROW BEGIN"
               "  DELETE FROM song WHERE song.idAlbum = old.idAlbum;"
               "  DELETE FROM album_artist WHERE album_artist.idAlbum = old.idAlbum;"
               "  DELETE FROM album_source WHERE album_source.idAlbum = old.idAlbum;"
               "  DELETE FROM art WHERE media_id=old.idAlbum AND media_type='album';"
+              "  DELETE FROM album_counts WHERE album_counts.idAlbum = old.idAlbum;"
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteArtist AFTER delete ON artist FOR EACH ROW BEGIN"
               "  DELETE FROM album_artist WHERE album_artist.idArtist = old.idArtist;"
@@ -307,13 +318,23 @@ void CMusicDatabase::CreateAnalytics()
   m_pDS->exec("CREATE TRIGGER tgrDeleteSong AFTER delete ON song FOR EACH ROW BEGIN"
               "  DELETE FROM song_artist WHERE song_artist.idSong = old.idSong;"
               "  DELETE FROM song_genre WHERE song_genre.idSong = old.idSong;"
-              "  DELETE FROM art WHERE media_id=old.idSong AND media_type='song';"
-              " END");
+              "  DELETE FROM art WHERE media_id=old.idSong AND media_type='song'; " +
+              StringUtils::Join(GetAlbumCountsSQL("old.idAlbum"), "; ") + "; END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteSource AFTER delete ON source FOR EACH ROW BEGIN"
               "  DELETE FROM source_path WHERE source_path.idSource = old.idSource;"
               "  DELETE FROM album_source WHERE album_source.idSource = old.idSource;"
               " END");
 
+  // Keep the play counts of albums up to date so the album view doesn't sum up the songs of
+  // every album it lists. Both databases can modify another table in an AFTER trigger. Updates
+  // only count an album again when they changed what is counted, not when the date triggers
+  // below or a rescan touch the song.
+  m_pDS->exec(GetTriggerSQL(m_sqlite, "tgrInsertSongCounts", "INSERT", "song", "",
+                            GetAlbumCountsSQL("NEW.idAlbum")));
+  m_pDS->exec(GetTriggerSQL(m_sqlite, "tgrUpdateSongCounts", "UPDATE", "song",
+                            GetChangedSQL(m_sqlite, {"idAlbum", "iTimesPlayed", "lastplayed"}),
+                            GetAlbumCountsSQL("OLD.idAlbum, NEW.idAlbum")));
+
   /* Maintain date new and last modified for songs, albums and artists using triggers
      MySQL triggers cannot modify a table that is already being used by the statement that invoked
      the trigger (to avoid recursion), but can set NEW column values before insert or update.
@@ -417,6 +438,16 @@ void CMusicDatabase::CreateRemovedLinkTriggers()
 }
 
 
+std::vector<std::string> CMusicDatabase::GetAlbumCountsSQL(const std::string& albums) const
+{
+  // same values as the album view got from the songs of the albums
+  return {StringUtils::Format("DELETE FROM album_counts WHERE idAlbum IN ({})", albums),
+          StringUtils::Format("INSERT INTO album_counts (idAlbum, iTimesPlayed, lastPlayed) "
+                              "SELECT idAlbum, ROUND(AVG(iTimesPlayed)), MAX(lastplayed) "
+                              "FROM song WHERE idAlbum IN ({}) GROUP BY idAlbum",
+                              albums)};
+}
+
 void CMusicDatabase::CreateViews()
 {
   CLog::Log(LOGINFO, "create song view");
@@ -492,14 +523,13 @@ void CMusicDatabase::CreateViews()
               "bScrapedMBID,"
               "lastScraped,"
               "dateAdded, dateNew, dateModified, "
-              "(SELECT ROUND(AVG(song.iTimesPlayed)) FROM song "
-              "WHERE song.idAlbum = album.idAlbum) AS iTimesPlayed, "
+              "album_counts.iTimesPlayed AS iTimesPlayed, "
               "strReleaseType, "
               "iDiscTotal, "
-              "(SELECT MAX(song.lastplayed) FROM song "
-              "WHERE song.idAlbum = album.idAlbum) AS lastplayed, "
+              "album_counts.lastPlayed AS lastplayed, "
               "iAlbumDuration "
-              "FROM album");
+              "FROM album "
+              "LEFT JOIN album_counts ON album_counts.idAlbum = album.idAlbum");
 
   CLog::Log(LOGINFO, "create artist view");
   m_pDS->exec("CREATE VIEW artistview AS SELECT"
@@ -4223,7 +4253,11 @@ bool CMusicDatabase::CleanupSongsByIds(const std::string& strSongIds)
       m_pDS->close();
       return true;
     }
-    std::vector<std::string> songsToDelete;
+    // the songs of the batch are checked together, several at once per host
+    CExistsChecker checker(CServiceBroker::GetSettingsComponent()
+                               ->GetAdvancedSettings()
+                               ->m_iMusicLibraryCleanConnections);
+    std::vector<std::pair<std::string, size_t>> songs;
     while (!m_pDS->eof())
     { // get the full song path
       std::string strFileName = URIUtils::AddFileToFolder(
@@ -4240,14 +4274,27 @@ bool CMusicDatabase::CleanupSongsByIds(const std::string& strSongIds)
         URIUtils::RemoveSlashAtEnd(strFileName);
       }
 
-      if (!CFile::Exists(strFileName, false))
-      { // file no longer exists, so add to deletion list
-        songsToDelete.push_back(m_pDS->fv("song.idSong").get_asString());
-      }
+      songs.emplace_back(m_pDS->fv("song.idSong").get_asString(), checker.AddFile(strFileName));
       m_pDS->next();
     }
     m_pDS->close();
 
+    checker.Run();
+    std::vector<std::string> songsToDelete;
+    for (const auto& song : songs)
+    {
+      if (!checker.Exists(song.second))
+      { // file no longer exists, so add to deletion list
+        songsToDelete.push_back(song.first);
+      }
+    }
+
+    const CExistsChecker::Stats& stats = checker.GetStats();
+    CLog::Log(LOGDEBUG,
+              "{}: Checked {} songs in {:.1f} s, {} missing ({} folder listings, {} single checks)",
+              __FUNCTION__, stats.paths, stats.seconds, stats.missing, stats.listings,
+              stats.requests);
+
     if (!songsToDelete.empty())
     {
       std::string strSongsToDelete = "(" + StringUtils::Join(songsToDelete, ",") + ")";
@@ -4276,6 +4323,8 @@ bool CMusicDatabase::CleanupSongs(CGUIDialogProgress* progressDialog /*= nullptr
     if (total == 0)
       return true;
 
+    const auto start = std::chrono::steady_clock::now();
+
     // run through all songs and get all unique path ids
     int iLIMIT = 1000;
     for (int i = 0;; i += iLIMIT)
@@ -4290,6 +4339,9 @@ bool CMusicDatabase::CleanupSongs(CGUIDialogProgress* progressDialog /*= nullptr
       if (iRowsFound == 0)
       {
         m_pDS->close();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        CLog::Log(LOGINFO, "{}: Checked {} songs in {:.1f} s", __FUNCTION__, total,
+                  elapsed.count());
         return true;
       }
 
@@ -9421,6 +9473,13 @@ void CMusicDatabase::UpdateTables(int version)
   if (version < 83)
     m_pDS->exec("ALTER TABLE song ADD strVideoURL TEXT");
 
+  if (version < 84)
+  {
+    // filled with the counts of all albums when the triggers are created again
+    m_pDS->exec("CREATE TABLE album_counts (idAlbum integer primary key, iTimesPlayed integer, "
+                "lastPlayed varchar(20) default NULL)");
+  }
+
   // Set the version of tag scanning required.
   // Not every schema change requires the tags to be rescanned, set to the highest schema version
   // that needs this. Forced rescanning (of music files that have not changed since they were
@@ -9441,7 +9500,7 @@ void CMusicDatabase::UpdateTables(int version)
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 83;
+  return 84;
 }
 
 int CMusicDatabase::GetMusicNeedsTagScan()
@@ -899,6 +899,10 @@ private:
   virtual void CreateViews();
   void CreateNativeDBFunctions();
   void CreateRemovedLinkTriggers();
+  /*! \brief Statements to sum up the play counts of albums again, for the album_counts table
+   \param albums SQL list of the ids of the albums, e.g. an id or a subquery
+   */
+  std::vector<std::string> GetAlbumCountsSQL(const std::string& albums) const;
 
   void SplitPath(const std::string& strFileNameAndPath,
                  std::string& strPath,
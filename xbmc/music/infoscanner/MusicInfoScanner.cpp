@@ -271,6 +271,14 @@ void CMusicInfoScanner::Process()
     CLog::Log(LOGERROR, "MusicInfoScanner: Exception while scanning.");
   }
   m_musicDatabase.Close();
+
+  const CTextureCacheBatch::Stats artwork = m_artwork.Wait();
+  if (artwork.images > 0 || artwork.failed > 0)
+    CLog::Log(LOGINFO,
+              "{} - Cached {} images ({} KiB) in {:.1f} s, {:.1f} images/s, {} failed, {} "
+              "duplicates",
+              __FUNCTION__, artwork.images, artwork.bytes / 1024, artwork.seconds,
+              artwork.ImagesPerSecond(), artwork.failed, artwork.duplicates);
   CLog::Log(LOGDEBUG, "{} - Finished scan", __FUNCTION__);
 
   m_bRunning = false;
@@ -448,6 +456,7 @@ void CMusicInfoScanner::Stop()
   if (m_bCanInterrupt)
     m_musicDatabase.Interrupt();
 
+  m_artwork.Cancel();
   m_bStop = true;
 }
 
@@ -2000,7 +2009,7 @@ bool CMusicInfoScanner::AddArtistArtwork(CArtist& artist, const std::string& art
     // (other art types will be cached when first displayed)
     if (iArtLevel != CSettings::MUSICLIBRARY_ARTWORK_LEVEL_ALL || it.first == "thumb" ||
         it.first == "fanart")
-      CServiceBroker::GetTextureCache()->BackgroundCacheImage(it.second);
+      m_artwork.Add(it.second);
     auto ret = artist.art.insert(it);
     if (ret.second)
       m_musicDatabase.SetArtForItem(artist.idArtist, MediaTypeArtist, it.first, it.second);
@@ -2121,7 +2130,7 @@ bool CMusicInfoScanner::AddAlbumArtwork(CAlbum& album)
     // (other art types will be cached when first displayed)
     if (iArtLevel != CSettings::MUSICLIBRARY_ARTWORK_LEVEL_ALL || it.first == "thumb" ||
         it.first == "fanart")
-      CServiceBroker::GetTextureCache()->BackgroundCacheImage(it.second);
+      m_artwork.Add(it.second);
 
     auto ret = album.art.insert(it);
     if (ret.second)
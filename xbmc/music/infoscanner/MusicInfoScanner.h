@@ -9,6 +9,7 @@
 #pragma once
 
 #include "InfoScanner.h"
+#include "TextureCacheBatch.h"
 #include "MusicAlbumInfo.h"
 #include "MusicInfoScraper.h"
 #include "music/MusicDatabase.h"
@@ -255,6 +256,7 @@ protected:
   int m_scanType = 0; // 0 - load from files, 1 - albums, 2 - artists
   int m_idSourcePath;
   CMusicDatabase m_musicDatabase;
+  CTextureCacheBatch m_artwork;
 
   std::set<int> m_albumsAdded;
 
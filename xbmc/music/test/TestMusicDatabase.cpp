@@ -0,0 +1,145 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "music/MusicDatabase.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+class TestMusicDatabase : public testing::TestWithParam<std::string>
+{
+protected:
+  void SetUp() override
+  {
+    m_mysql = GetParam() == "mysql";
+    if (m_mysql)
+    {
+      // a server set up as music database with --add-advancedsettings-file
+      const DatabaseSettings& musicDatabase =
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseMusic;
+      if (!StringUtils::EqualsNoCase(musicDatabase.type, "mysql"))
+        GTEST_SKIP() << "no MySQL server configured as music database";
+      m_settings = musicDatabase;
+    }
+    else
+    {
+      m_settings.type = "sqlite3";
+      m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+      CFile::Delete(m_settings.host + "TestMusicDatabase.db");
+    }
+
+    ASSERT_TRUE(m_database.Connect("TestMusicDatabase", m_settings, true));
+    // a server database is kept from the last run
+    for (const char* table : {"song", "album"})
+      m_database.ExecuteQuery(std::string("DELETE FROM ") + table);
+  }
+
+  void TearDown() override
+  {
+    m_database.Close();
+    if (!m_mysql)
+      CFile::Delete(m_settings.host + "TestMusicDatabase.db");
+  }
+
+  //! album 1 with songs played 1, 2 and 4 times, album 2 with a song never played
+  void AddAlbums()
+  {
+    m_database.BeginTransaction();
+    for (int album = 1; album <= 2; album++)
+    {
+      m_database.ExecuteQuery(StringUtils::Format(
+          "INSERT INTO album (idAlbum, strAlbum) VALUES ({0}, 'Album {0}')", album));
+    }
+    AddSong(1, 1, 1, "'2024-01-01 00:00:00'");
+    AddSong(2, 1, 2, "'2024-03-01 00:00:00'");
+    AddSong(3, 1, 4, "'2024-02-01 00:00:00'");
+    AddSong(4, 2, 0, "NULL");
+    m_database.CommitTransaction();
+  }
+
+  void AddSong(int song, int album, int played, const std::string& lastPlayed)
+  {
+    m_database.ExecuteQuery(
+        StringUtils::Format("INSERT INTO song (idSong, idAlbum, idPath, strTitle, iTimesPlayed, "
+                            "lastplayed) VALUES ({0}, {1}, 1, 'Song {0}', {2}, {3})",
+                            song, album, played, lastPlayed));
+  }
+
+  int GetTimesPlayed(int album)
+  {
+    return m_database.GetSingleValueInt(
+        StringUtils::Format("SELECT iTimesPlayed FROM album_counts WHERE idAlbum={}", album));
+  }
+
+  std::string GetLastPlayed(int album)
+  {
+    return m_database.GetSingleValue(
+        StringUtils::Format("SELECT lastPlayed FROM album_counts WHERE idAlbum={}", album));
+  }
+
+  DatabaseSettings m_settings;
+  bool m_mysql = false;
+  CMusicDatabase m_database;
+};
+
+TEST_P(TestMusicDatabase, AlbumCounts)
+{
+  AddAlbums();
+
+  // the average of the songs rounded, as the album view aggregated them
+  EXPECT_EQ(2, GetTimesPlayed(1));
+  EXPECT_EQ("2024-03-01 00:00:00", GetLastPlayed(1));
+  EXPECT_EQ(0, GetTimesPlayed(2));
+  EXPECT_EQ("", GetLastPlayed(2));
+}
+
+TEST_P(TestMusicDatabase, AlbumCountsFollowChanges)
+{
+  AddAlbums();
+
+  m_database.ExecuteQuery(
+      "UPDATE song SET iTimesPlayed=5, lastplayed='2025-01-01 00:00:00' WHERE idSong=4");
+  EXPECT_EQ(5, GetTimesPlayed(2));
+  EXPECT_EQ("2025-01-01 00:00:00", GetLastPlayed(2));
+
+  // both albums are counted again when a song moves
+  m_database.ExecuteQuery("UPDATE song SET idAlbum=2 WHERE idSong=2");
+  EXPECT_EQ(3, GetTimesPlayed(1));
+  EXPECT_EQ("2024-02-01 00:00:00", GetLastPlayed(1));
+  EXPECT_EQ(4, GetTimesPlayed(2));
+
+  m_database.ExecuteQuery("DELETE FROM album WHERE idAlbum=1");
+  EXPECT_EQ(0, m_database.GetSingleValueInt("SELECT COUNT(*) FROM album_counts WHERE idAlbum=1"));
+}
+
+TEST_P(TestMusicDatabase, AlbumCountsIgnoreOtherChanges)
+{
+  AddAlbums();
+
+  // a count the triggers would correct if they ran
+  m_database.ExecuteQuery("UPDATE album_counts SET iTimesPlayed=999 WHERE idAlbum=1");
+
+  // a rescan rewriting the tags, which also sets the modified date of the song
+  m_database.ExecuteQuery("UPDATE song SET strTitle='Renamed', iTrack=3 WHERE idSong=1");
+  m_database.ExecuteQuery("UPDATE song SET iTimesPlayed=2 WHERE idSong=2");
+  EXPECT_EQ(999, GetTimesPlayed(1));
+
+  m_database.ExecuteQuery("UPDATE song SET iTimesPlayed=3 WHERE idSong=2");
+  EXPECT_EQ(3, GetTimesPlayed(1));
+}
+
+INSTANTIATE_TEST_SUITE_P(Databases, TestMusicDatabase, testing::Values("sqlite3", "mysql"));
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SendQueuePolicy.h"
+
+CSendQueuePolicy::CSendQueuePolicy(size_t maxBytes, std::chrono::steady_clock::duration maxStall)
+  : m_maxBytes(maxBytes), m_maxStall(maxStall)
+{
+}
+
+bool CSendQueuePolicy::CanQueue(size_t queuedBytes,
+                                size_t size,
+                                std::chrono::steady_clock::time_point now)
+{
+  // once dropping, keep dropping until Sent() sees the client catch up
+  if (m_dropped == 0 && queuedBytes + size <= m_maxBytes)
+    return true;
+
+  if (m_dropped++ == 0)
+    m_droppingSince = now;
+  return false;
+}
+
+unsigned int CSendQueuePolicy::Sent(size_t queuedBytes)
+{
+  if (m_dropped == 0 || queuedBytes >= m_maxBytes / 2)
+    return 0;
+
+  const unsigned int dropped = m_dropped;
+  m_dropped = 0;
+  return dropped;
+}
+
+bool CSendQueuePolicy::IsStalled(std::chrono::steady_clock::time_point now) const
+{
+  return m_dropped > 0 && now - m_droppingSince > m_maxStall;
+}
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <stddef.h>
+
+/*!
+ * \brief Decides when announcements for a client that does not keep up are dropped and when
+ * the client is given up on
+ *
+ * Announcements are dropped once more than maxBytes would be waiting to be sent. Dropping stops
+ * only when Sent() sees less than half of maxBytes waiting, so a client that is queued again is
+ * never stalled. A client that has been dropping for longer than maxStall is stalled.
+ */
+class CSendQueuePolicy
+{
+public:
+  CSendQueuePolicy(size_t maxBytes, std::chrono::steady_clock::duration maxStall);
+
+  /*!
+   * \brief Whether an announcement can be queued, counts it as dropped if not
+   * \param queuedBytes the bytes waiting to be sent
+   * \param size the size of the announcement
+   */
+  bool CanQueue(size_t queuedBytes, size_t size, std::chrono::steady_clock::time_point now);
+
+  /*!
+   * \brief Update the policy after data was sent
+   * \param queuedBytes the bytes still waiting to be sent
+   * \return the number of announcements dropped if the client caught up, 0 otherwise
+   */
+  unsigned int Sent(size_t queuedBytes);
+
+  /*!
+   * \brief Whether announcements have been dropped for too long
+   */
+  bool IsStalled(std::chrono::steady_clock::time_point now) const;
+
+  unsigned int GetDropped() const { return m_dropped; }
+
+private:
+  size_t m_maxBytes;
+  std::chrono::steady_clock::duration m_maxStall;
+  unsigned int m_dropped = 0;
+  std::chrono::steady_clock::time_point m_droppingSince;
+};
@@ -18,6 +18,7 @@
 #include "utils/log.h"
 #include "websocket/WebSocketManager.h"
 
+#include <algorithm>
 #include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +27,13 @@
 #include <memory.h>
 #include <netinet/in.h>
 
+#if defined(TARGET_LINUX)
+#include <sys/epoll.h>
+#endif
+#if !defined(TARGET_WINDOWS)
+#include <fcntl.h>
+#endif
+
 using namespace std::chrono_literals;
 
 #if defined(TARGET_WINDOWS) || defined(HAVE_LIBBLUETOOTH)
@@ -58,7 +66,31 @@ using namespace JSONRPC;
 namespace
 {
 constexpr size_t maxBufferLength = 64 * 1024;
+
+// announcements are dropped while more than this is waiting to be sent to a client
+constexpr size_t maxSendQueueBytes = 4 * 1024 * 1024;
+// clients dropping announcements for longer than this are disconnected
+constexpr auto maxStallTime = 30s;
+
+#if defined(TARGET_LINUX)
+constexpr int MAX_EVENTS = 64;
+#endif
+
+#if defined(MSG_NOSIGNAL)
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+bool WouldBlock()
+{
+#if defined(TARGET_WINDOWS)
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
 }
+} // namespace
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
@@ -108,113 +140,235 @@ void CTCPServer::Process()
 {
   m_bStop = false;
 
+  std::vector<SocketEvent> events;
   while (!m_bStop)
   {
-    SOCKET          max_fd = 0;
-    fd_set          rfds;
-    struct timeval  to     = {1, 0};
-    FD_ZERO(&rfds);
+    if (!WaitForEvents(events))
+    {
+      CLog::Log(LOGERROR, "JSONRPC Server: Waiting for connections failed");
+      CThread::Sleep(1000ms);
+      Initialize();
+      continue;
+    }
 
-    for (auto& it : m_servers)
+    for (const auto& event : events)
     {
-      FD_SET(it, &rfds);
-      if ((intptr_t)it > (intptr_t)max_fd)
-        max_fd = it;
+      if (std::find(m_servers.begin(), m_servers.end(), event.socket) != m_servers.end())
+      {
+        AcceptConnection(event.socket);
+        continue;
+      }
+
+      auto it = m_connections.find(event.socket);
+      if (it == m_connections.end())
+        continue;
+
+      if (event.write && !it->second->Flush())
+      {
+        CLog::Log(LOGINFO, "JSONRPC Server: Sending failed, disconnecting");
+        CloseConnection(event.socket);
+        continue;
+      }
+
+      if (event.read)
+        ReadConnection(event.socket);
     }
 
-    for (unsigned int i = 0; i < m_connections.size(); i++)
+    // disconnect clients that stopped reading
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<SOCKET> stalled;
+    for (const auto& connection : m_connections)
+    {
+      if (connection.second->IsStalled(now))
+        stalled.push_back(connection.first);
+    }
+    for (const SOCKET socket : stalled)
     {
-      FD_SET(m_connections[i]->m_socket, &rfds);
-      if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
-        max_fd = m_connections[i]->m_socket;
+      CLog::Log(LOGWARNING, "JSONRPC Server: Client stopped reading announcements, disconnecting");
+      CloseConnection(socket);
     }
+  }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
-    if (res < 0)
+  Deinitialize();
+}
+
+bool CTCPServer::WaitForEvents(std::vector<SocketEvent>& events)
+{
+  events.clear();
+
+#if defined(TARGET_LINUX)
+  if (m_pollFd >= 0)
+  {
+    epoll_event ready[MAX_EVENTS];
+    const int count = epoll_wait(m_pollFd, ready, MAX_EVENTS, 1000);
+    if (count < 0)
+      return errno == EINTR;
+
+    for (int i = 0; i < count; i++)
+    {
+      // errors and hang ups show up as failing reads
+      const bool read = (ready[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0;
+      const bool write = (ready[i].events & EPOLLOUT) != 0;
+      events.push_back({ready[i].data.fd, read, write});
+    }
+    return true;
+  }
+#endif
+
+  SOCKET max_fd = 0;
+  fd_set rfds;
+  fd_set wfds;
+  struct timeval to = {1, 0};
+  FD_ZERO(&rfds);
+  FD_ZERO(&wfds);
+
+  for (auto& it : m_servers)
+  {
+    FD_SET(it, &rfds);
+    if ((intptr_t)it > (intptr_t)max_fd)
+      max_fd = it;
+  }
+
+  for (const auto& connection : m_connections)
+  {
+    const SOCKET socket = connection.first;
+    FD_SET(socket, &rfds);
+    if (connection.second->HasPendingData())
+      FD_SET(socket, &wfds);
+    if ((intptr_t)socket > (intptr_t)max_fd)
+      max_fd = socket;
+  }
+
+  int res = select((intptr_t)max_fd + 1, &rfds, &wfds, NULL, &to);
+  if (res < 0)
+    return false;
+
+  for (auto& it : m_servers)
+  {
+    if (FD_ISSET(it, &rfds))
+      events.push_back({it, true, false});
+  }
+
+  for (const auto& connection : m_connections)
+  {
+    const bool read = FD_ISSET(connection.first, &rfds);
+    const bool write = FD_ISSET(connection.first, &wfds);
+    if (read || write)
+      events.push_back({connection.first, read, write});
+  }
+  return true;
+}
+
+void CTCPServer::WatchSocket(SOCKET socket, bool write)
+{
+#if defined(TARGET_LINUX)
+  if (m_pollFd < 0)
+    return;
+
+  epoll_event event = {};
+  event.events = write ? EPOLLIN | EPOLLOUT : EPOLLIN;
+  event.data.fd = socket;
+  if (epoll_ctl(m_pollFd, EPOLL_CTL_MOD, socket, &event) < 0 && errno == ENOENT)
+    epoll_ctl(m_pollFd, EPOLL_CTL_ADD, socket, &event);
+#endif
+}
+
+void CTCPServer::AcceptConnection(SOCKET server)
+{
+  CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
+  auto newconnection = std::make_shared<CTCPClient>();
+  newconnection->m_socket =
+      accept(server, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
+
+  if (newconnection->m_socket == INVALID_SOCKET)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: {}", errno);
+    if (EBADF == errno)
     {
-      CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
       CThread::Sleep(1000ms);
       Initialize();
     }
-    else if (res > 0)
+    return;
+  }
+
+  // a slow client must not block the server, its data is queued instead
+#ifdef TARGET_WINDOWS
+  u_long nonblocking = 1;
+  ioctlsocket(newconnection->m_socket, FIONBIO, &nonblocking);
+#else
+  fcntl(newconnection->m_socket, F_SETFL, fcntl(newconnection->m_socket, F_GETFL) | O_NONBLOCK);
+#endif
+
+  newconnection->m_host = this;
+  WatchSocket(newconnection->m_socket, false);
+
+  CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+  std::unique_lock<CCriticalSection> lock(m_connectionsSection);
+  m_connections[newconnection->m_socket] = std::move(newconnection);
+}
+
+void CTCPServer::ReadConnection(SOCKET socket)
+{
+  std::shared_ptr<CTCPClient> connection = m_connections.at(socket);
+
+  char buffer[RECEIVEBUFFER] = {};
+  int nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
+  if (nread < 0 && WouldBlock())
+    return;
+
+  bool close = false;
+  if (nread > 0)
+  {
+    std::string response;
+    if (connection->IsNew())
     {
-      for (int i = m_connections.size() - 1; i >= 0; i--)
-      {
-        int socket = m_connections[i]->m_socket;
-        if (FD_ISSET(socket, &rfds))
-        {
-          char buffer[RECEIVEBUFFER] = {};
-          int  nread = 0;
-          nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
-          bool close = false;
-          if (nread > 0)
-          {
-            std::string response;
-            if (m_connections[i]->IsNew())
-            {
-              CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
-
-              if (!response.empty())
-                m_connections[i]->Send(response.c_str(), response.size());
-
-              if (websocket != NULL)
-              {
-                // Replace the CTCPClient with a CWebSocketClient
-                CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
-                delete m_connections[i];
-                m_connections.erase(m_connections.begin() + i);
-                m_connections.insert(m_connections.begin() + i, websocketClient);
-              }
-            }
-
-            if (response.size() <= 0)
-              m_connections[i]->PushBuffer(this, buffer, nread);
-
-            close = m_connections[i]->Closing();
-          }
-          else
-            close = true;
+      CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
 
-          if (close)
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
-            m_connections[i]->Disconnect();
-            delete m_connections[i];
-            m_connections.erase(m_connections.begin() + i);
-          }
-        }
-      }
+      if (!response.empty())
+        connection->Send(response.c_str(), response.size());
 
-      for (auto& it : m_servers)
+      if (websocket != NULL)
       {
-        if (FD_ISSET(it, &rfds))
+        // Replace the CTCPClient with a CWebSocketClient
+        std::shared_ptr<CTCPClient> websocketClient;
         {
-          CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
-          CTCPClient *newconnection = new CTCPClient();
-          newconnection->m_socket =
-              accept(it, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
-
-          if (newconnection->m_socket == INVALID_SOCKET)
-          {
-            CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: {}", errno);
-            if (EBADF == errno)
-            {
-              CThread::Sleep(1000ms);
-              Initialize();
-              break;
-            }
-          }
-          else
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
-            m_connections.push_back(newconnection);
-          }
+          std::unique_lock<CCriticalSection> lock(connection->m_critSection);
+          websocketClient = std::make_shared<CWebSocketClient>(websocket, *connection);
+          connection->Release();
         }
+        std::unique_lock<CCriticalSection> lock(m_connectionsSection);
+        m_connections[socket] = websocketClient;
+        connection = std::move(websocketClient);
       }
     }
+
+    if (response.size() <= 0)
+      connection->PushBuffer(this, buffer, nread);
+
+    close = connection->Closing();
   }
+  else
+    close = true;
 
-  Deinitialize();
+  if (close)
+  {
+    CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+    CloseConnection(socket);
+  }
+}
+
+void CTCPServer::CloseConnection(SOCKET socket)
+{
+  auto it = m_connections.find(socket);
+  if (it == m_connections.end())
+    return;
+
+  std::shared_ptr<CTCPClient> connection = it->second;
+  {
+    std::unique_lock<CCriticalSection> lock(m_connectionsSection);
+    m_connections.erase(it);
+  }
+  connection->Disconnect();
 }
 
 bool CTCPServer::PrepareDownload(const char *path, CVariant &details, std::string &protocol)
@@ -237,21 +391,49 @@ void CTCPServer::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
                           const std::string& message,
                           const CVariant& data)
 {
-  if (m_connections.empty())
-    return;
-
-  std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
-
-  for (unsigned int i = 0; i < m_connections.size(); i++)
+  std::vector<std::shared_ptr<CTCPClient>> clients;
+  std::vector<std::shared_ptr<CTCPClient>> batchClients;
   {
+    std::unique_lock<CCriticalSection> lock(m_connectionsSection);
+    clients.reserve(m_connections.size());
+    for (const auto& connection : m_connections)
     {
-      std::unique_lock<CCriticalSection> lock(m_connections[i]->m_critSection);
-      if ((m_connections[i]->GetAnnouncementFlags() & flag) == 0)
+      std::unique_lock<CCriticalSection> clientLock(connection.second->m_critSection);
+      if ((connection.second->GetAnnouncementFlags() & flag) == 0)
         continue;
+      if (connection.second->GetBatchAnnouncements())
+        batchClients.push_back(connection.second);
+      else
+        clients.push_back(connection.second);
     }
+  }
+
+  if (clients.empty() && batchClients.empty())
+    return;
+
+  // serialize once, all clients queue the same buffer
+  const auto str = std::make_shared<const std::string>(IJSONRPCAnnouncer::AnnouncementToJSONRPC(
+      flag, sender, message, data,
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact));
+
+  for (const auto& client : clients)
+    client->SendAnnouncement(str);
+  for (const auto& client : batchClients)
+    client->BatchAnnouncement(str);
+}
 
-    m_connections[i]->Send(str.c_str(), str.size());
+void CTCPServer::FlushAnnouncements()
+{
+  std::vector<std::shared_ptr<CTCPClient>> clients;
+  {
+    std::unique_lock<CCriticalSection> lock(m_connectionsSection);
+    clients.reserve(m_connections.size());
+    for (const auto& connection : m_connections)
+      clients.push_back(connection.second);
   }
+
+  for (const auto& client : clients)
+    client->FlushBatch();
 }
 
 bool CTCPServer::Initialize()
@@ -263,6 +445,12 @@ bool CTCPServer::Initialize()
   started |= InitializeBlue();
   started |= InitializeTCP();
 
+  if (started && !InitializePoll())
+  {
+    Deinitialize();
+    started = false;
+  }
+
   if (started)
   {
     CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
@@ -477,21 +665,44 @@ bool CTCPServer::InitializeTCP()
   return true;
 }
 
+bool CTCPServer::InitializePoll()
+{
+#if defined(TARGET_LINUX)
+  m_pollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (m_pollFd < 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: epoll_create1 failed: {} ({})", strerror(errno), errno);
+    return false;
+  }
+
+  for (const SOCKET server : m_servers)
+    WatchSocket(server, false);
+#endif
+  return true;
+}
+
 void CTCPServer::Deinitialize()
 {
-  for (unsigned int i = 0; i < m_connections.size(); i++)
+  decltype(m_connections) connections;
   {
-    m_connections[i]->Disconnect();
-    delete m_connections[i];
+    std::unique_lock<CCriticalSection> lock(m_connectionsSection);
+    connections.swap(m_connections);
   }
 
-  m_connections.clear();
+  for (const auto& connection : connections)
+    connection.second->Disconnect();
 
   for (unsigned int i = 0; i < m_servers.size(); i++)
     closesocket(m_servers[i]);
 
   m_servers.clear();
 
+#if defined(TARGET_LINUX)
+  if (m_pollFd >= 0)
+    close(m_pollFd);
+  m_pollFd = -1;
+#endif
+
 #ifdef HAVE_LIBBLUETOOTH
   if (m_sdpd)
     sdp_close((sdp_session_t*)m_sdpd);
@@ -501,7 +712,7 @@ void CTCPServer::Deinitialize()
   CServiceBroker::GetAnnouncementManager()->RemoveAnnouncer(this);
 }
 
-CTCPServer::CTCPClient::CTCPClient()
+CTCPServer::CTCPClient::CTCPClient() : m_sendPolicy(maxSendQueueBytes, maxStallTime)
 {
   m_new = true;
   m_announcementflags = ANNOUNCEMENT::ANNOUNCE_ALL;
@@ -515,6 +726,7 @@ CTCPServer::CTCPClient::CTCPClient()
 }
 
 CTCPServer::CTCPClient::CTCPClient(const CTCPClient& client)
+  : m_sendPolicy(maxSendQueueBytes, maxStallTime)
 {
   Copy(client);
 }
@@ -541,14 +753,142 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
   return true;
 }
 
+bool CTCPServer::CTCPClient::GetBatchAnnouncements()
+{
+  return m_batchAnnouncements;
+}
+
+bool CTCPServer::CTCPClient::SetBatchAnnouncements(bool batch)
+{
+  m_batchAnnouncements = batch;
+  return true;
+}
+
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
-  unsigned int sent = 0;
-  do
+  Queue(std::make_shared<const std::string>(data, size), false);
+}
+
+void CTCPServer::CTCPClient::SendAnnouncement(const std::shared_ptr<const std::string>& data)
+{
+  Queue(data, true);
+}
+
+void CTCPServer::CTCPClient::BatchAnnouncement(const std::shared_ptr<const std::string>& data)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_batch.push_back(data);
+}
+
+void CTCPServer::CTCPClient::FlushBatch()
+{
+  auto batch = std::make_shared<std::string>();
   {
     std::unique_lock<CCriticalSection> lock(m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    if (m_batch.empty())
+      return;
+
+    size_t size = m_batch.size() + 1;
+    for (const auto& data : m_batch)
+      size += data->size();
+    batch->reserve(size);
+
+    // a JSON-RPC batch of notifications, the announcements are serialized already
+    batch->push_back('[');
+    for (const auto& data : m_batch)
+    {
+      if (batch->size() > 1)
+        batch->push_back(',');
+      batch->append(*data);
+    }
+    batch->push_back(']');
+    m_batch.clear();
+  }
+
+  SendAnnouncement(batch);
+}
+
+bool CTCPServer::CTCPClient::Queue(std::shared_ptr<const std::string> data, bool droppable)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_socket == INVALID_SOCKET || data->empty())
+    return false;
+
+  if (droppable &&
+      !m_sendPolicy.CanQueue(m_queuedBytes, data->size(), std::chrono::steady_clock::now()))
+  {
+    if (m_sendPolicy.GetDropped() == 1)
+      CLog::Log(LOGWARNING, "JSONRPC Server: Client does not keep up, dropping announcements");
+    return false;
+  }
+
+  m_queuedBytes += data->size();
+  m_sendQueue.emplace_back(std::move(data));
+  return Flush();
+}
+
+bool CTCPServer::CTCPClient::Flush()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_socket == INVALID_SOCKET)
+    return false;
+
+  while (!m_sendQueue.empty())
+  {
+    const std::string& data = *m_sendQueue.front();
+    const int sent = send(m_socket, data.data() + m_sendOffset,
+                          static_cast<int>(data.size() - m_sendOffset), SEND_FLAGS);
+    if (sent < 0)
+    {
+      if (WouldBlock())
+        break;
+      return false;
+    }
+    // nothing was sent although there was data to send, the connection is gone
+    if (sent == 0)
+      return false;
+
+    m_sendOffset += sent;
+    m_queuedBytes -= sent;
+    if (m_sendOffset == data.size())
+    {
+      m_sendQueue.pop_front();
+      m_sendOffset = 0;
+    }
+  }
+
+  const unsigned int dropped = m_sendPolicy.Sent(m_queuedBytes);
+  if (dropped > 0)
+    CLog::Log(LOGINFO, "JSONRPC Server: Client caught up, {} announcements were dropped", dropped);
+
+  // only wait for the socket to become writable while there is something to send
+  const bool watchWrite = !m_sendQueue.empty();
+  if (watchWrite != m_watchWrite && m_host)
+    m_host->WatchSocket(m_socket, watchWrite);
+  m_watchWrite = watchWrite;
+
+  return true;
+}
+
+bool CTCPServer::CTCPClient::HasPendingData()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return !m_sendQueue.empty();
+}
+
+bool CTCPServer::CTCPClient::IsStalled(std::chrono::steady_clock::time_point now)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_sendPolicy.IsStalled(now);
+}
+
+void CTCPServer::CTCPClient::Release()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_socket = INVALID_SOCKET;
+  m_sendQueue.clear();
+  m_sendOffset = 0;
+  m_queuedBytes = 0;
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -641,11 +981,19 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_cliaddr           = client.m_cliaddr;
   m_addrlen           = client.m_addrlen;
   m_announcementflags = client.m_announcementflags;
+  m_batchAnnouncements = client.m_batchAnnouncements;
+  m_batch             = client.m_batch;
   m_beginBrackets     = client.m_beginBrackets;
   m_endBrackets       = client.m_endBrackets;
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_host              = client.m_host;
+  m_sendQueue         = client.m_sendQueue;
+  m_sendOffset        = client.m_sendOffset;
+  m_queuedBytes       = client.m_queuedBytes;
+  m_watchWrite        = client.m_watchWrite;
+  m_sendPolicy        = client.m_sendPolicy;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -695,6 +1043,20 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
 }
 
+void CTCPServer::CWebSocketClient::SendAnnouncement(const std::shared_ptr<const std::string>& data)
+{
+  const CWebSocketMessage* msg = m_websocket->Send(WebSocketTextFrame, data->c_str(), data->size());
+  if (msg == NULL || !msg->IsComplete())
+    return;
+
+  // the frames are queued as a whole, so they are either sent or dropped together
+  auto framed = std::make_shared<std::string>();
+  for (const CWebSocketFrame* frame : msg->GetFrames())
+    framed->append(frame->GetFrameData(), frame->GetFrameLength());
+
+  Queue(std::move(framed), true);
+}
+
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   bool send;
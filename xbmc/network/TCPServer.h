@@ -11,10 +11,16 @@
 #include "interfaces/json-rpc/IClient.h"
 #include "interfaces/json-rpc/IJSONRPCAnnouncer.h"
 #include "interfaces/json-rpc/ITransportLayer.h"
+#include "network/SendQueuePolicy.h"
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
 
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <sys/socket.h>
@@ -40,16 +46,31 @@ namespace JSONRPC
                   const std::string& sender,
                   const std::string& message,
                   const CVariant& data) override;
+    void FlushAnnouncements() override;
 
   protected:
     void Process() override;
   private:
+    struct SocketEvent
+    {
+      SOCKET socket;
+      bool read;
+      bool write;
+    };
+
     CTCPServer(int port, bool nonlocal);
     bool Initialize();
     bool InitializeBlue();
     bool InitializeTCP();
+    bool InitializePoll();
     void Deinitialize();
 
+    bool WaitForEvents(std::vector<SocketEvent>& events);
+    void WatchSocket(SOCKET socket, bool write);
+    void AcceptConnection(SOCKET server);
+    void ReadConnection(SOCKET socket);
+    void CloseConnection(SOCKET socket);
+
     class CTCPClient : public IClient
     {
     public:
@@ -63,27 +84,70 @@ namespace JSONRPC
       int GetPermissionFlags() override;
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
+      bool GetBatchAnnouncements() override;
+      bool SetBatchAnnouncements(bool batch) override;
 
+      /*!
+       * \brief Queue a response, it is sent in full whatever the queue size
+       */
       virtual void Send(const char *data, unsigned int size);
+      /*!
+       * \brief Queue an announcement, it is dropped when the client does not keep up
+       * \param data the serialized announcement, shared by all clients
+       */
+      virtual void SendAnnouncement(const std::shared_ptr<const std::string>& data);
+      /*!
+       * \brief Collect an announcement for a client that takes them in batches
+       */
+      void BatchAnnouncement(const std::shared_ptr<const std::string>& data);
+      /*!
+       * \brief Send the collected announcements as one JSON-RPC batch
+       */
+      void FlushBatch();
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
       virtual bool IsNew() const { return m_new; }
       virtual bool Closing() const { return false; }
 
+      /*!
+       * \brief Send as much of the queued data as the socket takes without blocking
+       * \return false if the connection failed
+       */
+      bool Flush();
+      bool HasPendingData();
+      /*!
+       * \brief Whether announcements have been dropped for too long
+       */
+      bool IsStalled(std::chrono::steady_clock::time_point now);
+      /*!
+       * \brief Stop using the socket, which is handed over to another client
+       */
+      void Release();
+
       SOCKET m_socket;
       sockaddr_storage m_cliaddr;
       socklen_t m_addrlen;
       CCriticalSection m_critSection;
+      CTCPServer* m_host = nullptr;
 
     protected:
       void Copy(const CTCPClient& client);
+      bool Queue(std::shared_ptr<const std::string> data, bool droppable);
     private:
       bool m_new;
       int m_announcementflags;
+      bool m_batchAnnouncements = false;
+      std::vector<std::shared_ptr<const std::string>> m_batch;
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+
+      std::deque<std::shared_ptr<const std::string>> m_sendQueue;
+      size_t m_sendOffset = 0;
+      size_t m_queuedBytes = 0;
+      bool m_watchWrite = false;
+      CSendQueuePolicy m_sendPolicy;
     };
 
     class CWebSocketClient : public CTCPClient
@@ -96,6 +160,7 @@ namespace JSONRPC
       ~CWebSocketClient() override;
 
       void Send(const char *data, unsigned int size) override;
+      void SendAnnouncement(const std::shared_ptr<const std::string>& data) override;
       void PushBuffer(CTCPServer *host, const char *buffer, int length) override;
       void Disconnect() override;
 
@@ -107,8 +172,11 @@ namespace JSONRPC
       std::string m_buffer;
     };
 
-    std::vector<CTCPClient*> m_connections;
+    // changed by the server thread only, under m_connectionsSection
+    std::unordered_map<SOCKET, std::shared_ptr<CTCPClient>> m_connections;
+    CCriticalSection m_connectionsSection;
     std::vector<SOCKET> m_servers;
+    int m_pollFd = -1; ///< epoll instance, -1 if select() is used
     int m_port;
     bool m_nonlocal;
     void* m_sdpd;
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "network/SendQueuePolicy.h"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// the limits the JSON-RPC server uses
+constexpr size_t MAX_BYTES = 4 * 1024 * 1024;
+constexpr auto MAX_STALL = 30s;
+} // unnamed namespace
+
+TEST(TestSendQueuePolicy, DropsAboveLimit)
+{
+  CSendQueuePolicy policy(MAX_BYTES, MAX_STALL);
+  const auto now = std::chrono::steady_clock::now();
+
+  EXPECT_TRUE(policy.CanQueue(0, MAX_BYTES, now));
+  EXPECT_TRUE(policy.CanQueue(MAX_BYTES - 100, 100, now));
+  EXPECT_EQ(0u, policy.GetDropped());
+
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES - 100, 101, now));
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES, 1, now));
+  EXPECT_EQ(2u, policy.GetDropped());
+}
+
+TEST(TestSendQueuePolicy, CatchesUpBelowHalf)
+{
+  CSendQueuePolicy policy(MAX_BYTES, MAX_STALL);
+  const auto now = std::chrono::steady_clock::now();
+
+  // nothing was dropped, nothing to report
+  EXPECT_EQ(0u, policy.Sent(0));
+
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES, 10, now));
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES, 10, now));
+
+  // still more than half waiting, keep dropping although the announcement would fit
+  EXPECT_EQ(0u, policy.Sent(MAX_BYTES / 2));
+  EXPECT_EQ(2u, policy.GetDropped());
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES / 2, 10, now));
+  EXPECT_EQ(3u, policy.GetDropped());
+
+  EXPECT_EQ(3u, policy.Sent(MAX_BYTES / 2 - 1));
+  EXPECT_EQ(0u, policy.GetDropped());
+  EXPECT_TRUE(policy.CanQueue(MAX_BYTES / 2 - 1, 10, now));
+}
+
+TEST(TestSendQueuePolicy, StallsAfterDroppingTooLong)
+{
+  CSendQueuePolicy policy(MAX_BYTES, MAX_STALL);
+  const auto start = std::chrono::steady_clock::now();
+
+  EXPECT_FALSE(policy.IsStalled(start + 1h));
+
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES, 10, start));
+  // later drops do not restart the clock
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES, 10, start + 20s));
+  EXPECT_FALSE(policy.IsStalled(start + MAX_STALL));
+  EXPECT_TRUE(policy.IsStalled(start + MAX_STALL + 1ms));
+}
+
+TEST(TestSendQueuePolicy, CatchingUpRestartsTheClock)
+{
+  CSendQueuePolicy policy(MAX_BYTES, MAX_STALL);
+  const auto start = std::chrono::steady_clock::now();
+
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES, 10, start));
+  EXPECT_EQ(1u, policy.Sent(0));
+  EXPECT_FALSE(policy.IsStalled(start + 1h));
+
+  EXPECT_FALSE(policy.CanQueue(MAX_BYTES, 10, start + 25s));
+  EXPECT_FALSE(policy.IsStalled(start + MAX_STALL + 1ms));
+  EXPECT_TRUE(policy.IsStalled(start + 25s + MAX_STALL + 1ms));
+}
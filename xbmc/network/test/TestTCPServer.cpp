@@ -0,0 +1,170 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "interfaces/AnnouncementManager.h"
+#include "network/TCPServer.h"
+#include "utils/Variant.h"
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr int CLIENTS = 256;
+constexpr int ANNOUNCEMENTS = 40;
+constexpr size_t PAYLOAD_SIZE = 8 * 1024;
+constexpr char MARKER[] = "Other.OnStressTest";
+
+int Connect(uint16_t port)
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// send a request and wait for any response, the server has added the connection then
+bool WaitForResponse(int fd)
+{
+  const std::string request = "{\"jsonrpc\":\"2.0\",\"method\":\"JSONRPC.Ping\",\"id\":1}";
+  if (send(fd, request.c_str(), request.size(), 0) != static_cast<ssize_t>(request.size()))
+    return false;
+
+  pollfd pfd = {fd, POLLIN, 0};
+  if (poll(&pfd, 1, 5000) <= 0)
+    return false;
+
+  char buffer[4096];
+  return recv(fd, buffer, sizeof(buffer), 0) > 0;
+}
+
+struct Client
+{
+  int fd = -1;
+  int received = 0;
+  std::string pending;
+};
+} // namespace
+
+class TestTCPServer : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_announcementManager = std::make_shared<ANNOUNCEMENT::CAnnouncementManager>();
+    m_announcementManager->Start();
+    CServiceBroker::RegisterAnnouncementManager(m_announcementManager);
+
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<uint16_t> dist(49152, 65535);
+    m_port = dist(mt);
+    ASSERT_TRUE(JSONRPC::CTCPServer::StartServer(m_port, false));
+  }
+
+  void TearDown() override
+  {
+    for (const auto& client : m_clients)
+      close(client.fd);
+
+    JSONRPC::CTCPServer::StopServer(true);
+    m_announcementManager->Deinitialize();
+    CServiceBroker::UnregisterAnnouncementManager();
+  }
+
+  uint16_t m_port = 0;
+  std::vector<Client> m_clients;
+  std::shared_ptr<ANNOUNCEMENT::CAnnouncementManager> m_announcementManager;
+};
+
+TEST_F(TestTCPServer, StalledClientDoesNotDelayOthers)
+{
+  for (int i = 0; i < CLIENTS; i++)
+  {
+    Client client;
+    client.fd = Connect(m_port);
+    ASSERT_GE(client.fd, 0);
+    ASSERT_TRUE(WaitForResponse(client.fd));
+    m_clients.push_back(client);
+  }
+
+  // a client that never reads what it is sent
+  Client stalled;
+  stalled.fd = Connect(m_port);
+  ASSERT_GE(stalled.fd, 0);
+  int receiveBuffer = 4096;
+  setsockopt(stalled.fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+  ASSERT_TRUE(WaitForResponse(stalled.fd));
+
+  const auto deadline = std::chrono::steady_clock::now() + 30s;
+
+  CVariant data;
+  data["payload"] = std::string(PAYLOAD_SIZE, 'x');
+  for (int i = 0; i < ANNOUNCEMENTS; i++)
+    m_announcementManager->Announce(ANNOUNCEMENT::Other, "xbmc", "OnStressTest", data);
+
+  int complete = 0;
+  std::vector<pollfd> pfds(m_clients.size());
+  while (complete < CLIENTS && std::chrono::steady_clock::now() < deadline)
+  {
+    for (size_t i = 0; i < m_clients.size(); i++)
+      pfds[i] = {m_clients[i].fd, POLLIN, 0};
+
+    if (poll(pfds.data(), pfds.size(), 1000) <= 0)
+      continue;
+
+    for (size_t i = 0; i < m_clients.size(); i++)
+    {
+      if ((pfds[i].revents & POLLIN) == 0)
+        continue;
+
+      Client& client = m_clients[i];
+      char buffer[16 * 1024];
+      const ssize_t nread = recv(client.fd, buffer, sizeof(buffer), 0);
+      ASSERT_GT(nread, 0);
+
+      client.pending.append(buffer, nread);
+      size_t pos;
+      while ((pos = client.pending.find(MARKER)) != std::string::npos)
+      {
+        client.pending.erase(0, pos + sizeof(MARKER) - 1);
+        if (++client.received == ANNOUNCEMENTS)
+          complete++;
+      }
+    }
+  }
+
+  for (const auto& client : m_clients)
+    EXPECT_EQ(ANNOUNCEMENTS, client.received);
+
+  close(stalled.fd);
+}
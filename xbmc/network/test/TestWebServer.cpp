@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include "URL.h"
 #include "filesystem/CurlFile.h"
+#include "filesystem/DllLibCurl.h"
 #include "filesystem/File.h"
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "network/WebServer.h"
@@ -29,6 +30,8 @@
 #include "utils/Variant.h"
 
 #include <random>
+#include <thread>
+#include <vector>
 
 using namespace XFILE;
 
@@ -40,6 +43,7 @@ using namespace XFILE;
 #define TEST_FILES_DATA_RANGES  "range1;range2;range3"
 #define TEST_FILES_HTML         TEST_FILES_DATA ".html"
 #define TEST_FILES_RANGES       TEST_FILES_DATA "-ranges.txt"
+#define TEST_FILES_PNG          TEST_FILES_DATA ".png"
 
 class TestWebServer : public testing::Test
 {
@@ -351,6 +355,21 @@ protected:
     return StringUtils::Format("bytes={}-{}", start, end);
   }
 
+  std::string GetContentOfTestFile(const std::string& testFile)
+  {
+    CFile file;
+    std::vector<uint8_t> content;
+    if (file.LoadFile(URIUtils::AddFileToFolder(sourcePath, testFile), content) <= 0)
+      return "";
+
+    return std::string(content.begin(), content.end());
+  }
+
+  static XCURL::CCurlMultiLoop::HostStats GetCurlStats()
+  {
+    return g_curlInterface.GetLoop().GetStats()[WEBSERVER_HOST];
+  }
+
   CWebServer webserver;
   CHTTPJsonRpcHandler m_jsonRpcHandler;
   CHTTPVfsHandler m_vfsHandler;
@@ -922,3 +941,68 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanGetFilesConcurrentlyOnSharedConnections)
+{
+  constexpr int THREADS = 4;
+  constexpr int READS = 8;
+
+  const std::string url = GetUrlOfTestFile(TEST_FILES_HTML);
+  const auto before = GetCurlStats();
+
+  std::vector<std::thread> threads;
+  std::vector<int> matches(THREADS, 0);
+  for (int i = 0; i < THREADS; i++)
+  {
+    threads.emplace_back([&url, &matches, i] {
+      for (int read = 0; read < READS; read++)
+      {
+        CCurlFile curl;
+        std::string result;
+        if (curl.Get(url, result) && result == TEST_FILES_DATA)
+          matches[i]++;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int i = 0; i < THREADS; i++)
+    EXPECT_EQ(READS, matches[i]);
+
+  const auto after = GetCurlStats();
+  const uint64_t transfers = after.transfers - before.transfers;
+  const uint64_t connections = after.connections - before.connections;
+  EXPECT_EQ(static_cast<uint64_t>(THREADS * READS), transfers);
+  EXPECT_EQ(0u, after.failed - before.failed);
+
+  // the files share the connections of the curl loop
+  EXPECT_GT(connections, 0u);
+  EXPECT_LT(connections, transfers);
+}
+
+TEST_F(TestWebServer, CanReadFileWithSmallBuffer)
+{
+  const std::string expected = GetContentOfTestFile(TEST_FILES_PNG);
+  ASSERT_FALSE(expected.empty());
+
+  // the transfer has to wait for the reader many times
+  CCurlFile curl;
+  curl.SetBufferSize(64);
+  ASSERT_TRUE(curl.Open(CURL(GetUrlOfTestFile(TEST_FILES_PNG))));
+  EXPECT_EQ(static_cast<int64_t>(expected.size()), curl.GetLength());
+
+  std::string result;
+  char buffer[30];
+  ssize_t read;
+  while ((read = curl.Read(buffer, sizeof(buffer))) > 0)
+    result.append(buffer, read);
+  EXPECT_EQ(0, read);
+  EXPECT_EQ(expected, result);
+
+  // seeking starts a second transfer on the same host
+  EXPECT_EQ(300, curl.Seek(300, SEEK_SET));
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(buffer)), curl.Read(buffer, sizeof(buffer)));
+  EXPECT_EQ(expected.substr(300, sizeof(buffer)), std::string(buffer, sizeof(buffer)));
+  curl.Close();
+}
@@ -32,8 +32,10 @@
 #include "pictures/GUIViewStatePictures.h"
 #include "pictures/PictureThumbLoader.h"
 #include "pictures/SlideShowDelegator.h"
+#include "pictures/SlideShowPrefetcher.h"
 #include "playlists/PlayListTypes.h"
 #include "rendering/RenderSystem.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/DisplaySettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -43,6 +45,8 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <random>
 
@@ -78,9 +82,10 @@ CBackgroundPicLoader::~CBackgroundPicLoader()
   StopThread();
 }
 
-void CBackgroundPicLoader::Create(CGUIWindowSlideShow *pCallback)
+void CBackgroundPicLoader::Create(CGUIWindowSlideShow* pCallback, CSlideShowPrefetcher* prefetcher)
 {
   m_pCallback = pCallback;
+  m_prefetcher = prefetcher;
   m_isLoading = false;
   CThread::Create(false);
 }
@@ -96,8 +101,12 @@ void CBackgroundPicLoader::Process()
       if (m_pCallback)
       {
         auto start = std::chrono::steady_clock::now();
-        std::unique_ptr<CTexture> texture =
-            CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
+        std::unique_ptr<CTexture> texture;
+        if (m_prefetcher)
+          texture = m_prefetcher->Take(m_strFileName, m_maxWidth, m_maxHeight);
+        if (!texture)
+          texture =
+              CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight, false, "", true);
 
         auto end = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -247,6 +256,8 @@ void CGUIWindowSlideShow::Reset()
   m_iCurrentPic = 0;
   m_iDirection = 1;
   m_iLastFailedNextSlide = -1;
+  m_iFullSizeSlide = -1;
+  m_iPrefetchSlide = -1;
   m_slides.clear();
   AnnouncePlaylistClear();
   m_Resolution = CServiceBroker::GetWinSystem()->GetGfxContext().GetVideoResolution();
@@ -275,6 +286,8 @@ void CGUIWindowSlideShow::OnDeinitWindow(int nextWindowID)
       m_pBackgroundLoader->StopThread();
       m_pBackgroundLoader.reset();
     }
+    m_prefetcher.reset();
+    m_iPrefetchSlide = -1;
     // and close the images.
     m_Image[0]->Close();
     m_Image[1]->Close();
@@ -417,8 +430,13 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
   // Create our background loader if necessary
   if (!m_pBackgroundLoader)
   {
+    const int prefetchMemory = CServiceBroker::GetSettingsComponent()
+                                   ->GetAdvancedSettings()
+                                   ->m_slideshowPrefetchMemory;
+    m_prefetcher =
+        std::make_unique<CSlideShowPrefetcher>(static_cast<size_t>(prefetchMemory) * 1024 * 1024);
     m_pBackgroundLoader = std::make_unique<CBackgroundPicLoader>();
-    m_pBackgroundLoader->Create(this);
+    m_pBackgroundLoader->Create(this, m_prefetcher.get());
   }
 
   bool bSlideShow = m_bSlideShow && !m_bPause && !m_bPlayingVideo;
@@ -510,10 +528,7 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
 
       // load using the background loader
       int maxWidth, maxHeight;
-
-      GetCheckedSize((float)res.iWidth * m_fZoom,
-        (float)res.iHeight * m_fZoom,
-        maxWidth, maxHeight);
+      GetSlideSize(maxWidth, maxHeight);
       m_pBackgroundLoader->LoadPic(m_iCurrentPic, m_iCurrentSlide, picturePath, maxWidth, maxHeight);
       m_iLastFailedNextSlide = -1;
       m_bLoadNextPic = false;
@@ -541,13 +556,30 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
         CLog::Log(LOGDEBUG, "Loading the next image {}: {}", m_iNextSlide, item->GetPath());
 
       int maxWidth, maxHeight;
-      GetCheckedSize((float)res.iWidth * m_fZoom,
-                     (float)res.iHeight * m_fZoom,
-                     maxWidth, maxHeight);
+      GetSlideSize(maxWidth, maxHeight);
       m_pBackgroundLoader->LoadPic(1 - m_iCurrentPic, m_iNextSlide, picturePath, maxWidth, maxHeight);
     }
   }
 
+  // pictures are loaded at display size, reload the current one in full when zooming in
+  if (m_fZoom > 1.0f && m_iFullSizeSlide != m_iCurrentSlide &&
+      m_Image[m_iCurrentPic]->IsLoaded() && !m_Image[m_iCurrentPic]->FullSize() &&
+      m_Image[m_iCurrentPic]->SlideNumber() == m_iCurrentSlide &&
+      !m_pBackgroundLoader->IsLoading())
+  {
+    m_iFullSizeSlide = m_iCurrentSlide;
+    CFileItemPtr item = m_slides.at(m_iCurrentSlide);
+    std::string picturePath = GetPicturePath(item.get());
+    if (!picturePath.empty())
+    {
+      CLog::Log(LOGDEBUG, "Loading the full size image {}: {}", m_iCurrentSlide, item->GetPath());
+      const int maxSize = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
+      m_pBackgroundLoader->LoadPic(m_iCurrentPic, m_iCurrentSlide, picturePath, maxSize, maxSize);
+    }
+  }
+
+  UpdatePrefetch();
+
   bool bPlayVideo = m_slides.at(m_iCurrentSlide)->IsVideo() && m_iVideoSlide != m_iCurrentSlide;
   if (bPlayVideo)
     bSlideShow = false;
@@ -657,6 +689,7 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     m_iZoomFactor = 1;
     m_fZoom = 1.0f;
     m_fRotate = 0.0f;
+    m_iFullSizeSlide = -1;
   }
 
   if (bPlayVideo && !PlayVideo())
@@ -732,6 +765,53 @@ void CGUIWindowSlideShow::RenderEx()
   CGUIWindow::RenderEx();
 }
 
+void CGUIWindowSlideShow::UpdatePrefetch()
+{
+  const int prefetchCount =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_slideshowPrefetchCount;
+  if (!m_prefetcher || prefetchCount <= 0)
+    return;
+
+  // the size the next slides will be loaded at, so the loader can take them
+  int maxWidth, maxHeight;
+  GetSlideSize(maxWidth, maxHeight);
+
+  if (m_iPrefetchSlide == m_iCurrentSlide && m_iPrefetchDirection == m_iDirection &&
+      m_iPrefetchSlides == m_slides.size() && m_iPrefetchSize == maxWidth)
+    return;
+
+  m_iPrefetchSlide = m_iCurrentSlide;
+  m_iPrefetchDirection = m_iDirection;
+  m_iPrefetchSlides = m_slides.size();
+  m_iPrefetchSize = maxWidth;
+
+  // slides in the current direction first, then the ones we came from
+  const int numSlides = static_cast<int>(m_slides.size());
+  const int step = m_iDirection >= 0 ? 1 : -1;
+  std::vector<CSlideShowPrefetcher::Request> ring;
+  for (int i = 1; i <= prefetchCount; i++)
+  {
+    for (const int offset : {step * i, -step * i})
+    {
+      const int slide = ((m_iCurrentSlide + offset) % numSlides + numSlides) % numSlides;
+      if (slide == m_iCurrentSlide ||
+          std::any_of(ring.begin(), ring.end(),
+                      [slide](const CSlideShowPrefetcher::Request& request) {
+                        return request.slide == slide;
+                      }))
+        continue;
+
+      const CFileItemPtr& item = m_slides.at(slide);
+      if (item->IsVideo() || item->HasProperty("unplayable"))
+        continue;
+
+      ring.push_back({slide, GetPicturePath(item.get()), maxWidth, maxHeight});
+    }
+  }
+
+  m_prefetcher->Prefetch(ring);
+}
+
 int CGUIWindowSlideShow::GetNextSlide()
 {
   if (m_slides.size() <= 1)
@@ -1208,6 +1288,17 @@ void CGUIWindowSlideShow::OnLoadPic(int iPic,
     { // throw this away - we must have cleared the slideshow while we were still loading
       return;
     }
+    if (iPic == m_iCurrentPic && m_Image[iPic]->IsLoaded() &&
+        m_Image[iPic]->SlideNumber() == iSlideNumber)
+    { // full size version of the picture on screen
+      CLog::Log(LOGDEBUG, "Finished loading full size slot {}, {}: {}", iPic, iSlideNumber,
+                m_slides.at(iSlideNumber)->GetPath());
+      m_Image[iPic]->SetOriginalSize(pTexture->GetOriginalWidth(), pTexture->GetOriginalHeight(),
+                                     bFullSize);
+      m_Image[iPic]->UpdateTexture(std::move(pTexture));
+      MarkDirtyRegion();
+      return;
+    }
     CLog::Log(LOGDEBUG, "Finished background loading slot {}, {}: {}", iPic, iSlideNumber,
               m_slides.at(iSlideNumber)->GetPath());
     m_Image[iPic]->SetOriginalSize(pTexture->GetOriginalWidth(), pTexture->GetOriginalHeight(),
@@ -1252,6 +1343,7 @@ void CGUIWindowSlideShow::Shuffle()
   KODI::UTILS::RandomShuffle(m_slides.begin(), m_slides.end());
   m_iCurrentSlide = 0;
   m_iNextSlide = GetNextSlide();
+  m_iPrefetchSlide = -1;
   m_bShuffled = true;
 
   AnnouncePropertyChanged("shuffled", true);
@@ -1370,8 +1462,16 @@ void CGUIWindowSlideShow::AddItems(const std::string &strPath, path_set *recursi
 
 void CGUIWindowSlideShow::GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight)
 {
-  maxWidth = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
-  maxHeight = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
+  CSlideShowPrefetcher::GetDecodeSize(width, height,
+                                      CServiceBroker::GetRenderSystem()->GetMaxTextureSize(),
+                                      maxWidth, maxHeight);
+}
+
+void CGUIWindowSlideShow::GetSlideSize(int& maxWidth, int& maxHeight)
+{
+  const RESOLUTION_INFO res = CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo();
+  GetCheckedSize(static_cast<float>(res.iWidth) * m_fZoom,
+                 static_cast<float>(res.iHeight) * m_fZoom, maxWidth, maxHeight);
 }
 
 std::string CGUIWindowSlideShow::GetPicturePath(CFileItem *item)
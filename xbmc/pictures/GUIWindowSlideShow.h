@@ -18,6 +18,7 @@
 #include <set>
 
 class CFileItemList;
+class CSlideShowPrefetcher;
 class CVariant;
 
 class CGUIWindowSlideShow;
@@ -28,7 +29,7 @@ public:
   CBackgroundPicLoader();
   ~CBackgroundPicLoader() override;
 
-  void Create(CGUIWindowSlideShow *pCallback);
+  void Create(CGUIWindowSlideShow* pCallback, CSlideShowPrefetcher* prefetcher);
   void LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight);
   bool IsLoading() { return m_isLoading; }
   int SlideNumber() const { return m_iSlideNumber; }
@@ -46,6 +47,7 @@ private:
   bool m_isLoading = false;
 
   CGUIWindowSlideShow* m_pCallback = nullptr;
+  CSlideShowPrefetcher* m_prefetcher = nullptr;
 };
 
 class CGUIWindowSlideShow : public CGUIDialog, public ISlideShowDelegate
@@ -122,8 +124,11 @@ private:
   void ZoomRelative(float fZoom, bool immediate = false);
   void Move(float fX, float fY);
   void GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight);
+  /*! \brief The size the current and the next slides are loaded and prefetched at */
+  void GetSlideSize(int& maxWidth, int& maxHeight);
   std::string GetPicturePath(CFileItem *item);
   int  GetNextSlide();
+  void UpdatePrefetch();
 
   void AnnouncePlayerPlay(const CFileItemPtr& item);
   void AnnouncePlayerPause(const CFileItemPtr& item);
@@ -155,6 +160,12 @@ private:
   int m_iCurrentPic;
   // background loader
   std::unique_ptr<CBackgroundPicLoader> m_pBackgroundLoader;
+  std::unique_ptr<CSlideShowPrefetcher> m_prefetcher;
+  int m_iPrefetchSlide = -1;
+  int m_iPrefetchDirection = 0;
+  size_t m_iPrefetchSlides = 0;
+  int m_iPrefetchSize = 0;
+  int m_iFullSizeSlide = -1;
   int m_iLastFailedNextSlide;
   bool m_bLoadNextPic;
   RESOLUTION m_Resolution;
@@ -0,0 +1,250 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SlideShowPrefetcher.h"
+
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "guilib/Texture.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+struct CSlideShowPrefetcher::Entry
+{
+  int slide;
+  std::string path;
+  int maxWidth;
+  int maxHeight;
+  size_t rank = 0;
+  bool loading = false;
+  bool done = false;
+  bool cancelled = false;
+  std::unique_ptr<CTexture> texture;
+  size_t bytes = 0;
+
+  bool Matches(const std::string& otherPath, int otherWidth, int otherHeight) const
+  {
+    return path == otherPath && maxWidth == otherWidth && maxHeight == otherHeight;
+  }
+};
+
+// shared with the decode jobs, which may outlive the prefetcher
+struct CSlideShowPrefetcher::State
+{
+  explicit State(size_t budget) : memoryBudget(budget) {}
+
+  void Drop(const std::shared_ptr<Entry>& entry)
+  {
+    entry->cancelled = true;
+    if (entry->texture)
+    {
+      stats.bytes -= entry->bytes;
+      stats.evictions++;
+      entry->texture.reset();
+    }
+    entries.erase(std::remove(entries.begin(), entries.end(), entry), entries.end());
+  }
+
+  CCriticalSection section;
+  XbmcThreads::ConditionVariable condition;
+  std::vector<std::shared_ptr<Entry>> entries;
+  const size_t memoryBudget;
+  Stats stats;
+};
+
+CSlideShowPrefetcher::CSlideShowPrefetcher(size_t memoryBudget)
+  : m_state(std::make_shared<State>(memoryBudget))
+{
+}
+
+CSlideShowPrefetcher::~CSlideShowPrefetcher()
+{
+  Clear();
+
+  const Stats stats = GetStats();
+  if (stats.hits + stats.waits + stats.misses > 0)
+    CLog::Log(LOGDEBUG,
+              "CSlideShowPrefetcher: {} slides decoded ahead, {} while waiting, {} missed, {} "
+              "evicted",
+              stats.hits, stats.waits, stats.misses, stats.evictions);
+}
+
+void CSlideShowPrefetcher::Prefetch(const std::vector<Request>& ring)
+{
+  if (m_state->memoryBudget == 0)
+    return;
+
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+
+  const auto entries = m_state->entries;
+  for (const auto& entry : entries)
+  {
+    auto it = std::find_if(ring.begin(), ring.end(), [&entry](const Request& request) {
+      return entry->Matches(request.path, request.maxWidth, request.maxHeight);
+    });
+    if (it == ring.end())
+      m_state->Drop(entry);
+    else
+      entry->rank = static_cast<size_t>(std::distance(ring.begin(), it));
+  }
+
+  for (size_t rank = 0; rank < ring.size(); ++rank)
+  {
+    const Request& request = ring[rank];
+    if (std::any_of(m_state->entries.begin(), m_state->entries.end(),
+                    [&request](const std::shared_ptr<Entry>& entry) {
+                      return entry->Matches(request.path, request.maxWidth, request.maxHeight);
+                    }))
+      continue;
+
+    auto entry = std::make_shared<Entry>();
+    entry->slide = request.slide;
+    entry->path = request.path;
+    entry->maxWidth = request.maxWidth;
+    entry->maxHeight = request.maxHeight;
+    entry->rank = rank;
+    m_state->entries.emplace_back(entry);
+
+    CServiceBroker::GetJobManager()->Submit([state = m_state, entry]() { Decode(state, entry); });
+  }
+}
+
+std::unique_ptr<CTexture> CSlideShowPrefetcher::Take(const std::string& path,
+                                                     int maxWidth,
+                                                     int maxHeight)
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+
+  auto it = std::find_if(m_state->entries.begin(), m_state->entries.end(),
+                         [&](const std::shared_ptr<Entry>& entry) {
+                           return entry->Matches(path, maxWidth, maxHeight);
+                         });
+  if (it == m_state->entries.end())
+  {
+    m_state->stats.misses++;
+    return {};
+  }
+
+  std::shared_ptr<Entry> entry = *it;
+  if (!entry->done && !entry->loading)
+  {
+    // still queued behind other jobs, the caller is faster decoding it itself
+    m_state->Drop(entry);
+    m_state->stats.misses++;
+    return {};
+  }
+
+  const bool waited = !entry->done;
+  m_state->condition.wait(lock, [&entry] { return entry->done; });
+
+  std::unique_ptr<CTexture> texture = std::move(entry->texture);
+  m_state->stats.bytes -= entry->bytes;
+  entry->cancelled = true;
+  m_state->entries.erase(
+      std::remove(m_state->entries.begin(), m_state->entries.end(), entry),
+      m_state->entries.end());
+
+  if (!texture)
+    m_state->stats.misses++;
+  else if (waited)
+    m_state->stats.waits++;
+  else
+    m_state->stats.hits++;
+
+  return texture;
+}
+
+void CSlideShowPrefetcher::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  for (const auto& entry : m_state->entries)
+  {
+    entry->cancelled = true;
+    entry->texture.reset();
+  }
+  m_state->entries.clear();
+  m_state->stats.bytes = 0;
+}
+
+CSlideShowPrefetcher::Stats CSlideShowPrefetcher::GetStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  return m_state->stats;
+}
+
+void CSlideShowPrefetcher::Decode(const std::shared_ptr<State>& state,
+                                  const std::shared_ptr<Entry>& entry)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(state->section);
+    if (entry->cancelled)
+      return;
+    entry->loading = true;
+  }
+
+  std::unique_ptr<CTexture> texture =
+      CTexture::LoadFromFile(entry->path, entry->maxWidth, entry->maxHeight, false, "", true);
+
+  std::unique_lock<CCriticalSection> lock(state->section);
+  entry->loading = false;
+  entry->done = true;
+
+  if (!texture)
+  {
+    CLog::Log(LOGDEBUG, "CSlideShowPrefetcher: failed to decode slide {}: {}", entry->slide,
+              CURL::GetRedacted(entry->path));
+  }
+  else if (!entry->cancelled)
+  {
+    const size_t bytes = static_cast<size_t>(texture->GetPitch()) * texture->GetRows();
+
+    // make room by dropping slides further away from the current one
+    while (state->stats.bytes + bytes > state->memoryBudget)
+    {
+      std::shared_ptr<Entry> farthest;
+      for (const auto& other : state->entries)
+      {
+        if (other->texture && other->rank > entry->rank &&
+            (!farthest || other->rank > farthest->rank))
+          farthest = other;
+      }
+      if (!farthest)
+        break;
+      state->Drop(farthest);
+    }
+
+    if (state->stats.bytes + bytes <= state->memoryBudget)
+    {
+      entry->texture = std::move(texture);
+      entry->bytes = bytes;
+      state->stats.bytes += bytes;
+    }
+    else
+    {
+      state->stats.evictions++;
+    }
+  }
+
+  state->condition.notifyAll();
+}
+
+void CSlideShowPrefetcher::GetDecodeSize(
+    float width, float height, unsigned int maxTextureSize, int& maxWidth, int& maxHeight)
+{
+  // decode at display size, a square so rotated pictures are as sharp
+  const int maxSize = static_cast<int>(maxTextureSize);
+  const int size = static_cast<int>(std::ceil(std::max(width, height)));
+  maxWidth = size > 0 ? std::min(size, maxSize) : maxSize;
+  maxHeight = maxWidth;
+}
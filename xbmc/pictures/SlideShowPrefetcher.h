@@ -0,0 +1,92 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class CTexture;
+
+/*!
+ * \brief Decodes the slides around the current one ahead of time
+ *
+ * The slides are decoded in parallel on the job manager. Decoded textures are
+ * kept until they are taken or fall out of the ring, bounded by a memory
+ * budget. Slides closer to the current one are kept over slides further away.
+ */
+class CSlideShowPrefetcher
+{
+public:
+  struct Request
+  {
+    int slide;
+    std::string path;
+    int maxWidth;
+    int maxHeight;
+  };
+
+  struct Stats
+  {
+    uint64_t hits = 0; ///< slides taken already decoded
+    uint64_t waits = 0; ///< slides taken while they were being decoded
+    uint64_t misses = 0; ///< slides that were not decoded ahead
+    uint64_t evictions = 0; ///< decoded slides dropped before they were taken
+    size_t bytes = 0; ///< memory held by decoded slides
+  };
+
+  /*!
+   * \param memoryBudget maximum bytes held by decoded slides
+   */
+  explicit CSlideShowPrefetcher(size_t memoryBudget);
+  ~CSlideShowPrefetcher();
+
+  /*!
+   * \brief Set the slides to decode ahead
+   * \param ring the slides, in order of priority. Slides not in the ring are
+   * dropped, queued decodes of them are cancelled.
+   */
+  void Prefetch(const std::vector<Request>& ring);
+
+  /*!
+   * \brief Take a decoded slide
+   *
+   * Waits if the slide is being decoded right now.
+   * \return the texture or nullptr if the slide was not decoded ahead
+   */
+  std::unique_ptr<CTexture> Take(const std::string& path, int maxWidth, int maxHeight);
+
+  /*!
+   * \brief Drop all decoded slides and cancel queued decodes
+   */
+  void Clear();
+
+  Stats GetStats() const;
+
+  /*!
+   * \brief The size a slide is decoded at, the same for the loader and the prefetcher so
+   * prefetched slides can be taken
+   * \param width, height the size the slide is shown at
+   * \param maxTextureSize the largest texture the render system supports
+   */
+  static void GetDecodeSize(float width,
+                            float height,
+                            unsigned int maxTextureSize,
+                            int& maxWidth,
+                            int& maxHeight);
+
+private:
+  struct Entry;
+  struct State;
+
+  static void Decode(const std::shared_ptr<State>& state, const std::shared_ptr<Entry>& entry);
+
+  std::shared_ptr<State> m_state;
+};
@@ -19,7 +19,17 @@
 
 namespace
 {
-std::vector<std::string> availableWindowSystems = CCompileInfo::GetAvailableWindowSystems();
+std::vector<std::string> GetAvailableWindowSystems()
+{
+  std::vector<std::string> windowSystems = CCompileInfo::GetAvailableWindowSystems();
+#if defined(TARGET_LINUX)
+  // the null window system has no dependencies, it's always built
+  windowSystems.emplace_back("null");
+#endif
+  return windowSystems;
+}
+
+std::vector<std::string> availableWindowSystems = GetAvailableWindowSystems();
 std::array<std::string, 1> availableLogTargets = {"console"};
 std::vector<std::string> availableAudioBackends = CCompileInfo::GetAvailableAudioBackends();
 std::vector<std::string> availableGlInterfaces = CCompileInfo::GetAvailableGlInterfaces();
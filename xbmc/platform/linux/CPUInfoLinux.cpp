@@ -212,6 +212,20 @@ CCPUInfoLinux::CCPUInfoLinux()
       m_cpuFeatures |= CPU_FEATURE_SSE42;
   }
 
+  // AVX2 also needs the OS to save the YMM state on context switches
+  if (__get_cpuid(CPUID_INFOTYPE_STANDARD, &eax, &ebx, &ecx, &edx) &&
+      (ecx & CPUID_00000001_ECX_OSXSAVE) && (ecx & CPUID_00000001_ECX_AVX))
+  {
+    unsigned int xcr0Low;
+    unsigned int xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+
+    if ((xcr0Low & 0x6) == 0x6 &&
+        __get_cpuid_count(CPUID_INFOTYPE_STRUCTURED_EXTENDED, 0, &eax, &ebx, &ecx, &edx) &&
+        (ebx & CPUID_00000007_EBX_AVX2))
+      m_cpuFeatures |= CPU_FEATURE_AVX2;
+  }
+
   if (__get_cpuid(CPUID_INFOTYPE_EXTENDED_IMPLEMENTED, &eax, &eax, &ecx, &edx))
   {
     if (eax >= CPUID_INFOTYPE_EXTENDED)
@@ -24,6 +24,7 @@
 #endif
 
 #include "platform/linux/powermanagement/LinuxPowerSyscall.h"
+#include "windowing/null/WinSystemNull.h"
 
 // clang-format off
 #if defined(HAS_GLES)
@@ -97,6 +98,10 @@ bool CPlatformLinux::InitStageOne()
 #endif
 #endif
 
+  // only when asked for, it never fails and would take over from the real ones
+  if (CServiceBroker::GetAppParams()->GetWindowing() == "null")
+    KODI::WINDOWING::CWinSystemNull::Register();
+
   RegisterPowerManagement();
 
   std::string_view sink = CServiceBroker::GetAppParams()->GetAudioBackend();
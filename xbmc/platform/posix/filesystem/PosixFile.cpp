@@ -8,6 +8,7 @@
 
 #include "PosixFile.h"
 
+#include "PosixReadAhead.h"
 #include "URL.h"
 #include "filesystem/File.h"
 #include "utils/AliasShortcutUtils.h"
@@ -32,6 +33,7 @@ using namespace XFILE;
 
 CPosixFile::~CPosixFile()
 {
+  m_readAhead.reset();
   if (m_fd >= 0)
     close(m_fd);
 }
@@ -85,6 +87,7 @@ void CPosixFile::Close()
 {
   if (m_fd >= 0)
   {
+    m_readAhead.reset();
     close(m_fd);
     m_fd = -1;
     m_filePos = -1;
@@ -106,7 +109,11 @@ ssize_t CPosixFile::Read(void* lpBuf, size_t uiBufSize)
   if (uiBufSize > SSIZE_MAX)
     uiBufSize = SSIZE_MAX;
 
-  const ssize_t res = read(m_fd, lpBuf, uiBufSize);
+  ssize_t res;
+  if (m_readAhead && m_filePos >= 0)
+    res = m_readAhead->Read(m_filePos, lpBuf, uiBufSize);
+  else
+    res = read(m_fd, lpBuf, uiBufSize);
   if (res < 0)
   {
     Seek(0, SEEK_CUR); // force update file position
@@ -166,6 +173,13 @@ int64_t CPosixFile::Seek(int64_t iFilePosition, int iWhence /* = SEEK_SET*/)
   if (m_fd < 0)
     return -1;
 
+  // reads ahead don't move the file offset
+  if (m_readAhead && iWhence == SEEK_CUR && m_filePos >= 0)
+  {
+    iFilePosition += m_filePos;
+    iWhence = SEEK_SET;
+  }
+
 #ifdef TARGET_ANDROID
   //! @todo properly support with detection in configure
   //! Android special case: Android doesn't substitute off64_t for off_t and similar functions
@@ -267,10 +281,43 @@ int CPosixFile::IoControl(EIoControl request, void* param)
         return 0; // size of file is 1 byte or more and seeking not possible
     }
   }
+  else if (request == IOCTRL_SET_READAHEAD)
+  {
+    if (!param)
+      return -1;
+    return SetReadAhead(*static_cast<unsigned int*>(param)) ? 0 : -1;
+  }
 
   return -1;
 }
 
+bool CPosixFile::SetReadAhead(unsigned int chunks)
+{
+  if (m_readAhead)
+  {
+    m_readAhead.reset();
+    // plain reads continue at the position of the reads ahead
+    if (m_filePos >= 0)
+      Seek(m_filePos, SEEK_SET);
+  }
+
+  if (chunks == 0)
+    return true;
+
+  if (m_allowWrite || GetPosition() < 0)
+    return false;
+
+  // pread() needs a regular file, and there is nothing to gain for files
+  // that are read with a single request anyway
+  struct stat64 st;
+  if (fstat64(m_fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+      st.st_size <= static_cast<int64_t>(CPosixReadAhead::CHUNK_SIZE))
+    return false;
+
+  m_readAhead = std::make_unique<CPosixReadAhead>(m_fd, chunks);
+  return true;
+}
+
 
 bool CPosixFile::Delete(const CURL& url)
 {
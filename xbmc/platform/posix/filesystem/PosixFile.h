@@ -10,8 +10,11 @@
 
 #include "filesystem/IFile.h"
 
+#include <memory>
+
 namespace XFILE
 {
+  class CPosixReadAhead;
 
   class CPosixFile : public IFile
   {
@@ -38,10 +41,13 @@ namespace XFILE
     int Stat(struct __stat64* buffer) override;
 
   protected:
+    bool SetReadAhead(unsigned int chunks);
+
     int     m_fd = -1;
     int64_t m_filePos = -1;
     int64_t m_lastDropPos = -1;
     bool    m_allowWrite = false;
+    std::unique_ptr<CPosixReadAhead> m_readAhead;
   };
 
 }
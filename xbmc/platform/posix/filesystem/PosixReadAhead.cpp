@@ -0,0 +1,376 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PosixReadAhead.h"
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <errno.h>
+#include <mutex>
+
+#include <unistd.h>
+
+#if defined(HAVE_LINUX_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace XFILE;
+
+#if defined(HAVE_LINUX_IO_URING)
+/*!
+ * \brief Minimal io_uring submission and completion rings, used by a single
+ * reader thread
+ */
+class CPosixReadAhead::CIoUring
+{
+public:
+  ~CIoUring()
+  {
+    if (m_sqes)
+      munmap(m_sqes, m_sqesSize);
+    if (m_cqRing && m_cqRing != m_sqRing)
+      munmap(m_cqRing, m_cqRingSize);
+    if (m_sqRing)
+      munmap(m_sqRing, m_sqRingSize);
+    if (m_ringFd >= 0)
+      close(m_ringFd);
+  }
+
+  bool Initialize(unsigned int entries)
+  {
+    io_uring_params params = {};
+    m_ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (m_ringFd < 0)
+    {
+      CLog::Log(LOGDEBUG, "CPosixReadAhead: io_uring is not available ({}), using threads",
+                strerror(errno));
+      return false;
+    }
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+      m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+    m_sqRing = Map(m_sqRingSize, IORING_OFF_SQ_RING);
+    if (!m_sqRing)
+      return false;
+    m_cqRing = singleMmap ? m_sqRing : Map(m_cqRingSize, IORING_OFF_CQ_RING);
+    if (!m_cqRing)
+      return false;
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = static_cast<io_uring_sqe*>(Map(m_sqesSize, IORING_OFF_SQES));
+    if (!m_sqes)
+      return false;
+
+    uint8_t* sq = static_cast<uint8_t*>(m_sqRing);
+    m_sqTail = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+
+    uint8_t* cq = static_cast<uint8_t*>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    return true;
+  }
+
+  /*!
+   * \brief Queue a read, the caller keeps no more reads in flight than the
+   * ring has entries
+   */
+  bool Submit(int fd, int64_t offset, const struct iovec* iov, uint64_t userData)
+  {
+    const unsigned int tail = *m_sqTail;
+    const unsigned int index = tail & m_sqMask;
+
+    io_uring_sqe& sqe = m_sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = fd;
+    sqe.off = static_cast<uint64_t>(offset);
+    sqe.addr = reinterpret_cast<uint64_t>(iov);
+    sqe.len = 1;
+    sqe.user_data = userData;
+
+    m_sqArray[index] = index;
+    __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    int res;
+    do
+    {
+      res = Enter(1, 0, 0);
+    } while (res < 0 && errno == EINTR);
+
+    if (res == 1)
+      return true;
+
+    // take the entry back, the kernel didn't consume it
+    __atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+    return false;
+  }
+
+  /*!
+   * \brief Wait for at least one completion if block is true and hand all
+   * completions to the callback
+   * \return false if waiting failed for another reason than a signal
+   */
+  template<typename Callback>
+  bool Reap(bool block, Callback&& callback)
+  {
+    unsigned int head = *m_cqHead;
+    if (block && head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+    {
+      if (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+      {
+        CLog::Log(LOGERROR, "CPosixReadAhead: waiting for io_uring failed ({})", strerror(errno));
+        return false;
+      }
+    }
+
+    while (head != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+    {
+      const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+      callback(cqe.user_data, cqe.res);
+      head++;
+    }
+    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    return true;
+  }
+
+private:
+  void* Map(size_t size, off_t offset)
+  {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd,
+                     offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  int Enter(unsigned int submit, unsigned int wait, unsigned int flags)
+  {
+    return static_cast<int>(
+        syscall(__NR_io_uring_enter, m_ringFd, submit, wait, flags, nullptr, 0));
+  }
+
+  int m_ringFd = -1;
+  void* m_sqRing = nullptr;
+  void* m_cqRing = nullptr;
+  size_t m_sqRingSize = 0;
+  size_t m_cqRingSize = 0;
+  io_uring_sqe* m_sqes = nullptr;
+  size_t m_sqesSize = 0;
+
+  unsigned int* m_sqTail = nullptr;
+  unsigned int m_sqMask = 0;
+  unsigned int* m_sqArray = nullptr;
+  unsigned int* m_cqHead = nullptr;
+  unsigned int* m_cqTail = nullptr;
+  unsigned int m_cqMask = 0;
+  io_uring_cqe* m_cqes = nullptr;
+};
+#else
+class CPosixReadAhead::CIoUring
+{
+};
+#endif
+
+/*!
+ * \brief Threads doing the reads when io_uring is not available
+ */
+class CPosixReadAhead::CThreadPool
+{
+public:
+  static constexpr unsigned int THREADS = 4;
+
+  static CThreadPool& GetInstance()
+  {
+    static CThreadPool pool;
+    return pool;
+  }
+
+  ~CThreadPool()
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      m_stop = true;
+    }
+    m_queued.notifyAll();
+    // the destructors of the workers wait for them
+    m_workers.clear();
+  }
+
+  void Submit(int fd, Chunk& chunk, size_t size)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      chunk.state = ChunkState::PENDING;
+      m_requests.push_back({fd, &chunk, size});
+    }
+    m_queued.notify();
+  }
+
+  void Wait(Chunk& chunk)
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_done.wait(lock, [&chunk] { return chunk.state != ChunkState::PENDING; });
+  }
+
+private:
+  struct Request
+  {
+    int fd;
+    Chunk* chunk;
+    size_t size;
+  };
+
+  class CWorker : public CThread
+  {
+  public:
+    explicit CWorker(CThreadPool& pool) : CThread("ReadAhead"), m_pool(pool) {}
+
+  protected:
+    void Process() override { m_pool.Run(); }
+
+  private:
+    CThreadPool& m_pool;
+  };
+
+  CThreadPool()
+  {
+    for (unsigned int i = 0; i < THREADS; i++)
+    {
+      m_workers.emplace_back(std::make_unique<CWorker>(*this));
+      m_workers.back()->Create();
+    }
+  }
+
+  void Run()
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    while (true)
+    {
+      m_queued.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+      if (m_stop)
+        return;
+
+      const Request request = m_requests.front();
+      m_requests.pop_front();
+      Chunk& chunk = *request.chunk;
+
+      lock.unlock();
+      ssize_t result = pread(request.fd, chunk.data.get(), request.size, chunk.offset);
+      if (result < 0)
+        result = -errno;
+      lock.lock();
+
+      chunk.result = result;
+      chunk.state = ChunkState::DONE;
+      m_done.notifyAll();
+    }
+  }
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_queued;
+  XbmcThreads::ConditionVariable m_done;
+  std::deque<Request> m_requests;
+  bool m_stop = false;
+  std::vector<std::unique_ptr<CWorker>> m_workers;
+};
+
+CPosixReadAhead::CPosixReadAhead(int fd, unsigned int depth, bool allowIoUring /* = true */)
+  : CReadAheadBuffer(CHUNK_SIZE, depth), m_fd(fd), m_iovecs(GetDepth())
+{
+  for (size_t i = 0; i < m_iovecs.size(); i++)
+  {
+    m_iovecs[i].iov_base = GetChunk(i).data.get();
+    m_iovecs[i].iov_len = m_chunkSize;
+  }
+
+#if defined(HAVE_LINUX_IO_URING)
+  if (allowIoUring)
+  {
+    m_ring = std::make_unique<CIoUring>();
+    if (!m_ring->Initialize(GetDepth()))
+      m_ring.reset();
+  }
+#endif
+}
+
+CPosixReadAhead::~CPosixReadAhead()
+{
+  // the buffers must outlive the reads
+  WaitAll();
+}
+
+void CPosixReadAhead::Submit(Chunk& chunk)
+{
+#if defined(HAVE_LINUX_IO_URING)
+  if (m_ring)
+  {
+    const size_t index = IndexOf(chunk);
+    chunk.state = ChunkState::PENDING;
+    if (m_ring->Submit(m_fd, chunk.offset, &m_iovecs[index], index))
+      return;
+
+    // read synchronously if the ring refuses the request
+    chunk.result = pread(m_fd, chunk.data.get(), m_chunkSize, chunk.offset);
+    if (chunk.result < 0)
+      chunk.result = -errno;
+    chunk.state = ChunkState::DONE;
+    return;
+  }
+#endif
+
+  CThreadPool::GetInstance().Submit(m_fd, chunk, m_chunkSize);
+}
+
+void CPosixReadAhead::Wait(Chunk& chunk)
+{
+#if defined(HAVE_LINUX_IO_URING)
+  if (m_ring)
+  {
+    while (chunk.state == ChunkState::PENDING)
+    {
+      const bool reaped = m_ring->Reap(true, [this](uint64_t index, int32_t result) {
+        Chunk& done = GetChunk(index);
+        done.result = result;
+        done.state = ChunkState::DONE;
+      });
+      if (!reaped)
+      {
+        // the ring is broken, read what is still pending here and use the threads from now on
+        for (size_t i = 0; i < GetDepth(); i++)
+        {
+          Chunk& pending = GetChunk(i);
+          if (pending.state != ChunkState::PENDING)
+            continue;
+          pending.result = pread(m_fd, pending.data.get(), m_chunkSize, pending.offset);
+          if (pending.result < 0)
+            pending.result = -errno;
+          pending.state = ChunkState::DONE;
+        }
+        m_ring.reset();
+      }
+    }
+    return;
+  }
+#endif
+
+  CThreadPool::GetInstance().Wait(chunk);
+}
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "filesystem/ReadAheadBuffer.h"
+
+#include <memory>
+#include <sys/uio.h>
+#include <vector>
+
+namespace XFILE
+{
+
+/*!
+ * \brief Read-ahead for local files
+ *
+ * Reads are issued with io_uring where the kernel supports it, otherwise by a
+ * pool of threads shared by all files.
+ */
+class CPosixReadAhead : public CReadAheadBuffer
+{
+public:
+  static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+  /*!
+   * \param fd The file to read, must support pread() and stay open while the
+   * object exists. The file offset of the descriptor is neither used nor
+   * changed.
+   * \param depth The number of chunks to keep in flight
+   * \param allowIoUring False to always use the thread pool
+   */
+  CPosixReadAhead(int fd, unsigned int depth, bool allowIoUring = true);
+  ~CPosixReadAhead() override;
+
+  bool UsesIoUring() const { return m_ring != nullptr; }
+
+protected:
+  // implementation of CReadAheadBuffer
+  void Submit(Chunk& chunk) override;
+  void Wait(Chunk& chunk) override;
+
+private:
+  class CIoUring;
+  class CThreadPool;
+
+  const int m_fd;
+  std::vector<struct iovec> m_iovecs;
+  std::unique_ptr<CIoUring> m_ring;
+};
+
+} // namespace XFILE
@@ -17,20 +17,27 @@
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "commons/Exception.h"
+#include "filesystem/ReadAheadBuffer.h"
 #include "filesystem/SpecialProtocol.h"
 #include "network/DNSNameCache.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/Condition.h"
+#include "threads/Thread.h"
 #include "utils/StringUtils.h"
 #include "utils/TimeUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cstring>
+#include <deque>
 #include <inttypes.h>
 #include <mutex>
 #include <regex>
+#include <unordered_map>
+#include <vector>
 
 #include <libsmbclient.h>
 
@@ -69,10 +76,20 @@ void xb_smbc_auth(const char *srv, const char *shr, char *wg, int wglen,
 // WTF is this ?, we get the original server cache only
 // to set the server cache to this function which call the
 // original one anyway. Seems quite silly.
-smbc_get_cached_srv_fn orig_cache;
+// The original function is kept per context, the readers ahead have contexts of their own.
+CCriticalSection origCacheSection;
+std::unordered_map<SMBCCTX*, smbc_get_cached_srv_fn> origCache;
 SMBCSRV* xb_smbc_cache(SMBCCTX* c, const char* server, const char* share, const char* workgroup, const char* username)
 {
-  return orig_cache(c, server, share, workgroup, username);
+  smbc_get_cached_srv_fn fn;
+  {
+    std::unique_lock<CCriticalSection> lock(origCacheSection);
+    const auto it = origCache.find(c);
+    if (it == origCache.end() || !it->second)
+      return nullptr;
+    fn = it->second;
+  }
+  return fn(c, server, share, workgroup, username);
 }
 
 bool CSMB::IsFirstInit = true;
@@ -97,7 +114,7 @@ void CSMB::Deinit()
   if (m_context)
   {
     smbc_set_context(NULL);
-    smbc_free_context(m_context, 1);
+    FreeContext(m_context);
     m_context = NULL;
   }
 }
@@ -187,6 +204,10 @@ void CSMB::Init()
     // 48 bytes -> smb_xmalloc_array
     // 32 bytes -> set_param_opt
     // 16 bytes -> set_param_opt
+#ifdef DEPRECATED_SMBC_INTERFACE
+    // the readers ahead use their own contexts on other threads
+    smbc_thread_posix();
+#endif
     smbc_init(xb_smbc_auth, 0);
 
     // setup our context
@@ -195,35 +216,7 @@ void CSMB::Init()
     // restore HOME
     setenv("HOME", truehome.c_str(), 1);
 
-#ifdef DEPRECATED_SMBC_INTERFACE
-    smbc_setDebug(m_context, CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
-    smbc_setLogCallback(m_context, this, xb_smbc_log);
-    smbc_setFunctionAuthData(m_context, xb_smbc_auth);
-    orig_cache = smbc_getFunctionGetCachedServer(m_context);
-    smbc_setFunctionGetCachedServer(m_context, xb_smbc_cache);
-    smbc_setOptionOneSharePerServer(m_context, false);
-    smbc_setOptionBrowseMaxLmbCount(m_context, 0);
-    smbc_setTimeout(m_context, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000);
-    // we do not need to strdup these, smbc_setXXX below will make their own copies
-    if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
-      //! @bug libsmbclient < 4.9 isn't const correct
-      smbc_setWorkgroup(m_context, const_cast<char*>(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str()));
-    std::string guest = "guest";
-    //! @bug libsmbclient < 4.8 isn't const correct
-    smbc_setUser(m_context, const_cast<char*>(guest.c_str()));
-#else
-    m_context->debug = (CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
-    m_context->callbacks.auth_fn = xb_smbc_auth;
-    orig_cache = m_context->callbacks.get_cached_srv_fn;
-    m_context->callbacks.get_cached_srv_fn = xb_smbc_cache;
-    m_context->options.one_share_per_server = false;
-    m_context->options.browse_max_lmb_count = 0;
-    m_context->timeout = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000;
-    // we need to strdup these, they will get free'd on smbc_free_context
-    if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
-      m_context->workgroup = strdup(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str());
-    m_context->user = strdup("guest");
-#endif
+    ConfigureContext(m_context);
 
     // initialize samba and do some hacking into the settings
     if (smbc_init_context(m_context))
@@ -244,13 +237,80 @@ void CSMB::Init()
     }
     else
     {
-      smbc_free_context(m_context, 1);
+      FreeContext(m_context);
       m_context = NULL;
     }
   }
   m_IdleTimeout = 180;
 }
 
+void CSMB::ConfigureContext(SMBCCTX* context)
+{
+  const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+
+#ifdef DEPRECATED_SMBC_INTERFACE
+  smbc_setDebug(context, CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
+  smbc_setLogCallback(context, nullptr, xb_smbc_log);
+  smbc_setFunctionAuthData(context, xb_smbc_auth);
+  {
+    std::unique_lock<CCriticalSection> lock(origCacheSection);
+    origCache[context] = smbc_getFunctionGetCachedServer(context);
+  }
+  smbc_setFunctionGetCachedServer(context, xb_smbc_cache);
+  smbc_setOptionOneSharePerServer(context, false);
+  smbc_setOptionBrowseMaxLmbCount(context, 0);
+  smbc_setTimeout(context, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000);
+  // we do not need to strdup these, smbc_setXXX below will make their own copies
+  if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
+    //! @bug libsmbclient < 4.9 isn't const correct
+    smbc_setWorkgroup(context, const_cast<char*>(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str()));
+  std::string guest = "guest";
+  //! @bug libsmbclient < 4.8 isn't const correct
+  smbc_setUser(context, const_cast<char*>(guest.c_str()));
+#else
+  context->debug = (CServiceBroker::GetLogging().CanLogComponent(LOGSAMBA) ? 10 : 0);
+  context->callbacks.auth_fn = xb_smbc_auth;
+  {
+    std::unique_lock<CCriticalSection> lock(origCacheSection);
+    origCache[context] = context->callbacks.get_cached_srv_fn;
+  }
+  context->callbacks.get_cached_srv_fn = xb_smbc_cache;
+  context->options.one_share_per_server = false;
+  context->options.browse_max_lmb_count = 0;
+  context->timeout = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_sambaclienttimeout * 1000;
+  // we need to strdup these, they will get free'd on smbc_free_context
+  if (settings->GetString(CSettings::SETTING_SMB_WORKGROUP).length() > 0)
+    context->workgroup = strdup(settings->GetString(CSettings::SETTING_SMB_WORKGROUP).c_str());
+  context->user = strdup("guest");
+#endif
+}
+
+SMBCCTX* CSMB::NewContext()
+{
+  // the configuration touches global state
+  std::unique_lock<CCriticalSection> lock(smb);
+
+  SMBCCTX* context = smbc_new_context();
+  if (!context)
+    return nullptr;
+
+  ConfigureContext(context);
+  if (!smbc_init_context(context))
+  {
+    FreeContext(context);
+    return nullptr;
+  }
+  return context;
+}
+
+void CSMB::FreeContext(SMBCCTX* context)
+{
+  smbc_free_context(context, 1);
+
+  std::unique_lock<CCriticalSection> lock(origCacheSection);
+  origCache.erase(context);
+}
+
 std::string CSMB::URLEncode(const CURL &url)
 {
   /* due to smb wanting encoded urls we have to build it manually */
@@ -359,6 +419,142 @@ CURL CSMB::GetResolvedUrl(const CURL& url)
 
 CSMB smb;
 
+namespace
+{
+// the reader ahead opens a connection of its own, only worth it for large files
+constexpr int64_t READ_AHEAD_MIN_FILE_SIZE = 32 * 1024 * 1024;
+} // unnamed namespace
+
+namespace XFILE
+{
+/*!
+ * \brief Read-ahead for SMB files
+ *
+ * libsmbclient has no asynchronous reads, so the chunks are read in order by
+ * a thread which opens the file on a context of its own, one read per round
+ * trip. It fills a buffer ahead of the player, it doesn't pipeline requests.
+ * One context per file keeps it to a single extra connection, it is
+ * independent of the shared one and doesn't need its lock.
+ */
+class CSMBReadAhead : public CReadAheadBuffer
+{
+public:
+  CSMBReadAhead(const std::string& path, size_t chunkSize, unsigned int depth)
+    : CReadAheadBuffer(chunkSize, depth), m_path(path), m_reader(*this)
+  {
+    m_reader.Create();
+  }
+
+  ~CSMBReadAhead() override
+  {
+    // the buffers must outlive the reads
+    WaitAll();
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      m_stop = true;
+    }
+    m_queued.notifyAll();
+    m_reader.StopThread(true);
+  }
+
+protected:
+  // implementation of CReadAheadBuffer
+  void Submit(Chunk& chunk) override
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      chunk.state = ChunkState::PENDING;
+      m_requests.push_back(&chunk);
+    }
+    m_queued.notify();
+  }
+
+  void Wait(Chunk& chunk) override
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_done.wait(lock, [&chunk] { return chunk.state != ChunkState::PENDING; });
+  }
+
+private:
+  class CReader : public CThread
+  {
+  public:
+    explicit CReader(CSMBReadAhead& owner) : CThread("SMBReadAhead"), m_owner(owner) {}
+
+  protected:
+    void Process() override
+    {
+      SMBCCTX* context = CSMB::NewContext();
+      SMBCFILE* file = nullptr;
+      if (context)
+        file = smbc_getFunctionOpen(context)(context, m_owner.m_path.c_str(), O_RDONLY, 0);
+      if (!file)
+        CLog::Log(LOGERROR, "CSMBReadAhead: Unable to open file ({})", strerror(errno));
+
+      m_owner.Run(context, file);
+
+      if (file)
+        smbc_getFunctionClose(context)(context, file);
+      if (context)
+        CSMB::FreeContext(context);
+    }
+
+  private:
+    CSMBReadAhead& m_owner;
+  };
+
+  void Run(SMBCCTX* context, SMBCFILE* file)
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    while (true)
+    {
+      m_queued.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+      if (m_stop)
+        return;
+
+      Chunk& chunk = *m_requests.front();
+      m_requests.pop_front();
+
+      lock.unlock();
+      const ssize_t result = file ? ReadChunk(context, file, chunk) : -EIO;
+      lock.lock();
+
+      chunk.result = result;
+      chunk.state = ChunkState::DONE;
+      m_done.notifyAll();
+    }
+  }
+
+  ssize_t ReadChunk(SMBCCTX* context, SMBCFILE* file, Chunk& chunk) const
+  {
+    if (smbc_getFunctionLseek(context)(context, file, chunk.offset, SEEK_SET) < 0)
+      return -errno;
+
+    // servers may return less than asked for, fill the chunk up to the end of the file
+    size_t total = 0;
+    while (total < m_chunkSize)
+    {
+      const ssize_t read =
+          smbc_getFunctionRead(context)(context, file, chunk.data.get() + total, m_chunkSize - total);
+      if (read < 0)
+        return total > 0 ? static_cast<ssize_t>(total) : -errno;
+      if (read == 0)
+        break;
+      total += read;
+    }
+    return static_cast<ssize_t>(total);
+  }
+
+  const std::string m_path;
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_queued;
+  XbmcThreads::ConditionVariable m_done;
+  std::deque<Chunk*> m_requests;
+  bool m_stop = false;
+  CReader m_reader;
+};
+} // namespace XFILE
+
 CSMBFile::CSMBFile()
 {
   smb.Init();
@@ -377,6 +573,8 @@ int64_t CSMBFile::GetPosition()
 {
   if (m_fd == -1)
     return -1;
+  if (m_readAhead)
+    return m_readAheadPos;
   std::unique_lock<CCriticalSection> lock(smb);
   if (!smb.IsSmbValid())
     return -1;
@@ -439,6 +637,7 @@ bool CSMBFile::Open(const CURL& url)
     m_fd = -1;
     return false;
   }
+  m_readAheadPos = 0;
   // We've successfully opened the file!
   return true;
 }
@@ -573,6 +772,21 @@ ssize_t CSMBFile::Read(void *lpBuf, size_t uiBufSize)
   if (uiBufSize == 0 && lpBuf == NULL)
     return 0;
 
+  if (m_readAhead)
+  {
+    smb.SetActivityTime();
+    const ssize_t bytesRead = m_readAhead->Read(m_readAheadPos, lpBuf, uiBufSize);
+    if (bytesRead >= 0)
+    {
+      m_readAheadPos += bytesRead;
+      return bytesRead;
+    }
+
+    CLog::Log(LOGERROR, "{} - Reading ahead failed ({}), continuing with single reads",
+              __FUNCTION__, strerror(errno));
+    SetReadAhead(false);
+  }
+
   std::unique_lock<CCriticalSection> lock(
       smb); // Init not called since it has to be "inited" by now
   if (!smb.IsSmbValid())
@@ -604,6 +818,13 @@ int64_t CSMBFile::Seek(int64_t iFilePosition, int iWhence)
   if (!smb.IsSmbValid())
     return -1;
   smb.SetActivityTime();
+
+  if (m_readAhead && iWhence == SEEK_CUR)
+  {
+    iFilePosition += m_readAheadPos;
+    iWhence = SEEK_SET;
+  }
+
   int64_t pos = smbc_lseek(m_fd, iFilePosition, iWhence);
 
   if ( pos < 0 )
@@ -612,11 +833,13 @@ int64_t CSMBFile::Seek(int64_t iFilePosition, int iWhence)
     return -1;
   }
 
+  m_readAheadPos = pos;
   return pos;
 }
 
 void CSMBFile::Close()
 {
+  m_readAhead.reset();
   if (m_fd != -1)
   {
     CLog::Log(LOGDEBUG, "CSMBFile::Close closing fd {}", m_fd);
@@ -739,9 +962,57 @@ int CSMBFile::IoControl(EIoControl request, void* param)
     return 0;
   }
 
+  if (request == IOCTRL_SET_READAHEAD)
+  {
+    if (!param)
+      return -1;
+    // the depth is configured per protocol, the request only turns it on or off
+    return SetReadAhead(*static_cast<unsigned int*>(param) > 0) ? 0 : -1;
+  }
+
   return -1;
 }
 
+bool CSMBFile::SetReadAhead(bool enable)
+{
+  if (m_fd == -1)
+    return false;
+
+  if (m_readAhead)
+  {
+    m_readAhead.reset();
+    // continue the plain reads where the reads ahead left off
+    std::unique_lock<CCriticalSection> lock(smb);
+    if (smb.IsSmbValid())
+      smbc_lseek(m_fd, m_readAheadPos, SEEK_SET);
+  }
+
+  if (!enable)
+    return true;
+
+  const auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const int depth = settings ? settings->GetInt(CSettings::SETTING_SMB_READAHEADBUFFER) : 0;
+  if (depth <= 0 || m_fileSize < READ_AHEAD_MIN_FILE_SIZE)
+    return false;
+
+  int64_t pos;
+  {
+    std::unique_lock<CCriticalSection> lock(smb);
+    if (!smb.IsSmbValid())
+      return false;
+    pos = smbc_lseek(m_fd, 0, SEEK_CUR);
+  }
+  if (pos < 0)
+    return false;
+
+  m_readAheadPos = pos;
+  m_readAhead =
+      std::make_unique<CSMBReadAhead>(GetAuthenticatedPath(m_url), GetChunkSize(), depth);
+  CLog::Log(LOGDEBUG, "CSMBFile: reading ahead {} chunks of {} bytes for {}", depth,
+            GetChunkSize(), m_url.GetRedacted());
+  return true;
+}
+
 int CSMBFile::GetChunkSize()
 {
   const auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
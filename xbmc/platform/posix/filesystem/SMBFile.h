@@ -19,6 +19,8 @@
 #include "filesystem/IFile.h"
 #include "threads/CriticalSection.h"
 
+#include <memory>
+
 #define NT_STATUS_CONNECTION_REFUSED long(0xC0000000 | 0x0236)
 #define NT_STATUS_INVALID_HANDLE long(0xC0000000 | 0x0008)
 #define NT_STATUS_ACCESS_DENIED long(0xC0000000 | 0x0022)
@@ -47,7 +49,19 @@ public:
   DWORD ConvertUnixToNT(int error);
   static CURL GetResolvedUrl(const CURL& url);
 
+  /*!
+   * \brief Create a context configured like the shared one, for use by a
+   * single thread without the lock
+   */
+  static SMBCCTX* NewContext();
+  /*!
+   * \brief Free a context created by NewContext()
+   */
+  static void FreeContext(SMBCCTX* context);
+
 private:
+  static void ConfigureContext(SMBCCTX* context);
+
   SMBCCTX *m_context;
   int m_OpenConnections;
   unsigned int m_IdleTimeout;
@@ -58,6 +72,8 @@ extern CSMB smb;
 
 namespace XFILE
 {
+class CSMBReadAhead;
+
 class CSMBFile : public IFile
 {
 public:
@@ -86,8 +102,12 @@ protected:
   CURL m_url;
   bool IsValidFile(const std::string& strFileName);
   std::string GetAuthenticatedPath(const CURL &url);
+  bool SetReadAhead(bool enable);
   int64_t m_fileSize;
   int m_fd;
   bool m_allowRetry;
+  std::unique_ptr<CSMBReadAhead> m_readAhead;
+  int64_t m_readAheadPos = 0; // the reads ahead don't move the offset of the file
+
 };
 }
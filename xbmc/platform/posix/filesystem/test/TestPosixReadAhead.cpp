@@ -0,0 +1,241 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "URL.h"
+#include "filesystem/File.h"
+#include "platform/posix/filesystem/PosixFile.h"
+#include "platform/posix/filesystem/PosixReadAhead.h"
+#include "test/TestUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr size_t FILE_SIZE = 32 * 1024 * 1024 + 12345;
+
+uint8_t PatternAt(int64_t position)
+{
+  return static_cast<uint8_t>(position * 7 + position / 4096);
+}
+
+::testing::AssertionResult MatchesPattern(const uint8_t* data, size_t size, int64_t position)
+{
+  for (size_t i = 0; i < size; i++)
+  {
+    if (data[i] != PatternAt(position + i))
+      return ::testing::AssertionFailure() << "mismatch at " << position + i;
+  }
+  return ::testing::AssertionSuccess();
+}
+
+class TestPosixReadAhead : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_file = XBMC_CREATETEMPFILE(".bin");
+    ASSERT_NE(nullptr, m_file);
+    Append(0, FILE_SIZE);
+    m_path = XBMC_TEMPFILEPATH(m_file);
+  }
+
+  void TearDown() override { XBMC_DELETETEMPFILE(m_file); }
+
+  void Append(int64_t position, size_t size)
+  {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++)
+      data[i] = PatternAt(position + i);
+    ASSERT_EQ(static_cast<ssize_t>(size), m_file->Write(data.data(), size));
+    m_file->Flush();
+  }
+
+  // drop the file from the page cache, so reads have to go to the disk
+  void DropCache() const
+  {
+    const int fd = open(m_path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+#if defined(HAVE_POSIX_FADVISE)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    close(fd);
+  }
+
+  CFile* m_file = nullptr;
+  std::string m_path;
+};
+} // namespace
+
+TEST_F(TestPosixReadAhead, Sequential)
+{
+  for (const bool ioUring : {true, false})
+  {
+    const int fd = open(m_path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    {
+      CPosixReadAhead readAhead(fd, 4, ioUring);
+
+      std::vector<uint8_t> buffer(100003);
+      int64_t position = 0;
+      ssize_t read;
+      while ((read = readAhead.Read(position, buffer.data(), buffer.size())) > 0)
+      {
+        ASSERT_TRUE(MatchesPattern(buffer.data(), read, position));
+        position += read;
+      }
+      EXPECT_EQ(0, read);
+      EXPECT_EQ(static_cast<int64_t>(FILE_SIZE), position);
+    }
+    close(fd);
+  }
+}
+
+TEST_F(TestPosixReadAhead, Seek)
+{
+  for (const bool ioUring : {true, false})
+  {
+    const int fd = open(m_path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    {
+      CPosixReadAhead readAhead(fd, 8, ioUring);
+
+      std::mt19937 random(42);
+      std::uniform_int_distribution<int64_t> positions(0, FILE_SIZE - 1);
+      std::uniform_int_distribution<int64_t> skips(0, 3 * CPosixReadAhead::CHUNK_SIZE);
+      std::vector<uint8_t> buffer(65536);
+      int64_t position = 0;
+      for (int i = 0; i < 500; i++)
+      {
+        // mostly short skips ahead within the window, sometimes a real seek
+        position = i % 10 == 0 ? positions(random) : position + skips(random);
+        const ssize_t read = readAhead.Read(position, buffer.data(), buffer.size());
+        const int64_t expected =
+            std::max<int64_t>(0, std::min<int64_t>(buffer.size(), FILE_SIZE - position));
+        ASSERT_EQ(expected, read) << "at " << position;
+        ASSERT_TRUE(MatchesPattern(buffer.data(), read, position));
+        if (read == 0)
+          position = 0;
+      }
+    }
+    close(fd);
+  }
+}
+
+TEST_F(TestPosixReadAhead, GrowingFile)
+{
+  const int fd = open(m_path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  {
+    CPosixReadAhead readAhead(fd, 4);
+
+    std::vector<uint8_t> buffer(1024 * 1024);
+    int64_t position = FILE_SIZE - 1000;
+    EXPECT_EQ(1000, readAhead.Read(position, buffer.data(), buffer.size()));
+    position += 1000;
+    EXPECT_EQ(0, readAhead.Read(position, buffer.data(), buffer.size()));
+
+    // a recording being written
+    Append(FILE_SIZE, 5000);
+    EXPECT_EQ(5000, readAhead.Read(position, buffer.data(), buffer.size()));
+    EXPECT_TRUE(MatchesPattern(buffer.data(), 5000, position));
+  }
+  close(fd);
+}
+
+TEST_F(TestPosixReadAhead, PosixFile)
+{
+  CPosixFile file;
+  ASSERT_TRUE(file.Open(CURL(m_path)));
+  unsigned int requests = 4;
+  ASSERT_EQ(0, file.IoControl(IOCTRL_SET_READAHEAD, &requests));
+
+  std::vector<uint8_t> buffer(10000);
+  ASSERT_EQ(10000, file.Read(buffer.data(), buffer.size()));
+  EXPECT_TRUE(MatchesPattern(buffer.data(), 10000, 0));
+  EXPECT_EQ(10000, file.GetPosition());
+
+  // the reads ahead don't move the offset of the descriptor
+  EXPECT_EQ(20000, file.Seek(10000, SEEK_CUR));
+  ASSERT_EQ(10000, file.Read(buffer.data(), buffer.size()));
+  EXPECT_TRUE(MatchesPattern(buffer.data(), 10000, 20000));
+
+  EXPECT_EQ(static_cast<int64_t>(FILE_SIZE) - 100, file.Seek(-100, SEEK_END));
+  EXPECT_EQ(100, file.Read(buffer.data(), buffer.size()));
+  EXPECT_TRUE(MatchesPattern(buffer.data(), 100, FILE_SIZE - 100));
+  EXPECT_EQ(0, file.Read(buffer.data(), buffer.size()));
+
+  // plain reads continue at the same position
+  EXPECT_EQ(5000, file.Seek(5000, SEEK_SET));
+  ASSERT_EQ(10000, file.Read(buffer.data(), buffer.size()));
+  requests = 0;
+  EXPECT_EQ(0, file.IoControl(IOCTRL_SET_READAHEAD, &requests));
+  ASSERT_EQ(10000, file.Read(buffer.data(), buffer.size()));
+  EXPECT_TRUE(MatchesPattern(buffer.data(), 10000, 15000));
+  EXPECT_EQ(25000, file.GetPosition());
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST_F(TestPosixReadAhead, DISABLED_Benchmark)
+{
+  // the size of a typical demuxer read
+  constexpr size_t READ_SIZE = 64 * 1024;
+  std::vector<uint8_t> buffer(READ_SIZE);
+
+  const int fd = open(m_path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+
+  const auto measure = [&](const std::string& name, auto&& readAt) {
+    DropCache();
+    const auto start = std::chrono::steady_clock::now();
+    int64_t position = 0;
+    ssize_t read;
+    while ((read = readAt(position, buffer.data(), READ_SIZE)) > 0)
+      position += read;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(static_cast<int64_t>(FILE_SIZE), position) << name;
+
+    std::cout << "[ PosixReadAhead ] " << name << ": "
+              << static_cast<int>(FILE_SIZE / elapsed.count() / (1024 * 1024)) << " MiB/s"
+              << std::endl;
+  };
+
+  measure("read()", [fd](int64_t position, void* data, size_t size) {
+    return pread(fd, data, size, position);
+  });
+
+  for (const bool ioUring : {true, false})
+  {
+    for (const unsigned int depth : {4u, 16u})
+    {
+      CPosixReadAhead readAhead(fd, depth, ioUring);
+      if (ioUring && !readAhead.UsesIoUring())
+        continue;
+
+      measure(std::string(ioUring ? "io_uring" : "threads") + ", " + std::to_string(depth) +
+                  " chunks",
+              [&readAhead](int64_t position, void* data, size_t size) {
+                return readAhead.Read(position, data, size);
+              });
+    }
+  }
+
+  close(fd);
+}
@@ -20,13 +20,19 @@
 #include "pvr/PVRPlaybackState.h"
 #include "pvr/addons/PVRClient.h"
 #include "pvr/addons/PVRClientUID.h"
+#include "pvr/addons/PVRConcurrentCalls.h"
 #include "pvr/guilib/PVRGUIProgressHandler.h"
+#include "pvr/providers/PVRProviders.h"
+#include "pvr/timers/PVRTimers.h"
 #include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -566,12 +572,67 @@ std::vector<std::pair<ADDON::AddonInstanceId, bool>> CPVRClients::GetInstanceIds
 // client API calls
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+/*!
+ * @brief What the clients pass back during concurrent calls, kept apart per client to be merged
+ * in the order of the client priorities once the calls returned. Shared with the calls running
+ * on jobs.
+ */
+template<typename T>
+class CPerClientData
+{
+public:
+  T& Get(const CPVRClient& client)
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    Entry& entry = m_data[client.GetID()];
+    entry.priority = client.GetPriority();
+    return entry.data;
+  }
+
+  /*!
+   * @brief Visit the data of the clients, the highest priority first. The failed clients are left
+   * out.
+   */
+  void ForEach(const std::vector<int>& failedClients, const std::function<void(const T&)>& function)
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    std::vector<const Entry*> entries;
+    for (const auto& entry : m_data)
+    {
+      if (std::find(failedClients.cbegin(), failedClients.cend(), entry.first) ==
+          failedClients.cend())
+        entries.emplace_back(&entry.second);
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) {
+      return a->priority > b->priority;
+    });
+
+    for (const Entry* entry : entries)
+      function(entry->data);
+  }
+
+private:
+  struct Entry
+  {
+    int priority = 0;
+    T data;
+  };
+
+  CCriticalSection m_critSection;
+  std::map<int, Entry> m_data;
+};
+} // unnamed namespace
+
 std::vector<SBackend> CPVRClients::GetBackendProperties() const
 {
-  std::vector<SBackend> backendProperties;
+  auto clientProperties = std::make_shared<CPerClientData<SBackend>>();
+  std::vector<int> failedClients;
 
   ForCreatedClients(
-      __FUNCTION__, [&backendProperties](const std::shared_ptr<const CPVRClient>& client) {
+      __FUNCTION__,
+      [clientProperties](const std::shared_ptr<const CPVRClient>& client) {
         SBackend properties;
 
         if (client->GetDriveSpace(properties.diskTotal, properties.diskUsed) == PVR_ERROR_NO_ERROR)
@@ -597,9 +658,15 @@ std::vector<SBackend> CPVRClients::GetBackendProperties() const
         properties.version = client->GetBackendVersion();
         properties.host = client->GetConnectionString();
 
-        backendProperties.emplace_back(properties);
+        clientProperties->Get(*client) = properties;
         return PVR_ERROR_NO_ERROR;
-      });
+      },
+      failedClients);
+
+  std::vector<SBackend> backendProperties;
+  clientProperties->ForEach(failedClients, [&backendProperties](const SBackend& properties) {
+    backendProperties.emplace_back(properties);
+  });
 
   return backendProperties;
 }
@@ -608,12 +675,23 @@ bool CPVRClients::GetTimers(const std::vector<std::shared_ptr<CPVRClient>>& clie
                             CPVRTimersContainer* timers,
                             std::vector<int>& failedClients) const
 {
-  return ForClients(
-             __FUNCTION__, clients,
-             [timers](const std::shared_ptr<const CPVRClient>& client) {
-               return client->GetTimers(timers);
-             },
-             failedClients) == PVR_ERROR_NO_ERROR;
+  auto clientTimers = std::make_shared<CPerClientData<CPVRTimersContainer>>();
+  const PVR_ERROR error = ForClients(
+      __FUNCTION__, clients,
+      [clientTimers](const std::shared_ptr<const CPVRClient>& client) {
+        return client->GetTimers(&clientTimers->Get(*client));
+      },
+      failedClients);
+
+  clientTimers->ForEach(failedClients, [timers](const CPVRTimersContainer& clientTimer) {
+    for (const auto& tagsAtStartTime : clientTimer.GetTags())
+    {
+      for (const auto& timer : tagsAtStartTime.second)
+        timers->UpdateFromClient(timer);
+    }
+  });
+
+  return error == PVR_ERROR_NO_ERROR;
 }
 
 PVR_ERROR CPVRClients::UpdateTimerTypes(const std::vector<std::shared_ptr<CPVRClient>>& clients,
@@ -653,7 +731,7 @@ PVR_ERROR CPVRClients::GetRecordings(const std::vector<std::shared_ptr<CPVRClien
       [recordings, deleted](const std::shared_ptr<const CPVRClient>& client) {
         return client->GetRecordings(recordings, deleted);
       },
-      failedClients);
+      failedClients, false /* the caller keeps the recordings locked */);
 }
 
 PVR_ERROR CPVRClients::DeleteAllRecordingsFromTrash()
@@ -682,24 +760,41 @@ PVR_ERROR CPVRClients::GetChannels(const std::vector<std::shared_ptr<CPVRClient>
                                    std::vector<std::shared_ptr<CPVRChannel>>& channels,
                                    std::vector<int>& failedClients) const
 {
-  return ForClients(
+  using Channels = std::vector<std::shared_ptr<CPVRChannel>>;
+  auto clientChannels = std::make_shared<CPerClientData<Channels>>();
+  const PVR_ERROR error = ForClients(
       __FUNCTION__, clients,
-      [bRadio, &channels](const std::shared_ptr<const CPVRClient>& client) {
-        return client->GetChannels(bRadio, channels);
+      [bRadio, clientChannels](const std::shared_ptr<const CPVRClient>& client) {
+        return client->GetChannels(bRadio, clientChannels->Get(*client));
       },
       failedClients);
+
+  clientChannels->ForEach(failedClients, [&channels](const Channels& clientChannel) {
+    channels.insert(channels.end(), clientChannel.cbegin(), clientChannel.cend());
+  });
+
+  return error;
 }
 
 PVR_ERROR CPVRClients::GetProviders(const std::vector<std::shared_ptr<CPVRClient>>& clients,
                                     CPVRProvidersContainer* providers,
                                     std::vector<int>& failedClients) const
 {
-  return ForClients(
+  auto clientProviders = std::make_shared<CPerClientData<CPVRProvidersContainer>>();
+  const PVR_ERROR error = ForClients(
       __FUNCTION__, clients,
-      [providers](const std::shared_ptr<const CPVRClient>& client) {
-        return client->GetProviders(*providers);
+      [clientProviders](const std::shared_ptr<const CPVRClient>& client) {
+        return client->GetProviders(clientProviders->Get(*client));
       },
       failedClients);
+
+  clientProviders->ForEach(failedClients,
+                           [providers](const CPVRProvidersContainer& clientProvider) {
+                             for (const auto& provider : clientProvider.GetProvidersList())
+                               providers->UpdateFromClient(provider);
+                           });
+
+  return error;
 }
 
 PVR_ERROR CPVRClients::GetChannelGroups(const std::vector<std::shared_ptr<CPVRClient>>& clients,
@@ -711,7 +806,7 @@ PVR_ERROR CPVRClients::GetChannelGroups(const std::vector<std::shared_ptr<CPVRCl
       [groups](const std::shared_ptr<const CPVRClient>& client) {
         return client->GetChannelGroups(groups);
       },
-      failedClients);
+      failedClients, false /* groups get their positions in the order they arrive */);
 }
 
 PVR_ERROR CPVRClients::GetChannelGroupMembers(
@@ -720,12 +815,20 @@ PVR_ERROR CPVRClients::GetChannelGroupMembers(
     std::vector<std::shared_ptr<CPVRChannelGroupMember>>& groupMembers,
     std::vector<int>& failedClients) const
 {
-  return ForClients(
+  using Members = std::vector<std::shared_ptr<CPVRChannelGroupMember>>;
+  auto clientMembers = std::make_shared<CPerClientData<Members>>();
+  const PVR_ERROR error = ForClients(
       __FUNCTION__, clients,
-      [group, &groupMembers](const std::shared_ptr<const CPVRClient>& client) {
-        return client->GetChannelGroupMembers(group, groupMembers);
+      [group, clientMembers](const std::shared_ptr<const CPVRClient>& client) {
+        return client->GetChannelGroupMembers(group, clientMembers->Get(*client));
       },
       failedClients);
+
+  clientMembers->ForEach(failedClients, [&groupMembers](const Members& clientMember) {
+    groupMembers.insert(groupMembers.end(), clientMember.cbegin(), clientMember.cend());
+  });
+
+  return error;
 }
 
 std::vector<std::shared_ptr<CPVRClient>> CPVRClients::GetClientsSupportingChannelScan() const
@@ -907,6 +1010,9 @@ void CPVRClients::ConnectionStateChange(CPVRClient* client,
 
 namespace
 {
+// a call taking longer is logged as slow, generous as a backend may take a while to list
+// thousands of channels or timers
+constexpr auto CLIENT_CALL_TIMEOUT = std::chrono::seconds(30);
 
 void LogClientWarning(const char* strFunctionName, const std::shared_ptr<const CPVRClient>& client)
 {
@@ -932,10 +1038,9 @@ PVR_ERROR CPVRClients::ForCreatedClients(const char* strFunctionName,
 
 PVR_ERROR CPVRClients::ForCreatedClients(const char* strFunctionName,
                                          const PVRClientFunction& function,
-                                         std::vector<int>& failedClients) const
+                                         std::vector<int>& failedClients,
+                                         bool bConcurrent /* = true */) const
 {
-  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
-
   CPVRClientMap clients;
   GetCallableClients(clients, failedClients);
 
@@ -950,39 +1055,21 @@ PVR_ERROR CPVRClients::ForCreatedClients(const char* strFunctionName,
     }
   }
 
-  for (const auto& clientEntry : clients)
-  {
-    //    CLog::LogFC(LOGDEBUG, LOGPVR, "Calling add-on function '{}' on client {}.", strFunctionName,
-    //                clientEntry.second->GetID());
-
-    PVR_ERROR currentError = function(clientEntry.second);
+  std::vector<std::shared_ptr<CPVRClient>> callableClients;
+  std::transform(clients.cbegin(), clients.cend(), std::back_inserter(callableClients),
+                 [](const auto& entry) { return entry.second; });
 
-    //    CLog::LogFC(LOGDEBUG, LOGPVR, "Called add-on function '{}' on client {}. return={}",
-    //                strFunctionName, clientEntry.second->GetID(), currentError);
-
-    if (currentError != PVR_ERROR_NO_ERROR && currentError != PVR_ERROR_NOT_IMPLEMENTED)
-    {
-      lastError = currentError;
-      failedClients.emplace_back(clientEntry.first);
-
-      CLog::LogFC(LOGDEBUG, LOGPVR,
-                  "Added client {} to failed clients list after call to "
-                  "function '{}‘ returned error {}.",
-                  clientEntry.second->GetID(), strFunctionName, currentError);
-    }
-  }
-  return lastError;
+  return CallClients(strFunctionName, callableClients, function, failedClients, bConcurrent);
 }
 
 PVR_ERROR CPVRClients::ForClients(const char* strFunctionName,
                                   const std::vector<std::shared_ptr<CPVRClient>>& clients,
                                   const PVRClientFunction& function,
-                                  std::vector<int>& failedClients) const
+                                  std::vector<int>& failedClients,
+                                  bool bConcurrent /* = true */) const
 {
   if (clients.empty())
-    return ForCreatedClients(strFunctionName, function, failedClients);
-
-  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
+    return ForCreatedClients(strFunctionName, function, failedClients, bConcurrent);
 
   failedClients.clear();
 
@@ -1002,33 +1089,47 @@ PVR_ERROR CPVRClients::ForClients(const char* strFunctionName,
     }
   }
 
+  std::vector<std::shared_ptr<CPVRClient>> callableClients;
   for (const auto& client : clients)
   {
     if (std::none_of(failedClients.cbegin(), failedClients.cend(),
                      [&client](int failedClientId) { return failedClientId == client->GetID(); }))
-    {
-      //      CLog::LogFC(LOGDEBUG, LOGPVR, "Calling add-on function '{}' on client {}.", strFunctionName,
-      //                  client->GetID());
+      callableClients.emplace_back(client);
+    else
+      LogClientWarning(strFunctionName, client);
+  }
 
-      PVR_ERROR currentError = function(client);
+  return CallClients(strFunctionName, callableClients, function, failedClients, bConcurrent);
+}
 
-      //      CLog::LogFC(LOGDEBUG, LOGPVR, "Called add-on function '{}' on client {}. return={}",
-      //                  strFunctionName, client->GetID(), currentError);
+PVR_ERROR CPVRClients::CallClients(const char* strFunctionName,
+                                   const std::vector<std::shared_ptr<CPVRClient>>& clients,
+                                   const PVRClientFunction& function,
+                                   std::vector<int>& failedClients,
+                                   bool bConcurrent) const
+{
+  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
 
-      if (currentError != PVR_ERROR_NO_ERROR && currentError != PVR_ERROR_NOT_IMPLEMENTED)
-      {
-        lastError = currentError;
-        failedClients.emplace_back(client->GetID());
+  CPVRConcurrentCalls calls(strFunctionName, m_clientCalls, bConcurrent, CLIENT_CALL_TIMEOUT);
+  // the function and the client are copied into the jobs
+  for (const auto& client : clients)
+  {
+    calls.Add(client->GetID(), client->GetPriority(),
+              [function, client] { return function(client); });
+  }
 
-        CLog::LogFC(LOGDEBUG, LOGPVR,
-                    "Added client {} to failed clients list after call to "
-                    "function '{}‘ returned error {}.",
-                    client->GetID(), strFunctionName, currentError);
-      }
-    }
-    else
+  // merge the results in client priority order, whichever client answered first
+  for (const auto& result : calls.Run())
+  {
+    if (result.error != PVR_ERROR_NO_ERROR && result.error != PVR_ERROR_NOT_IMPLEMENTED)
     {
-      LogClientWarning(strFunctionName, client);
+      lastError = result.error;
+      failedClients.emplace_back(result.clientId);
+
+      CLog::LogFC(LOGDEBUG, LOGPVR,
+                  "Added client {} to failed clients list after call to "
+                  "function '{}‘ returned error {}.",
+                  result.clientId, strFunctionName, result.error);
     }
   }
   return lastError;
@@ -11,6 +11,7 @@
 #include "addons/IAddonManagerCallback.h"
 #include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_general.h"
 #include "threads/CriticalSection.h"
+#include "utils/JobGroup.h"
 
 #include <functional>
 #include <map>
@@ -459,12 +460,14 @@ struct SBackend
      * @param clients The clients to wrap.
      * @param function The function to wrap. It has to have return type PVR_ERROR and must take a const reference to a std::shared_ptr<CPVRClient> as parameter.
      * @param failedClients Contains a list of the ids of clients for that the call failed, if any.
+     * @param bConcurrent True to call the clients at the same time, each on a job of its own. False to call them one after the other, e.g. when the function passes data to a container the caller keeps locked.
      * @return PVR_ERROR_NO_ERROR on success, any other PVR_ERROR_* value otherwise.
      */
     PVR_ERROR ForClients(const char* strFunctionName,
                          const std::vector<std::shared_ptr<CPVRClient>>& clients,
                          const PVRClientFunction& function,
-                         std::vector<int>& failedClients) const;
+                         std::vector<int>& failedClients,
+                         bool bConcurrent = true) const;
 
     /*!
      * @brief Wraps calls to all created clients in order to do common pre and post function invocation actions.
@@ -480,13 +483,33 @@ struct SBackend
      * @param strFunctionName The function name, for logging purposes.
      * @param function The function to wrap. It has to have return type PVR_ERROR and must take a const reference to a std::shared_ptr<CPVRClient> as parameter.
      * @param failedClients Contains a list of the ids of clients for that the call failed, if any.
+     * @param bConcurrent True to call the clients at the same time, see ForClients, false to call them one after the other.
      * @return PVR_ERROR_NO_ERROR on success, any other PVR_ERROR_* value otherwise.
      */
     PVR_ERROR ForCreatedClients(const char* strFunctionName,
                                 const PVRClientFunction& function,
-                                std::vector<int>& failedClients) const;
+                                std::vector<int>& failedClients,
+                                bool bConcurrent = true) const;
+
+    /*!
+     * @brief Call the given clients, several at once if requested, and collect the failed ones in client priority order.
+     * @param strFunctionName The function name, for logging purposes.
+     * @param clients The clients to call.
+     * @param function The function to call.
+     * @param failedClients The ids of clients for that the call failed are appended to this list.
+     * @param bConcurrent True to call the clients at the same time, false to call them one after the other.
+     * @return PVR_ERROR_NO_ERROR on success, the error of the last failed client otherwise.
+     */
+    PVR_ERROR CallClients(const char* strFunctionName,
+                          const std::vector<std::shared_ptr<CPVRClient>>& clients,
+                          const PVRClientFunction& function,
+                          std::vector<int>& failedClients,
+                          bool bConcurrent) const;
 
     mutable CCriticalSection m_critSection;
     CPVRClientMap m_clientMap;
+
+    //! runs the calls to the clients, one at a time per client across all calls of ForClients
+    mutable CJobGroup m_clientCalls{1};
   };
 }
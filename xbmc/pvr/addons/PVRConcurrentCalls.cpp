@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRConcurrentCalls.h"
+
+#include "utils/JobGroup.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+using namespace PVR;
+using namespace std::chrono_literals;
+
+CPVRConcurrentCalls::CPVRConcurrentCalls(const std::string& strFunctionName,
+                                         CJobGroup& jobs,
+                                         bool bConcurrent,
+                                         std::chrono::milliseconds timeout)
+  : m_jobs(jobs),
+    m_bConcurrent(bConcurrent),
+    m_state(std::make_shared<State>(strFunctionName, timeout))
+{
+}
+
+void CPVRConcurrentCalls::Add(int clientId, int priority, std::function<PVR_ERROR()> call)
+{
+  std::unique_lock<CCriticalSection> lock(m_state->critSection);
+  Call& added = m_state->calls.emplace_back();
+  added.function = std::move(call);
+  added.result.clientId = clientId;
+  added.result.priority = priority;
+}
+
+const std::vector<CPVRConcurrentCalls::Result>& CPVRConcurrentCalls::Run()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  if (m_bConcurrent && m_state->calls.size() > 1)
+  {
+    RunConcurrent();
+  }
+  else
+  {
+    // nothing to overlap, spare the jobs
+    for (size_t i = 0; i < m_state->calls.size(); i++)
+      RunCall(*m_state, i);
+  }
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_state->critSection);
+    m_results.clear();
+    for (const Call& call : m_state->calls)
+      m_results.emplace_back(call.result);
+  }
+  std::stable_sort(m_results.begin(), m_results.end(),
+                   [](const Result& a, const Result& b) { return a.priority > b.priority; });
+
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  for (const Result& result : m_results)
+  {
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Called add-on function '{}' on client {} in {} ms. return={}",
+                m_state->strFunctionName, result.clientId, result.duration.count(), result.error);
+  }
+  if (m_results.size() > 1)
+  {
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Called add-on function '{}' on {} clients in {:.0f} ms",
+                m_state->strFunctionName, m_results.size(), elapsed.count());
+  }
+
+  return m_results;
+}
+
+void CPVRConcurrentCalls::RunConcurrent()
+{
+  // a call queues behind the calls to its client still running, e.g. of an earlier batch
+  {
+    std::unique_lock<CCriticalSection> lock(m_state->critSection);
+    m_state->pending = m_state->calls.size();
+  }
+  for (size_t i = 0; i < m_state->calls.size(); i++)
+  {
+    m_jobs.Submit(std::to_string(m_state->calls[i].result.clientId),
+                  [state = m_state, i, finished = std::make_shared<CFinished>(m_state, i)] {
+                    RunCall(*state, i);
+                  });
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_state->critSection);
+  if (m_state->finishedCondition.wait(lock, m_state->timeout,
+                                      [this] { return m_state->pending == 0; }))
+    return;
+
+  // add-on calls can't be aborted, wait for them, a slow backend is not a failed one
+  for (const Call& call : m_state->calls)
+  {
+    if (!call.finished)
+      CLog::Log(LOGWARNING, "{}: Add-on call on client {} did not return within {} ms, waiting",
+                m_state->strFunctionName, call.result.clientId, m_state->timeout.count());
+  }
+  m_state->finishedCondition.wait(lock, [this] { return m_state->pending == 0; });
+}
+
+void CPVRConcurrentCalls::RunCall(State& state, size_t index)
+{
+  std::function<PVR_ERROR()> function;
+  {
+    std::unique_lock<CCriticalSection> lock(state.critSection);
+    function = state.calls[index].function;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const PVR_ERROR error = function();
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::unique_lock<CCriticalSection> lock(state.critSection);
+  Call& call = state.calls[index];
+  if (duration > state.timeout)
+  {
+    CLog::Log(LOGWARNING, "{}: Add-on call on client {} took {} ms", state.strFunctionName,
+              call.result.clientId, duration.count());
+  }
+
+  call.finished = true;
+  call.result.error = error;
+  call.result.duration = duration;
+}
+
+CPVRConcurrentCalls::CFinished::~CFinished()
+{
+  // a job cancelled, e.g. on shutdown, leaves its call failed
+  std::unique_lock<CCriticalSection> lock(m_state->critSection);
+  m_state->calls[m_index].finished = true;
+  m_state->pending--;
+  m_state->finishedCondition.notifyAll();
+}
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_general.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CJobGroup;
+
+namespace PVR
+{
+/*!
+ * @brief Calls several PVR clients at once, one call per client running at a time.
+ *
+ * A slow backend no longer holds up the calls to the other backends. The results are returned
+ * in the order of the client priorities, whichever call finishes first.
+ *
+ * The calls run on a job group shared by all batches and keyed by client, so the calls to a
+ * client run one after the other in the order they were made, also across batches. Add-on calls
+ * can't be aborted, Run() waits for every call of the batch. A call not returning within the
+ * timeout is only logged, a slow backend still gets its result in.
+ */
+class CPVRConcurrentCalls
+{
+public:
+  struct Result
+  {
+    int clientId = -1;
+    int priority = 0;
+    PVR_ERROR error = PVR_ERROR_FAILED;
+    std::chrono::milliseconds duration{0};
+  };
+
+  /*!
+   * @brief Create a batch of calls.
+   * @param strFunctionName The function called, for logging purposes.
+   * @param jobs The job group running the calls, one job per client at a time.
+   * @param bConcurrent True to call the clients at once on the job group, false to call them one
+   * after the other on the calling thread.
+   * @param timeout The time after which a call still running is logged as slow.
+   */
+  CPVRConcurrentCalls(const std::string& strFunctionName,
+                      CJobGroup& jobs,
+                      bool bConcurrent,
+                      std::chrono::milliseconds timeout);
+
+  /*!
+   * @brief Add a call to the batch.
+   * @param clientId The id of the client called.
+   * @param priority The priority of the client, see CPVRClient::GetPriority.
+   * @param call The call.
+   */
+  void Add(int clientId, int priority, std::function<PVR_ERROR()> call);
+
+  /*!
+   * @brief Run all calls added and wait for them.
+   * @return The results of the calls, the clients with the highest priority first and the order
+   * the calls were added in for the same priority.
+   */
+  const std::vector<Result>& Run();
+
+private:
+  CPVRConcurrentCalls(const CPVRConcurrentCalls&) = delete;
+  CPVRConcurrentCalls& operator=(const CPVRConcurrentCalls&) = delete;
+
+  struct Call
+  {
+    std::function<PVR_ERROR()> function;
+    Result result;
+    bool finished = false;
+  };
+
+  /*!
+   * @brief The calls, shared with the jobs running them.
+   */
+  struct State
+  {
+    State(const std::string& functionName, std::chrono::milliseconds callTimeout)
+      : strFunctionName(functionName), timeout(callTimeout)
+    {
+    }
+
+    const std::string strFunctionName;
+    const std::chrono::milliseconds timeout;
+    CCriticalSection critSection;
+    XbmcThreads::ConditionVariable finishedCondition;
+    std::vector<Call> calls;
+    size_t pending = 0;
+  };
+
+  /*!
+   * @brief Counts a call finished when its job is gone, whether it ran or was cancelled.
+   */
+  class CFinished
+  {
+  public:
+    CFinished(std::shared_ptr<State> state, size_t index)
+      : m_state(std::move(state)), m_index(index)
+    {
+    }
+    ~CFinished();
+
+  private:
+    CFinished(const CFinished&) = delete;
+    CFinished& operator=(const CFinished&) = delete;
+
+    const std::shared_ptr<State> m_state;
+    const size_t m_index;
+  };
+
+  static void RunCall(State& state, size_t index);
+
+  void RunConcurrent();
+
+  CJobGroup& m_jobs;
+  const bool m_bConcurrent;
+  const std::shared_ptr<State> m_state;
+  std::vector<Result> m_results;
+};
+} // namespace PVR
@@ -0,0 +1,222 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "pvr/addons/PVRConcurrentCalls.h"
+#include "test/MtTestUtils.h"
+#include "threads/Event.h"
+#include "utils/JobGroup.h"
+#include "utils/JobManager.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+using namespace ConditionPoll;
+using namespace std::chrono_literals;
+
+namespace
+{
+/*!
+ * @brief Lets the calls wait for each other, a call only returns once all of them are running.
+ */
+class CLatch
+{
+public:
+  explicit CLatch(int count) : m_count(count) {}
+
+  //! @return false if the others didn't arrive, i.e. the calls didn't overlap
+  bool ArriveAndWait()
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      if (--m_count == 0)
+        m_all.Set();
+    }
+    return m_all.Wait(10s);
+  }
+
+private:
+  CCriticalSection m_critSection;
+  int m_count;
+  CEvent m_all{true};
+};
+} // unnamed namespace
+
+class TestPVRConcurrentCalls : public testing::Test
+{
+protected:
+  TestPVRConcurrentCalls() { CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>()); }
+
+  ~TestPVRConcurrentCalls() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+};
+
+TEST_F(TestPVRConcurrentCalls, ResultsInPriorityOrder)
+{
+  // each call waits for the others, called one after the other the first would fail
+  auto latch = std::make_shared<CLatch>(3);
+  const auto call = [latch](PVR_ERROR error) {
+    return [latch, error] { return latch->ArriveAndWait() ? error : PVR_ERROR_FAILED; };
+  };
+
+  CJobGroup jobs(1);
+  CPVRConcurrentCalls calls("Test", jobs, true, 30s);
+  calls.Add(1, 0, call(PVR_ERROR_SERVER_ERROR));
+  calls.Add(2, 10, call(PVR_ERROR_NO_ERROR));
+  calls.Add(3, 0, call(PVR_ERROR_NOT_IMPLEMENTED));
+
+  const auto& results = calls.Run();
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ(2, results[0].clientId);
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, results[0].error);
+  EXPECT_EQ(1, results[1].clientId);
+  EXPECT_EQ(PVR_ERROR_SERVER_ERROR, results[1].error);
+  EXPECT_EQ(3, results[2].clientId);
+  EXPECT_EQ(PVR_ERROR_NOT_IMPLEMENTED, results[2].error);
+}
+
+TEST_F(TestPVRConcurrentCalls, OneCallPerClient)
+{
+  auto running = std::make_shared<std::atomic<int>>(0);
+  auto maxRunning = std::make_shared<std::atomic<int>>(0);
+  auto release = std::make_shared<CEvent>(true);
+
+  CJobGroup jobs(1);
+  CPVRConcurrentCalls calls("Test", jobs, true, 30s);
+  for (int i = 0; i < 3; i++)
+  {
+    calls.Add(1, 0, [running, maxRunning, release] {
+      const int now = ++*running;
+      int max = *maxRunning;
+      while (now > max && !maxRunning->compare_exchange_weak(max, now))
+        ;
+      release->Wait(10s);
+      --*running;
+      return PVR_ERROR_NO_ERROR;
+    });
+  }
+  // another client lets the calls go once the first call of client 1 is running
+  calls.Add(2, 0, [running, release] {
+    const bool started = poll([&running] { return *running > 0; });
+    release->Set();
+    return started ? PVR_ERROR_NO_ERROR : PVR_ERROR_FAILED;
+  });
+
+  const auto& results = calls.Run();
+  ASSERT_EQ(4u, results.size());
+  for (const auto& result : results)
+    EXPECT_EQ(PVR_ERROR_NO_ERROR, result.error);
+  EXPECT_EQ(1, *maxRunning);
+}
+
+TEST_F(TestPVRConcurrentCalls, WaitsForSlowClients)
+{
+  CJobGroup jobs(1);
+  CPVRConcurrentCalls calls("Test", jobs, true, 10ms);
+  calls.Add(1, 0, [] { return PVR_ERROR_NO_ERROR; });
+  calls.Add(2, 0, [] {
+    std::this_thread::sleep_for(100ms);
+    return PVR_ERROR_NO_ERROR;
+  });
+
+  // a call exceeding the timeout is only logged, the slow client doesn't count as failed
+  const auto& results = calls.Run();
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, results[0].error);
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, results[1].error);
+}
+
+TEST_F(TestPVRConcurrentCalls, OneCallPerClientAcrossBatches)
+{
+  CJobGroup jobs(1);
+  auto running = std::make_shared<std::atomic<int>>(0);
+  auto release = std::make_shared<CEvent>(true);
+
+  std::thread first([&jobs, running, release] {
+    CPVRConcurrentCalls calls("Test", jobs, true, 30s);
+    calls.Add(1, 0, [running, release] {
+      ++*running;
+      release->Wait(10s);
+      --*running;
+      return PVR_ERROR_NO_ERROR;
+    });
+    calls.Add(2, 0, [] { return PVR_ERROR_NO_ERROR; });
+    calls.Run();
+  });
+  const bool started = poll([&running] { return *running == 1; });
+  EXPECT_TRUE(started);
+
+  // the call to client 1 waits for the one of the first batch, the other client lets it go
+  CPVRConcurrentCalls second("Test", jobs, true, 30s);
+  second.Add(1, 0, [running] { return *running == 0 ? PVR_ERROR_NO_ERROR : PVR_ERROR_FAILED; });
+  second.Add(2, 0, [release] {
+    release->Set();
+    return PVR_ERROR_NO_ERROR;
+  });
+  if (!started)
+    release->Set();
+
+  const auto& results = second.Run();
+  first.join();
+  ASSERT_EQ(2u, results.size());
+  for (const auto& result : results)
+    EXPECT_EQ(PVR_ERROR_NO_ERROR, result.error);
+}
+
+TEST_F(TestPVRConcurrentCalls, OneAfterTheOther)
+{
+  const std::thread::id caller = std::this_thread::get_id();
+  int calls = 0;
+  const auto call = [&caller, &calls](int order, PVR_ERROR error) {
+    return [&caller, &calls, order, error] {
+      return caller == std::this_thread::get_id() && ++calls == order ? error : PVR_ERROR_FAILED;
+    };
+  };
+
+  // on the calling thread, in the order added, the results still in priority order
+  CJobGroup jobs(1);
+  CPVRConcurrentCalls sequential("Test", jobs, false, 30s);
+  sequential.Add(1, 0, call(1, PVR_ERROR_NO_ERROR));
+  sequential.Add(2, 5, call(2, PVR_ERROR_REJECTED));
+
+  const auto& results = sequential.Run();
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ(2, results[0].clientId);
+  EXPECT_EQ(PVR_ERROR_REJECTED, results[0].error);
+  EXPECT_EQ(1, results[1].clientId);
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, results[1].error);
+}
+
+TEST_F(TestPVRConcurrentCalls, Single)
+{
+  CJobGroup jobs(1);
+  CPVRConcurrentCalls calls("Test", jobs, true, 30s);
+  calls.Add(7, 0, [] { return PVR_ERROR_REJECTED; });
+
+  const auto& results = calls.Run();
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(7, results[0].clientId);
+  EXPECT_EQ(PVR_ERROR_REJECTED, results[0].error);
+}
+
+TEST_F(TestPVRConcurrentCalls, Empty)
+{
+  CJobGroup jobs(1);
+  CPVRConcurrentCalls calls("Test", jobs, true, 30s);
+  EXPECT_TRUE(calls.Run().empty());
+}
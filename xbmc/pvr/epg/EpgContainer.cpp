@@ -17,6 +17,7 @@
 #include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgUpdateJobs.h"
 #include "pvr/guilib/PVRGUIProgressHandler.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -25,6 +26,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -264,6 +266,8 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
 
   if (!changedEpgs.empty())
   {
+    const auto start = std::chrono::steady_clock::now();
+
     // Note: We must lock the db the whole time, otherwise races may occur.
     database->Lock();
 
@@ -283,7 +287,7 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
           CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committing {} queries in loop.",
                       queryCount);
           database->CommitDeleteQueries();
-          database->CommitInsertQueries();
+          database->CommitPersistQueries();
           CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: committed {} queries in loop.", queryCount);
         }
       }
@@ -294,10 +298,16 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
     if (bReturn)
     {
       database->CommitDeleteQueries();
-      database->CommitInsertQueries();
+      database->CommitPersistQueries();
     }
 
     database->Unlock();
+
+    CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: Persisted {} tables in {} ms",
+                changedEpgs.size(),
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
   }
 
   return bReturn;
@@ -733,7 +743,6 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
 
   std::vector<std::shared_ptr<CPVREpg>> invalidTables;
 
-  unsigned int iCounter = 0;
   const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
 
   m_critSection.lock();
@@ -745,38 +754,65 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
     progressHandler = std::make_unique<CPVRGUIProgressHandler>(
         g_localizeStrings.Get(19004)); // Loading programme guide
 
+  const auto updateStart = std::chrono::steady_clock::now();
+
+  CPVREpgUpdateJobs jobs;
   for (const auto& epgEntry : epgsToUpdate)
   {
-    if (InterruptUpdate())
-    {
-      bInterrupted = true;
-      break;
-    }
-
     const std::shared_ptr<CPVREpg> epg = epgEntry.second;
     if (!epg)
       continue;
 
-    if (progressHandler)
-      progressHandler->UpdateProgress(epg->GetChannelData()->ChannelName(), ++iCounter,
-                                      epgsToUpdate.size());
-
-    if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
-    {
-      iUpdatedTables++;
-    }
+    if (!bOnlyPending || epg->UpdatePending())
+      jobs.Add(epg);
     else if (!epg->IsValid())
-    {
       invalidTables.push_back(epg);
-    }
   }
 
+  const int iUpdateTime = m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60;
+  const int iPastDays = m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
+  const auto& results = jobs.Run(
+      [start, end, iUpdateTime, iPastDays, &database,
+       bOnlyPending](const std::shared_ptr<CPVREpg>& epg) {
+        return epg->Update(start, end, iUpdateTime, iPastDays, database, bOnlyPending);
+      },
+      [this, &progressHandler, &bInterrupted, &epgsToUpdate](
+          const std::shared_ptr<CPVREpg>& lastDone, size_t done) {
+        if (InterruptUpdate())
+        {
+          bInterrupted = true;
+          return false;
+        }
+
+        if (progressHandler && lastDone)
+          progressHandler->UpdateProgress(lastDone->GetChannelData()->ChannelName(),
+                                          static_cast<int>(done),
+                                          static_cast<int>(epgsToUpdate.size()));
+        return true;
+      });
+
+  std::chrono::milliseconds updateTime{0};
+  for (const auto& result : results)
+  {
+    if (!result.bDone)
+      continue;
+
+    updateTime += result.duration;
+
+    if (result.bUpdated)
+      iUpdatedTables++;
+    else if (!result.epg->IsValid())
+      invalidTables.push_back(result.epg);
+  }
+
+  CLog::LogFC(LOGDEBUG, LOGEPG,
+              "EPG Container: Updated {} of {} tables in {} ms, the updates took {} ms together",
+              iUpdatedTables, results.size(),
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - updateStart)
+                  .count(),
+              updateTime.count());
+
   progressHandler.reset();
 
   QueueDeleteEpgs(invalidTables);
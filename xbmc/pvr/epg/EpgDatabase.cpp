@@ -1201,6 +1201,54 @@ bool CPVREpgDatabase::QueueDeleteEpgTags(int iEpgId)
   return QueueDeleteQuery(strQuery);
 }
 
+std::string CPVREpgDatabase::GetPersistValues(const CPVREpgInfoTag& tag) const
+{
+  time_t iStartTime, iEndTime;
+  tag.StartAsUTC().GetAsTime(iStartTime);
+  tag.EndAsUTC().GetAsTime(iEndTime);
+
+  std::string sFirstAired;
+  if (tag.FirstAired().IsValid())
+    sFirstAired = tag.FirstAired().GetAsW3CDate();
+
+  // a new tag gets its id from the database
+  const int iBroadcastId = tag.DatabaseID();
+  const std::string strBroadcastId =
+      iBroadcastId < 0 ? "NULL" : StringUtils::Format("{}", iBroadcastId);
+
+  return PrepareSQL(
+      "(%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
+      "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, %s)",
+      tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
+      tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
+      tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
+      tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
+      tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
+      tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
+      tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
+      tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
+      tag.UniqueBroadcastID(), strBroadcastId.c_str());
+}
+
+namespace
+{
+const std::string PERSIST_TAGS_QUERY =
+    "REPLACE INTO epgtags (idEpg, iStartTime, "
+    "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
+    "sIMDBNumber, "
+    "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
+    "iSeriesId, "
+    "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
+    "iBroadcastUid, idBroadcast) "
+    "VALUES ";
+
+// a multi-row query takes rows until either limit is reached. SQLite bounds the length of a
+// statement (SQLITE_MAX_SQL_LENGTH, 1000000 bytes by default), not the rows of a VALUES clause,
+// and the plots make the length of a row vary a lot.
+constexpr size_t PERSIST_TAGS_ROWS_PER_QUERY = 200;
+constexpr size_t PERSIST_TAGS_QUERY_SIZE = 512 * 1024;
+} // unnamed namespace
+
 bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
 {
   if (tag.EpgID() <= 0)
@@ -1209,66 +1257,96 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
     return false;
   }
 
-  time_t iStartTime, iEndTime;
-  tag.StartAsUTC().GetAsTime(iStartTime);
-  tag.EndAsUTC().GetAsTime(iEndTime);
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return QueueInsertQuery(PERSIST_TAGS_QUERY + GetPersistValues(tag) + ";");
+}
 
-  std::string sFirstAired;
-  if (tag.FirstAired().IsValid())
-    sFirstAired = tag.FirstAired().GetAsW3CDate();
+bool CPVREpgDatabase::QueuePersistQuery(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  bool bReturn = true;
+  std::string strValues;
+  std::vector<size_t> rows;
 
-  int iBroadcastId = tag.DatabaseID();
-  std::string strQuery;
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto queueRows = [this, &bReturn, &strValues, &rows] {
+    // the rows are kept to write them one by one, should the query fail
+    if (QueueInsertQuery(PERSIST_TAGS_QUERY + strValues + ";"))
+      m_queuedRows[GetInsertQueriesCount() - 1] = rows;
+    else
+      bReturn = false;
+
+    strValues.clear();
+    rows.clear();
+  };
 
+  for (const auto& tag : tags)
+  {
+    if (tag->EpgID() <= 0)
+    {
+      CLog::LogF(LOGERROR, "Tag '{}' does not have a valid table", tag->Title());
+      bReturn = false;
+      continue;
+    }
+
+    const std::string strRow = GetPersistValues(*tag);
+    if (!rows.empty() && (rows.size() == PERSIST_TAGS_ROWS_PER_QUERY ||
+                          strValues.size() + strRow.size() > PERSIST_TAGS_QUERY_SIZE))
+      queueRows();
+
+    if (!rows.empty())
+      strValues += ", ";
+    strValues += strRow;
+    rows.emplace_back(strRow.size());
+  }
+
+  if (!rows.empty())
+    queueRows();
+
+  return bReturn;
+}
+
+bool CPVREpgDatabase::CommitPersistQueries()
+{
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
-  if (iBroadcastId < 0)
+  if (CommitInsertQueries())
   {
-    strQuery = PrepareSQL(
-        "REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
-        "sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
-        "iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
-        tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
-        tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
-        tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
-        tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
-        tag.UniqueBroadcastID());
+    m_queuedRows.clear();
+    return true;
   }
-  else
+
+  // the transaction was rolled back, the queries are still queued
+  const dbiplus::StringList queries = m_pDS2->get_insert_sql();
+  m_pDS2->clear_insert_sql();
+
+  CLog::LogF(LOGWARNING, "Failed to commit {} queries, writing them one by one", queries.size());
+
+  bool bReturn = true;
+  size_t iQuery = 0;
+
+  BeginTransaction();
+  for (const std::string& strQuery : queries)
   {
-    strQuery = PrepareSQL(
-        "REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
-        "sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
-        "iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid, idBroadcast) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
-        tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
-        tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
-        tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
-        tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
-        tag.UniqueBroadcastID(), iBroadcastId);
+    const auto rows = m_queuedRows.find(iQuery++);
+    if (rows == m_queuedRows.end())
+    {
+      bReturn &= ExecuteQuery(strQuery);
+      continue;
+    }
+
+    // the rows follow the query prefix, separated by ", "
+    size_t iPos = PERSIST_TAGS_QUERY.size();
+    for (size_t iLength : rows->second)
+    {
+      bReturn &= ExecuteQuery(PERSIST_TAGS_QUERY + strQuery.substr(iPos, iLength) + ";");
+      iPos += iLength + 2;
+    }
   }
+  bReturn &= CommitTransaction();
 
-  QueueInsertQuery(strQuery);
-  return true;
+  m_queuedRows.clear();
+  return bReturn;
 }
 
 int CPVREpgDatabase::GetLastEPGId() const
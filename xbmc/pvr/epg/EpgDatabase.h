@@ -11,7 +11,9 @@
 #include "dbwrappers/Database.h"
 #include "threads/CriticalSection.h"
 
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 class CDateTime;
@@ -297,6 +299,21 @@ namespace PVR
      */
     bool QueuePersistQuery(const CPVREpgInfoTag& tag);
 
+    /*!
+     * @brief Write the queries to persist the given EPG tags to db query queue, many tags per query.
+     * @param tags The tags to persist.
+     * @return True on success, false otherwise.
+     */
+    bool QueuePersistQuery(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
+
+    /*!
+     * @brief Commit the queued insert queries. Should the transaction fail, e.g. on a tag the
+     * database refuses, the queries are run again one by one and the tags queued together row by
+     * row, so one bad tag doesn't lose the tags queued with it.
+     * @return True if all queries and tags were written, false otherwise.
+     */
+    bool CommitPersistQueries();
+
     /*!
      * @return Last EPG id in the database
      */
@@ -376,6 +393,16 @@ namespace PVR
     std::shared_ptr<CPVREpgSearchFilter> CreateEpgSearchFilter(
         bool bRadio, const std::unique_ptr<dbiplus::Dataset>& pDS) const;
 
+    /*!
+     * @brief Get the values of the given tag for the query persisting it.
+     * @param tag The tag.
+     * @return The values, in parentheses.
+     */
+    std::string GetPersistValues(const CPVREpgInfoTag& tag) const;
+
     mutable CCriticalSection m_critSection;
+
+    //! the lengths of the rows of the queued multi-row queries, by position in the insert queue
+    std::map<size_t, std::vector<size_t>> m_queuedRows;
   };
 }
@@ -644,15 +644,20 @@ void CPVREpgTagsContainer::QueuePersistQuery()
 
     FixOverlappingEvents(m_changedTags);
 
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    tags.reserve(m_changedTags.size());
     for (const auto& tag : m_changedTags)
     {
       // remove any conflicting events from database before persisting the new event
       m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(
           m_iEpgID, tag.second->StartAsUTC() + ONE_SECOND, tag.second->EndAsUTC() - ONE_SECOND);
 
-      tag.second->QueuePersistQuery(m_database);
+      tags.emplace_back(tag.second);
     }
 
+    // the deletes are committed before the inserts, so the tags can go in a few queries
+    m_database->QueuePersistQuery(tags);
+
     Clear();
 
     m_database->Unlock();
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgUpdateJobs.h"
+
+#include "pvr/epg/Epg.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "utils/JobGroup.h"
+
+#include <mutex>
+#include <string>
+
+using namespace PVR;
+using namespace std::chrono_literals;
+
+namespace
+{
+// tables of a client updated at once, add-ons get one call at a time
+constexpr unsigned int EPG_UPDATE_JOBS_PER_CLIENT = 1;
+
+// how often a running update shows its progress and checks for being interrupted
+constexpr auto EPG_UPDATE_PROGRESS_INTERVAL = 100ms;
+} // unnamed namespace
+
+void CPVREpgUpdateJobs::Add(const std::shared_ptr<CPVREpg>& epg)
+{
+  Result& result = m_results.emplace_back();
+  result.epg = epg;
+}
+
+const std::vector<CPVREpgUpdateJobs::Result>& CPVREpgUpdateJobs::Run(
+    const std::function<bool(const std::shared_ptr<CPVREpg>& epg)>& update,
+    const std::function<bool(const std::shared_ptr<CPVREpg>& lastDone, size_t done)>& progress)
+{
+  CJobGroup jobs(EPG_UPDATE_JOBS_PER_CLIENT);
+  for (size_t i = 0; i < m_results.size(); i++)
+  {
+    jobs.Submit(std::to_string(m_results[i].epg->GetChannelData()->ClientId()),
+                [this, &update, i] {
+                  Result& result = m_results[i];
+                  const auto start = std::chrono::steady_clock::now();
+                  result.bUpdated = update(result.epg);
+                  result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start);
+
+                  std::unique_lock<CCriticalSection> lock(m_critSection);
+                  result.bDone = true;
+                  m_lastDone = result.epg;
+                });
+  }
+
+  const bool bFinished = jobs.Wait(EPG_UPDATE_PROGRESS_INTERVAL, [this, &jobs, &progress] {
+    std::shared_ptr<CPVREpg> lastDone;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      lastDone = m_lastDone;
+    }
+    return progress(lastDone, jobs.GetFinished());
+  });
+
+  if (!bFinished)
+  {
+    // running updates finish, the queued ones are dropped
+    jobs.Cancel();
+    jobs.Wait();
+  }
+
+  return m_results;
+}
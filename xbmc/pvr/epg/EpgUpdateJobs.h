@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace PVR
+{
+class CPVREpg;
+
+/*!
+ * @brief Updates EPG tables on jobs, one job per client running at a time, so the add-on calls
+ * of a slow backend don't hold up the tables of the others.
+ *
+ * Add-ons are not expected to handle several calls at once, the tables of a client are therefore
+ * updated one after the other.
+ */
+class CPVREpgUpdateJobs
+{
+public:
+  struct Result
+  {
+    std::shared_ptr<CPVREpg> epg;
+    bool bUpdated = false;
+    bool bDone = false; //!< false if the update was dropped before it started
+    std::chrono::milliseconds duration{0};
+  };
+
+  CPVREpgUpdateJobs() = default;
+
+  /*!
+   * @brief Add a table to update.
+   * @param epg The table.
+   */
+  void Add(const std::shared_ptr<CPVREpg>& epg);
+
+  /*!
+   * @brief Run the updates and wait for them.
+   * @param update The update of a table, returning whether the table was updated.
+   * @param progress Called regularly on the calling thread with the last table done and the
+   * number of tables done, return false to drop the updates not started yet.
+   * @return The results, in the order the tables were added.
+   */
+  const std::vector<Result>& Run(
+      const std::function<bool(const std::shared_ptr<CPVREpg>& epg)>& update,
+      const std::function<bool(const std::shared_ptr<CPVREpg>& lastDone, size_t done)>& progress);
+
+private:
+  CPVREpgUpdateJobs(const CPVREpgUpdateJobs&) = delete;
+  CPVREpgUpdateJobs& operator=(const CPVREpgUpdateJobs&) = delete;
+
+  std::vector<Result> m_results;
+
+  CCriticalSection m_critSection;
+  std::shared_ptr<CPVREpg> m_lastDone;
+};
+} // namespace PVR
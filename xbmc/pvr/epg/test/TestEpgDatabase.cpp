@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "settings/AdvancedSettings.h"
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+using namespace XFILE;
+
+namespace
+{
+constexpr int EPG_ID = 1;
+
+// more than two queries of PERSIST_TAGS_ROWS_PER_QUERY rows
+constexpr int TAGS = 450;
+
+const time_t FIRST_START = 1700000000;
+} // unnamed namespace
+
+class TestEpgDatabase : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_settings.type = "sqlite3";
+    m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    CFile::Delete(m_settings.host + "TestEpgDatabase.db");
+
+    ASSERT_TRUE(m_database.Connect("TestEpgDatabase", m_settings, true));
+  }
+
+  void TearDown() override
+  {
+    m_database.Close();
+    CFile::Delete(m_settings.host + "TestEpgDatabase.db");
+  }
+
+  //! hour long tags, one after the other
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> MakeTags(int iCount) const
+  {
+    const auto channelData = std::make_shared<CPVREpgChannelData>(1, 1);
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    for (int i = 0; i < iCount; i++)
+    {
+      const time_t start = FIRST_START + i * 3600;
+      tags.emplace_back(std::make_shared<CPVREpgInfoTag>(
+          channelData, EPG_ID, CDateTime(start), CDateTime(start + 3600), false));
+    }
+    return tags;
+  }
+
+  int GetTagsCount() const { return m_database.GetSingleValueInt("SELECT COUNT(*) FROM epgtags"); }
+
+  DatabaseSettings m_settings;
+  CPVREpgDatabase m_database;
+};
+
+TEST_F(TestEpgDatabase, PersistsTags)
+{
+  ASSERT_TRUE(m_database.QueuePersistQuery(MakeTags(TAGS)));
+  EXPECT_EQ(3u, m_database.GetInsertQueriesCount());
+
+  EXPECT_TRUE(m_database.CommitPersistQueries());
+  EXPECT_EQ(TAGS, GetTagsCount());
+}
+
+TEST_F(TestEpgDatabase, PersistsTagsOneByOneOnError)
+{
+  // the database refuses a tag in the second query
+  const time_t refused = FIRST_START + 300 * 3600;
+  ASSERT_TRUE(m_database.ExecuteQuery(
+      "CREATE TRIGGER refuse BEFORE INSERT ON epgtags WHEN new.iStartTime = " +
+      std::to_string(refused) + " BEGIN SELECT RAISE(ABORT, 'refused'); END"));
+
+  ASSERT_TRUE(m_database.QueuePersistQuery(MakeTags(TAGS)));
+  ASSERT_TRUE(m_database.QueuePersistLastEpgScanTimeQuery(EPG_ID, CDateTime(FIRST_START)));
+
+  // the other tags and queries are written regardless
+  EXPECT_FALSE(m_database.CommitPersistQueries());
+  EXPECT_EQ(TAGS - 1, GetTagsCount());
+  EXPECT_EQ(1, m_database.GetSingleValueInt("SELECT COUNT(*) FROM lastepgscan"));
+
+  // nothing failed is left in the queue, the tags replace the ones written
+  EXPECT_EQ(0u, m_database.GetInsertQueriesCount());
+  ASSERT_TRUE(m_database.ExecuteQuery("DROP TRIGGER refuse"));
+  ASSERT_TRUE(m_database.QueuePersistQuery(MakeTags(TAGS)));
+  EXPECT_TRUE(m_database.CommitPersistQueries());
+  EXPECT_EQ(TAGS, GetTagsCount());
+}
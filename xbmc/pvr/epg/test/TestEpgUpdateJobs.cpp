@@ -0,0 +1,168 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "pvr/epg/Epg.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "pvr/epg/EpgUpdateJobs.h"
+#include "test/MtTestUtils.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+using namespace ConditionPoll;
+using namespace std::chrono_literals;
+
+class TestEpgUpdateJobs : public testing::Test
+{
+protected:
+  TestEpgUpdateJobs() { CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>()); }
+
+  ~TestEpgUpdateJobs() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  //! a table of a channel of the given client, not backed by a database
+  std::shared_ptr<CPVREpg> MakeEpg(int iClientId)
+  {
+    const int iEpgId = ++m_iLastEpgId;
+    return std::make_shared<CPVREpg>(iEpgId, "Channel", "client",
+                                     std::make_shared<CPVREpgChannelData>(iClientId, iEpgId),
+                                     nullptr);
+  }
+
+private:
+  int m_iLastEpgId = 0;
+};
+
+TEST_F(TestEpgUpdateJobs, OneTablePerClient)
+{
+  CCriticalSection critSection;
+  std::map<int, int> running;
+  std::map<int, int> maxRunning;
+  CEvent started(true);
+
+  CPVREpgUpdateJobs jobs;
+  std::vector<std::shared_ptr<CPVREpg>> epgs;
+  for (int iClientId : {1, 1, 1, 2})
+  {
+    epgs.emplace_back(MakeEpg(iClientId));
+    jobs.Add(epgs.back());
+  }
+
+  const auto& results = jobs.Run(
+      [&](const std::shared_ptr<CPVREpg>& epg) {
+        const int iClientId = epg->GetChannelData()->ClientId();
+        {
+          std::unique_lock<CCriticalSection> lock(critSection);
+          maxRunning[iClientId] = std::max(maxRunning[iClientId], ++running[iClientId]);
+        }
+
+        // the tables of client 1 wait for client 2, the clients are updated side by side
+        bool bOverlapped = true;
+        if (iClientId == 2)
+          started.Set();
+        else
+          bOverlapped = started.Wait(10s);
+
+        std::unique_lock<CCriticalSection> lock(critSection);
+        running[iClientId]--;
+        return bOverlapped;
+      },
+      [](const std::shared_ptr<CPVREpg>& lastDone, size_t done) { return true; });
+
+  // in the order added, a client's add-on gets one call at a time
+  ASSERT_EQ(epgs.size(), results.size());
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    EXPECT_EQ(epgs[i], results[i].epg);
+    EXPECT_TRUE(results[i].bDone);
+    EXPECT_TRUE(results[i].bUpdated);
+  }
+  EXPECT_EQ(1, maxRunning[1]);
+  EXPECT_EQ(1, maxRunning[2]);
+}
+
+TEST_F(TestEpgUpdateJobs, Progress)
+{
+  std::atomic<bool> reported{false};
+  const std::shared_ptr<CPVREpg> slow = MakeEpg(1);
+  const std::shared_ptr<CPVREpg> fast = MakeEpg(2);
+
+  CPVREpgUpdateJobs jobs;
+  jobs.Add(slow);
+  jobs.Add(fast);
+
+  // the slow table waits for the fast one being reported done
+  const auto& results = jobs.Run(
+      [&slow, &reported](const std::shared_ptr<CPVREpg>& epg) {
+        return epg != slow || poll([&reported] { return reported.load(); });
+      },
+      [&fast, &reported](const std::shared_ptr<CPVREpg>& lastDone, size_t done) {
+        if (lastDone == fast && done == 1)
+          reported = true;
+        return true;
+      });
+
+  ASSERT_EQ(2u, results.size());
+  EXPECT_TRUE(results[0].bUpdated);
+  EXPECT_TRUE(results[1].bUpdated);
+}
+
+TEST_F(TestEpgUpdateJobs, Interrupt)
+{
+  CCriticalSection critSection;
+  std::set<std::shared_ptr<CPVREpg>> updated;
+  CEvent interrupted(true);
+
+  CPVREpgUpdateJobs jobs;
+  for (int i = 0; i < 3; i++)
+    jobs.Add(MakeEpg(1));
+
+  // the first table is running when the update is interrupted
+  const auto& results = jobs.Run(
+      [&](const std::shared_ptr<CPVREpg>& epg) {
+        interrupted.Wait(10s);
+        std::unique_lock<CCriticalSection> lock(critSection);
+        updated.insert(epg);
+        return true;
+      },
+      [&interrupted](const std::shared_ptr<CPVREpg>& lastDone, size_t done) {
+        interrupted.Set();
+        return false;
+      });
+
+  // the running update finished, the ones dropped are not done
+  ASSERT_EQ(3u, results.size());
+  EXPECT_TRUE(results[0].bDone);
+  for (const auto& result : results)
+  {
+    EXPECT_EQ(updated.find(result.epg) != updated.end(), result.bDone);
+    EXPECT_EQ(result.bDone, result.bUpdated);
+  }
+}
+
+TEST_F(TestEpgUpdateJobs, Empty)
+{
+  CPVREpgUpdateJobs jobs;
+  EXPECT_TRUE(jobs
+                  .Run([](const std::shared_ptr<CPVREpg>& epg) { return true; },
+                       [](const std::shared_ptr<CPVREpg>& lastDone, size_t done) { return true; })
+                  .empty());
+}
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RenderSystemNull.h"
+
+#include "guilib/GUITextureNull.h"
+
+bool CRenderSystemNull::InitRenderSystem()
+{
+  m_RenderRenderer = "null";
+  m_RenderVendor = "Team Kodi";
+  m_RenderVersion = "1.0";
+  m_RenderVersionMajor = 1;
+  m_RenderVersionMinor = 0;
+  m_maxTextureSize = 4096;
+
+  CGUITextureNull::Register();
+
+  m_bRenderCreated = true;
+  return true;
+}
+
+bool CRenderSystemNull::DestroyRenderSystem()
+{
+  m_bRenderCreated = false;
+  return true;
+}
+
+bool CRenderSystemNull::ResetRenderSystem(int width, int height)
+{
+  m_viewPort = CRect(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height));
+  return true;
+}
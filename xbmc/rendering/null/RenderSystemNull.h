@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "rendering/RenderSystem.h"
+
+/*!
+ \brief Render system without a GPU, nothing is drawn
+
+ BeginRender() fails, so the application skips rendering the GUI. Used by the
+ null window system for running playback on machines without a display.
+ */
+class CRenderSystemNull : public CRenderSystemBase
+{
+public:
+  CRenderSystemNull() = default;
+  ~CRenderSystemNull() override = default;
+
+  bool InitRenderSystem() override;
+  bool DestroyRenderSystem() override;
+  bool ResetRenderSystem(int width, int height) override;
+
+  bool BeginRender() override { return false; }
+  bool EndRender() override { return false; }
+  void PresentRender(bool rendered, bool videoLayer) override {}
+  bool ClearBuffers(UTILS::COLOR::Color color) override { return true; }
+  bool IsExtSupported(const char* extension) const override { return false; }
+
+  void SetViewPort(const CRect& viewPort) override { m_viewPort = viewPort; }
+  void GetViewPort(CRect& viewPort) override { viewPort = m_viewPort; }
+
+  void SetScissors(const CRect& rect) override {}
+  void ResetScissors() override {}
+
+  void CaptureStateBlock() override {}
+  void ApplyStateBlock() override {}
+
+  void SetCameraPosition(const CPoint& camera,
+                         int screenWidth,
+                         int screenHeight,
+                         float stereoFactor = 0.0f) override
+  {
+  }
+
+  void ShowSplash(const std::string& message) override {}
+
+protected:
+  CRect m_viewPort;
+};
@@ -181,6 +181,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int  m_videoFpsDetect;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    bool m_videoProbeCache = true;
+    int m_videoNullRenderer = 0; ///< 0 off, 1 don't draw the video, 2 also skip no late frames
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -188,6 +190,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_slideshowBlackBarCompensation;
     float m_slideshowZoomAmount;
     float m_slideshowPanAmount;
+    int m_slideshowPrefetchCount; ///< slides decoded ahead in each direction
+    int m_slideshowPrefetchMemory; ///< MB of decoded slides kept ahead
 
     int m_songInfoDuration;
     int m_logLevel;
@@ -256,6 +260,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iMusicLibraryDateAdded;
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
+    int m_iMusicLibraryCleanConnections; // existence checks per host when cleaning
     bool m_bMusicLibraryArtistSortOnUpdate;
     bool m_bMusicLibraryUseISODates;
     bool m_bMusicLibraryArtistNavigatesToSongs;
@@ -269,6 +274,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bVideoLibraryAllItemsOnBottom;
     int m_iVideoLibraryRecentlyAddedItems;
     bool m_bVideoLibraryCleanOnUpdate;
+    int m_iVideoLibraryCleanConnections; // existence checks per host when cleaning
     bool m_bVideoLibraryUseFastHash;
     bool m_bVideoLibraryImportWatchedState{true};
     bool m_bVideoLibraryImportResumePoint{true};
@@ -301,6 +307,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_curllowspeedtime;
     int m_curlretries;
     int m_curlKeepAliveInterval;    // seconds
+    int m_curlMaxHostConnections;   // 0 for no limit
     bool m_curlDisableIPV6;
     bool m_curlDisableHTTP2;
 
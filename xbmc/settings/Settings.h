@@ -364,6 +364,7 @@ public:
   static constexpr auto SETTING_SMB_MAXPROTOCOL = "smb.maxprotocol";
   static constexpr auto SETTING_SMB_LEGACYSECURITY = "smb.legacysecurity";
   static constexpr auto SETTING_SMB_CHUNKSIZE = "smb.chunksize";
+  static constexpr auto SETTING_SMB_READAHEADBUFFER = "smb.readaheadbuffer";
   static constexpr auto SETTING_SERVICES_WSDISCOVERY = "services.wsdiscovery";
   static constexpr auto SETTING_VIDEOSCREEN_MONITOR = "videoscreen.monitor";
   static constexpr auto SETTING_VIDEOSCREEN_SCREEN = "videoscreen.screen";
@@ -435,6 +436,7 @@ public:
   static constexpr auto SETTING_NETWORK_HTTPPROXYUSERNAME = "network.httpproxyusername";
   static constexpr auto SETTING_NETWORK_HTTPPROXYPASSWORD = "network.httpproxypassword";
   static constexpr auto SETTING_NETWORK_BANDWIDTH = "network.bandwidth";
+  static constexpr auto SETTING_NETWORK_HTTPSEGMENTS = "network.httpsegments";
   static constexpr auto SETTING_POWERMANAGEMENT_DISPLAYSOFF = "powermanagement.displaysoff";
   static constexpr auto SETTING_POWERMANAGEMENT_SHUTDOWNTIME = "powermanagement.shutdowntime";
   static constexpr auto SETTING_POWERMANAGEMENT_SHUTDOWNSTATE = "powermanagement.shutdownstate";
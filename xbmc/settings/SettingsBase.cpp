@@ -11,6 +11,7 @@
 #include "settings/SettingUtils.h"
 #include "settings/SettingsValueXmlSerializer.h"
 #include "settings/lib/Setting.h"
+#include "settings/lib/SettingHandle.h"
 #include "settings/lib/SettingsManager.h"
 #include "utils/Variant.h"
 #include "utils/XBMCTinyXML.h"
@@ -220,6 +221,21 @@ double CSettingsBase::GetNumber(const std::string& id) const
   return m_settingsManager->GetNumber(id);
 }
 
+CSettingBoolHandle CSettingsBase::GetBoolHandle(const std::string& id) const
+{
+  return m_settingsManager->GetBoolHandle(id);
+}
+
+CSettingIntHandle CSettingsBase::GetIntHandle(const std::string& id) const
+{
+  return m_settingsManager->GetIntHandle(id);
+}
+
+CSettingNumberHandle CSettingsBase::GetNumberHandle(const std::string& id) const
+{
+  return m_settingsManager->GetNumberHandle(id);
+}
+
 bool CSettingsBase::SetNumber(const std::string& id, double value)
 {
   return m_settingsManager->SetNumber(id, value);
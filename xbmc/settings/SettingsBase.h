@@ -16,12 +16,18 @@
 #include <vector>
 
 class CSetting;
+class CSettingBool;
+class CSettingInt;
+class CSettingNumber;
 class CSettingSection;
 class CSettingsManager;
 class CVariant;
 class CXBMCTinyXML;
 class TiXmlElement;
 
+template<typename TSetting>
+class CSettingHandle;
+
 /*!
  \brief Basic wrapper around CSettingsManager providing the framework for
  properly setting up the settings manager and registering all the callbacks,
@@ -156,6 +162,31 @@ public:
    */
   std::vector<CVariant> GetList(const std::string& id) const;
 
+  /*!
+   \brief Gets a handle to the boolean setting with the given identifier.
+
+   Reading the value through the handle doesn't need a lookup or lock, so
+   code on hot paths should resolve the handle once and keep it.
+
+   \param id Setting identifier
+   \return Handle to the setting, invalid if there's no boolean setting with the given identifier
+   */
+  CSettingHandle<CSettingBool> GetBoolHandle(const std::string& id) const;
+  /*!
+   \brief Gets a handle to the integer setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle to the setting, invalid if there's no integer setting with the given identifier
+   */
+  CSettingHandle<CSettingInt> GetIntHandle(const std::string& id) const;
+  /*!
+   \brief Gets a handle to the real number setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle to the setting, invalid if there's no real number setting with the given identifier
+   */
+  CSettingHandle<CSettingNumber> GetNumberHandle(const std::string& id) const;
+
   /*!
    \brief Sets the boolean value of the setting with the given identifier.
 
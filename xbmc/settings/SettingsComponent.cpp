@@ -397,4 +397,6 @@ void CSettingsComponent::CreateUserDirs() const
       CLog::Log(LOGWARNING, "Failed to remove the archive cache at {}", archiveCachePath);
   XFILE::CDirectory::Create(archiveCachePath);
 
+  // unlike the archive cache, probe results stay valid across restarts
+  XFILE::CDirectory::Create("special://temp/probecache/");
 }
@@ -676,7 +676,7 @@ CSettingBool::CSettingBool(const std::string& id,
                            int label,
                            bool value,
                            CSettingsManager* settingsManager /* = nullptr */)
-  : CTraitedSetting(id, settingsManager), m_value(value), m_default(value)
+  : CTraitedSetting(id, settingsManager), m_value(value), m_default(value), m_published(value)
 {
   SetLabel(label);
 
@@ -698,7 +698,10 @@ void CSettingBool::MergeDetails(const CSetting& other)
   if (m_default == false && boolSetting.m_default == true)
     m_default = boolSetting.m_default;
   if (m_value == m_default && boolSetting.m_value != m_default)
+  {
     m_value = boolSetting.m_value;
+    publish();
+  }
 }
 
 bool CSettingBool::Deserialize(const TiXmlNode *node, bool update /* = false */)
@@ -711,7 +714,10 @@ bool CSettingBool::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   bool value;
   if (XMLUtils::GetBoolean(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    publish();
+  }
   else if (!update)
   {
     s_logger->error("error reading the default value of \"{}\"", m_id);
@@ -770,6 +776,7 @@ bool CSettingBool::SetValue(bool value)
   }
 
   m_changed = m_value != m_default;
+  publish();
   OnSettingChanged(shared_from_base<CSettingBool>());
   return true;
 }
@@ -780,7 +787,10 @@ void CSettingBool::SetDefault(bool value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    publish();
+  }
 }
 
 void CSettingBool::copy(const CSettingBool &setting)
@@ -789,6 +799,7 @@ void CSettingBool::copy(const CSettingBool &setting)
 
   m_value = setting.m_value;
   m_default = setting.m_default;
+  publish();
 }
 
 bool CSettingBool::fromString(const std::string &strValue, bool &value) const
@@ -838,6 +849,7 @@ CSettingInt::CSettingInt(const std::string& id,
   : CTraitedSetting(id, settingsManager),
     m_value(value),
     m_default(value),
+    m_published(value),
     m_min(minimum),
     m_step(step),
     m_max(maximum)
@@ -872,7 +884,10 @@ void CSettingInt::MergeDetails(const CSetting& other)
   if (m_default == 0.0 && intSetting.m_default != 0.0)
     m_default = intSetting.m_default;
   if (m_value == m_default && intSetting.m_value != m_default)
+  {
     m_value = intSetting.m_value;
+    publish();
+  }
   if (m_min == 0.0 && intSetting.m_min != 0.0)
     m_min = intSetting.m_min;
   if (m_step == 1.0 && intSetting.m_step != 1.0)
@@ -906,7 +921,10 @@ bool CSettingInt::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   int value;
   if (XMLUtils::GetInt(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    publish();
+  }
   else if (!update)
   {
     s_logger->error("error reading the default value of \"{}\"", m_id);
@@ -1050,6 +1068,7 @@ bool CSettingInt::SetValue(int value)
   }
 
   m_changed = m_value != m_default;
+  publish();
   OnSettingChanged(shared_from_base<CSettingInt>());
   return true;
 }
@@ -1060,7 +1079,10 @@ void CSettingInt::SetDefault(int value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    publish();
+  }
 }
 
 SettingOptionsType CSettingInt::GetOptionsType() const
@@ -1131,6 +1153,7 @@ void CSettingInt::copy(const CSettingInt &setting)
 
   m_value = setting.m_value;
   m_default = setting.m_default;
+  publish();
   m_min = setting.m_min;
   m_step = setting.m_step;
   m_max = setting.m_max;
@@ -1186,6 +1209,7 @@ CSettingNumber::CSettingNumber(const std::string& id,
   : CTraitedSetting(id, settingsManager),
     m_value(static_cast<double>(value)),
     m_default(static_cast<double>(value)),
+    m_published(static_cast<double>(value)),
     m_min(static_cast<double>(minimum)),
     m_step(static_cast<double>(step)),
     m_max(static_cast<double>(maximum))
@@ -1210,7 +1234,10 @@ void CSettingNumber::MergeDetails(const CSetting& other)
   if (m_default == 0.0 && numberSetting.m_default != 0.0)
     m_default = numberSetting.m_default;
   if (m_value == m_default && numberSetting.m_value != m_default)
+  {
     m_value = numberSetting.m_value;
+    publish();
+  }
   if (m_min == 0.0 && numberSetting.m_min != 0.0)
     m_min = numberSetting.m_min;
   if (m_step == 1.0 && numberSetting.m_step != 1.0)
@@ -1229,7 +1256,10 @@ bool CSettingNumber::Deserialize(const TiXmlNode *node, bool update /* = false *
   // get the default value
   double value;
   if (XMLUtils::GetDouble(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    publish();
+  }
   else if (!update)
   {
     s_logger->error("error reading the default value of \"{}\"", m_id);
@@ -1319,6 +1349,7 @@ bool CSettingNumber::SetValue(double value)
   }
 
   m_changed = m_value != m_default;
+  publish();
   OnSettingChanged(shared_from_base<CSettingNumber>());
   return true;
 }
@@ -1329,7 +1360,10 @@ void CSettingNumber::SetDefault(double value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    publish();
+  }
 }
 
 void CSettingNumber::copy(const CSettingNumber &setting)
@@ -1339,6 +1373,7 @@ void CSettingNumber::copy(const CSettingNumber &setting)
 
   m_value = setting.m_value;
   m_default = setting.m_default;
+  publish();
   m_min = setting.m_min;
   m_step = setting.m_step;
   m_max = setting.m_max;
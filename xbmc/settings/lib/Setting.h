@@ -19,6 +19,7 @@
 #include "threads/SharedSection.h"
 #include "utils/logtypes.h"
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <shared_mutex>
@@ -250,6 +251,13 @@ public:
     std::shared_lock<CSharedSection> lock(m_critical);
     return m_value;
   }
+  /*!
+   \brief Gets the value without locking.
+
+   The value is published once it has been accepted by all OnSettingChanging()
+   callbacks, so it's meant for readers on hot paths through a setting handle.
+   */
+  bool GetPublishedValue() const { return m_published.load(std::memory_order_acquire); }
   bool SetValue(bool value);
   bool GetDefault() const { return m_default; }
   void SetDefault(bool value);
@@ -258,10 +266,12 @@ private:
   static constexpr Value DefaultValue = false;
 
   void copy(const CSettingBool &setting);
+  void publish() { m_published.store(m_value, std::memory_order_release); }
   bool fromString(const std::string &strValue, bool &value) const;
 
   bool m_value = DefaultValue;
   bool m_default = DefaultValue;
+  std::atomic<bool> m_published{DefaultValue};
 
   static Logger s_logger;
 };
@@ -298,6 +308,8 @@ public:
     std::shared_lock<CSharedSection> lock(m_critical);
     return m_value;
   }
+  //! \copydoc CSettingBool::GetPublishedValue()
+  int GetPublishedValue() const { return m_published.load(std::memory_order_acquire); }
   bool SetValue(int value);
   int GetDefault() const { return m_default; }
   void SetDefault(int value);
@@ -337,10 +349,12 @@ private:
   static constexpr Value DefaultMax = DefaultValue;
 
   void copy(const CSettingInt &setting);
+  void publish() { m_published.store(m_value, std::memory_order_release); }
   static bool fromString(const std::string &strValue, int &value);
 
   int m_value = DefaultValue;
   int m_default = DefaultValue;
+  std::atomic<int> m_published{DefaultValue};
   int m_min = DefaultMin;
   int m_step = DefaultStep;
   int m_max = DefaultMax;
@@ -386,6 +400,8 @@ public:
     std::shared_lock<CSharedSection> lock(m_critical);
     return m_value;
   }
+  //! \copydoc CSettingBool::GetPublishedValue()
+  double GetPublishedValue() const { return m_published.load(std::memory_order_acquire); }
   bool SetValue(double value);
   double GetDefault() const { return m_default; }
   void SetDefault(double value);
@@ -404,10 +420,12 @@ private:
   static constexpr Value DefaultMax = DefaultValue;
 
   virtual void copy(const CSettingNumber &setting);
+  void publish() { m_published.store(m_value, std::memory_order_release); }
   static bool fromString(const std::string &strValue, double &value);
 
   double m_value = DefaultValue;
   double m_default = DefaultValue;
+  std::atomic<double> m_published{DefaultValue};
   double m_min = DefaultMin;
   double m_step = DefaultStep;
   double m_max = DefaultMax;
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "Setting.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+/*!
+ \ingroup settings
+ \brief Typed handle to a setting resolved once by its identifier.
+
+ Reading the value through the handle doesn't look up the setting or take any
+ lock, which makes it suitable for code running every frame or every packet.
+ The handle sees a new value once it has passed all OnSettingChanging()
+ callbacks, i.e. before OnSettingChanged() callbacks are invoked.
+
+ The handle keeps the setting alive. After the settings have been unloaded it
+ keeps returning the last value, so it should be resolved again when the
+ settings are reloaded.
+ */
+template<typename TSetting>
+class CSettingHandle
+{
+public:
+  using Value = typename TSetting::Value;
+
+  CSettingHandle() = default;
+  explicit CSettingHandle(std::shared_ptr<const TSetting> setting) : m_setting(std::move(setting))
+  {
+  }
+
+  bool IsValid() const { return m_setting != nullptr; }
+  explicit operator bool() const { return IsValid(); }
+
+  /*!
+   \brief Gets the current value of the setting.
+
+   \return Value of the setting or the default value of the type if the handle is invalid
+   */
+  Value Get() const { return m_setting ? m_setting->GetPublishedValue() : Value(); }
+
+  const std::string& GetId() const
+  {
+    static const std::string empty;
+    return m_setting ? m_setting->GetId() : empty;
+  }
+
+private:
+  std::shared_ptr<const TSetting> m_setting;
+};
+
+using CSettingBoolHandle = CSettingHandle<CSettingBool>;
+using CSettingIntHandle = CSettingHandle<CSettingInt>;
+using CSettingNumberHandle = CSettingHandle<CSettingNumber>;
@@ -53,6 +53,18 @@ bool ParseSettingIdentifier(const std::string& settingId, std::string& categoryT
   return true;
 }
 
+namespace
+{
+template<typename TSetting>
+CSettingHandle<TSetting> MakeHandle(const SettingPtr& setting)
+{
+  if (setting == nullptr || setting->GetType() != TSetting::Type())
+    return {};
+
+  return CSettingHandle<TSetting>(std::static_pointer_cast<const TSetting>(setting));
+}
+} // namespace
+
 CSettingsManager::CSettingsManager()
   : m_logger(CServiceBroker::GetLogging().GetLogger("CSettingsManager"))
 {
@@ -650,6 +662,24 @@ bool CSettingsManager::SetNumber(const std::string &id, double value)
   return std::static_pointer_cast<CSettingNumber>(setting)->SetValue(value);
 }
 
+CSettingBoolHandle CSettingsManager::GetBoolHandle(const std::string &id) const
+{
+  std::shared_lock<CSharedSection> lock(m_settingsCritical);
+  return MakeHandle<CSettingBool>(GetSetting(id));
+}
+
+CSettingIntHandle CSettingsManager::GetIntHandle(const std::string &id) const
+{
+  std::shared_lock<CSharedSection> lock(m_settingsCritical);
+  return MakeHandle<CSettingInt>(GetSetting(id));
+}
+
+CSettingNumberHandle CSettingsManager::GetNumberHandle(const std::string &id) const
+{
+  std::shared_lock<CSharedSection> lock(m_settingsCritical);
+  return MakeHandle<CSettingNumber>(GetSetting(id));
+}
+
 std::string CSettingsManager::GetString(const std::string &id) const
 {
   std::shared_lock<CSharedSection> lock(m_settingsCritical);
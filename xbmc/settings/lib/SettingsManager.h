@@ -17,6 +17,7 @@
 #include "SettingConditions.h"
 #include "SettingDefinitions.h"
 #include "SettingDependency.h"
+#include "SettingHandle.h"
 #include "threads/SharedSection.h"
 #include "utils/logtypes.h"
 
@@ -358,6 +359,30 @@ public:
    */
   std::vector< std::shared_ptr<CSetting> > GetList(const std::string &id) const;
 
+  /*!
+   \brief Gets a handle to the boolean setting with the given identifier.
+
+   Reading the value through the handle doesn't need a lookup or lock.
+
+   \param id Setting identifier
+   \return Handle to the setting, invalid if there's no boolean setting with the given identifier
+   */
+  CSettingBoolHandle GetBoolHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle to the integer setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle to the setting, invalid if there's no integer setting with the given identifier
+   */
+  CSettingIntHandle GetIntHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle to the real number setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle to the setting, invalid if there's no real number setting with the given identifier
+   */
+  CSettingNumberHandle GetNumberHandle(const std::string &id) const;
+
   /*!
    \brief Sets the boolean value of the setting with the given identifier.
 
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
+#include "settings/lib/SettingHandle.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr int READERS = 4;
+constexpr int READS = 1000000;
+
+// runs the reader on several threads while the setting keeps changing
+std::chrono::milliseconds RunReaders(const std::function<bool()>& read,
+                                     int& failures,
+                                     int reads = READS)
+{
+  auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const int original = settings->GetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  settings->SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, 0);
+
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    int value = 0;
+    while (!stop)
+    {
+      settings->SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, value);
+      value = (value + 10) % 30;
+      std::this_thread::yield();
+    }
+  });
+
+  std::atomic<int> errors{0};
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> readers;
+  for (int i = 0; i < READERS; i++)
+  {
+    readers.emplace_back([&] {
+      for (int j = 0; j < reads; j++)
+      {
+        if (!read())
+          errors++;
+      }
+    });
+  }
+  for (auto& reader : readers)
+    reader.join();
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  stop = true;
+  writer.join();
+  settings->SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, original);
+
+  failures = errors;
+  return duration;
+}
+
+bool IsWrittenValue(int value)
+{
+  return value == 0 || value == 10 || value == 20;
+}
+} // namespace
+
+TEST(TestSettingHandle, FollowsValue)
+{
+  auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const int original = settings->GetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+
+  const CSettingIntHandle handle =
+      settings->GetIntHandle(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  ASSERT_TRUE(handle.IsValid());
+  EXPECT_EQ(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, handle.GetId());
+  EXPECT_EQ(original, handle.Get());
+
+  const int changed = original == 10 ? 20 : 10;
+  ASSERT_TRUE(settings->SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, changed));
+  EXPECT_EQ(changed, handle.Get());
+
+  settings->SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, original);
+  EXPECT_EQ(original, handle.Get());
+}
+
+TEST(TestSettingHandle, Invalid)
+{
+  auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+
+  const CSettingIntHandle unknown = settings->GetIntHandle("test.unknown");
+  EXPECT_FALSE(unknown.IsValid());
+  EXPECT_EQ(0, unknown.Get());
+
+  // type mismatch
+  const CSettingBoolHandle wrongType =
+      settings->GetBoolHandle(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  EXPECT_FALSE(wrongType.IsValid());
+  EXPECT_FALSE(wrongType.Get());
+}
+
+TEST(TestSettingHandle, ReadsWrittenValues)
+{
+  auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const CSettingIntHandle handle =
+      settings->GetIntHandle(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  ASSERT_TRUE(handle.IsValid());
+
+  // readers must only ever see values that were set
+  int failures = 0;
+  RunReaders([&handle] { return IsWrittenValue(handle.Get()); }, failures, 1000);
+  EXPECT_EQ(0, failures);
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST(TestSettingHandle, DISABLED_ConcurrentReaders)
+{
+  auto settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const CSettingIntHandle handle =
+      settings->GetIntHandle(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  ASSERT_TRUE(handle.IsValid());
+
+  int lookupFailures = 0;
+  const auto lookup = RunReaders(
+      [&settings] {
+        return IsWrittenValue(settings->GetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT));
+      },
+      lookupFailures);
+
+  int handleFailures = 0;
+  const auto handled =
+      RunReaders([&handle] { return IsWrittenValue(handle.Get()); }, handleFailures);
+
+  std::cout << "[ SettingHandle ] " << READERS << " readers x " << READS
+            << " reads: lookup by id " << lookup.count() << " ms, handle " << handled.count()
+            << " ms" << std::endl;
+
+  // readers must only ever see values that were set
+  EXPECT_EQ(0, lookupFailures);
+  EXPECT_EQ(0, handleFailures);
+}
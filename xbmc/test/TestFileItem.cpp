@@ -9,10 +9,21 @@
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "URL.h"
+#include "filesystem/File.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/SettingsManager.h"
+#include "test/TestUtils.h"
+#include "utils/Archive.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -130,3 +141,264 @@ const TestFileData BaseMovies[] = {{ "c:\\dir\\filename.avi", false, "c:\\dir\\f
                                    { "/home/user/movies/movie_name/BDMV/index.bdmv", true, "/home/user/movies/movie_name/" }};
 
 INSTANTIATE_TEST_SUITE_P(BaseNameMovies, TestFileItemBasePath, ValuesIn(BaseMovies));
+
+namespace
+{
+constexpr int MEMORY_TEST_ITEMS = 100000;
+
+// the properties and art of a synthetic music item
+template<typename P, typename A>
+void Fill(int i, P&& setProperty, A&& setArt)
+{
+  setProperty("isplayable", "true");
+  setProperty("tracknumber", i % 20);
+  setProperty("musicbrainzalbumid", "1a5b7b3c-8c2e-4f0a-9d63-3e2b6fd0c8a1");
+  setProperty("libraryartfilled", true);
+  setProperty("artistsortname", "Artist " + std::to_string(i / 12));
+
+  const std::string cover =
+      "image://music@smb%3a%2f%2fnas%2fmusic%2falbum" + std::to_string(i / 12) + "%2fcover.jpg/";
+  setArt("thumb", cover);
+  setArt("album.thumb", cover);
+  setArt("artist.fanart", "image://smb%3a%2f%2fnas%2fmusic%2fartist%2ffanart.jpg/");
+}
+
+void FillItem(CFileItem& item, int i)
+{
+  Fill(
+      i, [&item](const std::string& key, const CVariant& value) { item.SetProperty(key, value); },
+      [&item](const std::string& type, const std::string& url) { item.SetArt(type, url); });
+}
+
+// counts the bytes of the nodes a map allocates
+template<typename T>
+struct CountingAllocator
+{
+  using value_type = T;
+
+  explicit CountingAllocator(size_t& counter) : bytes(&counter) {}
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U>& other) : bytes(other.bytes)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    *bytes += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  template<typename U>
+  bool operator==(const CountingAllocator<U>& other) const
+  {
+    return bytes == other.bytes;
+  }
+  template<typename U>
+  bool operator!=(const CountingAllocator<U>& other) const
+  {
+    return bytes != other.bytes;
+  }
+
+  size_t* bytes;
+};
+
+struct LessNoCase
+{
+  bool operator()(const std::string& a, const std::string& b) const
+  {
+    return StringUtils::CompareNoCase(a, b) < 0;
+  }
+};
+
+size_t StringHeapBytes(const std::string& str)
+{
+  return str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0;
+}
+
+/*!
+ * \brief Bytes the properties and art of an item took when CGUIListItem kept them in maps keyed
+ * by std::string, the storage before property names and art types were interned
+ */
+size_t MapStorageBytes(int i)
+{
+  using PropertyMap = std::map<std::string, CVariant, LessNoCase,
+                               CountingAllocator<std::pair<const std::string, CVariant>>>;
+  using ArtMap = std::map<std::string, std::string, std::less<std::string>,
+                          CountingAllocator<std::pair<const std::string, std::string>>>;
+
+  size_t bytes = 0;
+  PropertyMap properties{PropertyMap::allocator_type(bytes)};
+  ArtMap art{ArtMap::allocator_type(bytes)};
+  Fill(
+      i, [&properties](const std::string& key, const CVariant& value) { properties[key] = value; },
+      [&art](const std::string& type, const std::string& url) { art[type] = url; });
+
+  for (const auto& it : properties)
+  {
+    bytes += StringHeapBytes(it.first);
+    if (it.second.isString())
+      bytes += StringHeapBytes(it.second.asString());
+  }
+  for (const auto& it : art)
+    bytes += StringHeapBytes(it.first) + StringHeapBytes(it.second);
+
+  // the item held three maps where it now holds three vectors
+  bytes += 3 * (sizeof(std::map<std::string, std::string>) - sizeof(std::vector<int>));
+  return bytes;
+}
+} // namespace
+
+TEST(TestFileItemMemory, GetMemoryUsage)
+{
+  CFileItemList items;
+  size_t inVectors = 0;
+  size_t inMaps = 0;
+  for (int i = 0; i < MEMORY_TEST_ITEMS; ++i)
+  {
+    const std::string path = "smb://nas/music/album" + std::to_string(i / 12) + "/" +
+                             std::to_string(i % 12) + ".flac";
+    auto item = std::make_shared<CFileItem>(path, false);
+    const size_t bare = item->GetMemoryUsage();
+    FillItem(*item, i);
+    inVectors += item->GetMemoryUsage() - bare;
+    inMaps += MapStorageBytes(i);
+    items.Add(item);
+  }
+
+  // the list as it is stored now, and as it was with the properties and art in maps
+  const size_t after = items.GetMemoryUsage();
+  const size_t before = after - inVectors + inMaps;
+  RecordProperty("BytesBefore", std::to_string(before));
+  RecordProperty("BytesAfter", std::to_string(after));
+
+  // at least the urls that don't fit the small string buffer
+  EXPECT_GT(inVectors, MEMORY_TEST_ITEMS * 2 * 50u);
+  // no tree node and no key string per entry
+  EXPECT_LT(after, before);
+}
+
+TEST(TestFileItemMemory, PropertiesAndArt)
+{
+  CFileItem item("/music/song.flac", false);
+  FillItem(item, 5);
+
+  EXPECT_EQ(5, item.GetProperty("TrackNumber").asInteger());
+  EXPECT_TRUE(item.HasProperty("ISPLAYABLE"));
+  EXPECT_FALSE(item.HasProperty("neverset"));
+  item.ClearProperty("isplayable");
+  EXPECT_FALSE(item.HasProperty("isplayable"));
+
+  EXPECT_TRUE(item.HasArt());
+  EXPECT_TRUE(item.HasArt("album.thumb"));
+  EXPECT_FALSE(item.HasArt("Thumb"));
+  EXPECT_EQ(3u, item.GetArt().size());
+
+  item.SetArtFallback("poster", "thumb");
+  EXPECT_EQ(item.GetArt("thumb"), item.GetArt("poster"));
+
+  CFileItem copy(item);
+  EXPECT_EQ(item.GetArt(), copy.GetArt());
+  EXPECT_EQ(item.GetProperty("artistsortname"), copy.GetProperty("artistsortname"));
+
+  item.ClearArt();
+  EXPECT_FALSE(item.HasArt());
+  EXPECT_TRUE(item.GetArt("poster").empty());
+}
+
+TEST(TestFileItemMemory, PropertyKeySpelling)
+{
+  CFileItem first("/music/first.flac", false);
+  first.SetProperty("SpellingTest", 1);
+
+  // the spelling of another item doesn't leak into this one
+  CFileItem item("/music/song.flac", false);
+  item.SetProperty("spellingtest", 2);
+  item.SetProperty("SPELLINGTEST", 3);
+  EXPECT_EQ(3, item.GetProperty("SpellingTest").asInteger());
+
+  CVariant value;
+  item.Serialize(value);
+  EXPECT_TRUE(value["customproperties"].isMember("spellingtest"));
+  EXPECT_FALSE(value["customproperties"].isMember("SpellingTest"));
+  EXPECT_EQ(3, value["customproperties"]["spellingtest"].asInteger());
+
+  first.Serialize(value);
+  EXPECT_TRUE(value["customproperties"].isMember("SpellingTest"));
+}
+
+TEST(TestFileItemMemory, ArtIsCopied)
+{
+  CFileItem item("/music/song.flac", false);
+  item.SetArt("thumb", "thumb.jpg");
+
+  const CGUIListItem::ArtMap art = item.GetArt();
+  item.SetArt("thumb", "other.jpg");
+  item.SetArt("fanart", "fanart.jpg");
+  ASSERT_EQ(1u, art.size());
+  EXPECT_EQ("thumb.jpg", art.at("thumb"));
+  EXPECT_EQ(2u, item.GetArt().size());
+}
+
+TEST(TestFileItemMemory, ArchiveOrder)
+{
+  XFILE::CFile* file = XBMC_CREATETEMPFILE(".ar");
+  ASSERT_NE(nullptr, file);
+
+  // set in an order that differs from the interned and the sorted order
+  CGUIListItem item;
+  item.SetProperty("zeta", 1);
+  item.SetProperty("Alpha", 2);
+  item.SetProperty("beta", 3);
+  item.SetArt("thumb", "thumb.jpg");
+  item.SetArt("banner", "banner.jpg");
+  item.SetArt("Poster", "poster.jpg");
+
+  CArchive store(file, CArchive::store);
+  item.Archive(store);
+  store.Close();
+
+  // the entries are archived sorted by name, as they were when kept in maps
+  ASSERT_EQ(0, file->Seek(0, SEEK_SET));
+  CArchive load(file, CArchive::load);
+  bool isFolder;
+  std::string label;
+  std::wstring sortLabel;
+  bool selected;
+  int overlay;
+  load >> isFolder >> label >> label >> sortLabel >> selected >> overlay;
+
+  int count;
+  load >> count;
+  std::vector<std::string> keys;
+  for (int i = 0; i < count; ++i)
+  {
+    std::string key;
+    CVariant value;
+    load >> key >> value;
+    keys.emplace_back(key);
+  }
+  EXPECT_EQ((std::vector<std::string>{"Alpha", "beta", "zeta"}), keys);
+
+  load >> count;
+  keys.clear();
+  for (int i = 0; i < count; ++i)
+  {
+    std::string type, url;
+    load >> type >> url;
+    keys.emplace_back(type);
+  }
+  EXPECT_EQ((std::vector<std::string>{"Poster", "banner", "thumb"}), keys);
+  load.Close();
+
+  // and read back into an item
+  ASSERT_EQ(0, file->Seek(0, SEEK_SET));
+  CArchive reload(file, CArchive::load);
+  CGUIListItem copy;
+  copy.Archive(reload);
+  reload.Close();
+  EXPECT_EQ(2, copy.GetProperty("ALPHA").asInteger());
+  EXPECT_EQ("poster.jpg", copy.GetArt("Poster"));
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
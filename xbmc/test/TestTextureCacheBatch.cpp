@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "TextureCache.h"
+#include "TextureCacheBatch.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr int IMAGES = 5;
+} // unnamed namespace
+
+class TestTextureCacheBatch : public testing::Test
+{
+protected:
+  TestTextureCacheBatch()
+  {
+    CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+    m_textureCache = std::make_shared<CTextureCache>();
+    m_textureCache->Initialize();
+    CServiceBroker::RegisterTextureCache(m_textureCache);
+  }
+
+  ~TestTextureCacheBatch() override
+  {
+    for (const std::string& image : m_images)
+    {
+      m_textureCache->ClearCachedImage(image);
+      CFile::Delete(image);
+    }
+
+    CServiceBroker::UnregisterTextureCache();
+    m_textureCache->Deinitialize();
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  //! every copy of the test image is a different image for the cache
+  std::string CopyImage()
+  {
+    const std::string image = StringUtils::Format("special://temp/texturecachebatch-{}.png",
+                                                  m_images.size());
+    if (!CFile::Copy(XBMC_REF_FILE_PATH("xbmc/network/test/data/webserver/test.png"), image))
+      return "";
+    m_images.push_back(image);
+    return image;
+  }
+
+  std::shared_ptr<CTextureCache> m_textureCache;
+  std::vector<std::string> m_images;
+};
+
+TEST_F(TestTextureCacheBatch, CachesEveryImageOnce)
+{
+  std::vector<std::string> images;
+  for (int i = 0; i < IMAGES; i++)
+  {
+    images.push_back(CopyImage());
+    ASSERT_FALSE(images.back().empty());
+  }
+
+  CTextureCacheBatch batch;
+  // items of a library share their artwork
+  for (int i = 0; i < 2; i++)
+  {
+    for (const std::string& image : images)
+      batch.Add(image);
+  }
+  batch.Add("");
+
+  const CTextureCacheBatch::Stats stats = batch.Wait();
+  EXPECT_EQ(static_cast<unsigned int>(IMAGES), stats.images);
+  EXPECT_EQ(static_cast<unsigned int>(IMAGES), stats.duplicates);
+  EXPECT_EQ(0u, stats.failed);
+  EXPECT_GT(stats.bytes, 0u);
+
+  for (const std::string& image : images)
+    EXPECT_TRUE(m_textureCache->HasCachedImage(image));
+}
+
+TEST_F(TestTextureCacheBatch, StartsNewBatch)
+{
+  const std::string image = CopyImage();
+  ASSERT_FALSE(image.empty());
+
+  CTextureCacheBatch batch;
+  batch.Add(image);
+  EXPECT_EQ(1u, batch.Wait().images);
+
+  // an image cached already is left to the texture cache, and not a duplicate of the last batch
+  batch.Add(image);
+  const CTextureCacheBatch::Stats stats = batch.Wait();
+  EXPECT_EQ(0u, stats.images);
+  EXPECT_EQ(0u, stats.duplicates);
+  EXPECT_EQ(0u, stats.failed);
+}
+
+TEST_F(TestTextureCacheBatch, MissingImage)
+{
+  CTextureCacheBatch batch;
+  batch.Add("special://temp/texturecachebatch-missing.png");
+
+  const CTextureCacheBatch::Stats stats = batch.Wait();
+  EXPECT_EQ(0u, stats.images);
+  EXPECT_EQ(1u, stats.failed);
+}
+
+TEST_F(TestTextureCacheBatch, Cancel)
+{
+  std::vector<std::string> images;
+  for (int i = 0; i < IMAGES; i++)
+  {
+    images.push_back(CopyImage());
+    ASSERT_FALSE(images.back().empty());
+  }
+
+  CTextureCacheBatch batch;
+  for (const std::string& image : images)
+    batch.Add(image);
+  batch.Cancel();
+
+  // the images being cached finish, the others are dropped
+  const CTextureCacheBatch::Stats stats = batch.Wait();
+  EXPECT_LE(stats.images, static_cast<unsigned int>(IMAGES));
+  EXPECT_EQ(0u, stats.failed);
+}
@@ -81,6 +81,8 @@ public:
 
   static CThread* GetCurrentThread();
 
+  const std::string& GetName() const { return m_ThreadName; }
+
   virtual void OnException(){} // signal termination handler
 
 protected:
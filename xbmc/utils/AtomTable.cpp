@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AtomTable.h"
+
+#include "utils/StringUtils.h"
+
+#include <cctype>
+#include <mutex>
+
+namespace
+{
+const std::string EMPTY_NAME;
+
+// a power of two, indexes double when half of the slots are used
+constexpr size_t INITIAL_SLOTS = 64;
+
+size_t StringHeapBytes(const std::string& str)
+{
+  // small strings live in the object itself
+  return str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0;
+}
+} // namespace
+
+CAtomTable::Index::Index(size_t slotCount)
+  : mask(slotCount - 1),
+    slots(std::make_unique<std::atomic<const Entry*>[]>(slotCount)),
+    atoms(std::make_unique<std::atomic<const Entry*>[]>(slotCount / 2))
+{
+}
+
+CAtomTable::CAtomTable(bool caseInsensitive) : m_caseInsensitive(caseInsensitive)
+{
+  m_indexes.emplace_back(std::make_unique<Index>(INITIAL_SLOTS));
+  m_index.store(m_indexes.back().get(), std::memory_order_release);
+}
+
+size_t CAtomTable::Hash(const std::string& name) const
+{
+  if (!m_caseInsensitive)
+    return std::hash<std::string>()(name);
+
+  // FNV-1a over the lower cased ascii characters, avoids a lower cased copy
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : name)
+  {
+    hash ^= static_cast<uint64_t>(::tolower(static_cast<unsigned char>(c)));
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
+
+bool CAtomTable::Equal(const std::string& a, const std::string& b) const
+{
+  return m_caseInsensitive ? StringUtils::EqualsNoCase(a, b) : a == b;
+}
+
+const CAtomTable::Entry* CAtomTable::Lookup(const Index& index,
+                                            const std::string& name,
+                                            size_t hash) const
+{
+  // at most half of the slots are used, there always is an empty one to stop at
+  for (size_t slot = hash & index.mask;; slot = (slot + 1) & index.mask)
+  {
+    const Entry* entry = index.slots[slot].load(std::memory_order_acquire);
+    if (!entry)
+      return nullptr;
+    if (entry->hash == hash && Equal(entry->name, name))
+      return entry;
+  }
+}
+
+void CAtomTable::Insert(Index& index, const Entry& entry)
+{
+  index.atoms[entry.atom].store(&entry, std::memory_order_release);
+
+  size_t slot = entry.hash & index.mask;
+  while (index.slots[slot].load(std::memory_order_relaxed))
+    slot = (slot + 1) & index.mask;
+  index.slots[slot].store(&entry, std::memory_order_release);
+}
+
+CAtomTable::Atom CAtomTable::Intern(const std::string& name)
+{
+  const size_t hash = Hash(name);
+  if (const Entry* entry = Lookup(*m_index.load(std::memory_order_acquire), name, hash))
+    return entry->atom;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  // may have been added while unlocked
+  Index* index = m_index.load(std::memory_order_relaxed);
+  if (const Entry* entry = Lookup(*index, name, hash))
+    return entry->atom;
+
+  const size_t size = m_size.load(std::memory_order_relaxed);
+  if (size + 1 > (index->mask + 1) / 2)
+  {
+    auto larger = std::make_unique<Index>(2 * (index->mask + 1));
+    for (const auto& entry : m_entries)
+      Insert(*larger, entry);
+    index = larger.get();
+    m_indexes.emplace_back(std::move(larger));
+    m_index.store(index, std::memory_order_release);
+  }
+
+  // deque elements don't move when the table grows
+  const Atom atom = static_cast<Atom>(size);
+  const Entry& entry = m_entries.emplace_back(Entry{name, hash, atom});
+  Insert(*index, entry);
+  m_size.store(size + 1, std::memory_order_release);
+  return atom;
+}
+
+CAtomTable::Atom CAtomTable::Find(const std::string& name) const
+{
+  const Entry* entry = Lookup(*m_index.load(std::memory_order_acquire), name, Hash(name));
+  return entry ? entry->atom : NONE;
+}
+
+const std::string& CAtomTable::GetName(Atom atom) const
+{
+  // the index published with the atom or a later one, both have it
+  if (atom >= m_size.load(std::memory_order_acquire))
+    return EMPTY_NAME;
+
+  const Index* index = m_index.load(std::memory_order_acquire);
+  return index->atoms[atom].load(std::memory_order_acquire)->name;
+}
+
+size_t CAtomTable::Size() const
+{
+  return m_size.load(std::memory_order_acquire);
+}
+
+size_t CAtomTable::GetMemoryUsage() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  size_t bytes = m_entries.size() * sizeof(Entry);
+  for (const auto& entry : m_entries)
+    bytes += StringHeapBytes(entry.name);
+
+  // slots and atoms of the current and the replaced indexes
+  for (const auto& index : m_indexes)
+    bytes += sizeof(Index) + (index->mask + 1) * 3 / 2 * sizeof(std::atomic<const Entry*>);
+  return bytes;
+}
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Table of interned strings
+ *
+ * Maps strings that are repeated in many objects, like list item property
+ * names or art types, to small integer atoms, so every object only has to
+ * store the atom. Atoms are never released, so the table is meant for a
+ * bounded vocabulary of names and not for arbitrary values.
+ *
+ * Names that were interned before are found without taking a lock, as list
+ * items look up their property names and art types on every access. Adding
+ * a name takes a lock and publishes a new index when the current one fills.
+ */
+class CAtomTable
+{
+public:
+  using Atom = uint32_t;
+  static constexpr Atom NONE = std::numeric_limits<Atom>::max();
+
+  /*!
+   * \param caseInsensitive whether names differing in case only map to the same atom.
+   * The spelling of the first interned name is returned by GetName() then.
+   */
+  explicit CAtomTable(bool caseInsensitive);
+
+  /*!
+   * \brief Get the atom of a name, adding it to the table if needed
+   */
+  Atom Intern(const std::string& name);
+
+  /*!
+   * \brief Get the atom of a name without adding it
+   * \return the atom or NONE if the name was never interned
+   */
+  Atom Find(const std::string& name) const;
+
+  /*!
+   * \brief Get the name of an atom
+   * \return the name, stays valid for the lifetime of the table
+   */
+  const std::string& GetName(Atom atom) const;
+
+  size_t Size() const;
+
+  /*!
+   * \brief Approximate number of bytes allocated by the table
+   */
+  size_t GetMemoryUsage() const;
+
+private:
+  struct Entry
+  {
+    std::string name;
+    size_t hash;
+    Atom atom;
+  };
+
+  /*!
+   * \brief Open addressing hash table of the entries and the entries by atom
+   *
+   * Never changed once published except for filling empty slots, a full index
+   * is replaced by a larger copy. Replaced indexes are kept until the table is
+   * destroyed, as readers may still use them.
+   */
+  struct Index
+  {
+    explicit Index(size_t slotCount);
+
+    size_t mask;
+    std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    std::unique_ptr<std::atomic<const Entry*>[]> atoms;
+  };
+
+  size_t Hash(const std::string& name) const;
+  bool Equal(const std::string& a, const std::string& b) const;
+  const Entry* Lookup(const Index& index, const std::string& name, size_t hash) const;
+  static void Insert(Index& index, const Entry& entry);
+
+  const bool m_caseInsensitive;
+  std::atomic<Index*> m_index;
+  std::atomic<size_t> m_size{0};
+
+  mutable CCriticalSection m_critSection;
+  std::vector<std::unique_ptr<Index>> m_indexes;
+  std::deque<Entry> m_entries;
+};
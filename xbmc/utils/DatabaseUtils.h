@@ -31,6 +31,7 @@ typedef enum
   FieldUnknown = -1,
   FieldNone = 0,
   FieldSort, // used to store the string to use for sorting
+  FieldSortKey, // binary key of FieldSort, see StringUtils::AlphaNumericSortKey()
   FieldSortSpecial, // whether the item needs special handling (0 = no, 1 = sort on top, 2 = sort on bottom)
   FieldLabel,
   FieldFolder,
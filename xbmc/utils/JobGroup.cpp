@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "JobGroup.h"
+
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+CJobGroup::CJobGroup(unsigned int jobsPerKey, CJob::PRIORITY priority)
+  : m_jobsPerKey(std::max(jobsPerKey, 1u)), m_priority(priority), m_state(std::make_shared<State>())
+{
+}
+
+CJobGroup::~CJobGroup()
+{
+  Cancel();
+}
+
+CJobGroup::CFinished::~CFinished()
+{
+  if (!m_state)
+    return;
+
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  m_state->done++;
+  m_state->finished.notifyAll();
+}
+
+void CJobGroup::Submit(const std::string& key, std::function<void()> function)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_state->section);
+    m_state->submitted++;
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_queueSection);
+  auto& jobs = m_queues[key];
+  if (!jobs)
+    jobs = std::make_unique<CJobQueue>(false, m_jobsPerKey, m_priority);
+
+  jobs->Submit([function = std::move(function), finished = CFinished(m_state)] { function(); });
+}
+
+void CJobGroup::Cancel()
+{
+  std::unique_lock<CCriticalSection> lock(m_queueSection);
+  for (auto& jobs : m_queues)
+    jobs.second->CancelJobs();
+}
+
+size_t CJobGroup::GetPending() const
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  return m_state->submitted - m_state->done;
+}
+
+size_t CJobGroup::GetFinished() const
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  return m_state->done;
+}
+
+void CJobGroup::WaitForFewer(size_t pending)
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  m_state->finished.wait(lock,
+                         [this, pending] { return m_state->submitted - m_state->done < pending; });
+}
+
+void CJobGroup::Wait()
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  m_state->finished.wait(lock, [this] { return m_state->done == m_state->submitted; });
+}
+
+bool CJobGroup::Wait(std::chrono::milliseconds interval, const std::function<bool()>& check)
+{
+  std::unique_lock<CCriticalSection> lock(m_state->section);
+  while (m_state->done < m_state->submitted)
+  {
+    m_state->finished.wait(lock, interval);
+    lock.unlock();
+    const bool wait = check();
+    lock.lock();
+    if (!wait)
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "utils/Job.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+class CJobQueue;
+
+/*!
+ \ingroup jobs
+ \brief Runs functions on job queues, one queue per key, and waits for them
+
+ Every key, e.g. a host or an add-on, gets a queue running a limited number of
+ jobs at once, so a slow key doesn't hold up the others. A function counts as
+ finished once its job is gone, whether it ran or was cancelled.
+
+ The counters outlive the group, a job still running when the group is
+ destroyed finishes on its own. Wait for the jobs before destroying what they
+ use.
+
+ \sa CJobQueue
+ */
+class CJobGroup
+{
+public:
+  /*!
+   \param jobsPerKey number of jobs of a key running at once
+   \param priority priority of the jobs, dedicated jobs don't wait for a busy job manager
+   */
+  explicit CJobGroup(unsigned int jobsPerKey, CJob::PRIORITY priority = CJob::PRIORITY_DEDICATED);
+
+  /*!
+   \brief Cancels the jobs not started yet, see Cancel()
+   */
+  ~CJobGroup();
+
+  /*!
+   \brief Run a function on the queue of a key
+   */
+  void Submit(const std::string& key, std::function<void()> function);
+
+  /*!
+   \brief Drop the jobs not started yet, running jobs finish
+   */
+  void Cancel();
+
+  /*!
+   \brief Number of functions submitted and not finished yet
+   */
+  size_t GetPending() const;
+
+  /*!
+   \brief Number of functions finished since the group was created
+   */
+  size_t GetFinished() const;
+
+  /*!
+   \brief Wait until fewer than the given number of functions are pending
+   */
+  void WaitForFewer(size_t pending);
+
+  /*!
+   \brief Wait until all functions submitted are finished
+   */
+  void Wait();
+
+  /*!
+   \brief Wait until all functions submitted are finished
+   \param interval how often check is called while waiting
+   \param check called on the calling thread without any lock held, return false to stop waiting
+   \return false if check stopped the waiting
+   */
+  bool Wait(std::chrono::milliseconds interval, const std::function<bool()>& check);
+
+private:
+  CJobGroup(const CJobGroup&) = delete;
+  CJobGroup& operator=(const CJobGroup&) = delete;
+
+  struct State
+  {
+    CCriticalSection section;
+    XbmcThreads::ConditionVariable finished;
+    size_t submitted = 0;
+    size_t done = 0;
+  };
+
+  /*!
+   \brief Counts a function finished when its job is gone, whether it ran or was cancelled
+   */
+  class CFinished
+  {
+  public:
+    explicit CFinished(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+    CFinished(CFinished&& other) noexcept = default;
+    ~CFinished();
+
+  private:
+    std::shared_ptr<State> m_state;
+  };
+
+  const unsigned int m_jobsPerKey;
+  const CJob::PRIORITY m_priority;
+  const std::shared_ptr<State> m_state;
+
+  CCriticalSection m_queueSection;
+  std::map<std::string, std::unique_ptr<CJobQueue>> m_queues;
+};
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <inttypes.h>
+#include <string_view>
 
 std::string ArrayToString(SortAttribute attributes, const CVariant &variant, const std::string &separator = " / ")
 {
@@ -504,16 +505,21 @@ std::string ByBPM(SortAttribute attributes, const SortItem& values)
                              ByLabel(attributes, values));
 }
 
-bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFolder, bool &result, std::wstring &labelLeft, std::wstring &labelRight)
+bool preliminarySort(const SortItem& left,
+                     const SortItem& right,
+                     bool handleFolder,
+                     bool& result,
+                     std::string_view& keyLeft,
+                     std::string_view& keyRight)
 {
   // make sure both items have the necessary data to do the sorting
   SortItem::const_iterator itLeftSort, itRightSort;
-  if ((itLeftSort = left.find(FieldSort)) == left.end())
+  if ((itLeftSort = left.find(FieldSortKey)) == left.end())
   {
     result = false;
     return true;
   }
-  if ((itRightSort = right.find(FieldSort)) == right.end())
+  if ((itRightSort = right.find(FieldSortKey)) == right.end())
   {
     result = true;
     return true;
@@ -564,8 +570,9 @@ bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFol
     }
   }
 
-  labelLeft = itLeftSort->second.asWideString();
-  labelRight = itRightSort->second.asWideString();
+  // the keys are prepared once per item, compare them without copying
+  keyLeft = std::string_view(itLeftSort->second.c_str(), itLeftSort->second.size());
+  keyRight = std::string_view(itRightSort->second.c_str(), itRightSort->second.size());
 
   return false;
 }
@@ -573,41 +580,41 @@ bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFol
 bool SorterAscending(const SortItem &left, const SortItem &right)
 {
   bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
+  std::string_view keyLeft, keyRight;
+  if (preliminarySort(left, right, true, result, keyLeft, keyRight))
     return result;
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
+  return keyLeft < keyRight;
 }
 
 bool SorterDescending(const SortItem &left, const SortItem &right)
 {
   bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
+  std::string_view keyLeft, keyRight;
+  if (preliminarySort(left, right, true, result, keyLeft, keyRight))
     return result;
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
+  return keyLeft > keyRight;
 }
 
 bool SorterIgnoreFoldersAscending(const SortItem &left, const SortItem &right)
 {
   bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
+  std::string_view keyLeft, keyRight;
+  if (preliminarySort(left, right, false, result, keyLeft, keyRight))
     return result;
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
+  return keyLeft < keyRight;
 }
 
 bool SorterIgnoreFoldersDescending(const SortItem &left, const SortItem &right)
 {
   bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
+  std::string_view keyLeft, keyRight;
+  if (preliminarySort(left, right, false, result, keyLeft, keyRight))
     return result;
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
+  return keyLeft > keyRight;
 }
 
 bool SorterIndirectAscending(const SortItemPtr &left, const SortItemPtr &right)
@@ -1006,6 +1013,7 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
 
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
+        item->insert(std::pair<Field, CVariant>(FieldSortKey, CVariant(StringUtils::AlphaNumericSortKey(sortLabel))));
         item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
       }
 
@@ -1045,6 +1053,7 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
 
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
+        (*item)->insert(std::pair<Field, CVariant>(FieldSortKey, CVariant(StringUtils::AlphaNumericSortKey(sortLabel))));
         (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
       }
 
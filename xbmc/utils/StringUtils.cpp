@@ -1224,6 +1224,88 @@ int64_t StringUtils::AlphaNumericCompare(const wchar_t* left, const wchar_t* rig
   return 0; // files are the same
 }
 
+namespace
+{
+// Classes of the units in a sort key, ascii symbols sort above everything else
+constexpr char SORTKEY_SYMBOL = 1;
+constexpr char SORTKEY_CHARACTER = 2;
+
+void AppendBigEndian(std::string& key, uint64_t value, int bytes)
+{
+  for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8)
+    key += static_cast<char>((value >> shift) & 0xFF);
+}
+
+void AppendLocaleWeight(std::string& key, const std::collate<wchar_t>& coll, wchar_t c)
+{
+  // The transformed string never contains L'\0', so a zero unit terminates it and sorts a
+  // prefix before the longer weight, as a comparison of the transformed strings would.
+  for (const wchar_t unit : coll.transform(&c, &c + 1))
+    AppendBigEndian(key, static_cast<uint32_t>(unit), 4);
+  AppendBigEndian(key, 0, 4);
+}
+} // unnamed namespace
+
+// Builds the key from the same rules AlphaNumericCompare() applies per character. The
+// only difference is a number compared against a character: it compares like the digit
+// '0' instead of its first digit, which matters only for characters that collate between
+// the digits (e.g. superscripts), where AlphaNumericCompare() is not transitive anyway.
+std::string StringUtils::AlphaNumericSortKey(const std::wstring& str)
+{
+  const bool useLocale = g_langInfo.UseLocaleCollation();
+  const std::collate<wchar_t>& coll =
+      std::use_facet<std::collate<wchar_t>>(g_langInfo.GetSystemLocale());
+
+  std::string key;
+  key.reserve(str.size() * 3);
+
+  const wchar_t* s = str.c_str();
+  while (*s != 0)
+  {
+    wchar_t c = *s;
+    if (c >= L'0' && c <= L'9')
+    {
+      // compare only up to 15 digits, longer runs continue as the next number
+      const wchar_t* end = s + 15;
+      uint64_t number = 0;
+      while (*s >= L'0' && *s <= L'9' && s < end)
+        number = number * 10 + (*s++ - L'0');
+
+      key += SORTKEY_CHARACTER;
+      if (useLocale)
+        AppendLocaleWeight(key, coll, L'0');
+      else
+        AppendBigEndian(key, L'0', 2);
+      AppendBigEndian(key, number, 7);
+      continue;
+    }
+
+    const bool symbol = (c >= 32 && c < L'0') || (c > L'9' && c < L'A') ||
+                        (c > L'Z' && c < L'a') || (c > L'z' && c < 128);
+    if (symbol)
+    {
+      key += SORTKEY_SYMBOL;
+      key += static_cast<char>(c);
+    }
+    else
+    {
+      if (!useLocale && c > 128)
+        c = GetCollationWeight(c);
+      if (c >= L'A' && c <= L'Z')
+        c += L'a' - L'A';
+
+      key += SORTKEY_CHARACTER;
+      if (useLocale)
+        AppendLocaleWeight(key, coll, c);
+      else
+        AppendBigEndian(key, static_cast<uint32_t>(c), 2);
+    }
+    s++;
+  }
+
+  return key;
+}
+
 /*
   Convert the UTF8 character to which z points into a 31-bit Unicode point.
   Return how many bytes (0 to 3) of UTF8 data encode the character.
@@ -247,6 +247,14 @@ public:
                                              size_t iMaxStrings = 0);
   static int FindNumber(const std::string& strInput, const std::string &strFind);
   static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right);
+  /*! \brief Get a binary key of a string for natural sorting
+   Comparing two keys with memcmp (or std::string::compare) orders them like AlphaNumericCompare()
+   does, so the locale collation and the digit parsing are done once per string instead of
+   once per comparison.
+   \param str The string to get the key for
+   \return The sort key, may contain '\\0' bytes
+   */
+  static std::string AlphaNumericSortKey(const std::wstring& str);
   static int AlphaNumericCollation(int nKey1, const void* pKey1, int nKey2, const void* pKey2);
   static long TimeStringToSeconds(const std::string &timeString);
   static void RemoveCRLF(std::string& strLine);
@@ -0,0 +1,238 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TraceRecorder.h"
+
+#include "ServiceBroker.h"
+#include "filesystem/File.h"
+#include "messaging/ApplicationMessenger.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include <fmt/format.h>
+
+namespace
+{
+constexpr const char* TRACE_DIRECTORY = "special://logpath/";
+constexpr const char* DEFAULT_FILE_NAME = "kodi-trace.json";
+
+bool IsFileName(const std::string& name)
+{
+  return !name.empty() && name != "." && name != ".." &&
+         name.find_first_of("/\\:") == std::string::npos;
+}
+
+void AppendEscaped(std::string& out, const char* str)
+{
+  for (; *str; ++str)
+  {
+    if (*str == '"' || *str == '\\')
+      out += '\\';
+    if (static_cast<unsigned char>(*str) >= 0x20)
+      out += *str;
+  }
+}
+
+// Chrome traces are in microseconds
+void AppendMicroseconds(std::string& out, int64_t ns)
+{
+  out += fmt::format("{}.{:03}", ns / 1000, ns % 1000);
+}
+} // namespace
+
+struct CTraceRecorder::ThreadBuffer
+{
+  ThreadBuffer(uint32_t session, int id, std::string threadName)
+    : session(session), tid(id), name(std::move(threadName)), events(new Event[EVENTS_PER_THREAD])
+  {
+  }
+
+  const uint32_t session;
+  const int tid;
+  const std::string name;
+  const std::unique_ptr<Event[]> events;
+  // only written by the owning thread
+  std::atomic<uint64_t> count{0};
+};
+
+std::atomic<bool> CTraceRecorder::s_recording{false};
+std::atomic<uint32_t> CTraceRecorder::s_session{0};
+std::atomic<int> CTraceRecorder::s_writers{0};
+
+thread_local std::shared_ptr<CTraceRecorder::ThreadBuffer> CTraceRecorder::t_buffer;
+
+CTraceRecorder& CTraceRecorder::GetInstance()
+{
+  static CTraceRecorder recorder;
+  return recorder;
+}
+
+void CTraceRecorder::Start()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+
+  s_recording = false;
+  // threads register again with the new session
+  s_session++;
+  m_buffers.clear();
+  m_startTime = Now();
+  s_recording = true;
+
+  CLog::Log(LOGINFO, "CTraceRecorder: started recording");
+}
+
+void CTraceRecorder::Pause()
+{
+  s_recording = false;
+  while (s_writers.load() > 0)
+    std::this_thread::yield();
+}
+
+std::string CTraceRecorder::Stop(const std::string& fileName /* = "" */)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    Pause();
+  }
+
+  const std::string name = fileName.empty() ? DEFAULT_FILE_NAME : fileName;
+  if (!IsFileName(name))
+  {
+    CLog::Log(LOGERROR, "CTraceRecorder: refusing to write trace to {}, not a file name", name);
+    return "";
+  }
+
+  const std::string json = ToJson();
+  const std::string file = TRACE_DIRECTORY + name;
+
+  XFILE::CFile output;
+  if (!output.OpenForWrite(file, true) ||
+      output.Write(json.data(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CTraceRecorder: failed to write trace to {}", file);
+    return "";
+  }
+
+  CLog::Log(LOGINFO, "CTraceRecorder: wrote trace to {}", file);
+  return file;
+}
+
+std::string CTraceRecorder::ToJson()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+
+  const bool recording = IsRecording();
+  Pause();
+
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+
+  std::vector<Event> events;
+  for (const auto& buffer : m_buffers)
+  {
+    out += first ? "\n" : ",\n";
+    first = false;
+    out += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                       "\"args\":{{\"name\":\"",
+                       buffer->tid);
+    AppendEscaped(out, buffer->name.c_str());
+    out += "\"}}";
+
+    // no thread writes while paused
+    const uint64_t count = buffer->count.load(std::memory_order_acquire);
+    const uint64_t begin = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0;
+    events.assign(buffer->events.get(), buffer->events.get() + EVENTS_PER_THREAD);
+
+    for (uint64_t index = begin; index < count; ++index)
+    {
+      const Event& event = events[index % EVENTS_PER_THREAD];
+      // started before recording was restarted
+      if (event.start < m_startTime)
+        continue;
+
+      out += ",\n{\"name\":\"";
+      AppendEscaped(out, event.name);
+      out += "\",\"cat\":\"";
+      AppendEscaped(out, event.category);
+      out += fmt::format("\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":", buffer->tid);
+      AppendMicroseconds(out, event.start - m_startTime);
+      out += ",\"dur\":";
+      AppendMicroseconds(out, event.duration);
+      out += "}";
+    }
+  }
+
+  out += "\n]}\n";
+
+  s_recording = recording;
+  return out;
+}
+
+void CTraceRecorder::Record(const char* category, const char* name, int64_t start, int64_t end)
+{
+  if (!IsRecording())
+    return;
+
+  // announce the write before checking again, Pause() waits for it then
+  s_writers++;
+  if (!s_recording.load())
+  {
+    s_writers--;
+    return;
+  }
+
+  ThreadBuffer* buffer = t_buffer.get();
+  if (!buffer || buffer->session != s_session.load(std::memory_order_relaxed))
+  {
+    // the recorder may be paused while waiting for its lock
+    s_writers--;
+    buffer = GetInstance().RegisterThread();
+    if (!buffer)
+      return;
+    s_writers++;
+    if (!s_recording.load())
+    {
+      s_writers--;
+      return;
+    }
+  }
+
+  const uint64_t index = buffer->count.load(std::memory_order_relaxed);
+  buffer->events[index % EVENTS_PER_THREAD] = {category, name, start, end - start};
+  buffer->count.store(index + 1, std::memory_order_release);
+  s_writers--;
+}
+
+CTraceRecorder::ThreadBuffer* CTraceRecorder::RegisterThread()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+
+  // recording may have been stopped meanwhile
+  if (!IsRecording())
+    return nullptr;
+
+  const int tid = static_cast<int>(m_buffers.size()) + 1;
+
+  std::string name;
+  const CThread* thread = CThread::GetCurrentThread();
+  const auto messenger = CServiceBroker::GetAppMessenger();
+  if (thread)
+    name = thread->GetName();
+  else if (messenger && messenger->IsProcessThread())
+    name = "Application";
+  else
+    name = fmt::format("Thread {}", tid);
+
+  t_buffer = std::make_shared<ThreadBuffer>(s_session.load(), tid, std::move(name));
+  m_buffers.emplace_back(t_buffer);
+  return t_buffer.get();
+}
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Records how long scopes take on all threads and writes them as a
+ * Chrome trace event file
+ *
+ * The file can be loaded into https://ui.perfetto.dev or chrome://tracing to
+ * see where the time of a frame goes across the application, GUI, player,
+ * render and audio threads.
+ *
+ * Scopes are recorded with KODI_TRACE_SCOPE(). Recording is off by default and
+ * a scope costs a single relaxed atomic load then. While recording, every
+ * thread writes into its own ring buffer without locking, the oldest events of
+ * a thread are overwritten once its buffer is full. The buffers are only read
+ * once no thread writes to them any more.
+ */
+class CTraceRecorder
+{
+public:
+  //! Events kept per thread, older events are overwritten
+  static constexpr size_t EVENTS_PER_THREAD = 16384;
+
+  static CTraceRecorder& GetInstance();
+
+  static bool IsRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+  /*!
+   * \brief Drop previously recorded events and start recording
+   */
+  void Start();
+
+  /*!
+   * \brief Stop recording and write the recorded events
+   *
+   * \param fileName The name of the file to write in special://logpath, kodi-trace.json if
+   * empty. Paths are refused, the callers include JSON-RPC clients.
+   * \return The path of the written file, empty on failure
+   */
+  std::string Stop(const std::string& fileName = "");
+
+  /*!
+   * \brief Write the events as Chrome trace event JSON
+   *
+   * Recording is paused while the events are copied, scopes ending meanwhile are not recorded.
+   */
+  std::string ToJson();
+
+  static int64_t Now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static void Record(const char* category, const char* name, int64_t start, int64_t end);
+
+  class CScope
+  {
+  public:
+    /*!
+     * \param category, name Must be string literals, only the pointers are kept
+     */
+    CScope(const char* category, const char* name)
+    {
+      if (IsRecording())
+      {
+        m_category = category;
+        m_name = name;
+        m_start = Now();
+      }
+    }
+
+    ~CScope()
+    {
+      if (m_name)
+        Record(m_category, m_name, m_start, Now());
+    }
+
+    CScope(const CScope&) = delete;
+    CScope& operator=(const CScope&) = delete;
+
+  private:
+    const char* m_category = nullptr;
+    const char* m_name = nullptr;
+    int64_t m_start = 0;
+  };
+
+private:
+  CTraceRecorder() = default;
+
+  struct Event
+  {
+    const char* category;
+    const char* name;
+    int64_t start;
+    int64_t duration;
+  };
+
+  struct ThreadBuffer;
+
+  ThreadBuffer* RegisterThread();
+
+  /*!
+   * \brief Stop recording and wait for the threads writing an event right now
+   */
+  static void Pause();
+
+  static std::atomic<bool> s_recording;
+  // threads in Record() past the check for recording
+  static std::atomic<int> s_writers;
+  static std::atomic<uint32_t> s_session;
+  // the recorder keeps the buffer after the thread is gone
+  static thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+
+  CCriticalSection m_section;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+  int64_t m_startTime = 0;
+};
+
+#define KODI_TRACE_CONCAT_INNER(a, b) a##b
+#define KODI_TRACE_CONCAT(a, b) KODI_TRACE_CONCAT_INNER(a, b)
+
+/*!
+ * \brief Record the time until the end of the enclosing scope
+ *
+ * \param category, name String literals shown in the trace
+ */
+#define KODI_TRACE_SCOPE(category, name) \
+  CTraceRecorder::CScope KODI_TRACE_CONCAT(traceScope, __LINE__)(category, name)
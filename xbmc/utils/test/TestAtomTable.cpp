@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/AtomTable.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(TestAtomTable, Intern)
+{
+  CAtomTable table(false);
+  const auto thumb = table.Intern("thumb");
+  const auto fanart = table.Intern("fanart");
+  EXPECT_NE(thumb, fanart);
+  EXPECT_EQ(thumb, table.Intern("thumb"));
+  EXPECT_EQ(thumb, table.Find("thumb"));
+  EXPECT_EQ("fanart", table.GetName(fanart));
+  EXPECT_EQ(2u, table.Size());
+}
+
+TEST(TestAtomTable, CaseSensitive)
+{
+  CAtomTable table(false);
+  EXPECT_NE(table.Intern("Thumb"), table.Intern("thumb"));
+  EXPECT_EQ(CAtomTable::NONE, table.Find("THUMB"));
+}
+
+TEST(TestAtomTable, CaseInsensitive)
+{
+  CAtomTable table(true);
+  const auto atom = table.Intern("IsPlayable");
+  EXPECT_EQ(atom, table.Intern("isplayable"));
+  EXPECT_EQ(atom, table.Find("ISPLAYABLE"));
+  // the first spelling is kept
+  EXPECT_EQ("IsPlayable", table.GetName(atom));
+  EXPECT_EQ(1u, table.Size());
+}
+
+TEST(TestAtomTable, Unknown)
+{
+  CAtomTable table(true);
+  EXPECT_EQ(CAtomTable::NONE, table.Find("missing"));
+  EXPECT_TRUE(table.GetName(42).empty());
+  EXPECT_EQ(0u, table.Size());
+}
+
+TEST(TestAtomTable, Concurrent)
+{
+  CAtomTable table(true);
+  std::vector<std::thread> threads;
+  std::vector<std::vector<CAtomTable::Atom>> results(4);
+  for (size_t t = 0; t < results.size(); ++t)
+  {
+    threads.emplace_back([&table, &result = results[t]] {
+      for (int i = 0; i < 1000; ++i)
+        result.emplace_back(table.Intern("key" + std::to_string(i % 100)));
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(100u, table.Size());
+  for (const auto& result : results)
+    EXPECT_EQ(results[0], result);
+}
+
+TEST(TestAtomTable, LookupWhileGrowing)
+{
+  CAtomTable table(false);
+  const auto first = table.Intern("first");
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> errors{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t)
+  {
+    readers.emplace_back([&] {
+      while (!stop)
+      {
+        if (table.Find("first") != first || table.GetName(first) != "first")
+          errors++;
+
+        // every atom below the size has its name
+        const auto size = static_cast<CAtomTable::Atom>(table.Size());
+        if (size > 1 && table.GetName(size - 1) != "key" + std::to_string(size - 2))
+          errors++;
+      }
+    });
+  }
+
+  for (int i = 0; i < 5000; ++i)
+    table.Intern("key" + std::to_string(i));
+  stop = true;
+  for (auto& reader : readers)
+    reader.join();
+
+  EXPECT_EQ(0, errors);
+  EXPECT_EQ(5001u, table.Size());
+  EXPECT_EQ(5001u, table.Intern("key4999") + 1);
+}
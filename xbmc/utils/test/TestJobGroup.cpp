@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "test/MtTestUtils.h"
+#include "threads/Event.h"
+#include "utils/JobGroup.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+using namespace ConditionPoll;
+using namespace std::chrono_literals;
+
+class TestJobGroup : public testing::Test
+{
+protected:
+  TestJobGroup() { CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>()); }
+
+  ~TestJobGroup() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+};
+
+TEST_F(TestJobGroup, KeysDontHoldUpEachOther)
+{
+  CJobGroup group(1);
+  CEvent release;
+  std::atomic<int> fast{0};
+
+  group.Submit("slow", [&release] { release.Wait(); });
+  for (int i = 0; i < 3; i++)
+    group.Submit("fast", [&fast] { fast++; });
+
+  // the blocked job only holds up the queue of its key
+  EXPECT_TRUE(poll([&fast] { return fast == 3; }));
+  EXPECT_TRUE(poll([&group] { return group.GetPending() == 1; }));
+
+  release.Set();
+  group.Wait();
+  EXPECT_EQ(0u, group.GetPending());
+  EXPECT_EQ(4u, group.GetFinished());
+}
+
+TEST_F(TestJobGroup, JobsPerKey)
+{
+  CJobGroup group(2);
+  CEvent release(true);
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+
+  for (int i = 0; i < 4; i++)
+  {
+    group.Submit("key", [&] {
+      const int now = ++running;
+      int max = maxRunning;
+      while (now > max && !maxRunning.compare_exchange_weak(max, now))
+        ;
+      release.Wait();
+      running--;
+    });
+  }
+
+  // two jobs of the key overlap, the others wait for them
+  EXPECT_TRUE(poll([&running] { return running == 2; }));
+  EXPECT_EQ(4u, group.GetPending());
+
+  release.Set();
+  group.Wait();
+  EXPECT_EQ(2, maxRunning);
+}
+
+TEST_F(TestJobGroup, CancelledJobsFinish)
+{
+  CJobGroup group(1);
+  CEvent started;
+  CEvent release;
+  std::atomic<int> ran{0};
+
+  group.Submit("key", [&] {
+    started.Set();
+    release.Wait();
+    ran++;
+  });
+  for (int i = 0; i < 2; i++)
+    group.Submit("key", [&ran] { ran++; });
+
+  ASSERT_TRUE(started.Wait(5s));
+  group.Cancel();
+  release.Set();
+
+  // the running job completes, the queued ones are dropped and count as finished
+  group.Wait();
+  EXPECT_EQ(1, ran);
+  EXPECT_EQ(3u, group.GetFinished());
+}
+
+TEST_F(TestJobGroup, WaitForFewer)
+{
+  CJobGroup group(1);
+  CEvent release;
+
+  group.Submit("key", [&release] { release.Wait(); });
+  group.Submit("key", [] {});
+  EXPECT_EQ(2u, group.GetPending());
+
+  release.Set();
+  group.WaitForFewer(1);
+  EXPECT_EQ(0u, group.GetPending());
+}
+
+TEST_F(TestJobGroup, CheckStopsWaiting)
+{
+  CJobGroup group(1);
+  CEvent release;
+  int checks = 0;
+
+  group.Submit("key", [&release] { release.Wait(); });
+
+  EXPECT_FALSE(group.Wait(1ms, [&checks] { return ++checks < 3; }));
+  EXPECT_EQ(3, checks);
+  EXPECT_EQ(1u, group.GetPending());
+
+  release.Set();
+  EXPECT_TRUE(group.Wait(1ms, [] { return true; }));
+}
@@ -9,6 +9,11 @@
 #include "utils/StringUtils.h"
 
 #include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 enum class ECG
@@ -356,6 +361,101 @@ TEST(TestStringUtils, AlphaNumericCompare)
   EXPECT_LT(var, ref);
 }
 
+namespace
+{
+// Labels mixing cases, accents, symbols and numbers of different lengths
+std::vector<std::wstring> RandomLabels(size_t count)
+{
+  static const std::wstring alphabet = L"aAbBzZ eE\u00e9\u00c9\u00e0\u00f6\u00df\u0142-_.!(~";
+  std::mt19937 random(1234);
+  std::uniform_int_distribution<size_t> length(0, 12);
+  std::uniform_int_distribution<size_t> character(0, alphabet.size() - 1);
+  std::uniform_int_distribution<int> kind(0, 3);
+  std::uniform_int_distribution<uint64_t> number(0, 100000);
+
+  std::vector<std::wstring> labels;
+  for (size_t i = 0; i < count; i++)
+  {
+    std::wstring label;
+    for (size_t j = length(random); j > 0; j--)
+    {
+      if (kind(random) == 0)
+        label += std::to_wstring(number(random));
+      else
+        label += alphabet[character(random)];
+    }
+    labels.emplace_back(label);
+  }
+  // leading zeros and runs longer than 15 digits
+  labels.emplace_back(L"track 007");
+  labels.emplace_back(L"track 7");
+  labels.emplace_back(L"track 1234567890123456789");
+  labels.emplace_back(L"track 123456789012345");
+  return labels;
+}
+
+int Sign(int64_t value)
+{
+  return (value > 0) - (value < 0);
+}
+} // namespace
+
+TEST(TestStringUtils, AlphaNumericSortKey)
+{
+  const std::vector<std::wstring> labels = RandomLabels(400);
+
+  std::vector<std::string> keys;
+  for (const auto& label : labels)
+    keys.emplace_back(StringUtils::AlphaNumericSortKey(label));
+
+  for (size_t i = 0; i < labels.size(); i++)
+  {
+    for (size_t j = 0; j < labels.size(); j++)
+    {
+      ASSERT_EQ(Sign(StringUtils::AlphaNumericCompare(labels[i].c_str(), labels[j].c_str())),
+                Sign(keys[i].compare(keys[j])))
+          << "comparing \"" << i << "\" and \"" << j << "\"";
+    }
+  }
+
+  EXPECT_LT(StringUtils::AlphaNumericSortKey(L"Episode 9"),
+            StringUtils::AlphaNumericSortKey(L"episode 10"));
+  EXPECT_EQ(StringUtils::AlphaNumericSortKey(L"Track 007"),
+            StringUtils::AlphaNumericSortKey(L"track 7"));
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST(TestStringUtils, DISABLED_AlphaNumericSortKeyBenchmark)
+{
+  const std::vector<std::wstring> labels = RandomLabels(80000);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::wstring> compared(labels);
+  std::stable_sort(compared.begin(), compared.end(),
+                   [](const std::wstring& left, const std::wstring& right) {
+                     return StringUtils::AlphaNumericCompare(left.c_str(), right.c_str()) < 0;
+                   });
+  const auto compareTime = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  std::vector<std::pair<std::string, const std::wstring*>> keyed;
+  keyed.reserve(labels.size());
+  for (const auto& label : labels)
+    keyed.emplace_back(StringUtils::AlphaNumericSortKey(label), &label);
+  std::stable_sort(keyed.begin(), keyed.end(),
+                   [](const auto& left, const auto& right) { return left.first < right.first; });
+  const auto keyTime = std::chrono::steady_clock::now() - start;
+
+  for (size_t i = 0; i < labels.size(); i++)
+    ASSERT_EQ(0, StringUtils::AlphaNumericCompare(compared[i].c_str(), keyed[i].second->c_str()));
+
+  using std::chrono::milliseconds;
+  using std::chrono::duration_cast;
+  std::cout << "[ AlphaNumericSortKey ] " << labels.size() << " labels: compare "
+            << duration_cast<milliseconds>(compareTime).count() << " ms, keys "
+            << duration_cast<milliseconds>(keyTime).count() << " ms" << std::endl;
+}
+
 TEST(TestStringUtils, TimeStringToSeconds)
 {
   EXPECT_EQ(77455, StringUtils::TimeStringToSeconds("21:30:55"));
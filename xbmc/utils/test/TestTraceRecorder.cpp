@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "threads/Thread.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/TraceRecorder.h"
+#include "utils/Variant.h"
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+class CTracingThread : public CThread
+{
+public:
+  CTracingThread(const char* name, int scopes) : CThread(name), m_scopes(scopes) {}
+
+protected:
+  void Process() override
+  {
+    for (int i = 0; i < m_scopes; i++)
+    {
+      KODI_TRACE_SCOPE("test", "Outer");
+      KODI_TRACE_SCOPE("test", "Inner \"quoted\"");
+    }
+  }
+
+private:
+  const int m_scopes;
+};
+
+// events per thread name
+std::map<std::string, int> CountEvents(const CVariant& trace)
+{
+  std::map<int64_t, std::string> threads;
+  for (auto it = trace["traceEvents"].begin_array(); it != trace["traceEvents"].end_array(); ++it)
+  {
+    if ((*it)["ph"].asString() == "M")
+      threads[(*it)["tid"].asInteger()] = (*it)["args"]["name"].asString();
+  }
+
+  std::map<std::string, int> events;
+  for (auto it = trace["traceEvents"].begin_array(); it != trace["traceEvents"].end_array(); ++it)
+  {
+    if ((*it)["ph"].asString() == "X")
+    {
+      EXPECT_GE((*it)["dur"].asDouble(), 0.0);
+      events[threads[(*it)["tid"].asInteger()]]++;
+    }
+  }
+  return events;
+}
+} // namespace
+
+class TestTraceRecorder : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // the traces are written to the log folder
+    m_logPath = CSpecialProtocol::TranslatePath("special://logpath");
+    CSpecialProtocol::SetLogPath(CSpecialProtocol::TranslatePath("special://temp"));
+  }
+
+  void TearDown() override { CSpecialProtocol::SetLogPath(m_logPath); }
+
+private:
+  std::string m_logPath;
+};
+
+TEST_F(TestTraceRecorder, NotRecording)
+{
+  CTraceRecorder& recorder = CTraceRecorder::GetInstance();
+  recorder.Start();
+  recorder.Stop("kodi-trace-test.json");
+
+  {
+    KODI_TRACE_SCOPE("test", "Ignored");
+  }
+
+  CVariant trace;
+  ASSERT_TRUE(CJSONVariantParser::Parse(recorder.ToJson(), trace));
+  EXPECT_TRUE(CountEvents(trace).empty());
+}
+
+TEST_F(TestTraceRecorder, Threads)
+{
+  CTraceRecorder& recorder = CTraceRecorder::GetInstance();
+  recorder.Start();
+
+  CTracingThread first("TraceFirst", 100);
+  CTracingThread second("TraceSecond", 200);
+  first.Create();
+  second.Create();
+  first.StopThread(true);
+  second.StopThread(true);
+
+  const std::string path = recorder.Stop("kodi-trace-test.json");
+  EXPECT_EQ("special://logpath/kodi-trace-test.json", path);
+  EXPECT_TRUE(XFILE::CFile::Exists("special://temp/kodi-trace-test.json"));
+
+  CVariant trace;
+  ASSERT_TRUE(CJSONVariantParser::Parse(recorder.ToJson(), trace));
+  const auto events = CountEvents(trace);
+  ASSERT_EQ(2, events.size());
+  EXPECT_EQ(200, events.at("TraceFirst"));
+  EXPECT_EQ(400, events.at("TraceSecond"));
+}
+
+TEST_F(TestTraceRecorder, Overwrite)
+{
+  CTraceRecorder& recorder = CTraceRecorder::GetInstance();
+  recorder.Start();
+
+  CTracingThread thread("TraceOverwrite", CTraceRecorder::EVENTS_PER_THREAD);
+  thread.Create();
+  thread.StopThread(true);
+
+  recorder.Stop("kodi-trace-test.json");
+
+  // the oldest events are dropped
+  CVariant trace;
+  ASSERT_TRUE(CJSONVariantParser::Parse(recorder.ToJson(), trace));
+  EXPECT_EQ(static_cast<int>(CTraceRecorder::EVENTS_PER_THREAD),
+            CountEvents(trace).at("TraceOverwrite"));
+}
+
+TEST_F(TestTraceRecorder, RefusesPaths)
+{
+  CTraceRecorder& recorder = CTraceRecorder::GetInstance();
+
+  for (const std::string name : {"../kodi-trace.json", "/tmp/kodi-trace.json",
+                                 "special://home/kodi-trace.json", "dir\\kodi-trace.json", ".."})
+  {
+    recorder.Start();
+    EXPECT_EQ("", recorder.Stop(name)) << name;
+    EXPECT_FALSE(CTraceRecorder::IsRecording());
+  }
+}
+
+TEST_F(TestTraceRecorder, ToJsonWhileRecording)
+{
+  CTraceRecorder& recorder = CTraceRecorder::GetInstance();
+  recorder.Start();
+
+  CTracingThread thread("TraceWhileRecording", 100000);
+  thread.Create();
+
+  // the buffers are copied while the thread records, recording goes on afterwards
+  for (int i = 0; i < 10; i++)
+  {
+    CVariant trace;
+    ASSERT_TRUE(CJSONVariantParser::Parse(recorder.ToJson(), trace));
+    EXPECT_TRUE(CTraceRecorder::IsRecording());
+  }
+
+  thread.StopThread(true);
+  recorder.Stop("kodi-trace-test.json");
+}
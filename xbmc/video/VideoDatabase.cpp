@@ -24,6 +24,7 @@
 #include "dialogs/GUIDialogProgress.h"
 #include "dialogs/GUIDialogYesNo.h"
 #include "filesystem/Directory.h"
+#include "filesystem/ExistsChecker.h"
 #include "filesystem/File.h"
 #include "filesystem/MultiPathDirectory.h"
 #include "filesystem/PluginDirectory.h"
@@ -187,6 +188,15 @@ void CVideoDatabase::CreateTables()
   CLog::Log(LOGINFO, "create seasons table");
   m_pDS->exec("CREATE TABLE seasons ( idSeason integer primary key, idShow integer, season integer, name text, userrating integer)");
 
+  CLog::Log(LOGINFO, "create tvshow_counts table");
+  m_pDS->exec("CREATE TABLE tvshow_counts (idShow integer primary key, lastPlayed text, "
+              "totalCount integer, watchedCount integer, totalSeasons integer, dateAdded text, "
+              "inProgressCount integer)");
+
+  CLog::Log(LOGINFO, "create season_counts table");
+  m_pDS->exec("CREATE TABLE season_counts (idSeason integer primary key, idShow integer, "
+              "episodes integer, playCount integer, aired text, inProgressCount integer)");
+
   CLog::Log(LOGINFO, "create art table");
   m_pDS->exec("CREATE TABLE art(art_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, type TEXT, url TEXT)");
 
@@ -210,6 +220,38 @@ void CVideoDatabase::CreateTables()
               "TEXT, itemType INTEGER, idType INTEGER)");
 }
 
+std::vector<std::string> CVideoDatabase::GetShowCountsSQL(const std::string& shows) const
+{
+  // same aggregates as listing the episodes of the shows would give
+  return {
+      StringUtils::Format("DELETE FROM tvshow_counts WHERE idShow IN ({})", shows),
+      StringUtils::Format(
+          "INSERT INTO tvshow_counts (idShow, lastPlayed, totalCount, watchedCount, "
+          "totalSeasons, dateAdded, inProgressCount) "
+          "SELECT episode.idShow, MAX(files.lastPlayed), COUNT(episode.c{0:02}), "
+          "COUNT(files.playCount), COUNT(DISTINCT episode.c{0:02}), MAX(files.dateAdded), "
+          "COUNT(bookmark.type) "
+          "FROM episode "
+          "LEFT JOIN files ON files.idFile=episode.idFile "
+          "LEFT JOIN bookmark ON bookmark.idFile=files.idFile AND bookmark.type=1 "
+          "WHERE episode.idShow IN ({1}) "
+          "GROUP BY episode.idShow",
+          VIDEODB_ID_EPISODE_SEASON, shows),
+      StringUtils::Format("DELETE FROM season_counts WHERE idShow IN ({})", shows),
+      StringUtils::Format(
+          "INSERT INTO season_counts (idSeason, idShow, episodes, playCount, aired, "
+          "inProgressCount) "
+          "SELECT seasons.idSeason, seasons.idShow, COUNT(DISTINCT episode.idEpisode), "
+          "COUNT(files.playCount), MIN(episode.c{0:02}), COUNT(bookmark.type) "
+          "FROM seasons "
+          "JOIN episode ON episode.idShow=seasons.idShow AND episode.c{1:02}=seasons.season "
+          "JOIN files ON files.idFile=episode.idFile "
+          "LEFT JOIN bookmark ON bookmark.idFile=files.idFile AND bookmark.type=1 "
+          "WHERE seasons.idShow IN ({2}) "
+          "GROUP BY seasons.idSeason, seasons.idShow",
+          VIDEODB_ID_EPISODE_AIRED, VIDEODB_ID_EPISODE_SEASON, shows)};
+}
+
 void CVideoDatabase::CreateLinkIndex(const char *table)
 {
   m_pDS->exec(PrepareSQL("CREATE UNIQUE INDEX ix_%s_1 ON %s (name(255))", table, table));
@@ -275,6 +317,7 @@ void CVideoDatabase::CreateAnalytics()
 
   m_pDS->exec("CREATE INDEX ix_streamdetails ON streamdetails (idFile)");
   m_pDS->exec("CREATE INDEX ix_seasons ON seasons (idShow, season)");
+  m_pDS->exec("CREATE INDEX ix_season_counts ON season_counts (idShow)");
   m_pDS->exec("CREATE INDEX ix_art ON art(media_id, media_type(20), type(20))");
 
   m_pDS->exec("CREATE INDEX ix_rating ON rating(media_id, media_type(20))");
@@ -300,6 +343,13 @@ void CVideoDatabase::CreateAnalytics()
   CreateLinkIndex("genre");
   CreateLinkIndex("country");
 
+  // the counts tables are not maintained while the triggers are dropped for an update
+  CLog::Log(LOGINFO, "{} - filling episode counts", __FUNCTION__);
+  m_pDS->exec("DELETE FROM tvshow_counts");
+  m_pDS->exec("DELETE FROM season_counts");
+  for (const std::string& sql : GetShowCountsSQL("SELECT idShow FROM tvshow"))
+    m_pDS->exec(sql);
+
   CLog::Log(LOGINFO, "{} - creating triggers", __FUNCTION__);
   m_pDS->exec("CREATE TRIGGER delete_movie AFTER DELETE ON movie FOR EACH ROW BEGIN "
               "DELETE FROM genre_link WHERE media_id=old.idMovie AND media_type='movie'; "
@@ -328,6 +378,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM tag_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM rating WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM uniqueid WHERE media_id=old.idShow AND media_type='tvshow'; "
+              "DELETE FROM tvshow_counts WHERE idShow=old.idShow; "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
@@ -344,10 +395,11 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM writer_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM art WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM rating WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "END");
+              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; " +
+              StringUtils::Join(GetShowCountsSQL("old.idShow"), "; ") + "; END");
   m_pDS->exec("CREATE TRIGGER delete_season AFTER DELETE ON seasons FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSeason AND media_type='season'; "
+              "DELETE FROM season_counts WHERE idSeason=old.idSeason; "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_set AFTER DELETE ON sets FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSet AND media_type='set'; "
@@ -364,8 +416,43 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "DELETE FROM videoversion WHERE idFile=old.idFile; "
-              "DELETE FROM art WHERE media_id=old.idFile AND media_type='videoversion'; "
-              "END");
+              "DELETE FROM art WHERE media_id=old.idFile AND media_type='videoversion'; " +
+              StringUtils::Join(
+                  GetShowCountsSQL("SELECT idShow FROM episode WHERE idFile=old.idFile"), "; ") +
+              "; END");
+
+  // Keep the episode counts of tv shows and seasons up to date, so listing them doesn't have to
+  // aggregate all episodes every time. A show is counted again as a whole, as maximums and
+  // distinct seasons can't be adjusted by the changed row alone. That is only done when a row
+  // changed that is counted, not for every update of a file or resume point.
+  const auto createCountsTrigger = [this](const std::string& name, const std::string& event,
+                                          const std::string& table, const std::string& condition,
+                                          const std::string& shows) {
+    m_pDS->exec(GetTriggerSQL(m_sqlite, name, event, table, condition, GetShowCountsSQL(shows)));
+  };
+  const std::string episodeChanged = GetChangedSQL(
+      m_sqlite, {"idShow", "idFile", StringUtils::Format("c{:02}", VIDEODB_ID_EPISODE_SEASON),
+                 StringUtils::Format("c{:02}", VIDEODB_ID_EPISODE_AIRED)});
+  createCountsTrigger("insert_episode_counts", "INSERT", "episode", "", "NEW.idShow");
+  createCountsTrigger("update_episode_counts", "UPDATE", "episode", episodeChanged,
+                      "OLD.idShow, NEW.idShow");
+  createCountsTrigger("insert_season_counts", "INSERT", "seasons", "", "NEW.idShow");
+  createCountsTrigger("update_season_counts", "UPDATE", "seasons",
+                      GetChangedSQL(m_sqlite, {"idShow", "season"}), "OLD.idShow, NEW.idShow");
+  createCountsTrigger("insert_file_counts", "INSERT", "files", "",
+                      "SELECT idShow FROM episode WHERE idFile=NEW.idFile");
+  createCountsTrigger("update_file_counts", "UPDATE", "files",
+                      GetChangedSQL(m_sqlite, {"idFile", "playCount", "lastPlayed", "dateAdded"}),
+                      "SELECT idShow FROM episode WHERE idFile IN (OLD.idFile, NEW.idFile)");
+  // only resume points are counted, moving one along doesn't change the counts
+  createCountsTrigger("insert_bookmark_counts", "INSERT", "bookmark", "NEW.type=1",
+                      "SELECT idShow FROM episode WHERE idFile=NEW.idFile");
+  createCountsTrigger("update_bookmark_counts", "UPDATE", "bookmark",
+                      "(OLD.type=1 OR NEW.type=1) AND " +
+                          GetChangedSQL(m_sqlite, {"idFile", "type"}),
+                      "SELECT idShow FROM episode WHERE idFile IN (OLD.idFile, NEW.idFile)");
+  createCountsTrigger("delete_bookmark_counts", "DELETE", "bookmark", "OLD.type=1",
+                      "SELECT idShow FROM episode WHERE idFile=OLD.idFile");
 
   CreateViews();
 }
@@ -418,20 +505,15 @@ void CVideoDatabase::CreateViews()
   // clang-format off
   std::string tvshowcounts = PrepareSQL("CREATE VIEW tvshowcounts AS SELECT "
                                        "      tvshow.idShow AS idShow,"
-                                       "      MAX(files.lastPlayed) AS lastPlayed,"
-                                       "      NULLIF(COUNT(episode.c12), 0) AS totalCount,"
-                                       "      COUNT(files.playCount) AS watchedcount,"
-                                       "      NULLIF(COUNT(DISTINCT(episode.c12)), 0) AS totalSeasons, "
-                                       "      MAX(files.dateAdded) as dateAdded, "
-                                       "      COUNT(bookmark.type) AS inProgressCount "
+                                       "      tvshow_counts.lastPlayed AS lastPlayed,"
+                                       "      NULLIF(tvshow_counts.totalCount, 0) AS totalCount,"
+                                       "      COALESCE(tvshow_counts.watchedCount, 0) AS watchedcount,"
+                                       "      NULLIF(tvshow_counts.totalSeasons, 0) AS totalSeasons, "
+                                       "      tvshow_counts.dateAdded as dateAdded, "
+                                       "      COALESCE(tvshow_counts.inProgressCount, 0) AS inProgressCount "
                                        "    FROM tvshow"
-                                       "      LEFT JOIN episode ON"
-                                       "        episode.idShow=tvshow.idShow"
-                                       "      LEFT JOIN files ON"
-                                       "        files.idFile=episode.idFile "
-                                       "      LEFT JOIN bookmark ON"
-                                       "        bookmark.idFile=files.idFile AND bookmark.type=1 "
-                                       "GROUP BY tvshow.idShow");
+                                       "      LEFT JOIN tvshow_counts ON"
+                                       "        tvshow_counts.idShow=tvshow.idShow");
   // clang-format on
   m_pDS->exec(tvshowcounts);
 
@@ -493,34 +575,15 @@ void CVideoDatabase::CreateViews()
                                      "  tvshow_view.c%02d AS genre,"
                                      "  tvshow_view.c%02d AS studio,"
                                      "  tvshow_view.c%02d AS mpaa,"
-                                     "  count(DISTINCT episode.idEpisode) AS episodes,"
-                                     "  count(files.playCount) AS playCount,"
-                                     "  min(episode.c%02d) AS aired, "
-                                     "  count(bookmark.type) AS inProgressCount "
+                                     "  season_counts.episodes AS episodes,"
+                                     "  season_counts.playCount AS playCount,"
+                                     "  season_counts.aired AS aired, "
+                                     "  season_counts.inProgressCount AS inProgressCount "
                                      "FROM seasons"
                                      "  JOIN tvshow_view ON"
                                      "    tvshow_view.idShow = seasons.idShow"
-                                     "  JOIN episode ON"
-                                     "    episode.idShow = seasons.idShow AND episode.c%02d = seasons.season"
-                                     "  JOIN files ON"
-                                     "    files.idFile = episode.idFile "
-                                     "  LEFT JOIN bookmark ON"
-                                     "    bookmark.idFile = files.idFile AND bookmark.type = 1 "
-                                     "GROUP BY seasons.idSeason,"
-                                     "         seasons.idShow,"
-                                     "         seasons.season,"
-                                     "         seasons.name,"
-                                     "         seasons.userrating,"
-                                     "         tvshow_view.strPath,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d ",
-                                     VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_PLOT, VIDEODB_ID_TV_PREMIERED,
-                                     VIDEODB_ID_TV_GENRE, VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_MPAA,
-                                     VIDEODB_ID_EPISODE_AIRED, VIDEODB_ID_EPISODE_SEASON,
+                                     "  JOIN season_counts ON"
+                                     "    season_counts.idSeason = seasons.idSeason",
                                      VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_PLOT, VIDEODB_ID_TV_PREMIERED,
                                      VIDEODB_ID_TV_GENRE, VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_MPAA);
   // clang-format on
@@ -6392,11 +6455,21 @@ void CVideoDatabase::UpdateTables(int iVersion)
     }
     m_pDS->close();
   }
+
+  if (iVersion < 132)
+  {
+    // filled with the counts of all shows when the triggers are created again
+    m_pDS->exec("CREATE TABLE tvshow_counts (idShow integer primary key, lastPlayed text, "
+                "totalCount integer, watchedCount integer, totalSeasons integer, dateAdded text, "
+                "inProgressCount integer)");
+    m_pDS->exec("CREATE TABLE season_counts (idSeason integer primary key, idShow integer, "
+                "episodes integer, playCount integer, aired text, inProgressCount integer)");
+  }
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 131;
+  return 132;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -9999,10 +10072,12 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
       VECSOURCES videoSources(*CMediaSourceSettings::GetInstance().GetSources("video"));
       CServiceBroker::GetMediaManager().GetRemovableDrives(videoSources);
 
-      int total = m_pDS2->num_rows();
-      int current = 0;
-      std::string lastDir;
-      bool gotDir = true;
+      // the files on the sources are checked together, several at once per host
+      const int connections = CServiceBroker::GetSettingsComponent()
+                                  ->GetAdvancedSettings()
+                                  ->m_iVideoLibraryCleanConnections;
+      CExistsChecker checker(connections);
+      std::vector<std::pair<std::string, size_t>> filesToCheck;
 
       while (!m_pDS2->eof())
       {
@@ -10010,6 +10085,7 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
         std::string fileName = m_pDS2->fv("files.strFileName").get_asString();
         std::string fullPath;
         ConstructPath(fullPath, path, fileName);
+        const std::string idFile = m_pDS2->fv("files.idFile").get_asString();
 
         // get the first stacked file
         if (URIUtils::IsStack(fullPath))
@@ -10036,25 +10112,18 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
           if (!URIUtils::IsOnDVD(fullPath) &&
               CUtil::GetMatchingSource(fullPath, videoSources, bIsSource) >= 0)
           {
-            const std::string pathDir = URIUtils::GetDirectory(fullPath);
-
-            // Cache file's directory in case it's different from the previous file
-            if (lastDir != pathDir)
-            {
-              lastDir = pathDir;
-              CFileItemList items; // Dummy list
-              gotDir = CDirectory::GetDirectory(pathDir, items, "",
-                                                DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
-            }
-
-            // Keep existing files
-            if (gotDir && CFile::Exists(fullPath, true))
-              del = false;
+            filesToCheck.emplace_back(idFile, checker.AddFile(fullPath));
+            del = false;
           }
         }
         if (del)
-          filesToTestForDelete += m_pDS2->fv("files.idFile").get_asString() + ",";
+          filesToTestForDelete += idFile + ",";
+
+        m_pDS2->next();
+      }
+      m_pDS2->close();
 
+      const bool checked = checker.Run([handle, progress](size_t current, size_t total) {
         if (handle == NULL && progress != NULL)
         {
           int percentage = current * 100 / total;
@@ -10063,22 +10132,33 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
             progress->SetPercentage(percentage);
             progress->Progress();
           }
-          if (progress->IsCanceled())
-          {
-            progress->Close();
-            m_pDS2->close();
-            CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary,
-                                                               "OnCleanFinished");
-            return;
-          }
+          return !progress->IsCanceled();
         }
         else if (handle != NULL)
           handle->SetPercentage(current * 100 / (float)total);
+        return true;
+      });
+      if (!checked)
+      {
+        progress->Close();
+        CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary,
+                                                           "OnCleanFinished");
+        return;
+      }
 
-        m_pDS2->next();
-        current++;
+      // Keep existing files
+      for (const auto& file : filesToCheck)
+      {
+        if (!checker.Exists(file.second))
+          filesToTestForDelete += file.first + ",";
       }
-      m_pDS2->close();
+
+      const CExistsChecker::Stats& stats = checker.GetStats();
+      CLog::Log(LOGINFO,
+                "{}: Checked {} files in {:.1f} s, {} missing ({} folder listings, {} single "
+                "checks, {} per host)",
+                __FUNCTION__, stats.paths, stats.seconds, stats.missing, stats.listings,
+                stats.requests, connections);
 
       std::string filesToDelete;
 
@@ -10179,36 +10259,56 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
             "AND (strHash IS NULL OR strHash = '') "
             "AND (exclude IS NULL OR exclude != 1))";
       m_pDS2->query(sql);
-      std::string strIds;
+      struct PathToClean
+      {
+        int id;
+        int parentId;
+        bool plugin;
+        bool exists; // plugins are asked right away
+        size_t check; // others are checked together afterwards
+      };
+      std::vector<PathToClean> pathsToClean;
+      CExistsChecker pathChecker(connections);
       while (!m_pDS2->eof())
       {
-        auto pathsDeleteDecision = pathsDeleteDecisions.find(m_pDS2->fv(0).get_asInt());
-        // Check if we have a decision for the parent path
-        auto pathsDeleteDecisionByParent = pathsDeleteDecisions.find(m_pDS2->fv(2).get_asInt());
         std::string path = m_pDS2->fv(1).get_asString();
 
-        bool exists = false;
-        if (URIUtils::IsPlugin(path))
+        PathToClean pathToClean{m_pDS2->fv(0).get_asInt(), m_pDS2->fv(2).get_asInt(),
+                                URIUtils::IsPlugin(path), false, 0};
+        if (pathToClean.plugin)
         {
           SScanSettings settings;
           bool foundDirectly = false;
           ScraperPtr scraper = GetScraperForPath(path, settings, foundDirectly);
           if (scraper && CPluginDirectory::CheckExists(TranslateContent(scraper->Content()), path))
-            exists = true;
+            pathToClean.exists = true;
         }
         else
-          exists = CDirectory::Exists(path, false);
+          pathToClean.check = pathChecker.AddDirectory(path);
+        pathsToClean.push_back(pathToClean);
+
+        m_pDS2->next();
+      }
+      m_pDS2->close();
+      pathChecker.Run();
+
+      std::string strIds;
+      for (const PathToClean& pathToClean : pathsToClean)
+      {
+        auto pathsDeleteDecision = pathsDeleteDecisions.find(pathToClean.id);
+        // Check if we have a decision for the parent path
+        auto pathsDeleteDecisionByParent = pathsDeleteDecisions.find(pathToClean.parentId);
+
+        const bool exists =
+            pathToClean.plugin ? pathToClean.exists : pathChecker.Exists(pathToClean.check);
 
         if (((pathsDeleteDecision != pathsDeleteDecisions.end() && pathsDeleteDecision->second) ||
              (pathsDeleteDecision == pathsDeleteDecisions.end() && !exists)) &&
             ((pathsDeleteDecisionByParent != pathsDeleteDecisions.end() &&
               pathsDeleteDecisionByParent->second) ||
              (pathsDeleteDecisionByParent == pathsDeleteDecisions.end())))
-          strIds += m_pDS2->fv(0).get_asString() + ",";
-
-        m_pDS2->next();
+          strIds += std::to_string(pathToClean.id) + ",";
       }
-      m_pDS2->close();
 
       if (!strIds.empty())
       {
@@ -1204,6 +1204,14 @@ private:
    */
   virtual void CreateViews();
 
+  /*! \brief Statements to count the episodes of tv shows and their seasons again
+   Used to fill the tvshow_counts and season_counts tables and by the triggers that keep them
+   up to date.
+   \param shows SQL list of the ids of the shows, e.g. an id or a subquery
+   \return the statements to execute in order
+   */
+  std::vector<std::string> GetShowCountsSQL(const std::string& shows) const;
+
   /*! \brief Helper to get a database id given a query.
    Returns an integer, -1 if not found, and greater than 0 if found.
    \param query the SQL that will retrieve a database id.
@@ -166,6 +166,14 @@ namespace VIDEO
       CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().ResetLibraryBools();
       m_database.Close();
 
+      const CTextureCacheBatch::Stats artwork = m_artwork.Wait();
+      if (artwork.images > 0 || artwork.failed > 0)
+        CLog::Log(LOGINFO,
+                  "VideoInfoScanner: Cached {} images ({} KiB) in {:.1f} s, {:.1f} images/s, {} "
+                  "failed, {} duplicates",
+                  artwork.images, artwork.bytes / 1024, artwork.seconds,
+                  artwork.ImagesPerSecond(), artwork.failed, artwork.duplicates);
+
       auto end = std::chrono::steady_clock::now();
       auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
@@ -228,6 +236,7 @@ namespace VIDEO
     if (m_bCanInterrupt)
       m_database.Interrupt();
 
+    m_artwork.Cancel();
     m_bStop = true;
   }
 
@@ -1871,7 +1880,7 @@ namespace VIDEO
     for (const auto& artType : artTypes)
     {
       if (art.find(artType) != art.end())
-        CServiceBroker::GetTextureCache()->BackgroundCacheImage(art[artType]);
+        m_artwork.Add(art[artType]);
     }
 
     pItem->SetArt(art);
@@ -2389,7 +2398,7 @@ namespace VIDEO
         if (i->thumb.empty() && !i->thumbUrl.GetFirstUrlByType().m_url.empty())
           i->thumb = CScraperUrl::GetThumbUrl(i->thumbUrl.GetFirstUrlByType());
         if (!i->thumb.empty())
-          CServiceBroker::GetTextureCache()->BackgroundCacheImage(i->thumb);
+          m_artwork.Add(i->thumb);
       }
     }
   }
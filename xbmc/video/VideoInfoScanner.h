@@ -9,6 +9,7 @@
 #pragma once
 
 #include "InfoScanner.h"
+#include "TextureCacheBatch.h"
 #include "VideoDatabase.h"
 #include "addons/Scraper.h"
 #include "guilib/GUIListItem.h"
@@ -248,6 +249,7 @@ namespace VIDEO
     bool m_ignoreVideoExtras{false};
     std::string m_strStartDir;
     CVideoDatabase m_database;
+    CTextureCacheBatch m_artwork;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
 
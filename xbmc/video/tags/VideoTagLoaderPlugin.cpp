@@ -24,9 +24,8 @@ CVideoTagLoaderPlugin::CVideoTagLoaderPlugin(const CFileItem& item, bool forceRe
   // Preserve CFileItem video info and art to avoid info loss between creating VideoInfoTagLoaderFactory and calling Load()
   if (m_item.HasVideoInfoTag())
     m_tag = std::make_unique<CVideoInfoTag>(*m_item.GetVideoInfoTag());
-  auto& art = item.GetArt();
-  if (!art.empty())
-    m_art = std::make_unique<CGUIListItem::ArtMap>(art);
+  if (item.HasArt())
+    m_art = std::make_unique<CGUIListItem::ArtMap>(item.GetArt());
 }
 
 bool CVideoTagLoaderPlugin::HasInfo() const
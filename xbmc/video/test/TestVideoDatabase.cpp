@@ -0,0 +1,290 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
+#include "video/VideoDatabase.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+// the episode counts as tvshowcounts and season_view aggregated them before the counts tables
+const std::string LEGACY_SHOW_COUNTS =
+    "SELECT tvshow.idShow AS idShow, MAX(files.lastPlayed) AS lastPlayed, "
+    "NULLIF(COUNT(episode.c12), 0) AS totalCount, COUNT(files.playCount) AS watchedcount, "
+    "NULLIF(COUNT(DISTINCT(episode.c12)), 0) AS totalSeasons, "
+    "MAX(files.dateAdded) AS dateAdded, COUNT(bookmark.type) AS inProgressCount "
+    "FROM tvshow "
+    "LEFT JOIN episode ON episode.idShow=tvshow.idShow "
+    "LEFT JOIN files ON files.idFile=episode.idFile "
+    "LEFT JOIN bookmark ON bookmark.idFile=files.idFile AND bookmark.type=1 "
+    "GROUP BY tvshow.idShow";
+
+const std::string LEGACY_SEASON_COUNTS =
+    "SELECT seasons.idSeason AS idSeason, COUNT(DISTINCT episode.idEpisode) AS episodes, "
+    "COUNT(files.playCount) AS playCount, MIN(episode.c05) AS aired, "
+    "COUNT(bookmark.type) AS inProgressCount "
+    "FROM seasons "
+    "JOIN episode ON episode.idShow=seasons.idShow AND episode.c12=seasons.season "
+    "JOIN files ON files.idFile=episode.idFile "
+    "LEFT JOIN bookmark ON bookmark.idFile=files.idFile AND bookmark.type=1 "
+    "GROUP BY seasons.idSeason";
+} // unnamed namespace
+
+class TestVideoDatabase : public testing::TestWithParam<std::string>
+{
+protected:
+  void SetUp() override
+  {
+    m_mysql = GetParam() == "mysql";
+    if (m_mysql)
+    {
+      // a server set up as video database with --add-advancedsettings-file
+      const DatabaseSettings& videoDatabase =
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseVideo;
+      if (!StringUtils::EqualsNoCase(videoDatabase.type, "mysql"))
+        GTEST_SKIP() << "no MySQL server configured as video database";
+      m_settings = videoDatabase;
+    }
+    else
+    {
+      m_settings.type = "sqlite3";
+      m_settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+      CFile::Delete(m_settings.host + "TestVideoDatabase.db");
+    }
+
+    ASSERT_TRUE(m_database.Connect("TestVideoDatabase", m_settings, true));
+    // a server database is kept from the last run
+    for (const char* table : {"tvshow", "seasons", "episode", "files", "bookmark"})
+      m_database.ExecuteQuery(std::string("DELETE FROM ") + table);
+  }
+
+  void TearDown() override
+  {
+    m_database.Close();
+    if (!m_mysql)
+      CFile::Delete(m_settings.host + "TestVideoDatabase.db");
+  }
+
+  //! whether the values differ, NULL compared like any other value
+  std::string Differs(const std::string& a, const std::string& b) const
+  {
+    return m_mysql ? "NOT (" + a + " <=> " + b + ")" : a + " IS NOT " + b;
+  }
+
+  void AddShows(int shows, int seasons, int episodes)
+  {
+    m_database.BeginTransaction();
+    for (int show = 1; show <= shows; show++)
+    {
+      m_database.ExecuteQuery(
+          StringUtils::Format("INSERT INTO tvshow (idShow, c00) VALUES ({0}, 'Show {0}')", show));
+      for (int season = 1; season <= seasons; season++)
+      {
+        m_database.ExecuteQuery(
+            StringUtils::Format("INSERT INTO seasons (idSeason, idShow, season) "
+                                "VALUES ({}, {}, {})",
+                                show * seasons + season, show, season));
+        for (int episode = 1; episode <= episodes; episode++)
+        {
+          const int id = (show * seasons + season) * episodes + episode;
+          // every third episode is watched, every fifth one is in progress
+          m_database.ExecuteQuery(StringUtils::Format(
+              "INSERT INTO files (idFile, idPath, strFilename, playCount, lastPlayed, dateAdded) "
+              "VALUES ({0}, 1, '{0}.mkv', {1}, {2}, '2024-01-{3:02} 00:00:00')",
+              id, id % 3 == 0 ? "1" : "NULL",
+              id % 3 == 0 ? StringUtils::Format("'2024-02-{:02} 00:00:00'", episode) : "NULL",
+              episode));
+          m_database.ExecuteQuery(StringUtils::Format(
+              "INSERT INTO episode (idEpisode, idFile, c00, c05, c12, c13, idShow, idSeason) "
+              "VALUES ({0}, {0}, 'Episode {0}', '2023-{1:02}-{2:02}', '{1}', '{2}', {3}, {4})",
+              id, season, episode, show, show * seasons + season));
+          if (id % 5 == 0)
+          {
+            m_database.ExecuteQuery(
+                StringUtils::Format("INSERT INTO bookmark (idFile, timeInSeconds, "
+                                    "totalTimeInSeconds, type) VALUES ({}, 60, 1200, 1)",
+                                    id));
+          }
+        }
+      }
+    }
+    m_database.CommitTransaction();
+  }
+
+  void ExpectLegacyCounts()
+  {
+    EXPECT_EQ(m_database.GetSingleValueInt("SELECT COUNT(*) FROM (" + LEGACY_SHOW_COUNTS +
+                                           ") AS legacy"),
+              m_database.GetSingleValueInt("SELECT COUNT(*) FROM tvshowcounts"));
+    std::string differs;
+    for (const char* column : {"lastPlayed", "totalCount", "watchedcount", "totalSeasons",
+                               "dateAdded", "inProgressCount"})
+    {
+      differs += " OR " + Differs(std::string("legacy.") + column,
+                                  std::string("tvshowcounts.") + column);
+    }
+    EXPECT_EQ(0, m_database.GetSingleValueInt(
+                     "SELECT COUNT(*) FROM (" + LEGACY_SHOW_COUNTS + ") AS legacy "
+                     "LEFT JOIN tvshowcounts ON tvshowcounts.idShow=legacy.idShow "
+                     "WHERE tvshowcounts.idShow IS NULL" + differs));
+
+    EXPECT_EQ(m_database.GetSingleValueInt("SELECT COUNT(*) FROM (" + LEGACY_SEASON_COUNTS +
+                                           ") AS legacy"),
+              m_database.GetSingleValueInt("SELECT COUNT(*) FROM season_view"));
+    differs.clear();
+    for (const char* column : {"episodes", "playCount", "aired", "inProgressCount"})
+    {
+      differs += " OR " + Differs(std::string("legacy.") + column,
+                                  std::string("season_view.") + column);
+    }
+    EXPECT_EQ(0, m_database.GetSingleValueInt(
+                     "SELECT COUNT(*) FROM (" + LEGACY_SEASON_COUNTS + ") AS legacy "
+                     "LEFT JOIN season_view ON season_view.idSeason=legacy.idSeason "
+                     "WHERE season_view.idSeason IS NULL" + differs));
+  }
+
+  DatabaseSettings m_settings;
+  bool m_mysql = false;
+  CVideoDatabase m_database;
+};
+
+TEST_P(TestVideoDatabase, ShowCounts)
+{
+  AddShows(3, 2, 4);
+  // a show without episodes and a season without episodes
+  m_database.ExecuteQuery("INSERT INTO tvshow (idShow, c00) VALUES (100, 'Empty')");
+  m_database.ExecuteQuery("INSERT INTO seasons (idSeason, idShow, season) VALUES (100, 1, 5)");
+
+  EXPECT_EQ(8, m_database.GetSingleValueInt("SELECT totalCount FROM tvshowcounts WHERE idShow=1"));
+  EXPECT_EQ(1, m_database.GetSingleValueInt(
+                   "SELECT COUNT(*) FROM tvshowcounts WHERE idShow=100 AND totalCount IS NULL "
+                   "AND watchedcount=0 AND inProgressCount=0"));
+  EXPECT_EQ(0, m_database.GetSingleValueInt("SELECT COUNT(*) FROM season_view WHERE idSeason=100"));
+  ExpectLegacyCounts();
+}
+
+TEST_P(TestVideoDatabase, ShowCountsFollowChanges)
+{
+  AddShows(3, 2, 4);
+
+  // playing an episode, resuming another, stopping one and moving one to another season
+  m_database.ExecuteQuery("UPDATE files SET playCount=1, lastPlayed='2025-01-01 00:00:00' "
+                          "WHERE idFile=13");
+  m_database.ExecuteQuery("INSERT INTO bookmark (idFile, timeInSeconds, totalTimeInSeconds, "
+                          "type) VALUES (14, 30, 1200, 1)");
+  m_database.ExecuteQuery("UPDATE bookmark SET type=0 WHERE idFile=15");
+  m_database.ExecuteQuery("UPDATE episode SET c12='1', idSeason=3 WHERE idEpisode=17");
+  ExpectLegacyCounts();
+
+  // moving an episode to another show, removing episodes and a whole show
+  m_database.ExecuteQuery("UPDATE episode SET idShow=3, idSeason=7 WHERE idEpisode=18");
+  m_database.ExecuteQuery("DELETE FROM bookmark WHERE idFile=20");
+  m_database.ExecuteQuery("DELETE FROM episode WHERE idEpisode IN (19, 21)");
+  m_database.ExecuteQuery("DELETE FROM files WHERE idFile=22");
+  m_database.ExecuteQuery("DELETE FROM seasons WHERE idSeason=8");
+  m_database.ExecuteQuery("DELETE FROM episode WHERE idShow=2");
+  m_database.ExecuteQuery("DELETE FROM tvshow WHERE idShow=2");
+  ExpectLegacyCounts();
+  EXPECT_EQ(0, m_database.GetSingleValueInt("SELECT COUNT(*) FROM tvshow_counts WHERE idShow=2"));
+}
+
+TEST_P(TestVideoDatabase, ShowCountsIgnoreOtherChanges)
+{
+  AddShows(3, 2, 4);
+
+  // a count the triggers would correct if they ran, idFile 13 to 16 are of show 1
+  m_database.ExecuteQuery("UPDATE tvshow_counts SET totalCount=999 WHERE idShow=1");
+
+  m_database.ExecuteQuery("UPDATE files SET strFilename='renamed.mkv' WHERE idFile=13");
+  m_database.ExecuteQuery("UPDATE files SET playCount=NULL WHERE idFile=14");
+  m_database.ExecuteQuery("UPDATE bookmark SET timeInSeconds=90 WHERE idFile=15");
+  m_database.ExecuteQuery("INSERT INTO bookmark (idFile, timeInSeconds, totalTimeInSeconds, "
+                          "type) VALUES (16, 30, 1200, 0)");
+  m_database.ExecuteQuery("UPDATE episode SET c00='Renamed' WHERE idEpisode=16");
+  EXPECT_EQ(999, m_database.GetSingleValueInt("SELECT totalCount FROM tvshow_counts "
+                                              "WHERE idShow=1"));
+
+  m_database.ExecuteQuery("UPDATE files SET playCount=1 WHERE idFile=14");
+  EXPECT_EQ(8, m_database.GetSingleValueInt("SELECT totalCount FROM tvshow_counts "
+                                            "WHERE idShow=1"));
+  ExpectLegacyCounts();
+}
+
+// a benchmark, not run with the unit tests, see --gtest_also_run_disabled_tests
+TEST_P(TestVideoDatabase, DISABLED_ShowCountsBenchmark)
+{
+  AddShows(200, 5, 10);
+
+  const auto time = [this](const std::string& sql, std::string& result) {
+    const auto start = std::chrono::steady_clock::now();
+    result = m_database.GetSingleValue(sql);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  };
+
+  std::string legacy;
+  std::string counts;
+  const double legacyTime = time("SELECT SUM(totalCount) + SUM(watchedcount) + "
+                                 "SUM(inProgressCount) FROM (" +
+                                     LEGACY_SHOW_COUNTS + ") AS legacy",
+                                 legacy);
+  const double countsTime = time("SELECT SUM(totalCount) + SUM(watchedcount) + "
+                                 "SUM(inProgressCount) FROM tvshowcounts",
+                                 counts);
+  EXPECT_EQ(legacy, counts);
+
+  std::cout << StringUtils::Format("tv show counts of 10000 episodes: aggregated {:.2f} ms, "
+                                   "from counts table {:.2f} ms",
+                                   legacyTime, countsTime)
+            << std::endl;
+}
+
+INSTANTIATE_TEST_SUITE_P(Databases, TestVideoDatabase, testing::Values("sqlite3", "mysql"));
+
+TEST(TestDatabaseTriggers, SQLiteSyntax)
+{
+  EXPECT_EQ("CREATE TRIGGER counts AFTER UPDATE ON files FOR EACH ROW "
+            "WHEN (OLD.playCount IS NOT NEW.playCount OR OLD.lastPlayed IS NOT NEW.lastPlayed) "
+            "BEGIN DELETE FROM counts; INSERT INTO counts SELECT 1; END",
+            CDatabase::GetTriggerSQL(true, "counts", "UPDATE", "files",
+                                     CDatabase::GetChangedSQL(true, {"playCount", "lastPlayed"}),
+                                     {"DELETE FROM counts", "INSERT INTO counts SELECT 1"}));
+  EXPECT_EQ("CREATE TRIGGER counts AFTER INSERT ON files FOR EACH ROW "
+            "BEGIN DELETE FROM counts; END",
+            CDatabase::GetTriggerSQL(true, "counts", "INSERT", "files", "",
+                                     {"DELETE FROM counts"}));
+}
+
+TEST(TestDatabaseTriggers, MySQLSyntax)
+{
+  // MySQL has no WHEN for triggers and no IS NOT for values
+  EXPECT_EQ("CREATE TRIGGER counts AFTER UPDATE ON files FOR EACH ROW "
+            "BEGIN IF (NOT (OLD.playCount <=> NEW.playCount) OR "
+            "NOT (OLD.lastPlayed <=> NEW.lastPlayed)) "
+            "THEN DELETE FROM counts; INSERT INTO counts SELECT 1; END IF; END",
+            CDatabase::GetTriggerSQL(false, "counts", "UPDATE", "files",
+                                     CDatabase::GetChangedSQL(false, {"playCount", "lastPlayed"}),
+                                     {"DELETE FROM counts", "INSERT INTO counts SELECT 1"}));
+  EXPECT_EQ("CREATE TRIGGER counts AFTER DELETE ON bookmark FOR EACH ROW "
+            "BEGIN IF OLD.type=1 THEN DELETE FROM counts; END IF; END",
+            CDatabase::GetTriggerSQL(false, "counts", "DELETE", "bookmark", "OLD.type=1",
+                                     {"DELETE FROM counts"}));
+}
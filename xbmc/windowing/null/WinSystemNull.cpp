@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "WinSystemNull.h"
+
+#include "ServiceBroker.h"
+#include "application/AppInboundProtocol.h"
+#include "settings/DisplaySettings.h"
+#include "utils/log.h"
+#include "windowing/GraphicContext.h"
+#include "windowing/WindowSystemFactory.h"
+
+using namespace KODI::WINDOWING;
+
+namespace
+{
+constexpr int WIDTH = 1920;
+constexpr int HEIGHT = 1080;
+constexpr float REFRESH_RATE = 60.0f;
+} // unnamed namespace
+
+void CWinSystemNull::Register()
+{
+  CWindowSystemFactory::RegisterWindowSystem(CreateWinSystem, "null");
+}
+
+std::unique_ptr<CWinSystemBase> CWinSystemNull::CreateWinSystem()
+{
+  return std::make_unique<CWinSystemNull>();
+}
+
+bool CWinSystemNull::InitWindowSystem()
+{
+  CLog::Log(LOGINFO, "CWinSystemNull::InitWindowSystem - no display, the GUI is not rendered");
+  return CWinSystemBase::InitWindowSystem();
+}
+
+bool CWinSystemNull::DestroyWindowSystem()
+{
+  CWinSystemBase::DestroyWindowSystem();
+  return true;
+}
+
+bool CWinSystemNull::CreateNewWindow(const std::string& name,
+                                     bool fullScreen,
+                                     RESOLUTION_INFO& res)
+{
+  m_nWidth = res.iWidth;
+  m_nHeight = res.iHeight;
+  m_fRefreshRate = res.fRefreshRate;
+  m_bFullScreen = fullScreen;
+  m_bWindowCreated = true;
+  return true;
+}
+
+bool CWinSystemNull::DestroyWindow()
+{
+  m_bWindowCreated = false;
+  return true;
+}
+
+bool CWinSystemNull::ResizeWindow(int newWidth, int newHeight, int newLeft, int newTop)
+{
+  m_nWidth = newWidth;
+  m_nHeight = newHeight;
+  m_nLeft = newLeft;
+  m_nTop = newTop;
+  return true;
+}
+
+bool CWinSystemNull::SetFullScreen(bool fullScreen, RESOLUTION_INFO& res, bool blankOtherDisplays)
+{
+  m_nWidth = res.iWidth;
+  m_nHeight = res.iHeight;
+  m_fRefreshRate = res.fRefreshRate;
+  m_bFullScreen = fullScreen;
+  return true;
+}
+
+void CWinSystemNull::UpdateResolutions()
+{
+  RESOLUTION_INFO& desktop = CDisplaySettings::GetInstance().GetResolutionInfo(RES_DESKTOP);
+  UpdateDesktopResolution(desktop, "null", WIDTH, HEIGHT, REFRESH_RATE, 0);
+  GetGfxContext().ResetOverscan(desktop);
+  CDisplaySettings::GetInstance().ClearCustomResolutions();
+}
+
+bool CWinSystemNull::MessagePump()
+{
+  // nothing shows the GUI, don't let the application spend time on rendering it
+  std::shared_ptr<CAppInboundProtocol> appPort = CServiceBroker::GetAppPort();
+  if (appPort)
+    appPort->SetRenderGUI(false);
+
+  return false;
+}
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (C) 2025 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "rendering/null/RenderSystemNull.h"
+#include "windowing/WinSystem.h"
+
+#include <memory>
+
+namespace KODI
+{
+namespace WINDOWING
+{
+
+/*!
+ \brief Window system without a display, selected with --windowing=null
+
+ There's no window and the GUI isn't rendered, the application keeps running its
+ loop for the players. Meant for playback on build servers, e.g. with
+ --playback-benchmark, where the video is played with the null renderer.
+ */
+class CWinSystemNull : public CWinSystemBase, public CRenderSystemNull
+{
+public:
+  CWinSystemNull() = default;
+  ~CWinSystemNull() override = default;
+
+  static void Register();
+  static std::unique_ptr<CWinSystemBase> CreateWinSystem();
+
+  // Implementation of CWinSystemBase
+  CRenderSystemBase* GetRenderSystem() override { return this; }
+  bool InitWindowSystem() override;
+  bool DestroyWindowSystem() override;
+  bool CreateNewWindow(const std::string& name, bool fullScreen, RESOLUTION_INFO& res) override;
+  bool DestroyWindow() override;
+  bool ResizeWindow(int newWidth, int newHeight, int newLeft, int newTop) override;
+  bool SetFullScreen(bool fullScreen, RESOLUTION_INFO& res, bool blankOtherDisplays) override;
+  void UpdateResolutions() override;
+  bool MessagePump() override;
+
+  void Register(IDispResource* resource) override {}
+  void Unregister(IDispResource* resource) override {}
+};
+
+} // namespace WINDOWING
+} // namespace KODI
@@ -24,6 +24,7 @@ public:
   void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions) override;
   void Render() override;
   bool OnMessage(CGUIMessage &message) override;
+  bool HasAutoVisibility() const override { return true; }
 protected:
   void UpdateVisibility() override;
 private:
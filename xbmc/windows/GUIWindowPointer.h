@@ -17,6 +17,7 @@ public:
   CGUIWindowPointer(void);
   ~CGUIWindowPointer(void) override;
   void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions) override;
+  bool HasAutoVisibility() const override { return true; }
 protected:
   void SetPointer(int pointer);
   void OnWindowLoaded() override;
@@ -33,6 +33,7 @@ public:
   }
   void Render() override;
   void Process(unsigned int currentTime, CDirtyRegionList& regions) override;
+  bool HasAutoVisibility() const override { return true; }
 
 protected:
   void UpdateVisibility() override;
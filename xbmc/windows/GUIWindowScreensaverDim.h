@@ -17,6 +17,7 @@ public:
 
   void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions) override;
   void Render() override;
+  bool HasAutoVisibility() const override { return true; }
 
 protected:
   void UpdateVisibility() override;